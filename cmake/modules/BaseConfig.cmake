@@ -76,6 +76,15 @@ if(FEATURE_METRICS)
         REQUIRED
     )
 endif()
+if(FEATURE_IO_URING)
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(
+        liburing
+        REQUIRED
+        IMPORTED_TARGET
+        liburing
+    )
+endif()
 find_package(mio REQUIRED)
 find_package(
     pugixml
@@ -137,6 +137,18 @@ foreach(
         )
     endif()
 
+    if(FEATURE_IO_URING)
+        # asio picks its reactor at compile time, every socket operation then goes through io_uring
+        target_compile_definitions(
+            ${core_target}
+            PUBLIC ASIO_HAS_IO_URING ASIO_DISABLE_EPOLL
+        )
+        target_link_libraries(
+            ${core_target}
+            PUBLIC PkgConfig::liburing
+        )
+    endif()
+
     if(MSVC)
         target_link_libraries(
             ${core_target}
@@ -0,0 +1,10 @@
+-- The scripts of this folder are loaded by the pure Lua states, not by the main one (see luaPureStates in config.lua)
+-- They only see plain values and the base, string, table and math libraries: no game object, storage or event
+-- Call them from any script with Game.callPureAsync(functionName, callback, ...), callback gets the returned values
+
+-- Same shape as the onGetFormulaValues of the magic level based spells
+function pureMagicDamage(level, magicLevel, minFactor, minBase, maxFactor, maxBase)
+	local min = (level / 5) + (magicLevel * minFactor) + minBase
+	local max = (level / 5) + (magicLevel * maxFactor) + maxBase
+	return -math.floor(min), -math.floor(max)
+end
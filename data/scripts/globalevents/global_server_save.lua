@@ -1,6 +1,6 @@
 local function ServerSave()
 	if configManager.getBoolean(configKeys.GLOBAL_SERVER_SAVE_CLEAN_MAP) then
-		cleanMap()
+		cleanMap(true)
 	end
 
 	if configManager.getBoolean(configKeys.GLOBAL_SERVER_SAVE_CLOSE) then
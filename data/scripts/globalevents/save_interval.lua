@@ -1,6 +1,6 @@
 local function serverSave(interval)
 	if configManager.getBoolean(configKeys.TOGGLE_SAVE_INTERVAL_CLEAN_MAP) then
-		cleanMap()
+		cleanMap(true)
 	end
 
 	saveServer()
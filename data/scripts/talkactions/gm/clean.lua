@@ -6,7 +6,7 @@ function clean.onSay(player, words, param)
 
 	local itemCount = cleanMap()
 	if itemCount ~= 0 then
-		player:sendTextMessage(MESSAGE_ADMINISTRATOR, "Cleaned " .. itemCount .. " item" .. (itemCount > 1 and "s" or "") .. " from the map.")
+		player:sendTextMessage(MESSAGE_ADMINISTRATOR, "Cleaning " .. itemCount .. " item" .. (itemCount > 1 and "s" or "") .. " from the map.")
 	end
 	return true
 end
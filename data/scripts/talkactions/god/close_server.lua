@@ -9,7 +9,7 @@ function closeServer.onSay(player, words, param)
 		Webhook.sendMessage(":red_circle: Server was shutdown by: **" .. player:getName() .. "**", announcementChannels["serverAnnouncements"])
 	elseif param == "save" then
 		if configManager.getBoolean(configKeys.GLOBAL_SERVER_SAVE_CLEAN_MAP) then
-			cleanMap()
+			cleanMap(true)
 		end
 		if configManager.getBoolean(configKeys.GLOBAL_SERVER_SAVE_CLOSE) then
 			Game.setGameState(GAME_STATE_CLOSED, true)
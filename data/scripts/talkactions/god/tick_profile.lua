@@ -0,0 +1,25 @@
+local tickProfile = TalkAction("/tickprofile")
+
+function tickProfile.onSay(player, words, param)
+	-- create log
+	logCommand(player, words, param)
+
+	local format = param ~= "" and param:lower() or "folded"
+	if format ~= "folded" and format ~= "chrome" then
+		player:sendCancelMessage("Usage: /tickprofile [folded|chrome]")
+		return true
+	end
+
+	local path = Game.dumpTickProfile(format)
+	if not path then
+		player:sendTextMessage(MESSAGE_ADMINISTRATOR, "No slow tick has been recorded yet.")
+		return true
+	end
+
+	player:sendTextMessage(MESSAGE_ADMINISTRATOR, "Slowest ticks dumped to " .. path .. ".")
+	return true
+end
+
+tickProfile:separator(" ")
+tickProfile:groupType("god")
+tickProfile:register()
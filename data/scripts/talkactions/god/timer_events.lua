@@ -0,0 +1,29 @@
+local timerEvents = TalkAction("/timerevents")
+
+function timerEvents.onSay(player, words, param)
+	-- create log
+	logCommand(player, words, param)
+
+	local limit = tonumber(param) or 10
+	local stats = Game.getTimerEventStats()
+	local lines = {}
+	for i = 1, math.min(limit, #stats) do
+		local script = stats[i]
+		if script.active == 0 then
+			break
+		end
+		lines[#lines + 1] = string.format("%s: %d active, %d created", script.script, script.active, script.created)
+	end
+
+	if #lines == 0 then
+		player:sendTextMessage(MESSAGE_ADMINISTRATOR, "There are no pending timer events.")
+		return true
+	end
+
+	player:showTextDialog(2819, "Scripts with the most pending timer events:\n" .. table.concat(lines, "\n"))
+	return true
+end
+
+timerEvents:separator(" ")
+timerEvents:groupType("god")
+timerEvents:register()
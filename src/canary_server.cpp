@@ -27,8 +27,11 @@
 #include "lib/thread/thread_pool.hpp"
 #include "lua/creature/events.hpp"
 #include "lua/modules/modules.hpp"
+#include "lua/scripts/lua_bytecode_cache.hpp"
 #include "lua/scripts/lua_environment.hpp"
+#include "lua/scripts/lua_state_pool.hpp"
 #include "lua/scripts/scripts.hpp"
+#include "server/network/protocol/authworkers.hpp"
 #include "server/network/protocol/protocollogin.hpp"
 #include "server/network/protocol/protocolstatus.hpp"
 #include "server/network/webhook/webhook.hpp"
@@ -77,10 +80,28 @@ int CanaryServer::run() {
 				g_metrics().init(metricsOptions);
 #endif
 				rsa.start();
-				initializeDatabase();
-				loadModules();
+				g_authWorkers().start(g_configManager().getNumber(AUTH_WORKERS), g_configManager().getNumber(AUTH_QUEUE_SIZE));
+
+				// Startup dependency graph: data files load while the database is set up, the main map
+				// tiles only need the item types and are parsed right after them. Scripts write to the
+				// item types, so they load once the tiles are parsed. Everything that needs both
+				// (spawns, houses, npcs, zones) is loaded afterwards by loadMaps.
+				auto dataLoaders = loadDataFiles();
+				try {
+					timedLoad("database", [this] {
+						initializeDatabase();
+						return true;
+					});
+				} catch (...) {
+					joinLoaders(dataLoaders);
+					throw;
+				}
+				joinLoaders(dataLoaders);
+
 				setWorldType();
+				loadModules();
 				loadMaps();
+				logLoaderTimings();
 
 				logger.info("Initializing gamestate...");
 				g_game().setGameState(GAME_STATE_INIT);
@@ -196,15 +217,35 @@ void CanaryServer::setWorldType() {
 	logger.debug("World type set as {}", asUpperCaseString(worldType));
 }
 
-void CanaryServer::loadMaps() const {
+void CanaryServer::loadMainMapTiles() {
+	timedLoad("world/" + g_configManager().getString(MAP_NAME) + ".otbm", [] {
+		try {
+			g_game().loadMainMapTiles(g_configManager().getString(MAP_NAME));
+		} catch (const std::exception &err) {
+			throw FailedToInitializeCanary(err.what());
+		}
+		return true;
+	});
+}
+
+void CanaryServer::loadMaps() {
 	try {
-		g_game().loadMainMap(g_configManager().getString(MAP_NAME));
+		timedLoad("world data", [] {
+			g_game().loadMainMapData();
+			return true;
+		});
 
 		// If "mapCustomEnabled" is true on config.lua, then load the custom map
 		if (g_configManager().getBoolean(TOGGLE_MAP_CUSTOM)) {
-			g_game().loadCustomMaps(g_configManager().getString(DATA_DIRECTORY) + "/world/custom/");
+			timedLoad("world/custom", [] {
+				g_game().loadCustomMaps(g_configManager().getString(DATA_DIRECTORY) + "/world/custom/");
+				return true;
+			});
 		}
 		Zone::refreshAll();
+		g_game().map.logMemoryUsage();
+	} catch (const FailedToInitializeCanary &) {
+		throw;
 	} catch (const std::exception &err) {
 		throw FailedToInitializeCanary(err.what());
 	}
@@ -372,6 +413,38 @@ void CanaryServer::initializeDatabase() {
 	g_logger().info("Database connection established!");
 }
 
+std::vector<std::future<void>> CanaryServer::loadDataFiles() {
+	logger.info("Loading data files...");
+
+	const auto coreFolder = g_configManager().getString(CORE_DIRECTORY);
+	std::vector<std::future<void>> loaders;
+	// appearances.dat first, outfits check the registered look types and items.xml extends the item types.
+	// The main map tiles are parsed next, while nothing writes to the item types yet.
+	loaders.emplace_back(loadAsync([this, coreFolder] {
+		timedLoad("appearances.dat", [&coreFolder] {
+			return g_game().loadAppearanceProtobuf(coreFolder + "/items/appearances.dat") == ERROR_NONE;
+		});
+		timedLoad("XML/outfits.xml", [] { return Outfits::getInstance().loadFromXml(); });
+		timedLoad("items.xml", [] { return Item::items.loadFromXml(); });
+		loadMainMapTiles();
+	}));
+
+	// XML files without dependencies
+	loaders.emplace_back(loadAsync([this] {
+		timedLoad("XML/vocations.xml", [] { return g_vocations().loadFromXml(); });
+	}));
+	loaders.emplace_back(loadAsync([this] {
+		timedLoad("XML/familiars.xml", [] { return Familiars::getInstance().loadFromXml(); });
+	}));
+	loaders.emplace_back(loadAsync([this] {
+		timedLoad("XML/imbuements.xml", [] { return g_imbuements().loadFromXml(); });
+	}));
+	loaders.emplace_back(loadAsync([this] {
+		timedLoad("XML/storages.xml", [] { return g_storages().loadFromXML(); });
+	}));
+	return loaders;
+}
+
 void CanaryServer::loadModules() {
 	logger.info("Initializing lua environment...");
 	if (!g_luaEnvironment().getLuaState()) {
@@ -379,42 +452,39 @@ void CanaryServer::loadModules() {
 	}
 
 	logger.info("Loading modules and scripts...");
+	g_luaBytecodeCache().setDirectory(g_configManager().getString(LUA_BYTECODE_CACHE_DIRECTORY));
 
-	auto coreFolder = g_configManager().getString(CORE_DIRECTORY);
-	// Load appearances.dat first
-	modulesLoadHelper((g_game().loadAppearanceProtobuf(coreFolder + "/items/appearances.dat") == ERROR_NONE), "appearances.dat");
-
-	// Load XML folder dependencies (order matters)
-	modulesLoadHelper(g_vocations().loadFromXml(), "XML/vocations.xml");
-	modulesLoadHelper(Outfits::getInstance().loadFromXml(), "XML/outfits.xml");
-	modulesLoadHelper(Familiars::getInstance().loadFromXml(), "XML/familiars.xml");
-	modulesLoadHelper(g_imbuements().loadFromXml(), "XML/imbuements.xml");
-	modulesLoadHelper(g_storages().loadFromXML(), "XML/storages.xml");
-
-	modulesLoadHelper(Item::items.loadFromXml(), "items.xml");
-
+	// Scripts share the lua state, so they load one after another
+	const auto coreFolder = g_configManager().getString(CORE_DIRECTORY);
 	const auto datapackFolder = g_configManager().getString(DATA_DIRECTORY);
 	logger.debug("Loading core scripts on folder: {}/", coreFolder);
 	// Load first core Lua libs
-	modulesLoadHelper((g_luaEnvironment().loadFile(coreFolder + "/core.lua", "core.lua") == 0), "core.lua");
-	modulesLoadHelper(g_scripts().loadScripts(coreFolder + "/scripts/lib", true, false), coreFolder + "/scripts/libs");
-	modulesLoadHelper(g_scripts().loadScripts(coreFolder + "/scripts", false, false), coreFolder + "/scripts");
-	modulesLoadHelper((g_npcs().load(true, false)), "npclib");
-
-	modulesLoadHelper(g_events().loadFromXml(), "events/events.xml");
-	modulesLoadHelper(g_modules().loadFromXml(), "modules/modules.xml");
+	timedLoad("core.lua", [&coreFolder] { return g_luaEnvironment().loadFile(coreFolder + "/core.lua", "core.lua") == 0; });
+	timedLoad(coreFolder + "/scripts/libs", [&coreFolder] { return g_scripts().loadScripts(coreFolder + "/scripts/lib", true, false); });
+	timedLoad(coreFolder + "/scripts", [&coreFolder] { return g_scripts().loadScripts(coreFolder + "/scripts", false, false); });
+	// Side-effect-free scripts, run apart from the main state through Game.callPureAsync
+	timedLoad(coreFolder + "/pure", [&coreFolder] {
+		g_luaStatePool().init(static_cast<size_t>(std::max<int32_t>(0, g_configManager().getNumber(LUA_PURE_STATES))));
+		return g_luaStatePool().loadDirectory(coreFolder + "/pure");
+	});
+	timedLoad("npclib", [] { return g_npcs().load(true, false); });
+
+	timedLoad("events/events.xml", [] { return g_events().loadFromXml(); });
+	timedLoad("modules/modules.xml", [] { return g_modules().loadFromXml(); });
 
 	logger.debug("Loading datapack scripts on folder: {}/", datapackFolder);
-	modulesLoadHelper(g_scripts().loadScripts(datapackFolder + "/scripts/lib", true, false), datapackFolder + "/scripts/libs");
+	timedLoad(datapackFolder + "/scripts/libs", [&datapackFolder] { return g_scripts().loadScripts(datapackFolder + "/scripts/lib", true, false); });
 	// Load scripts
-	modulesLoadHelper(g_scripts().loadScripts(datapackFolder + "/scripts", false, false), datapackFolder + "/scripts");
+	timedLoad(datapackFolder + "/scripts", [&datapackFolder] { return g_scripts().loadScripts(datapackFolder + "/scripts", false, false); });
 	// Load monsters
-	modulesLoadHelper(g_scripts().loadScripts(datapackFolder + "/monster", false, false), datapackFolder + "/monster");
-	modulesLoadHelper((g_npcs().load(false, true)), "npc");
+	timedLoad(datapackFolder + "/monster", [&datapackFolder] { return g_scripts().loadScripts(datapackFolder + "/monster", false, false); });
+	timedLoad("npc", [] { return g_npcs().load(false, true); });
 
 	// It needs to be loaded after the revscript is read in order to use the scripting interface
-	modulesLoadHelper(g_eventsScheduler().loadScheduleEventFromXml(), "XML/events.xml");
-	modulesLoadHelper(g_eventsScheduler().loadScheduleEventFromJson(), "json/eventscheduler/events.json");
+	timedLoad("XML/events.xml", [] { return g_eventsScheduler().loadScheduleEventFromXml(); });
+	timedLoad("json/eventscheduler/events.json", [] { return g_eventsScheduler().loadScheduleEventFromJson(); });
+
+	g_luaBytecodeCache().logStats("Startup scripts");
 
 	g_game().loadBoostedCreature();
 	g_ioBosstiary().loadBoostedBoss();
@@ -429,9 +499,44 @@ void CanaryServer::modulesLoadHelper(bool loaded, std::string moduleName) {
 	}
 }
 
+void CanaryServer::timedLoad(const std::string &moduleName, const std::function<bool()> &loader) {
+	Benchmark bm_loader;
+	const bool loaded = loader();
+	{
+		std::scoped_lock lock(loaderTimingsMutex);
+		loaderTimings.push_back({ moduleName, bm_loader.duration() });
+	}
+	modulesLoadHelper(loaded, moduleName);
+}
+
+std::future<void> CanaryServer::loadAsync(std::function<void()> &&loaders) {
+	return g_threadPool().submit_task(std::move(loaders));
+}
+
+void CanaryServer::joinLoaders(std::vector<std::future<void>> &loaders) {
+	for (auto &loader : loaders) {
+		loader.wait();
+	}
+	for (auto &loader : loaders) {
+		loader.get();
+	}
+	loaders.clear();
+}
+
+void CanaryServer::logLoaderTimings() {
+	std::scoped_lock lock(loaderTimingsMutex);
+	std::ranges::sort(loaderTimings, std::ranges::greater {}, &LoaderTiming::duration);
+	logger.info("Startup loader timings:");
+	for (const auto &[name, duration] : loaderTimings) {
+		logger.info("  {:<40} {:>10.2f} ms", name, duration);
+	}
+}
+
 void CanaryServer::shutdown() {
 	g_database().createDatabaseBackup(true);
+	g_authWorkers().stop();
 	g_dispatcher().shutdown();
 	g_metrics().shutdown();
 	g_threadPool().shutdown();
+	g_luaStatePool().close();
 }
@@ -54,6 +54,14 @@ private:
 	std::mutex loaderMutex;
 	std::condition_variable loaderCV;
 
+	struct LoaderTiming {
+		std::string name;
+		double duration;
+	};
+
+	std::mutex loaderTimingsMutex;
+	std::vector<LoaderTiming> loaderTimings;
+
 	void logInfos();
 	static void toggleForceCloseButton();
 	static void badAllocationHandler();
@@ -65,9 +73,25 @@ private:
 	void loadConfigLua();
 	void validateDatapack();
 	void initializeDatabase();
+	std::vector<std::future<void>> loadDataFiles();
 	void loadModules();
 	void setWorldType();
-	void loadMaps() const;
+	void loadMainMapTiles();
+	void loadMaps();
 	void setupHousesRent();
 	void modulesLoadHelper(bool loaded, std::string moduleName);
+
+	/**
+	 * Runs a startup loader, records how long it took and fails the startup if it did not load.
+	 */
+	void timedLoad(const std::string &moduleName, const std::function<bool()> &loader);
+	/**
+	 * Runs startup loaders on the thread pool, they must not depend on anything that is still loading.
+	 */
+	static std::future<void> loadAsync(std::function<void()> &&loaders);
+	/**
+	 * Waits for every loader before rethrowing the first failure, so none is left running.
+	 */
+	static void joinLoaders(std::vector<std::future<void>> &loaders);
+	void logLoaderTimings();
 };
@@ -23,9 +23,12 @@ enum ConfigKey_t : uint16_t {
 	AUGMENT_INCREASED_DAMAGE_PERCENT,
 	AUGMENT_POWERFUL_IMPACT_PERCENT,
 	AUGMENT_STRONG_IMPACT_PERCENT,
+	AUTH_QUEUE_SIZE,
 	AUTH_TYPE,
+	AUTH_WORKERS,
 	AUTOBANK,
 	AUTOLOOT,
+	AUTOSEND_MAX_BATCH_TICKS,
 	BESTIARY_KILL_MULTIPLIER,
 	BESTIARY_RATE_CHARM_SHOP_PRICE,
 	BIND_ONLY_GLOBAL_ADDRESS,
@@ -41,6 +44,7 @@ enum ConfigKey_t : uint16_t {
 	CHECK_EXPIRED_MARKET_OFFERS_EACH_MINUTES,
 	CLASSIC_ATTACK_SPEED,
 	CLEAN_PROTECTION_ZONES,
+	COALESCE_SOCKET_IO,
 	COMBAT_CHAIN_DELAY,
 	COMBAT_CHAIN_SKILL_FORMULA_FIST,
 	COMBAT_CHAIN_SKILL_FORMULA_AXE,
@@ -125,6 +129,8 @@ enum ConfigKey_t : uint16_t {
 	HOUSE_PURSHASED_SHOW_PRICE,
 	HOUSE_RENT_PERIOD,
 	HOUSE_RENT_RATE,
+	INBOUND_PACKET_QUEUE_DISCONNECT,
+	INBOUND_PACKET_QUEUE_SIZE,
 	INVENTORY_GLOW,
 	IP,
 	KICK_AFTER_MINUTES,
@@ -139,10 +145,14 @@ enum ConfigKey_t : uint16_t {
 	LOYALTY_POINTS_PER_CREATION_DAY,
 	LOYALTY_POINTS_PER_PREMIUM_DAY_PURCHASED,
 	LOYALTY_POINTS_PER_PREMIUM_DAY_SPENT,
+	LUA_BYTECODE_CACHE_DIRECTORY,
+	LUA_PURE_STATES,
 	M_CONST,
 	MAINTAIN_MODE_MESSAGE,
 	MAP_AUTHOR,
 	MAP_DOWNLOAD_URL,
+	MAP_EVICTION_IDLE_TIME,
+	MAP_EVICTION_MEMORY_BUDGET,
 	MAP_NAME,
 	MARKET_OFFER_DURATION,
 	MARKET_REFRESH_PRICES,
@@ -177,6 +187,7 @@ enum ConfigKey_t : uint16_t {
 	MYSQL_PASS,
 	MYSQL_SOCK,
 	MYSQL_USER,
+	NETWORK_REACTORS,
 	OLD_PROTOCOL,
 	ONE_PLAYER_ON_ACCOUNT,
 	ONLY_INVITED_CAN_MOVE_HOUSE_ITEMS,
@@ -289,6 +300,8 @@ enum ConfigKey_t : uint16_t {
 	TIBIADROME_CONCOCTION_COOLDOWN,
 	TIBIADROME_CONCOCTION_DURATION,
 	TIBIADROME_CONCOCTION_TICK_TYPE,
+	TICK_PROFILER_MIN_DURATION,
+	TICK_PROFILER_SLOWEST_TICKS,
 	TOGGLE_CHAIN_SYSTEM,
 	TOGGLE_DOWNLOAD_MAP,
 	TOGGLE_FREE_QUEST,
@@ -300,6 +313,7 @@ enum ConfigKey_t : uint16_t {
 	TOGGLE_IMBUEMENT_SHRINE_STORAGE,
 	TOGGLE_MAINTAIN_MODE,
 	TOGGLE_MAP_CUSTOM,
+	TOGGLE_MAP_SNAPSHOT,
 	TOGGLE_MOUNT_IN_PZ,
 	TOGGLE_RECEIVE_REWARD,
 	TOGGLE_SAVE_ASYNC,
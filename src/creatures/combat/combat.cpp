@@ -1276,7 +1276,7 @@ void Combat::setupChain(const std::shared_ptr<Weapon> &weapon) {
 }
 
 bool Combat::doCombatChain(const std::shared_ptr<Creature> &caster, const std::shared_ptr<Creature> &target, bool aggressive) const {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (!params.chainCallback) {
 		return false;
 	}
@@ -1710,7 +1710,7 @@ void Combat::setRuneSpellName(const std::string &value) {
 
 std::vector<std::pair<Position, std::vector<uint32_t>>> Combat::pickChainTargets(const std::shared_ptr<Creature> &caster, const CombatParams &params, uint8_t chainDistance, uint8_t maxTargets, bool backtracking, bool aggressive, const std::shared_ptr<Creature> &initialTarget /* = nullptr */) {
 	Benchmark bm_pickChain;
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (!caster) {
 		return {};
 	}
@@ -1836,7 +1836,7 @@ void ValueCallback::getMinMaxValues(const std::shared_ptr<Player> &player, Comba
 	scriptInterface->pushFunction(scriptId);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	int16_t elementAttack = 0; // To calculate elemental damage after executing spell script and get real damage.
 	int32_t attackValue = 7; // default start attack value
@@ -2474,7 +2474,7 @@ void MagicField::onStepInField(const std::shared_ptr<Creature> &creature) {
 }
 
 void Combat::applyExtensions(const std::shared_ptr<Creature> &caster, const std::vector<std::shared_ptr<Creature>> targets, CombatDamage &damage, const CombatParams &params) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (damage.extension || !caster || damage.primary.type == COMBAT_HEALING) {
 		return;
 	}
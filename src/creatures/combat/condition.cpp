@@ -165,7 +165,7 @@ void Condition::serialize(PropWriteStream &propWriteStream) {
 	propWriteStream.write<uint32_t>(id);
 
 	propWriteStream.write<uint8_t>(CONDITIONATTR_TICKS);
-	propWriteStream.write<uint32_t>(ticks);
+	propWriteStream.write<uint32_t>(getTicks());
 
 	propWriteStream.write<uint8_t>(CONDITIONATTR_ISBUFF);
 	propWriteStream.write<uint8_t>(isBuff);
@@ -409,9 +409,25 @@ int64_t Condition::getEndTime() const {
 }
 
 int32_t Condition::getTicks() const {
+	// Not executed on every think, the ticks were only counted down up to the last setTicks
+	if (executedWhenDue && ticks > 0) {
+		return static_cast<int32_t>(std::clamp<int64_t>(endTime - OTSYS_TIME(), 0, ticks));
+	}
 	return ticks;
 }
 
+void Condition::setExecutedWhenDue(bool value) {
+	// Back to the regular countdown, it has to continue from the real remaining time
+	if (executedWhenDue && !value) {
+		ticks = getTicks();
+	}
+	executedWhenDue = value;
+}
+
+bool Condition::executesOnThink() const {
+	return tickSound != SoundEffect_t::SILENCE;
+}
+
 bool Condition::updateCondition(const std::shared_ptr<Condition> &addCondition) {
 	if (conditionType != addCondition->getType()) {
 		return false;
@@ -40,6 +40,22 @@ public:
 	int32_t getTicks() const;
 	void setTicks(int32_t newTicks);
 
+	/**
+	 * Whether executeCondition does something on every think (damage, regeneration, sounds...).
+	 * The other conditions only expire, so their owner doesn't execute them until their end time.
+	 */
+	virtual bool executesOnThink() const;
+
+	/**
+	 * Called by the owner when it stops executing the condition on every think.
+	 * From then on the remaining ticks are taken from the end time.
+	 */
+	void setExecutedWhenDue(bool value);
+
+	bool isExecutionDue(int64_t timeNow) const {
+		return !executedWhenDue || (ticks != -1 && endTime < timeNow);
+	}
+
 	static std::shared_ptr<Condition> createCondition(ConditionId_t id, ConditionType_t type, int32_t ticks, int32_t param = 0, bool buff = false, uint32_t subId = 0, bool isPersistent = false);
 	static std::shared_ptr<Condition> createCondition(PropStream &propStream);
 
@@ -69,6 +85,7 @@ protected:
 private:
 	SoundEffect_t tickSound = SoundEffect_t::SILENCE;
 	SoundEffect_t addSound = SoundEffect_t::SILENCE;
+	bool executedWhenDue = false;
 
 	friend class ConditionDamage;
 	friend class ConditionGeneric;
@@ -216,6 +233,9 @@ public:
 	void endCondition(std::shared_ptr<Creature> creature) override;
 	void addCondition(std::shared_ptr<Creature> creature, std::shared_ptr<Condition> addCondition) override;
 	bool executeCondition(const std::shared_ptr<Creature> &creature, int32_t interval) override;
+	bool executesOnThink() const override {
+		return true;
+	}
 
 	bool setParam(ConditionParam_t param, int32_t value) override;
 
@@ -265,6 +285,9 @@ public:
 
 	void addCondition(std::shared_ptr<Creature> creature, std::shared_ptr<Condition> addCondition) override;
 	bool executeCondition(const std::shared_ptr<Creature> &creature, int32_t interval) override;
+	bool executesOnThink() const override {
+		return true;
+	}
 
 	bool setParam(ConditionParam_t param, int32_t value) override;
 
@@ -299,6 +322,9 @@ public:
 
 	bool startCondition(std::shared_ptr<Creature> creature) override;
 	bool executeCondition(const std::shared_ptr<Creature> &creature, int32_t interval) override;
+	bool executesOnThink() const override {
+		return true;
+	}
 	void endCondition(std::shared_ptr<Creature> creature) override;
 	void addCondition(std::shared_ptr<Creature> creature, std::shared_ptr<Condition> condition) override;
 	std::unordered_set<PlayerIcon> getIcons() const override;
@@ -345,6 +371,9 @@ public:
 
 	bool startCondition(std::shared_ptr<Creature> creature) override;
 	bool executeCondition(const std::shared_ptr<Creature> &creature, int32_t interval) override;
+	bool executesOnThink() const override {
+		return true;
+	}
 	void endCondition(std::shared_ptr<Creature> creature) override;
 	void addCondition(std::shared_ptr<Creature> creature, std::shared_ptr<Condition> condition) override;
 	std::unordered_set<PlayerIcon> getIcons() const override;
@@ -436,6 +465,9 @@ public:
 
 	bool startCondition(std::shared_ptr<Creature> creature) override;
 	bool executeCondition(const std::shared_ptr<Creature> &creature, int32_t interval) override;
+	bool executesOnThink() const override {
+		return true;
+	}
 	void endCondition(std::shared_ptr<Creature> creature) override;
 	void addCondition(std::shared_ptr<Creature> creature, std::shared_ptr<Condition> addCondition) override;
 
@@ -35,7 +35,7 @@ Creature::~Creature() {
 }
 
 bool Creature::canSee(const Position &myPos, const Position &pos, int32_t viewRangeX, int32_t viewRangeY) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (myPos.z <= MAP_INIT_SURFACE_LAYER) {
 		// we are on ground level or above (7 -> 0)
 		// view is from 7 -> 0
@@ -95,7 +95,7 @@ int32_t Creature::getWalkSize() {
 }
 
 void Creature::onThink(uint32_t interval) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 
 	const auto &followCreature = getFollowCreature();
 	const auto &master = getMaster();
@@ -125,9 +125,10 @@ void Creature::onThink(uint32_t interval) {
 
 	auto onThink = [self = getCreature(), interval] {
 		// scripting event - onThink
-		const auto &thinkEvents = self->getCreatureEvents(CREATURE_EVENT_THINK);
-		for (const auto &creatureEventPtr : thinkEvents) {
-			creatureEventPtr->executeOnThink(self->static_self_cast<Creature>(), interval);
+		if (const auto &thinkEvents = self->getCreatureEvents(CREATURE_EVENT_THINK)) {
+			for (const auto &creatureEventPtr : *thinkEvents) {
+				creatureEventPtr->executeOnThink(self->static_self_cast<Creature>(), interval);
+			}
 		}
 	};
 
@@ -190,7 +191,7 @@ void Creature::onCreatureWalk() {
 
 	checkingWalkCreature = true;
 
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 
 	auto selfCreature = getCreature();
 
@@ -332,7 +333,7 @@ void Creature::stopEventWalk() {
 }
 
 void Creature::onCreatureAppear(const std::shared_ptr<Creature> &creature, bool isLogin) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (creature.get() == this) {
 		if (isLogin) {
 			setLastPosition(getPosition());
@@ -341,7 +342,7 @@ void Creature::onCreatureAppear(const std::shared_ptr<Creature> &creature, bool
 }
 
 void Creature::onRemoveCreature(const std::shared_ptr<Creature> &creature, bool) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	onCreatureDisappear(creature, true);
 
 	// Update player from monster target list (avoid memory usage after clean)
@@ -352,7 +353,7 @@ void Creature::onRemoveCreature(const std::shared_ptr<Creature> &creature, bool)
 }
 
 void Creature::onCreatureDisappear(const std::shared_ptr<Creature> &creature, bool isLogout) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (getAttackedCreature() == creature) {
 		setAttackedCreature(nullptr);
 		onAttackedCreatureDisappear(isLogout);
@@ -365,7 +366,7 @@ void Creature::onCreatureDisappear(const std::shared_ptr<Creature> &creature, bo
 }
 
 void Creature::onChangeZone(ZoneType_t zone) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &attackedCreature = getAttackedCreature();
 	if (attackedCreature && zone == ZONE_PROTECTION) {
 		onCreatureDisappear(attackedCreature, false);
@@ -373,7 +374,7 @@ void Creature::onChangeZone(ZoneType_t zone) {
 }
 
 void Creature::onAttackedCreatureChangeZone(ZoneType_t zone) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (zone == ZONE_PROTECTION) {
 		const auto &attackedCreature = getAttackedCreature();
 		if (attackedCreature) {
@@ -383,7 +384,7 @@ void Creature::onAttackedCreatureChangeZone(ZoneType_t zone) {
 }
 
 void Creature::checkSummonMove(const Position &newPos, bool teleportSummon) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (hasSummons()) {
 		std::vector<std::shared_ptr<Creature>> despawnMonsterList;
 		for (const auto &summon : getSummons()) {
@@ -430,7 +431,7 @@ void Creature::checkSummonMove(const Position &newPos, bool teleportSummon) {
 }
 
 void Creature::onCreatureMove(const std::shared_ptr<Creature> &creature, const std::shared_ptr<Tile> &newTile, const Position &newPos, const std::shared_ptr<Tile> &oldTile, const Position &oldPos, bool teleport) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (hasCondition(CONDITION_ROOTED)) {
 		resetMovementState();
 		return;
@@ -497,7 +498,7 @@ void Creature::onCreatureMove(const std::shared_ptr<Creature> &creature, const s
 }
 
 void Creature::onDeath() {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	bool lastHitUnjustified = false;
 	bool mostDamageUnjustified = false;
 	const auto &lastHitCreature = g_game().getCreatureByID(lastHitCreatureId);
@@ -650,13 +651,14 @@ void Creature::onDeath() {
 }
 
 bool Creature::dropCorpse(const std::shared_ptr<Creature> &lastHitCreature, const std::shared_ptr<Creature> &mostDamageCreature, bool lastHitUnjustified, bool mostDamageUnjustified) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (!lootDrop && getMonster()) {
 		if (getMaster()) {
 			// Scripting event onDeath
-			const CreatureEventList &deathEvents = getCreatureEvents(CREATURE_EVENT_DEATH);
-			for (const auto &deathEventPtr : deathEvents) {
-				deathEventPtr->executeOnDeath(static_self_cast<Creature>(), nullptr, lastHitCreature, mostDamageCreature, lastHitUnjustified, mostDamageUnjustified);
+			if (const auto &deathEvents = getCreatureEvents(CREATURE_EVENT_DEATH)) {
+				for (const auto &deathEventPtr : *deathEvents) {
+					deathEventPtr->executeOnDeath(static_self_cast<Creature>(), nullptr, lastHitCreature, mostDamageCreature, lastHitUnjustified, mostDamageUnjustified);
+				}
 			}
 		}
 
@@ -737,8 +739,8 @@ bool Creature::dropCorpse(const std::shared_ptr<Creature> &lastHitCreature, cons
 		}
 
 		// Scripting event onDeath
-		for (const auto &deathEventPtr : getCreatureEvents(CREATURE_EVENT_DEATH)) {
-			if (deathEventPtr) {
+		if (const auto &deathEvents = getCreatureEvents(CREATURE_EVENT_DEATH)) {
+			for (const auto &deathEventPtr : *deathEvents) {
 				deathEventPtr->executeOnDeath(static_self_cast<Creature>(), corpse, lastHitCreature, mostDamageCreature, lastHitUnjustified, mostDamageUnjustified);
 			}
 		}
@@ -970,7 +972,7 @@ void Creature::goToFollowCreature_async(std::function<void()> &&onComplete) {
 }
 
 void Creature::goToFollowCreature() {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &followCreature = getFollowCreature();
 	if (!followCreature) {
 		return;
@@ -1025,7 +1027,7 @@ bool Creature::canFollowMaster() const {
 }
 
 bool Creature::setFollowCreature(const std::shared_ptr<Creature> &creature) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (creature) {
 		if (getFollowCreature() == creature) {
 			return true;
@@ -1178,7 +1180,7 @@ void Creature::onAttackedCreatureDrainHealth(const std::shared_ptr<Creature> &ta
 }
 
 void Creature::onAttackedCreatureKilled(const std::shared_ptr<Creature> &target) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (target != getCreature()) {
 		uint64_t gainExp = target->getGainedExperience(static_self_cast<Creature>());
 		onGainExperience(gainExp, target);
@@ -1186,22 +1188,23 @@ void Creature::onAttackedCreatureKilled(const std::shared_ptr<Creature> &target)
 }
 
 bool Creature::deprecatedOnKilledCreature(const std::shared_ptr<Creature> &target, bool lastHit) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &master = getMaster();
 	if (master) {
 		master->deprecatedOnKilledCreature(target, lastHit);
 	}
 
 	// scripting event - onKill
-	const CreatureEventList &killEvents = getCreatureEvents(CREATURE_EVENT_KILL);
-	for (const auto &killEventPtr : killEvents) {
-		killEventPtr->executeOnKill(static_self_cast<Creature>(), target, lastHit);
+	if (const auto &killEvents = getCreatureEvents(CREATURE_EVENT_KILL)) {
+		for (const auto &killEventPtr : *killEvents) {
+			killEventPtr->executeOnKill(static_self_cast<Creature>(), target, lastHit);
+		}
 	}
 	return false;
 }
 
 void Creature::onGainExperience(uint64_t gainExp, const std::shared_ptr<Creature> &target) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &master = getMaster();
 	if (gainExp == 0 || !master) {
 		return;
@@ -1232,7 +1235,7 @@ void Creature::onGainExperience(uint64_t gainExp, const std::shared_ptr<Creature
 }
 
 bool Creature::setMaster(const std::shared_ptr<Creature> &newMaster, bool reloadCreature /* = false*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	// Persists if this creature has ever been a summon
 	this->summoned = true;
 	const auto &oldMaster = getMaster();
@@ -1265,7 +1268,7 @@ bool Creature::setMaster(const std::shared_ptr<Creature> &newMaster, bool reload
 }
 
 bool Creature::addCondition(const std::shared_ptr<Condition> &condition, bool attackerPlayer /* = false*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (condition == nullptr) {
 		return false;
 	}
@@ -1279,7 +1282,9 @@ bool Creature::addCondition(const std::shared_ptr<Condition> &condition, bool at
 	}
 
 	if (condition->startCondition(getCreature())) {
+		condition->setExecutedWhenDue(!condition->executesOnThink());
 		conditions.emplace_back(condition);
+		conditionTypes |= 1ULL << condition->getType();
 		onAddCondition(condition->getType());
 		return true;
 	}
@@ -1287,6 +1292,18 @@ bool Creature::addCondition(const std::shared_ptr<Condition> &condition, bool at
 	return false;
 }
 
+ConditionList::iterator Creature::eraseCondition(ConditionList::iterator it) {
+	const auto &condition = *it;
+	const auto type = condition->getType();
+	condition->setExecutedWhenDue(false);
+
+	it = conditions.erase(it);
+	if (std::ranges::none_of(conditions, [type](const auto &other) { return other->getType() == type; })) {
+		conditionTypes &= ~(1ULL << type);
+	}
+	return it;
+}
+
 bool Creature::addCombatCondition(const std::shared_ptr<Condition> &condition, bool attackerPlayer /* = false*/) {
 	if (condition == nullptr) {
 		return false;
@@ -1303,28 +1320,39 @@ bool Creature::addCombatCondition(const std::shared_ptr<Condition> &condition, b
 }
 
 void Creature::removeCondition(ConditionType_t type) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
-	auto it = conditions.begin(), end = conditions.end();
-	while (it != end) {
+	METRICS_METHOD_LATENCY(measure);
+	if (!hasConditionType(type)) {
+		return;
+	}
+
+	auto it = conditions.begin();
+	while (it != conditions.end()) {
 		std::shared_ptr<Condition> condition = *it;
 		if (condition->getType() != type) {
 			++it;
 			continue;
 		}
 
-		it = conditions.erase(it);
+		const auto index = std::distance(conditions.begin(), it);
+		eraseCondition(it);
 
 		condition->endCondition(getCreature());
 
 		onEndCondition(type);
+
+		// Ending the condition may have changed the list
+		it = conditions.begin() + std::min<ptrdiff_t>(index, conditions.size());
 	}
 }
 
 void Creature::removeCondition(ConditionType_t conditionType, ConditionId_t conditionId, bool force /* = false*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
+	if (!hasConditionType(conditionType)) {
+		return;
+	}
+
 	auto it = conditions.begin();
-	const auto end = conditions.end();
-	while (it != end) {
+	while (it != conditions.end()) {
 		auto condition = *it;
 		if (condition->getType() != conditionType || condition->getId() != conditionId) {
 			++it;
@@ -1341,15 +1369,23 @@ void Creature::removeCondition(ConditionType_t conditionType, ConditionId_t cond
 			}
 		}
 
-		it = conditions.erase(it);
+		const auto index = std::distance(conditions.begin(), it);
+		eraseCondition(it);
 
 		condition->endCondition(getCreature());
 
 		onEndCondition(conditionType);
+
+		// Ending the condition may have changed the list
+		it = conditions.begin() + std::min<ptrdiff_t>(index, conditions.size());
 	}
 }
 
 void Creature::removeCombatCondition(ConditionType_t type) {
+	if (!hasConditionType(type)) {
+		return;
+	}
+
 	std::vector<std::shared_ptr<Condition>> removeConditions;
 	for (const auto &condition : conditions) {
 		if (condition->getType() == type) {
@@ -1368,13 +1404,17 @@ void Creature::removeCondition(const std::shared_ptr<Condition> &condition) {
 		return;
 	}
 
-	conditions.erase(it);
+	eraseCondition(it);
 
 	condition->endCondition(getCreature());
 	onEndCondition(condition->getType());
 }
 
 std::shared_ptr<Condition> Creature::getCondition(ConditionType_t type) const {
+	if (!hasConditionType(type)) {
+		return nullptr;
+	}
+
 	for (const auto &condition : conditions) {
 		if (condition->getType() == type) {
 			return condition;
@@ -1384,7 +1424,10 @@ std::shared_ptr<Condition> Creature::getCondition(ConditionType_t type) const {
 }
 
 std::shared_ptr<Condition> Creature::getCondition(ConditionType_t type, ConditionId_t conditionId, uint32_t subId /* = 0*/) const {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	if (!hasConditionType(type)) {
+		return nullptr;
+	}
+
 	for (const auto &condition : conditions) {
 		if (condition->getType() == type && condition->getId() == conditionId && condition->getSubId() == subId) {
 			return condition;
@@ -1419,6 +1462,10 @@ std::vector<std::shared_ptr<Condition>> Creature::getCleansableConditions() cons
 
 std::vector<std::shared_ptr<Condition>> Creature::getConditionsByType(ConditionType_t type) const {
 	std::vector<std::shared_ptr<Condition>> conditionsVec;
+	if (!hasConditionType(type)) {
+		return conditionsVec;
+	}
+
 	for (const auto &condition : conditions) {
 		if (condition->getType() == type) {
 			conditionsVec.emplace_back(condition);
@@ -1428,27 +1475,43 @@ std::vector<std::shared_ptr<Condition>> Creature::getConditionsByType(ConditionT
 }
 
 void Creature::executeConditions(uint32_t interval) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
-	auto it = conditions.begin(), end = conditions.end();
-	while (it != end) {
-		std::shared_ptr<Condition> condition = *it;
-		if (!condition->executeCondition(getCreature(), interval)) {
-			ConditionType_t type = condition->getType();
-
-			it = conditions.erase(it);
+	METRICS_METHOD_LATENCY(measure);
+	const int64_t timeNow = OTSYS_TIME();
+	size_t index = 0;
+	while (index < conditions.size()) {
+		// Conditions that only expire are left alone until their end time
+		if (!conditions[index]->isExecutionDue(timeNow)) {
+			++index;
+			continue;
+		}
 
-			condition->endCondition(getCreature());
+		std::shared_ptr<Condition> condition = conditions[index];
+		if (condition->executeCondition(getCreature(), interval)) {
+			++index;
+			continue;
+		}
 
-			onEndCondition(type);
-		} else {
-			++it;
+		// Executing the condition may have changed the list, or removed the condition already
+		if (index >= conditions.size() || conditions[index] != condition) {
+			const auto it = std::ranges::find(conditions, condition);
+			if (it == conditions.end()) {
+				continue;
+			}
+			index = std::distance(conditions.begin(), it);
 		}
+
+		ConditionType_t type = condition->getType();
+
+		eraseCondition(conditions.begin() + index);
+
+		condition->endCondition(getCreature());
+
+		onEndCondition(type);
 	}
 }
 
 bool Creature::hasCondition(ConditionType_t type, uint32_t subId /* = 0*/) const {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
-	if (isSuppress(type, false)) {
+	if (!hasConditionType(type) || isSuppress(type, false)) {
 		return false;
 	}
 
@@ -1539,17 +1602,18 @@ bool Creature::registerCreatureEvent(const std::string &name) {
 	}
 
 	CreatureEventType_t type = event->getEventType();
-	if (hasEventRegistered(type)) {
-		for (const auto &creatureEventPtr : eventsList) {
-			if (creatureEventPtr == event) {
-				return false;
-			}
+	auto events = std::make_shared<CreatureEventList>();
+	if (const auto &registeredEvents = eventsByType[type]) {
+		if (std::ranges::find(*registeredEvents, event) != registeredEvents->end()) {
+			return false;
 		}
-	} else {
-		scriptEventsBitField |= static_cast<uint32_t>(1) << type;
+		events->reserve(registeredEvents->size() + 1);
+		events->assign(registeredEvents->begin(), registeredEvents->end());
 	}
 
-	eventsList.emplace_back(event);
+	events->emplace_back(event);
+	eventsByType[type] = std::move(events);
+	scriptEventsBitField |= static_cast<uint32_t>(1) << type;
 	return true;
 }
 
@@ -1560,28 +1624,18 @@ bool Creature::unregisterCreatureEvent(const std::string &name) {
 	}
 
 	CreatureEventType_t type = event->getEventType();
-	if (!hasEventRegistered(type)) {
+	const auto &registeredEvents = eventsByType[type];
+	if (!registeredEvents) {
 		return false;
 	}
 
-	bool resetTypeBit = true;
-
-	auto it = eventsList.begin(), end = eventsList.end();
-	while (it != end) {
-		const auto curEvent = *it;
-		if (curEvent == event) {
-			it = eventsList.erase(it);
-			continue;
-		}
-
-		if (curEvent->getEventType() == type) {
-			resetTypeBit = false;
-		}
-		++it;
-	}
-
-	if (resetTypeBit) {
+	auto events = std::make_shared<CreatureEventList>(*registeredEvents);
+	std::erase(*events, event);
+	if (events->empty()) {
+		eventsByType[type] = nullptr;
 		scriptEventsBitField &= ~(static_cast<uint32_t>(1) << type);
+	} else {
+		eventsByType[type] = std::move(events);
 	}
 	return true;
 }
@@ -1614,23 +1668,17 @@ void Creature::setParent(std::weak_ptr<Cylinder> cylinder) {
 
 // creature script events
 bool Creature::hasEventRegistered(CreatureEventType_t event) const {
+	if (event >= eventsByType.size()) {
+		return false;
+	}
 	return (0 != (scriptEventsBitField & (static_cast<uint32_t>(1) << event)));
 }
 
-CreatureEventList Creature::getCreatureEvents(CreatureEventType_t type) const {
-	CreatureEventList tmpEventList;
-
+std::shared_ptr<const CreatureEventList> Creature::getCreatureEvents(CreatureEventType_t type) const {
 	if (!hasEventRegistered(type)) {
-		return tmpEventList;
+		return nullptr;
 	}
-
-	for (const auto &creatureEventPtr : eventsList) {
-		if (creatureEventPtr->getEventType() == type) {
-			tmpEventList.emplace_back(creatureEventPtr);
-		}
-	}
-
-	return tmpEventList;
+	return eventsByType[type];
 }
 
 bool FrozenPathingConditionCall::isInRange(const Position &startPos, const Position &testPos, const FindPathParams &fpp) const {
@@ -1708,10 +1756,7 @@ bool FrozenPathingConditionCall::operator()(const Position &startPos, const Posi
 }
 
 bool Creature::isInvisible() const {
-	return std::ranges::find_if(conditions, [](const std::shared_ptr<Condition> &condition) {
-			   return condition->getType() == CONDITION_INVISIBLE;
-		   })
-		!= conditions.end();
+	return hasConditionType(CONDITION_INVISIBLE);
 }
 
 ZoneType_t Creature::getZoneType() {
@@ -1723,7 +1768,7 @@ ZoneType_t Creature::getZoneType() {
 }
 
 bool Creature::getPathTo(const Position &targetPos, std::vector<Direction> &dirList, const FindPathParams &fpp) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (fpp.maxSearchDist != 0 || fpp.keepDistance) {
 		return g_game().map.getPathMatchingCond(getCreature(), targetPos, dirList, FrozenPathingConditionCall(targetPos), fpp);
 	}
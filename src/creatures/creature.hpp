@@ -13,6 +13,7 @@
 #include "game/game_definitions.hpp"
 #include "game/movement/position.hpp"
 #include "items/thing.hpp"
+#include "lua/lua_definitions.hpp"
 #include "map/map_const.hpp"
 #include "utils/utils_definitions.hpp"
 
@@ -35,10 +36,8 @@ struct Position;
 
 enum CreatureType_t : uint8_t;
 enum ZoneType_t : uint8_t;
-enum CreatureEventType_t : uint8_t;
-
-using ConditionList = std::list<std::shared_ptr<Condition>>;
-using CreatureEventList = std::list<std::shared_ptr<CreatureEvent>>;
+using ConditionList = std::vector<std::shared_ptr<Condition>>;
+using CreatureEventList = std::vector<std::shared_ptr<CreatureEvent>>;
 
 static constexpr uint8_t WALK_TARGET_NEARBY_EXTRA_COST = 2;
 static constexpr uint8_t WALK_FLOOR_CHANGE_EXTRA_COST = 2;
@@ -744,8 +743,11 @@ protected:
 	CountMap damageMap;
 
 	std::vector<std::shared_ptr<Creature>> m_summons;
-	CreatureEventList eventsList;
+	// Registered script events by type, replaced instead of modified so a dispatch in progress keeps its list
+	std::array<std::shared_ptr<const CreatureEventList>, magic_enum::enum_count<CreatureEventType_t>()> eventsByType;
 	ConditionList conditions;
+	// Bit per ConditionType_t present in conditions
+	uint64_t conditionTypes = 0;
 
 	std::vector<Direction> listWalkDir;
 
@@ -822,9 +824,16 @@ protected:
 	// use map here instead of phmap to keep the keys in a predictable order
 	std::map<std::string, CreatureIcon> creatureIcons = {};
 
+	bool hasConditionType(ConditionType_t type) const {
+		return (conditionTypes & (1ULL << type)) != 0;
+	}
+	// Removes the condition from the list and keeps conditionTypes in sync, it doesn't end the condition
+	ConditionList::iterator eraseCondition(ConditionList::iterator it);
+
 	// creature script events
 	bool hasEventRegistered(CreatureEventType_t event) const;
-	CreatureEventList getCreatureEvents(CreatureEventType_t type) const;
+	// Returns nullptr when no event of the type is registered
+	std::shared_ptr<const CreatureEventList> getCreatureEvents(CreatureEventType_t type) const;
 
 	void onCreatureDisappear(const std::shared_ptr<Creature> &creature, bool isLogout);
 	virtual void doAttacking(uint32_t) { }
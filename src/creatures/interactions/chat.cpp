@@ -231,7 +231,7 @@ bool ChatChannel::executeCanJoinEvent(const std::shared_ptr<Player> &player) con
 
 	scriptInterface->pushFunction(canJoinEvent);
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	return scriptInterface->callFunction(1);
 }
@@ -257,7 +257,7 @@ bool ChatChannel::executeOnJoinEvent(const std::shared_ptr<Player> &player) cons
 
 	scriptInterface->pushFunction(onJoinEvent);
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	return scriptInterface->callFunction(1);
 }
@@ -283,7 +283,7 @@ bool ChatChannel::executeOnLeaveEvent(const std::shared_ptr<Player> &player) con
 
 	scriptInterface->pushFunction(onLeaveEvent);
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	return scriptInterface->callFunction(1);
 }
@@ -309,7 +309,7 @@ bool ChatChannel::executeOnSpeakEvent(const std::shared_ptr<Player> &player, Spe
 
 	scriptInterface->pushFunction(onSpeakEvent);
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, type);
 	LuaScriptInterface::pushString(L, message);
@@ -311,7 +311,7 @@ void Monster::onCreatureAppear(const std::shared_ptr<Creature> &creature, bool i
 		scriptInterface->pushFunction(m_monsterType->info.creatureAppearEvent);
 
 		LuaScriptInterface::pushUserdata<Monster>(L, getMonster());
-		LuaScriptInterface::setMetatable(L, -1, "Monster");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Monster);
 
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
 		LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -351,7 +351,7 @@ void Monster::onRemoveCreature(const std::shared_ptr<Creature> &creature, bool i
 		scriptInterface->pushFunction(m_monsterType->info.creatureDisappearEvent);
 
 		LuaScriptInterface::pushUserdata<Monster>(L, getMonster());
-		LuaScriptInterface::setMetatable(L, -1, "Monster");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Monster);
 
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
 		LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -394,7 +394,7 @@ void Monster::onCreatureMove(const std::shared_ptr<Creature> &creature, const st
 		scriptInterface->pushFunction(m_monsterType->info.creatureMoveEvent);
 
 		LuaScriptInterface::pushUserdata<Monster>(L, getMonster());
-		LuaScriptInterface::setMetatable(L, -1, "Monster");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Monster);
 
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
 		LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -476,7 +476,7 @@ void Monster::onCreatureSay(const std::shared_ptr<Creature> &creature, SpeakClas
 		scriptInterface->pushFunction(m_monsterType->info.creatureSayEvent);
 
 		LuaScriptInterface::pushUserdata<Monster>(L, getMonster());
-		LuaScriptInterface::setMetatable(L, -1, "Monster");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Monster);
 
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
 		LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -506,10 +506,10 @@ void Monster::onAttackedByPlayer(const std::shared_ptr<Player> &attackerPlayer)
 		scriptInterface->pushFunction(m_monsterType->info.monsterAttackedByPlayerEvent);
 
 		LuaScriptInterface::pushUserdata<Monster>(L, getMonster());
-		LuaScriptInterface::setMetatable(L, -1, "Monster");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Monster);
 
 		LuaScriptInterface::pushUserdata<Player>(L, attackerPlayer);
-		LuaScriptInterface::setMetatable(L, -1, "Player");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 		scriptInterface->callVoidFunction(2);
 	}
@@ -533,7 +533,7 @@ void Monster::onSpawn(const Position &position) {
 		scriptInterface->pushFunction(m_monsterType->info.spawnEvent);
 
 		LuaScriptInterface::pushUserdata<Monster>(L, getMonster());
-		LuaScriptInterface::setMetatable(L, -1, "Monster");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Monster);
 		LuaScriptInterface::pushPosition(L, position);
 
 		scriptInterface->callVoidFunction(2);
@@ -1056,7 +1056,7 @@ void Monster::onThink(uint32_t interval) {
 		scriptInterface->pushFunction(m_monsterType->info.thinkEvent);
 
 		LuaScriptInterface::pushUserdata<Monster>(L, getMonster());
-		LuaScriptInterface::setMetatable(L, -1, "Monster");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Monster);
 
 		lua_pushnumber(L, interval);
 
@@ -2183,6 +2183,12 @@ void Player::sendMagicEffect(const Position &pos, uint16_t type) const {
 	}
 }
 
+void Player::sendBroadcast(BroadcastMessage &broadcast) const {
+	if (client) {
+		client->sendBroadcast(broadcast);
+	}
+}
+
 void Player::removeMagicEffect(const Position &pos, uint16_t type) const {
 	if (client) {
 		client->removeMagicEffect(pos, type);
@@ -3954,15 +3960,17 @@ void Player::death(const std::shared_ptr<Creature> &lastHitCreature) {
 			mana = manaMax;
 		}
 
-		auto it = conditions.begin(), end = conditions.end();
-		while (it != end) {
+		auto it = conditions.begin();
+		while (it != conditions.end()) {
 			auto condition = *it;
 			// isSupress block to delete spells conditions (ensures that the player cannot, for example, reset the cooldown time of the familiar and summon several)
 			if (condition->isPersistent() && condition->isRemovableOnDeath()) {
-				it = conditions.erase(it);
+				const auto index = std::distance(conditions.begin(), it);
+				eraseCondition(it);
 
 				condition->endCondition(static_self_cast<Player>());
 				onEndCondition(condition->getType());
+				it = conditions.begin() + std::min<ptrdiff_t>(index, conditions.size());
 			} else {
 				++it;
 			}
@@ -3971,14 +3979,16 @@ void Player::death(const std::shared_ptr<Creature> &lastHitCreature) {
 	} else {
 		setSkillLoss(true);
 
-		auto it = conditions.begin(), end = conditions.end();
-		while (it != end) {
+		auto it = conditions.begin();
+		while (it != conditions.end()) {
 			auto condition = *it;
 			if (condition->isPersistent()) {
-				it = conditions.erase(it);
+				const auto index = std::distance(conditions.begin(), it);
+				eraseCondition(it);
 
 				condition->endCondition(static_self_cast<Player>());
 				onEndCondition(condition->getType());
+				it = conditions.begin() + std::min<ptrdiff_t>(index, conditions.size());
 			} else {
 				++it;
 			}
@@ -4830,7 +4840,17 @@ uint32_t Player::getItemTypeCount(uint16_t itemId, int32_t subType /*= -1*/) con
 			count += Item::countByType(item, subType);
 		}
 
-		if (const auto &container = item->getContainer()) {
+		const auto &container = item->getContainer();
+		if (!container) {
+			continue;
+		}
+
+		if (subType == -1) {
+#if defined(DEBUG_LOG)
+			container->checkItemTypeCounts();
+#endif
+			count += container->getRecursiveItemTypeCount(itemId);
+		} else {
 			for (ContainerIterator it = container->iterator(); it.hasNext(); it.advance()) {
 				if ((*it)->getID() == itemId) {
 					count += Item::countByType(*it, subType);
@@ -5583,8 +5603,21 @@ std::vector<std::shared_ptr<Item>> Player::getEquippedItems() const {
 }
 
 std::map<uint32_t, uint32_t> &Player::getAllItemTypeCount(std::map<uint32_t, uint32_t> &countMap) const {
-	for (const auto &item : getAllInventoryItems()) {
-		countMap[static_cast<uint32_t>(item->getID())] += Item::countByType(item, -1);
+	for (int32_t i = CONST_SLOT_FIRST; i <= CONST_SLOT_LAST; ++i) {
+		const auto &item = inventory[i];
+		if (!item) {
+			continue;
+		}
+
+		countMap[static_cast<uint32_t>(item->getID())] += item->getItemCount();
+		if (const auto &container = item->getContainer()) {
+#if defined(DEBUG_LOG)
+			container->checkItemTypeCounts();
+#endif
+			for (const auto &[itemId, count] : container->getRecursiveItemTypeCounts()) {
+				countMap[static_cast<uint32_t>(itemId)] += count;
+			}
+		}
 	}
 	return countMap;
 }
@@ -33,6 +33,7 @@
 
 class House;
 class NetworkMessage;
+class BroadcastMessage;
 class Weapon;
 class ProtocolGame;
 class Party;
@@ -1001,6 +1002,7 @@ public:
 	void sendClientCheck() const;
 	void sendGameNews() const;
 	void sendMagicEffect(const Position &pos, uint16_t type) const;
+	void sendBroadcast(BroadcastMessage &broadcast) const;
 	void removeMagicEffect(const Position &pos, uint16_t type) const;
 	void sendPing();
 	void sendPingBack() const;
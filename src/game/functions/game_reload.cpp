@@ -20,6 +20,7 @@
 #include "lib/di/container.hpp"
 #include "lua/creature/events.hpp"
 #include "lua/modules/modules.hpp"
+#include "lua/scripts/lua_bytecode_cache.hpp"
 #include "lua/scripts/lua_environment.hpp"
 #include "lua/scripts/scripts.hpp"
 #include "creatures/players/vocations/vocation.hpp"
@@ -197,6 +198,7 @@ bool GameReload::reloadScripts() {
 	reloadMonsters();
 	reloadNpcs();
 	reloadItems();
+	g_luaBytecodeCache().logStats("Reloaded scripts");
 	logReloadStatus("Scripts", true);
 	return true;
 }
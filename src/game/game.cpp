@@ -28,6 +28,7 @@
 #include "database/databasetasks.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/save_manager.hpp"
+#include "game/scheduling/tick_profiler.hpp"
 #include "game/zones/zone.hpp"
 #include "io/io_bosstiary.hpp"
 #include "io/io_wheel.hpp"
@@ -201,6 +202,22 @@ namespace InternalGame {
 
 		return static_cast<T>(value);
 	}
+
+	std::string_view getThinkFrameName(CreatureType_t type) {
+		switch (type) {
+			case CREATURETYPE_PLAYER:
+				return "player";
+			case CREATURETYPE_MONSTER:
+				return "monster";
+			case CREATURETYPE_NPC:
+				return "npc";
+			case CREATURETYPE_SUMMON_PLAYER:
+			case CREATURETYPE_SUMMON_OTHERS:
+				return "summon";
+			default:
+				return "creature";
+		}
+	}
 } // Namespace InternalGame
 
 Game::Game() {
@@ -552,6 +569,11 @@ void Game::start(ServiceManager* manager) {
 	g_dispatcher().cycleEvent(
 		EVENT_LUA_GARBAGE_COLLECTION, [this] { g_luaEnvironment().collectGarbage(); }, "Calling GC"
 	);
+	if (g_configManager().getNumber(MAP_EVICTION_MEMORY_BUDGET) > 0) {
+		g_dispatcher().cycleEvent(
+			EVENT_MAP_EVICTION_INTERVAL, [this] { map.evictColdTiles(); }, "Map::evictColdTiles"
+		);
+	}
 	auto marketItemsPriceIntervalMinutes = g_configManager().getNumber(MARKET_REFRESH_PRICES);
 	if (marketItemsPriceIntervalMinutes > 0) {
 		auto marketItemsPriceIntervalMS = marketItemsPriceIntervalMinutes * 60000;
@@ -705,9 +727,18 @@ void Game::loadItemsPrice() {
 }
 
 void Game::loadMainMap(const std::string &filename) {
+	loadMainMapTiles(filename);
+	loadMainMapData();
+}
+
+void Game::loadMainMapTiles(const std::string &filename) {
+	map.loadMapTiles(g_configManager().getString(DATA_DIRECTORY) + "/world/" + filename + ".otbm", true);
+}
+
+void Game::loadMainMapData() {
 	Monster::despawnRange = g_configManager().getNumber(DEFAULT_DESPAWNRANGE);
 	Monster::despawnRadius = g_configManager().getNumber(DEFAULT_DESPAWNRADIUS);
-	map.loadMap(g_configManager().getString(DATA_DIRECTORY) + "/world/" + filename + ".otbm", true, true, true, true, true);
+	map.loadMapData(true, true, true, true, true);
 }
 
 void Game::loadCustomMaps(const std::filesystem::path &customMapPath) {
@@ -1171,7 +1202,7 @@ bool Game::internalPlaceCreature(const std::shared_ptr<Creature> &creature, cons
 }
 
 bool Game::placeCreature(const std::shared_ptr<Creature> &creature, const Position &pos, bool extendedPos /*=false*/, bool forced /*= false*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (!internalPlaceCreature(creature, pos, extendedPos, forced)) {
 		return false;
 	}
@@ -1198,7 +1229,7 @@ bool Game::placeCreature(const std::shared_ptr<Creature> &creature, const Positi
 }
 
 bool Game::removeCreature(const std::shared_ptr<Creature> &creature, bool isLogout /* = true*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (!creature || creature->isRemoved()) {
 		return false;
 	}
@@ -1266,7 +1297,7 @@ bool Game::removeCreature(const std::shared_ptr<Creature> &creature, bool isLogo
 }
 
 void Game::playerTeleport(uint32_t playerId, const Position &newPosition) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &player = getPlayerByID(playerId);
 	if (!player || !player->hasFlag(PlayerFlags_t::CanMapClickTeleport)) {
 		return;
@@ -1279,7 +1310,7 @@ void Game::playerTeleport(uint32_t playerId, const Position &newPosition) {
 }
 
 void Game::playerInspectItem(const std::shared_ptr<Player> &player, const Position &pos) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const std::shared_ptr<Thing> &thing = internalGetThing(player, pos, 0, 0, STACKPOS_TOPDOWN_ITEM);
 	if (!thing) {
 		player->sendCancelMessage(RETURNVALUE_NOTPOSSIBLE);
@@ -1296,7 +1327,7 @@ void Game::playerInspectItem(const std::shared_ptr<Player> &player, const Positi
 }
 
 void Game::playerInspectItem(const std::shared_ptr<Player> &player, uint16_t itemId, uint8_t itemCount, bool cyclopedia) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	player->sendItemInspection(itemId, itemCount, nullptr, cyclopedia);
 }
 
@@ -1350,7 +1381,7 @@ FILELOADER_ERRORS Game::loadAppearanceProtobuf(const std::string &file) {
 }
 
 void Game::playerMoveThing(uint32_t playerId, const Position &fromPos, uint16_t itemId, uint8_t fromStackPos, const Position &toPos, uint8_t count) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &player = getPlayerByID(playerId);
 	if (!player) {
 		return;
@@ -1435,7 +1466,7 @@ void Game::playerMoveCreatureByID(uint32_t playerId, uint32_t movingCreatureId,
 }
 
 void Game::playerMoveCreature(const std::shared_ptr<Player> &player, const std::shared_ptr<Creature> &movingCreature, const Position &movingCreatureOrigPos, const std::shared_ptr<Tile> &toTile) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 
 	g_dispatcher().addWalkEvent([=, this] {
 		if (!player->canDoAction()) {
@@ -1596,7 +1627,7 @@ ReturnValue Game::internalMoveCreature(const std::shared_ptr<Creature> &creature
 }
 
 ReturnValue Game::internalMoveCreature(const std::shared_ptr<Creature> &creature, const std::shared_ptr<Tile> &toTile, uint32_t flags /*= 0*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (creature->hasCondition(CONDITION_ROOTED)) {
 		return RETURNVALUE_NOTPOSSIBLE;
 	}
@@ -2020,7 +2051,7 @@ ReturnValue Game::checkMoveItemToCylinder(const std::shared_ptr<Player> &player,
 }
 
 ReturnValue Game::internalMoveItem(std::shared_ptr<Cylinder> fromCylinder, std::shared_ptr<Cylinder> toCylinder, int32_t index, const std::shared_ptr<Item> &item, uint32_t count, std::shared_ptr<Item>* movedItem, uint32_t flags /*= 0*/, const std::shared_ptr<Creature> &actor /*=nullptr*/, const std::shared_ptr<Item> &tradeItem /* = nullptr*/, bool checkTile /* = true*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (fromCylinder == nullptr) {
 		g_logger().error("[{}] fromCylinder is nullptr", __FUNCTION__);
 		return RETURNVALUE_NOTPOSSIBLE;
@@ -2282,7 +2313,7 @@ ReturnValue Game::internalAddItem(std::shared_ptr<Cylinder> toCylinder, const st
 }
 
 ReturnValue Game::internalAddItem(std::shared_ptr<Cylinder> toCylinder, const std::shared_ptr<Item> &item, int32_t index, uint32_t flags, bool test, uint32_t &remainderCount) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (toCylinder == nullptr) {
 		g_logger().error("[{}] fromCylinder is nullptr", __FUNCTION__);
 		return RETURNVALUE_NOTPOSSIBLE;
@@ -2370,7 +2401,7 @@ ReturnValue Game::internalAddItem(std::shared_ptr<Cylinder> toCylinder, const st
 
 ReturnValue Game::internalRemoveItem(const std::shared_ptr<Item> &items, int32_t count /*= -1*/, bool test /*= false*/, uint32_t flags /*= 0*/, bool force /*= false*/) {
 	auto item = items;
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (item == nullptr) {
 		g_logger().debug("{} - Item is nullptr", __FUNCTION__);
 		return RETURNVALUE_NOTPOSSIBLE;
@@ -2451,7 +2482,7 @@ std::tuple<ReturnValue, uint32_t, uint32_t> Game::addItemBatch(const std::shared
 		return std::make_tuple(ret, totalAdded, containersCreated);
 	}
 
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &player = toCylinder->getPlayer();
 	bool dropping = false;
 	auto setupDestination = [&]() -> std::shared_ptr<Cylinder> {
@@ -2531,7 +2562,7 @@ std::tuple<ReturnValue, uint32_t, uint32_t> Game::addItemBatch(const std::shared
 }
 
 std::tuple<ReturnValue, uint32_t, uint32_t> Game::createItemBatch(const std::shared_ptr<Cylinder> &toCylinder, const std::vector<std::tuple<uint16_t, uint32_t, uint16_t>> &itemCounts, uint32_t flags /* = 0 */, bool dropOnMap /* = true */, uint32_t autoContainerId /* = 0 */) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	std::vector<std::shared_ptr<Item>> items;
 	for (const auto &[itemId, count, subType] : itemCounts) {
 		const auto &itemType = Item::items[itemId];
@@ -2565,7 +2596,7 @@ std::tuple<ReturnValue, uint32_t, uint32_t> Game::createItem(const std::shared_p
 }
 
 ReturnValue Game::internalPlayerAddItem(const std::shared_ptr<Player> &player, const std::shared_ptr<Item> &item, bool dropOnMap /*= true*/, Slots_t slot /*= CONST_SLOT_WHEREEVER*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	uint32_t remainderCount = 0;
 	ReturnValue ret;
 	if (slot == CONST_SLOT_WHEREEVER) {
@@ -2597,7 +2628,7 @@ ReturnValue Game::internalPlayerAddItem(const std::shared_ptr<Player> &player, c
 }
 
 std::shared_ptr<Item> Game::findItemOfType(const std::shared_ptr<Cylinder> &cylinder, uint16_t itemId, bool depthSearch /*= true*/, int32_t subType /*= -1*/) const {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (cylinder == nullptr) {
 		g_logger().error("[{}] Cylinder is nullptr", __FUNCTION__);
 		return nullptr;
@@ -2763,7 +2794,7 @@ void Game::addMoney(const std::shared_ptr<Cylinder> &cylinder, uint64_t money, u
 }
 
 std::shared_ptr<Item> Game::transformItem(std::shared_ptr<Item> item, uint16_t newId, int32_t newCount /*= -1*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (item->getID() == newId && (newCount == -1 || (newCount == item->getSubType() && newCount != 0))) { // chargeless item placed on map = infinite
 		return item;
 	}
@@ -2902,7 +2933,7 @@ std::shared_ptr<Item> Game::transformItem(std::shared_ptr<Item> item, uint16_t n
 }
 
 ReturnValue Game::internalTeleport(const std::shared_ptr<Thing> &thing, const Position &newPos, bool pushMove /* = true*/, uint32_t flags /*= 0*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (thing == nullptr) {
 		g_logger().error("[{}] thing is nullptr", __FUNCTION__);
 		return RETURNVALUE_NOTPOSSIBLE;
@@ -3850,7 +3881,7 @@ void Game::playerStopAutoWalk(uint32_t playerId) {
 }
 
 void Game::playerUseItemEx(uint32_t playerId, const Position &fromPos, uint8_t fromStackPos, uint16_t fromItemId, const Position &toPos, uint8_t toStackPos, uint16_t toItemId) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &player = getPlayerByID(playerId);
 	if (!player) {
 		return;
@@ -3997,7 +4028,7 @@ void Game::playerUseItemEx(uint32_t playerId, const Position &fromPos, uint8_t f
 }
 
 void Game::playerUseItem(uint32_t playerId, const Position &pos, uint8_t stackPos, uint8_t index, uint16_t itemId) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &player = getPlayerByID(playerId);
 	if (!player) {
 		return;
@@ -4109,7 +4140,7 @@ void Game::playerUseItem(uint32_t playerId, const Position &pos, uint8_t stackPo
 }
 
 void Game::playerUseWithCreature(uint32_t playerId, const Position &fromPos, uint8_t fromStackPos, uint32_t creatureId, uint16_t itemId) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &player = getPlayerByID(playerId);
 	if (!player) {
 		return;
@@ -4805,10 +4836,12 @@ void Game::playerWriteItem(uint32_t playerId, uint32_t windowTextId, const std::
 		return;
 	}
 
-	for (const auto &creatureEvent : player->getCreatureEvents(CREATURE_EVENT_TEXTEDIT)) {
-		if (!creatureEvent->executeTextEdit(player, writeItem, text)) {
-			player->setWriteItem(nullptr);
-			return;
+	if (const auto &events = player->getCreatureEvents(CREATURE_EVENT_TEXTEDIT)) {
+		for (const auto &creatureEvent : *events) {
+			if (!creatureEvent->executeTextEdit(player, writeItem, text)) {
+				player->setWriteItem(nullptr);
+				return;
+			}
 		}
 	}
 
@@ -5458,7 +5491,7 @@ void Game::internalCloseTrade(const std::shared_ptr<Player> &player) {
 }
 
 void Game::playerBuyItem(uint32_t playerId, uint16_t itemId, uint8_t count, uint16_t amount, bool ignoreCap /* = false*/, bool inBackpacks /* = false*/) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (amount == 0) {
 		return;
 	}
@@ -5514,7 +5547,7 @@ void Game::playerBuyItem(uint32_t playerId, uint16_t itemId, uint8_t count, uint
 }
 
 void Game::playerSellItem(uint32_t playerId, uint16_t itemId, uint8_t count, uint16_t amount, bool ignoreEquipped) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (amount == 0) {
 		return;
 	}
@@ -6657,10 +6690,11 @@ bool Game::internalCreatureSay(const std::shared_ptr<Creature> &creature, SpeakC
 	}
 
 	// Send to client
+	auto broadcast = ProtocolGame::broadcastCreatureSay(creature, type, text, pos);
 	for (const auto &spectator : spectators) {
 		if (const auto &tmpPlayer = spectator->getPlayer()) {
 			if (!ghostMode || tmpPlayer->canSeeCreature(creature)) {
-				tmpPlayer->sendCreatureSay(creature, type, text, pos);
+				tmpPlayer->sendBroadcast(broadcast);
 			}
 		}
 	}
@@ -6691,19 +6725,21 @@ void Game::addCreatureCheck(const std::shared_ptr<Creature> &creature) {
 }
 
 void Game::removeCreatureCheck(const std::shared_ptr<Creature> &creature) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	if (creature->inCheckCreaturesVector.load()) {
 		creature->creatureCheck.store(false);
 	}
 }
 
 void Game::checkCreatures() {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	static size_t index = 0;
 
 	std::erase_if(checkCreatureLists[index], [this](const std::weak_ptr<Creature> &weak) {
 		if (const auto creature = weak.lock()) {
 			if (creature->creatureCheck && creature->isAlive()) {
+				// By creature type, a frame per creature name would intern every player that ever logged in
+				TickProfiler::Frame profile(TickFrameType::Think, [&creature] { return static_cast<uint64_t>(creature->getType()); }, [&creature] { return InternalGame::getThinkFrameName(creature->getType()); });
 				creature->onThink(EVENT_CREATURE_THINK_INTERVAL);
 				if (creature->getMonster()) {
 					// The monster's onThink is executed asynchronously,
@@ -6736,8 +6772,9 @@ void Game::changeSpeed(const std::shared_ptr<Creature> &creature, int32_t varSpe
 	creature->setSpeed(varSpeed);
 
 	// Send to clients
+	auto broadcast = ProtocolGame::broadcastChangeSpeed(creature, creature->getStepSpeed());
 	for (const auto &spectator : Spectators().find<Player>(creature->getPosition())) {
-		spectator->getPlayer()->sendChangeSpeed(creature, creature->getStepSpeed());
+		spectator->getPlayer()->sendBroadcast(broadcast);
 	}
 }
 
@@ -6745,8 +6782,9 @@ void Game::setCreatureSpeed(const std::shared_ptr<Creature> &creature, int32_t s
 	creature->setBaseSpeed(static_cast<uint16_t>(speed));
 
 	// Send creature speed to client
+	auto broadcast = ProtocolGame::broadcastChangeSpeed(creature, creature->getStepSpeed());
 	for (const auto &spectator : Spectators().find<Player>(creature->getPosition())) {
-		spectator->getPlayer()->sendChangeSpeed(creature, creature->getStepSpeed());
+		spectator->getPlayer()->sendBroadcast(broadcast);
 	}
 }
 
@@ -6757,8 +6795,9 @@ void Game::changePlayerSpeed(const std::shared_ptr<Player> &player, int32_t varS
 	player->setSpeed(varSpeed);
 
 	// Send new player speed to the spectators
+	auto broadcast = ProtocolGame::broadcastChangeSpeed(player, player->getStepSpeed());
 	for (const auto &creatureSpectator : Spectators().find<Player>(player->getPosition())) {
-		creatureSpectator->getPlayer()->sendChangeSpeed(player, player->getStepSpeed());
+		creatureSpectator->getPlayer()->sendBroadcast(broadcast);
 	}
 }
 
@@ -7347,9 +7386,8 @@ bool Game::combatChangeHealth(const std::shared_ptr<Creature> &attacker, const s
 		}
 
 		if (damage.origin != ORIGIN_NONE) {
-			const auto events = target->getCreatureEvents(CREATURE_EVENT_HEALTHCHANGE);
-			if (!events.empty()) {
-				for (const auto &creatureEvent : events) {
+			if (const auto &events = target->getCreatureEvents(CREATURE_EVENT_HEALTHCHANGE)) {
+				for (const auto &creatureEvent : *events) {
 					creatureEvent->executeHealthChange(target, attacker, damage);
 				}
 				damage.origin = ORIGIN_NONE;
@@ -7447,9 +7485,8 @@ bool Game::combatChangeHealth(const std::shared_ptr<Creature> &attacker, const s
 		}
 
 		if (damage.origin != ORIGIN_NONE) {
-			const auto events = target->getCreatureEvents(CREATURE_EVENT_HEALTHCHANGE);
-			if (!events.empty()) {
-				for (const auto &creatureEvent : events) {
+			if (const auto &events = target->getCreatureEvents(CREATURE_EVENT_HEALTHCHANGE)) {
+				for (const auto &creatureEvent : *events) {
 					creatureEvent->executeHealthChange(target, attacker, damage);
 				}
 				damage.origin = ORIGIN_NONE;
@@ -7589,9 +7626,8 @@ bool Game::combatChangeHealth(const std::shared_ptr<Creature> &attacker, const s
 			}
 			if (manaDamage != 0) {
 				if (damage.origin != ORIGIN_NONE) {
-					const auto events = target->getCreatureEvents(CREATURE_EVENT_MANACHANGE);
-					if (!events.empty()) {
-						for (const auto &creatureEvent : events) {
+					if (const auto &events = target->getCreatureEvents(CREATURE_EVENT_MANACHANGE)) {
+						for (const auto &creatureEvent : *events) {
 							creatureEvent->executeManaChange(target, attacker, damage);
 						}
 						healthChange = damage.primary.value + damage.secondary.value;
@@ -7702,9 +7738,11 @@ bool Game::combatChangeHealth(const std::shared_ptr<Creature> &attacker, const s
 		if (realDamage == 0) {
 			return true;
 		} else if (realDamage >= targetHealth) {
-			for (const auto &creatureEvent : target->getCreatureEvents(CREATURE_EVENT_PREPAREDEATH)) {
-				if (!creatureEvent->executeOnPrepareDeath(target, attacker, std::ref(realDamage))) {
-					return false;
+			if (const auto &events = target->getCreatureEvents(CREATURE_EVENT_PREPAREDEATH)) {
+				for (const auto &creatureEvent : *events) {
+					if (!creatureEvent->executeOnPrepareDeath(target, attacker, std::ref(realDamage))) {
+						return false;
+					}
 				}
 			}
 		}
@@ -8082,9 +8120,8 @@ bool Game::combatChangeMana(const std::shared_ptr<Creature> &attacker, const std
 		}
 
 		if (damage.origin != ORIGIN_NONE) {
-			const auto events = target->getCreatureEvents(CREATURE_EVENT_MANACHANGE);
-			if (!events.empty()) {
-				for (const auto &creatureEvent : events) {
+			if (const auto &events = target->getCreatureEvents(CREATURE_EVENT_MANACHANGE)) {
+				for (const auto &creatureEvent : *events) {
 					creatureEvent->executeManaChange(target, attacker, damage);
 				}
 				damage.origin = ORIGIN_NONE;
@@ -8168,9 +8205,8 @@ bool Game::combatChangeMana(const std::shared_ptr<Creature> &attacker, const std
 		}
 
 		if (damage.origin != ORIGIN_NONE) {
-			const auto events = target->getCreatureEvents(CREATURE_EVENT_MANACHANGE);
-			if (!events.empty()) {
-				for (const auto &creatureEvent : events) {
+			if (const auto &events = target->getCreatureEvents(CREATURE_EVENT_MANACHANGE)) {
+				for (const auto &creatureEvent : *events) {
 					creatureEvent->executeManaChange(target, attacker, damage);
 				}
 				damage.origin = ORIGIN_NONE;
@@ -8300,9 +8336,10 @@ void Game::addCreatureHealth(const CreatureVector &spectators, const std::shared
 			}
 		}
 	}
+	auto broadcast = ProtocolGame::broadcastCreatureHealth(target);
 	for (const auto &spectator : spectators) {
 		if (const auto &tmpPlayer = spectator->getPlayer()) {
-			tmpPlayer->sendCreatureHealth(target);
+			tmpPlayer->sendBroadcast(broadcast);
 		}
 	}
 }
@@ -8330,9 +8367,10 @@ void Game::addMagicEffect(const Position &pos, uint16_t effect) {
 }
 
 void Game::addMagicEffect(const CreatureVector &spectators, const Position &pos, uint16_t effect) {
+	auto broadcast = ProtocolGame::broadcastMagicEffect(pos, effect);
 	for (const auto &spectator : spectators) {
 		if (const auto &tmpPlayer = spectator->getPlayer()) {
-			tmpPlayer->sendMagicEffect(pos, effect);
+			tmpPlayer->sendBroadcast(broadcast);
 		}
 	}
 }
@@ -8356,9 +8394,10 @@ void Game::addDistanceEffect(const Position &fromPos, const Position &toPos, uin
 }
 
 void Game::addDistanceEffect(const CreatureVector &spectators, const Position &fromPos, const Position &toPos, uint16_t effect) {
+	auto broadcast = ProtocolGame::broadcastDistanceShoot(fromPos, toPos, effect);
 	for (const auto &spectator : spectators) {
 		if (const auto &tmpPlayer = spectator->getPlayer()) {
-			tmpPlayer->sendDistanceShoot(fromPos, toPos, effect);
+			tmpPlayer->sendBroadcast(broadcast);
 		}
 	}
 }
@@ -9782,8 +9821,10 @@ void Game::parsePlayerExtendedOpcode(uint32_t playerId, uint8_t opcode, const st
 		return;
 	}
 
-	for (const auto &creatureEvent : player->getCreatureEvents(CREATURE_EVENT_EXTENDED_OPCODE)) {
-		creatureEvent->executeExtendedOpcode(player, opcode, buffer);
+	if (const auto &events = player->getCreatureEvents(CREATURE_EVENT_EXTENDED_OPCODE)) {
+		for (const auto &creatureEvent : *events) {
+			creatureEvent->executeExtendedOpcode(player, opcode, buffer);
+		}
 	}
 }
 
@@ -9833,15 +9874,15 @@ void Game::playerAnswerModalWindow(uint32_t playerId, uint32_t modalWindowId, ui
 		}
 
 		player->setBedItem(nullptr);
-	} else {
-		for (const auto &creatureEvent : player->getCreatureEvents(CREATURE_EVENT_MODALWINDOW)) {
+	} else if (const auto &events = player->getCreatureEvents(CREATURE_EVENT_MODALWINDOW)) {
+		for (const auto &creatureEvent : *events) {
 			creatureEvent->executeModalWindow(player, modalWindowId, button, choice);
 		}
 	}
 }
 
 void Game::playerForgeFuseItems(uint32_t playerId, ForgeAction_t actionType, uint16_t firstItemId, uint8_t tier, uint16_t secondItemId, bool usedCore, bool reduceTierLoss, bool convergence) {
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
 	const auto &player = getPlayerByID(playerId);
 	if (!player) {
 		return;
@@ -67,6 +67,7 @@ static constexpr int32_t EVENT_DECAYINTERVAL = 250;
 static constexpr int32_t EVENT_DECAY_BUCKETS = 4;
 static constexpr int32_t EVENT_FORGEABLEMONSTERCHECKINTERVAL = 300000;
 static constexpr int32_t EVENT_LUA_GARBAGE_COLLECTION = 60000 * 10; // 10min
+static constexpr int32_t EVENT_MAP_EVICTION_INTERVAL = 60000; // 1min
 
 static constexpr std::chrono::minutes CACHE_EXPIRATION_TIME { 10 }; // 10min
 static constexpr std::chrono::minutes HIGHSCORE_CACHE_EXPIRATION_TIME { 10 }; // 10min
@@ -113,6 +114,11 @@ public:
 	 * \returns true if the custom map was loaded successfully
 	 */
 	void loadMainMap(const std::string &filename);
+	/**
+	 * Split of loadMainMap, the tiles only need the item types and can be parsed while the scripts load
+	 */
+	void loadMainMapTiles(const std::string &filename);
+	void loadMainMapData();
 	/**
 	 * Load the custom map
 	 * \param filename Is the map custom name (Example: "map".otbm, not is necessary add extension .otbm)
@@ -575,7 +581,7 @@ public:
 	Raids raids;
 	std::unique_ptr<Canary::protobuf::appearances::Appearances> m_appearancesPtr;
 
-	auto getTilesToClean() const {
+	const auto &getTilesToClean() const {
 		return tilesToClean;
 	}
 	void addTileToClean(const std::shared_ptr<Tile> &tile) {
@@ -9,6 +9,7 @@
 
 #include "game/scheduling/dispatcher.hpp"
 
+#include "game/scheduling/tick_profiler.hpp"
 #include "lib/thread/thread_pool.hpp"
 #include "lib/di/container.hpp"
 #include "utils/tools.hpp"
@@ -32,11 +33,14 @@ void Dispatcher::init() {
 
 		while (!threadPool.isStopped()) {
 			UPDATE_OTSYS_TIME();
+			g_tickProfiler().beginTick(dispatcherCycle);
 
 			executeEvents();
 			executeScheduledEvents();
 			mergeEvents();
 
+			g_tickProfiler().endTick();
+
 			if (!hasPendingTasks) {
 				signalSchedule.wait_for(asyncLock, timeUntilNextScheduledTask());
 			}
@@ -9,6 +9,7 @@
 
 #include "game/scheduling/task.hpp"
 
+#include "game/scheduling/tick_profiler.hpp"
 #include "lib/metrics/metrics.hpp"
 
 #include "utils/tools.hpp"
@@ -60,6 +61,7 @@ bool Task::execute() const {
 		}
 	}
 
+	TickProfiler::Frame profile(TickFrameType::Task, context);
 	func();
 	return true;
 }
@@ -75,7 +75,7 @@ private:
 			"Game::updateForgeableMonsters",
 			"Game::addCreatureCheck",
 			"GlobalEvents::think",
-			"LuaEnvironment::executeTimerEvent",
+			"LuaEnvironment::executeTimerEvents",
 			"Modules::executeOnRecvbyte",
 			"OutputMessagePool::sendAll",
 			"ProtocolGame::addGameTask",
@@ -0,0 +1,252 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "game/scheduling/tick_profiler.hpp"
+
+#include "config/configmanager.hpp"
+#include "lib/di/container.hpp"
+
+#include <nlohmann/json.hpp>
+
+thread_local bool TickProfiler::recording = false;
+
+namespace {
+	bool isFasterTick(const TickSample &a, const TickSample &b) {
+		return a.duration > b.duration;
+	}
+
+	std::string_view getFrameTypeName(TickFrameType type) {
+		switch (type) {
+			case TickFrameType::Task:
+				return "task";
+			case TickFrameType::Lua:
+				return "lua";
+			case TickFrameType::Think:
+				return "think";
+		}
+		return "unknown";
+	}
+
+	/**
+	 * Calls f(frameIndex, parentIndex) for every frame of the sample, in the order they were opened.
+	 * parentIndex is -1 for the frames opened directly by the tick.
+	 */
+	template <typename F>
+	void forEachFrame(const TickSample &sample, F &&f) {
+		std::vector<int32_t> stack;
+		for (int32_t i = 0; i < static_cast<int32_t>(sample.frames.size()); ++i) {
+			const auto &frame = sample.frames[i];
+			while (stack.size() > frame.depth) {
+				stack.pop_back();
+			}
+			f(i, stack.empty() ? -1 : stack.back());
+			stack.emplace_back(i);
+		}
+	}
+}
+
+TickProfiler &TickProfiler::getInstance() {
+	return inject<TickProfiler>();
+}
+
+int64_t TickProfiler::now() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TickProfiler::beginTick(uint64_t cycle) {
+	recording = g_configManager().getNumber(TICK_PROFILER_SLOWEST_TICKS) > 0;
+	if (!recording) {
+		return;
+	}
+
+	current.cycle = cycle;
+	current.droppedFrames = 0;
+	current.frames.clear();
+	depth = 0;
+	tickStart = now();
+}
+
+void TickProfiler::endTick() {
+	if (!recording) {
+		return;
+	}
+
+	recording = false;
+
+	// Idle ticks only merge events, there is nothing worth keeping
+	if (current.frames.empty()) {
+		return;
+	}
+
+	const auto end = now();
+	current.duration = end - tickStart;
+	if (current.duration < g_configManager().getNumber(TICK_PROFILER_MIN_DURATION) * 1000) {
+		return;
+	}
+
+	const auto capacity = static_cast<size_t>(g_configManager().getNumber(TICK_PROFILER_SLOWEST_TICKS));
+	while (slowest.size() > capacity) {
+		std::ranges::pop_heap(slowest, isFasterTick);
+		slowest.pop_back();
+	}
+
+	if (slowest.size() == capacity) {
+		if (slowest.front().duration >= current.duration) {
+			return;
+		}
+		std::ranges::pop_heap(slowest, isFasterTick);
+	} else {
+		slowest.emplace_back();
+	}
+
+	const auto wallClock = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	current.timestamp = wallClock - current.duration;
+
+	// Swapping hands the evicted sample's buffer back to the next tick
+	std::swap(slowest.back(), current);
+	std::ranges::push_heap(slowest, isFasterTick);
+}
+
+uint32_t TickProfiler::pushFrame(TickFrameType type, std::string_view name) {
+	return pushInternedFrame(type, intern(name));
+}
+
+uint32_t TickProfiler::pushInternedFrame(TickFrameType type, std::string_view name) {
+	if (current.frames.size() >= MAX_FRAMES_PER_TICK || depth == std::numeric_limits<uint8_t>::max()) {
+		++current.droppedFrames;
+		return DROPPED_FRAME;
+	}
+
+	const auto index = static_cast<uint32_t>(current.frames.size());
+	current.frames.push_back({ name, now() - tickStart, 0, type, depth++ });
+	return index;
+}
+
+void TickProfiler::popFrame(uint32_t index) {
+	// The frame may outlive the tick, e.g. when a task stops the dispatcher
+	if (!recording || index == DROPPED_FRAME || index >= current.frames.size()) {
+		return;
+	}
+
+	auto &frame = current.frames[index];
+	frame.duration = now() - tickStart - frame.start;
+	depth = frame.depth;
+}
+
+std::string_view TickProfiler::intern(std::string_view name) {
+	auto it = names.find(name);
+	if (it == names.end()) {
+		it = names.emplace(name).first;
+	}
+	return *it;
+}
+
+std::string TickProfiler::dump(TickProfileFormat format) const {
+	if (slowest.empty()) {
+		return {};
+	}
+
+	const auto directory = std::string("tick_profiles/");
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	if (error) {
+		g_logger().error("[{}] - Failed to create directory {}: {}", __FUNCTION__, directory, error.message());
+		return {};
+	}
+
+	const auto isFolded = format == TickProfileFormat::Folded;
+	const auto path = fmt::format("{}tick_profile_{:%Y-%m-%d_%H-%M-%S}.{}", directory, std::chrono::system_clock::now(), isFolded ? "folded" : "json");
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		g_logger().error("[{}] - Failed to open {} for writing", __FUNCTION__, path);
+		return {};
+	}
+
+	file << (isFolded ? toFolded() : toChromeTrace());
+	g_logger().info("Dumped the {} slowest ticks to {}", slowest.size(), path);
+	return path;
+}
+
+std::string TickProfiler::toFolded() const {
+	// Identical stacks of different ticks are merged, the value is the self time in microseconds
+	std::map<std::string, int64_t> stacks;
+	for (const auto &sample : slowest) {
+		std::vector<std::string> paths(sample.frames.size());
+		std::vector<int64_t> selfTime(sample.frames.size());
+		int64_t tickSelfTime = sample.duration;
+
+		forEachFrame(sample, [&](int32_t index, int32_t parent) {
+			const auto &frame = sample.frames[index];
+			std::string name(frame.name);
+			std::ranges::replace(name, ';', ',');
+
+			const auto &parentPath = parent == -1 ? std::string("tick") : paths[parent];
+			paths[index] = fmt::format("{};{}:{}", parentPath, getFrameTypeName(frame.type), name);
+			selfTime[index] = frame.duration;
+
+			if (parent == -1) {
+				tickSelfTime -= frame.duration;
+			} else {
+				selfTime[parent] -= frame.duration;
+			}
+		});
+
+		stacks["tick"] += std::max<int64_t>(tickSelfTime, 0);
+		for (size_t i = 0; i < paths.size(); ++i) {
+			stacks[paths[i]] += std::max<int64_t>(selfTime[i], 0);
+		}
+	}
+
+	std::string output;
+	for (const auto &[stack, time] : stacks) {
+		if (time > 0) {
+			output += fmt::format("{} {}\n", stack, time);
+		}
+	}
+	return output;
+}
+
+std::string TickProfiler::toChromeTrace() const {
+	using json = nlohmann::json;
+
+	std::vector<const TickSample*> samples;
+	samples.reserve(slowest.size());
+	for (const auto &sample : slowest) {
+		samples.emplace_back(&sample);
+	}
+	std::ranges::sort(samples, {}, &TickSample::timestamp);
+
+	auto events = json::array();
+	for (const auto* sample : samples) {
+		events.push_back({
+			{ "name", fmt::format("tick {}", sample->cycle) },
+			{ "cat", "tick" },
+			{ "ph", "X" },
+			{ "ts", sample->timestamp },
+			{ "dur", sample->duration },
+			{ "pid", 1 },
+			{ "tid", 1 },
+			{ "args", { { "droppedFrames", sample->droppedFrames } } },
+		});
+
+		for (const auto &frame : sample->frames) {
+			events.push_back({
+				{ "name", frame.name },
+				{ "cat", getFrameTypeName(frame.type) },
+				{ "ph", "X" },
+				{ "ts", sample->timestamp + frame.start },
+				{ "dur", frame.duration },
+				{ "pid", 1 },
+				{ "tid", 1 },
+			});
+		}
+	}
+
+	return json { { "traceEvents", events }, { "displayTimeUnit", "ms" } }.dump();
+}
@@ -0,0 +1,161 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+enum class TickFrameType : uint8_t {
+	Task,
+	Lua,
+	Think,
+};
+
+enum class TickProfileFormat : uint8_t {
+	Folded,
+	ChromeTrace,
+};
+
+struct TickFrame {
+	// Interned by the profiler, stays valid for the whole server lifetime
+	std::string_view name;
+	// Microseconds since the beginning of the tick
+	int64_t start = 0;
+	int64_t duration = 0;
+	TickFrameType type = TickFrameType::Task;
+	uint8_t depth = 0;
+};
+
+struct TickSample {
+	uint64_t cycle = 0;
+	// Wall clock of the beginning of the tick, in microseconds
+	int64_t timestamp = 0;
+	int64_t duration = 0;
+	uint32_t droppedFrames = 0;
+	std::vector<TickFrame> frames;
+};
+
+/**
+ * Tick profiler of the dispatcher thread.
+ * Every dispatcher cycle records how long each task context, Lua script and creature think took.
+ * Only the slowest ticks are kept (tickProfilerSlowestTicks), with their full breakdown, and can be
+ * dumped on demand as folded stacks (flamegraph.pl, speedscope) or as a Chrome trace (chrome://tracing, Perfetto).
+ * Frames opened outside of the dispatcher thread are ignored.
+ */
+class TickProfiler {
+public:
+	static constexpr size_t MAX_FRAMES_PER_TICK = 8192;
+
+	TickProfiler() = default;
+
+	// Ensures that we don't accidentally copy it
+	TickProfiler(const TickProfiler &) = delete;
+	TickProfiler operator=(const TickProfiler &) = delete;
+
+	static TickProfiler &getInstance();
+
+	static bool isRecording() {
+		return recording;
+	}
+
+	void beginTick(uint64_t cycle);
+	void endTick();
+
+	/**
+	 * Writes the slowest ticks recorded so far to "tick_profiles/".
+	 * Must be called from the dispatcher thread.
+	 * \returns the path of the written file, or an empty string if there was nothing to write or it failed
+	 */
+	std::string dump(TickProfileFormat format) const;
+
+	size_t getSampleCount() const {
+		return slowest.size();
+	}
+
+	/**
+	 * Opens a frame for the current tick and closes it when going out of scope.
+	 * The name can be given lazily, so it is only built while the tick is being recorded.
+	 */
+	class Frame {
+	public:
+		Frame(TickFrameType type, std::string_view name) {
+			if (recording) {
+				index = getInstance().pushFrame(type, name);
+			}
+		}
+
+		template <typename F>
+			requires std::is_invocable_v<F>
+		Frame(TickFrameType type, F &&name) {
+			if (recording) {
+				index = getInstance().pushFrame(type, name());
+			}
+		}
+
+		/**
+		 * The name is only built the first time the key is seen, later frames with the same key reuse it.
+		 */
+		template <typename K, typename F>
+			requires std::is_invocable_r_v<uint64_t, K> && std::is_invocable_v<F>
+		Frame(TickFrameType type, K &&key, F &&name) {
+			if (recording) {
+				index = getInstance().pushKeyedFrame(type, key(), name);
+			}
+		}
+
+		~Frame() {
+			if (index != NO_FRAME) {
+				getInstance().popFrame(index);
+			}
+		}
+
+		Frame(const Frame &) = delete;
+		Frame &operator=(const Frame &) = delete;
+
+	private:
+		uint32_t index = NO_FRAME;
+	};
+
+private:
+	static constexpr uint32_t NO_FRAME = std::numeric_limits<uint32_t>::max();
+	static constexpr uint32_t DROPPED_FRAME = NO_FRAME - 1;
+
+	thread_local static bool recording;
+
+	static int64_t now();
+
+	uint32_t pushFrame(TickFrameType type, std::string_view name);
+	uint32_t pushInternedFrame(TickFrameType type, std::string_view name);
+	void popFrame(uint32_t index);
+
+	template <typename F>
+	uint32_t pushKeyedFrame(TickFrameType type, uint64_t key, F &&name) {
+		auto &names = keyedNames[static_cast<size_t>(type)];
+		auto it = names.find(key);
+		if (it == names.end()) {
+			it = names.emplace(key, intern(name())).first;
+		}
+		return pushInternedFrame(type, it->second);
+	}
+
+	std::string_view intern(std::string_view name);
+
+	std::string toFolded() const;
+	std::string toChromeTrace() const;
+
+	// Min-heap on the tick duration, the fastest of the kept ticks is at the front
+	std::vector<TickSample> slowest;
+	TickSample current;
+	int64_t tickStart = 0;
+	uint8_t depth = 0;
+
+	phmap::node_hash_set<std::string> names;
+	// By frame type, the keys of the Lua scripts and of the creature thinks don't overlap
+	std::array<phmap::flat_hash_map<uint64_t, std::string_view>, 3> keyedNames;
+};
+
+constexpr auto g_tickProfiler = TickProfiler::getInstance;
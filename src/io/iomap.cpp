@@ -12,6 +12,7 @@
 #include "game/movement/teleport.hpp"
 #include "game/game.hpp"
 #include "io/filestream.hpp"
+#include "io/iomapsnapshot.hpp"
 
 /*
     OTBM_ROOTV1
@@ -40,6 +41,14 @@
 void IOMap::loadMap(Map* map, const Position &pos) {
 	Benchmark bm_mapLoad;
 
+	const bool useSnapshot = g_configManager().getBoolean(TOGGLE_MAP_SNAPSHOT);
+	if (useSnapshot && IOMapSnapshot::load(*map, pos)) {
+		g_logger().debug("Map Loaded {} ({}x{}) from snapshot in {} milliseconds", map->path.filename().string(), map->width, map->height, bm_mapLoad.duration());
+		return;
+	}
+
+	std::unique_ptr<MapSnapshotData> snapshot = useSnapshot ? std::make_unique<MapSnapshotData>() : nullptr;
+
 	const auto &fileByte = mio::mmap_source(map->path.string());
 
 	const auto begin = fileByte.begin() + sizeof(OTB::Identifier { { 'O', 'T', 'B', 'M' } });
@@ -68,12 +77,16 @@ void IOMap::loadMap(Map* map, const Position &pos) {
 
 	if (stream.startNode(OTBM_MAP_DATA)) {
 		parseMapDataAttributes(stream, map);
-		parseTileArea(stream, *map, pos);
+		parseTileArea(stream, *map, pos, snapshot.get());
 		stream.endNode();
 	}
 
-	parseTowns(stream, *map);
-	parseWaypoints(stream, *map);
+	parseTowns(stream, *map, snapshot.get());
+	parseWaypoints(stream, *map, snapshot.get());
+
+	if (snapshot) {
+		IOMapSnapshot::save(*map, pos, *snapshot);
+	}
 
 	map->flush();
 
@@ -116,7 +129,7 @@ void IOMap::parseMapDataAttributes(FileStream &stream, Map* map) {
 	}
 }
 
-void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
+void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos, MapSnapshotData* snapshot) {
 	while (stream.startNode(OTBM_TILE_AREA)) {
 		const uint16_t base_x = stream.getU16();
 		const uint16_t base_y = stream.getU16();
@@ -128,7 +141,8 @@ void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
 				throw IOMapException("Could not read tile type node.");
 			}
 
-			const auto tile = std::make_shared<BasicTile>();
+			BasicTile tile;
+			std::vector<BasicItemHandle> tileItems;
 
 			const uint8_t tileCoordsX = stream.getU8();
 			const uint8_t tileCoordsY = stream.getU8();
@@ -138,24 +152,24 @@ void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
 			const auto z = static_cast<uint8_t>(base_z + pos.z);
 
 			if (tileType == OTBM_HOUSETILE) {
-				tile->houseId = stream.getU32();
-				if (!map.houses.addHouse(tile->houseId)) {
-					throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not create house id: {}", x, y, z, tile->houseId));
+				tile.houseId = stream.getU32();
+				if (!map.houses.addHouse(tile.houseId)) {
+					throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not create house id: {}", x, y, z, tile.houseId));
 				}
 			}
 
 			if (stream.isProp(OTBM_ATTR_TILE_FLAGS)) {
 				const uint32_t flags = stream.getU32();
 				if ((flags & OTBM_TILEFLAG_PROTECTIONZONE) != 0) {
-					tile->flags |= TILESTATE_PROTECTIONZONE;
+					tile.flags |= TILESTATE_PROTECTIONZONE;
 				} else if ((flags & OTBM_TILEFLAG_NOPVPZONE) != 0) {
-					tile->flags |= TILESTATE_NOPVPZONE;
+					tile.flags |= TILESTATE_NOPVPZONE;
 				} else if ((flags & OTBM_TILEFLAG_PVPZONE) != 0) {
-					tile->flags |= TILESTATE_PVPZONE;
+					tile.flags |= TILESTATE_PVPZONE;
 				}
 
 				if ((flags & OTBM_TILEFLAG_NOLOGOUT) != 0) {
-					tile->flags |= TILESTATE_NOLOGOUT;
+					tile.flags |= TILESTATE_NOLOGOUT;
 				}
 			}
 
@@ -163,19 +177,19 @@ void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
 				const uint16_t id = stream.getU16();
 				const auto &iType = Item::items[id];
 
-				if (!tile->isHouse() || !iType.isBed()) {
-					const auto item = std::make_shared<BasicItem>();
-					item->id = id;
+				if (!tile.isHouse() || !iType.isBed()) {
+					BasicItem item;
+					item.id = id;
 
-					if (tile->isHouse() && iType.movable) {
+					if (tile.isHouse() && iType.movable) {
 						g_logger().warn("[IOMap::loadMap] - "
 						                "Movable item with ID: {}, in house: {}, "
 						                "at position: x {}, y {}, z {}",
-						                id, tile->houseId, x, y, z);
+						                id, tile.houseId, x, y, z);
 					} else if (iType.isGroundTile()) {
-						tile->ground = map.tryReplaceItemFromCache(item);
+						tile.ground = map.tryReplaceItemFromCache(item, {});
 					} else {
-						tile->items.emplace_back(map.tryReplaceItemFromCache(item));
+						tileItems.emplace_back(map.tryReplaceItemFromCache(item, {}));
 					}
 				}
 			}
@@ -186,24 +200,25 @@ void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
 					case OTBM_ITEM: {
 						const uint16_t id = stream.getU16();
 						const auto &iType = Item::items[id];
-						const auto item = std::make_shared<BasicItem>();
-						item->id = id;
+						BasicItem item;
+						item.id = id;
 
-						if (!item->unserializeItemNode(stream, x, y, z)) {
+						std::vector<BasicItemHandle> children;
+						if (!item.unserializeItemNode(stream, x, y, z, children)) {
 							throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Failed to load item {}, Node Type.", x, y, z, id));
 						}
 
-						if (tile->isHouse() && (iType.isBed() || iType.isTrashHolder())) {
+						if (tile.isHouse() && (iType.isBed() || iType.isTrashHolder())) {
 							// nothing
-						} else if (tile->isHouse() && iType.movable) {
+						} else if (tile.isHouse() && iType.movable) {
 							g_logger().warn("[IOMap::loadMap] - "
 							                "Movable item with ID: {}, in house: {}, "
 							                "at position: x {}, y {}, z {}",
-							                id, tile->houseId, x, y, z);
+							                id, tile.houseId, x, y, z);
 						} else if (iType.isGroundTile()) {
-							tile->ground = map.tryReplaceItemFromCache(item);
+							tile.ground = map.tryReplaceItemFromCache(item, children);
 						} else {
-							tile->items.emplace_back(map.tryReplaceItemFromCache(item));
+							tileItems.emplace_back(map.tryReplaceItemFromCache(item, children));
 						}
 					} break;
 					case OTBM_TILE_ZONE: {
@@ -213,8 +228,10 @@ void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
 							if (!zoneId) {
 								throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Invalid zone id.", x, y, z));
 							}
-							auto zone = Zone::getZone(zoneId);
-							zone->addPosition(Position(x, y, z));
+							map.pendingZones.emplace_back(Position(x, y, z), zoneId);
+							if (snapshot) {
+								snapshot->zones.emplace_back(Position(x, y, z), zoneId);
+							}
 						}
 					} break;
 					default:
@@ -230,11 +247,14 @@ void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
 				throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not end node.", x, y, z));
 			}
 
-			if (tile->isEmpty(true)) {
+			if (tile.ground == 0 && tileItems.empty()) {
 				continue;
 			}
 
-			map.setBasicTile(x, y, z, tile);
+			const auto handle = map.setBasicTile(x, y, z, tile, tileItems);
+			if (snapshot && handle != 0) {
+				snapshot->tiles.emplace_back(Position(x, y, z), handle);
+			}
 		}
 
 		if (!stream.endNode()) {
@@ -243,7 +263,7 @@ void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
 	}
 }
 
-void IOMap::parseTowns(FileStream &stream, Map &map) {
+void IOMap::parseTowns(FileStream &stream, Map &map, MapSnapshotData* snapshot) {
 	if (!stream.startNode(OTBM_TOWNS)) {
 		throw IOMapException("Could not read towns node.");
 	}
@@ -258,6 +278,9 @@ void IOMap::parseTowns(FileStream &stream, Map &map) {
 		auto town = map.towns.getOrCreateTown(townId);
 		town->setName(townName);
 		town->setTemplePos(Position(x, y, z));
+		if (snapshot) {
+			snapshot->towns.emplace_back(townId, townName, Position(x, y, z));
+		}
 
 		if (!stream.endNode()) {
 			throw IOMapException("Could not end node.");
@@ -269,7 +292,7 @@ void IOMap::parseTowns(FileStream &stream, Map &map) {
 	}
 }
 
-void IOMap::parseWaypoints(FileStream &stream, Map &map) {
+void IOMap::parseWaypoints(FileStream &stream, Map &map, MapSnapshotData* snapshot) {
 	if (!stream.startNode(OTBM_WAYPOINTS)) {
 		throw IOMapException("Could not read waypoints node.");
 	}
@@ -281,6 +304,9 @@ void IOMap::parseWaypoints(FileStream &stream, Map &map) {
 		const uint8_t z = stream.getU8();
 
 		map.waypoints[name] = Position(x, y, z);
+		if (snapshot) {
+			snapshot->waypoints.emplace_back(name, Position(x, y, z));
+		}
 
 		if (!stream.endNode()) {
 			throw IOMapException("Could not end node.");
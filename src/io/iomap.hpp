@@ -20,6 +20,8 @@
 #include "creatures/npcs/spawns/spawn_npc.hpp"
 #include "game/zones/zone.hpp"
 
+struct MapSnapshotData;
+
 class IOMap {
 public:
 	static void loadMap(Map* map, const Position &pos = Position());
@@ -151,9 +153,9 @@ public:
 
 private:
 	static void parseMapDataAttributes(FileStream &stream, Map* map);
-	static void parseWaypoints(FileStream &stream, Map &map);
-	static void parseTowns(FileStream &stream, Map &map);
-	static void parseTileArea(FileStream &stream, Map &map, const Position &pos);
+	static void parseWaypoints(FileStream &stream, Map &map, MapSnapshotData* snapshot);
+	static void parseTowns(FileStream &stream, Map &map, MapSnapshotData* snapshot);
+	static void parseTileArea(FileStream &stream, Map &map, const Position &pos, MapSnapshotData* snapshot);
 };
 
 class IOMapException : public std::exception {
@@ -0,0 +1,472 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "io/iomapsnapshot.hpp"
+
+#include "config/configmanager.hpp"
+#include "io/fileloader.hpp"
+#include "map/map.hpp"
+#include "utils/hash.hpp"
+
+/*
+    Snapshot layout (little endian, strings are u16 length + bytes)
+
+    header      "CWSN", u32 version, u64 source hash, u16/u16/u8 load offset
+    map data    u32 width, u32 height, monster/npc/house/zone file names
+    items       u32 count, { u16 id, u16 charges, u16 actionId, u16 uniqueId,
+                             u16 destX, u16 destY, u8 destZ, u16 doorOrDepotId,
+                             string text, u32 count, u32 child index... }
+    tiles       u32 count, { u32 ground index, u32 flags, u32 houseId, u8 type,
+                             u8 isStatic, u32 count, u32 item index... }
+    placements  u32 count, { u16 x, u16 y, u8 z, u32 tile index }
+    zones       u32 count, { u16 x, u16 y, u8 z, u16 zoneId }
+    towns       u32 count, { u32 id, string name, u16 x, u16 y, u8 z }
+    waypoints   u32 count, { string name, u16 x, u16 y, u8 z }
+
+    Items are written children first, so every child index points to an earlier entry.
+*/
+
+namespace {
+	constexpr OTB::Identifier SNAPSHOT_IDENTIFIER = { { 'C', 'W', 'S', 'N' } };
+	constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+	void hashFileContents(size_t &h, const std::string &path) {
+		std::error_code ec;
+		const auto fileSize = std::filesystem::file_size(path, ec);
+		if (ec || fileSize == 0) {
+			stdext::hash_combine(h, static_cast<uint64_t>(0));
+			return;
+		}
+
+		const auto file = mio::mmap_source(path);
+		const char* data = file.data();
+		const size_t size = file.size();
+
+		size_t i = 0;
+		for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+			uint64_t word;
+			std::memcpy(&word, data + i, sizeof(uint64_t));
+			stdext::hash_combine(h, word);
+		}
+
+		uint64_t tail = 0;
+		std::memcpy(&tail, data + i, size - i);
+		stdext::hash_combine(h, tail);
+		stdext::hash_combine(h, static_cast<uint64_t>(size));
+	}
+
+	void writePosition(PropWriteStream &stream, const Position &pos) {
+		stream.write<uint16_t>(pos.x);
+		stream.write<uint16_t>(pos.y);
+		stream.write<uint8_t>(pos.z);
+	}
+
+	bool readPosition(PropStream &stream, Position &pos) {
+		return stream.read<uint16_t>(pos.x) && stream.read<uint16_t>(pos.y) && stream.read<uint8_t>(pos.z);
+	}
+
+	class SnapshotWriter {
+	public:
+		uint32_t addItem(BasicItemHandle handle) {
+			if (const auto it = itemIndexes.find(handle); it != itemIndexes.end()) {
+				return it->second;
+			}
+
+			const auto &item = MapCache::getBasicItem(handle);
+			std::vector<uint32_t> children;
+			children.reserve(item.childCount);
+			for (const auto child : MapCache::getChildren(item)) {
+				children.emplace_back(addItem(child));
+			}
+
+			itemStream.write<uint16_t>(item.id);
+			itemStream.write<uint16_t>(item.charges);
+			itemStream.write<uint16_t>(item.actionId);
+			itemStream.write<uint16_t>(item.uniqueId);
+			itemStream.write<uint16_t>(item.destX);
+			itemStream.write<uint16_t>(item.destY);
+			itemStream.write<uint8_t>(item.destZ);
+			itemStream.write<uint16_t>(item.doorOrDepotId);
+			itemStream.writeString(MapCache::getText(item));
+			itemStream.write<uint32_t>(static_cast<uint32_t>(children.size()));
+			for (const auto index : children) {
+				itemStream.write<uint32_t>(index);
+			}
+
+			return itemIndexes[handle] = itemCount++;
+		}
+
+		uint32_t addTile(BasicTileHandle handle) {
+			if (const auto it = tileIndexes.find(handle); it != tileIndexes.end()) {
+				return it->second;
+			}
+
+			const auto &tile = MapCache::getBasicTile(handle);
+			const uint32_t ground = tile.ground != 0 ? addItem(tile.ground) : NO_INDEX;
+			std::vector<uint32_t> items;
+			items.reserve(tile.itemCount);
+			for (const auto item : MapCache::getItems(tile)) {
+				items.emplace_back(addItem(item));
+			}
+
+			tileStream.write<uint32_t>(ground);
+			tileStream.write<uint32_t>(tile.flags);
+			tileStream.write<uint32_t>(tile.houseId);
+			tileStream.write<uint8_t>(tile.type);
+			tileStream.write<uint8_t>(tile.isStatic ? 1 : 0);
+			tileStream.write<uint32_t>(static_cast<uint32_t>(items.size()));
+			for (const auto index : items) {
+				tileStream.write<uint32_t>(index);
+			}
+
+			return tileIndexes[handle] = tileCount++;
+		}
+
+		void flush(std::ofstream &file) const {
+			size_t size;
+			const char* buffer;
+
+			file.write(reinterpret_cast<const char*>(&itemCount), sizeof(itemCount));
+			buffer = itemStream.getStream(size);
+			file.write(buffer, static_cast<std::streamsize>(size));
+
+			file.write(reinterpret_cast<const char*>(&tileCount), sizeof(tileCount));
+			buffer = tileStream.getStream(size);
+			file.write(buffer, static_cast<std::streamsize>(size));
+		}
+
+	private:
+		PropWriteStream itemStream;
+		PropWriteStream tileStream;
+		uint32_t itemCount = 0;
+		uint32_t tileCount = 0;
+		phmap::flat_hash_map<BasicItemHandle, uint32_t> itemIndexes;
+		phmap::flat_hash_map<BasicTileHandle, uint32_t> tileIndexes;
+	};
+}
+
+std::string IOMapSnapshot::getSnapshotPath(const Map &map) {
+	return map.path.string() + ".snapshot";
+}
+
+uint64_t IOMapSnapshot::getSourceHash(const Map &map, const Position &pos) {
+	const auto &coreFolder = g_configManager().getString(CORE_DIRECTORY);
+
+	size_t h = 0;
+	stdext::hash_combine(h, VERSION);
+	stdext::hash_combine(h, pos.x);
+	stdext::hash_combine(h, pos.y);
+	stdext::hash_combine(h, pos.z);
+	hashFileContents(h, map.path.string());
+	// Ground/bed/movable flags decide where items end up while parsing the OTBM
+	hashFileContents(h, coreFolder + "/items/items.xml");
+	hashFileContents(h, coreFolder + "/items/appearances.dat");
+	return h;
+}
+
+bool IOMapSnapshot::save(const Map &map, const Position &pos, const MapSnapshotData &data) {
+	Benchmark bm_snapshot;
+
+	SnapshotWriter writer;
+	PropWriteStream placements;
+	for (const auto &[tilePos, tile] : data.tiles) {
+		writePosition(placements, tilePos);
+		placements.write<uint32_t>(writer.addTile(tile));
+	}
+
+	PropWriteStream header;
+	for (const auto c : SNAPSHOT_IDENTIFIER) {
+		header.write<char>(c);
+	}
+	header.write<uint32_t>(VERSION);
+	header.write<uint64_t>(getSourceHash(map, pos));
+	writePosition(header, pos);
+	header.write<uint32_t>(map.width);
+	header.write<uint32_t>(map.height);
+	header.writeString(map.monsterfile);
+	header.writeString(map.npcfile);
+	header.writeString(map.housefile);
+	header.writeString(map.zonesfile);
+
+	PropWriteStream trailer;
+	trailer.write<uint32_t>(static_cast<uint32_t>(data.zones.size()));
+	for (const auto &[zonePos, zoneId] : data.zones) {
+		writePosition(trailer, zonePos);
+		trailer.write<uint16_t>(zoneId);
+	}
+	trailer.write<uint32_t>(static_cast<uint32_t>(data.towns.size()));
+	for (const auto &[townId, townName, templePos] : data.towns) {
+		trailer.write<uint32_t>(townId);
+		trailer.writeString(townName);
+		writePosition(trailer, templePos);
+	}
+	trailer.write<uint32_t>(static_cast<uint32_t>(data.waypoints.size()));
+	for (const auto &[name, waypointPos] : data.waypoints) {
+		trailer.writeString(name);
+		writePosition(trailer, waypointPos);
+	}
+
+	const auto path = getSnapshotPath(map);
+	const auto tmpPath = path + ".tmp";
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			g_logger().warn("[IOMapSnapshot::save] - Cannot open {} for writing", tmpPath);
+			return false;
+		}
+
+		size_t size;
+		const char* buffer = header.getStream(size);
+		file.write(buffer, static_cast<std::streamsize>(size));
+
+		writer.flush(file);
+
+		const auto placementCount = static_cast<uint32_t>(data.tiles.size());
+		file.write(reinterpret_cast<const char*>(&placementCount), sizeof(placementCount));
+		buffer = placements.getStream(size);
+		file.write(buffer, static_cast<std::streamsize>(size));
+
+		buffer = trailer.getStream(size);
+		file.write(buffer, static_cast<std::streamsize>(size));
+
+		if (!file.good()) {
+			g_logger().warn("[IOMapSnapshot::save] - Failed to write {}", tmpPath);
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, path, ec);
+	if (ec) {
+		g_logger().warn("[IOMapSnapshot::save] - Failed to replace {}: {}", path, ec.message());
+		std::filesystem::remove(tmpPath, ec);
+		return false;
+	}
+
+	g_logger().debug("Map snapshot {} written in {} milliseconds", path, bm_snapshot.duration());
+	return true;
+}
+
+bool IOMapSnapshot::load(Map &map, const Position &pos) {
+	Benchmark bm_snapshot;
+
+	const auto path = getSnapshotPath(map);
+	std::error_code ec;
+	if (!std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) == 0) {
+		return false;
+	}
+
+	const auto file = mio::mmap_source(path);
+	PropStream stream;
+	stream.init(file.data(), file.size());
+
+	OTB::Identifier identifier;
+	uint32_t version;
+	uint64_t sourceHash;
+	Position offset;
+	if (!stream.read(identifier) || identifier != SNAPSHOT_IDENTIFIER || !stream.read(version) || version != VERSION) {
+		g_logger().info("Map snapshot {} has an unknown format, rebuilding it", path);
+		return false;
+	}
+
+	if (!stream.read(sourceHash) || !readPosition(stream, offset) || offset != pos || sourceHash != getSourceHash(map, pos)) {
+		g_logger().info("Map snapshot {} is outdated, rebuilding it", path);
+		return false;
+	}
+
+	// Decode everything first, so a truncated file never leaves the map half loaded
+	const auto corrupted = [&path] {
+		g_logger().warn("Map snapshot {} is corrupted, rebuilding it", path);
+		return false;
+	};
+
+	uint32_t width, height;
+	std::string monsterfile, npcfile, housefile, zonesfile;
+	if (!stream.read(width) || !stream.read(height) || !stream.readString(monsterfile) || !stream.readString(npcfile) || !stream.readString(housefile) || !stream.readString(zonesfile)) {
+		return corrupted();
+	}
+
+	uint32_t count;
+	if (!stream.read(count)) {
+		return corrupted();
+	}
+
+	// Decoded entries reference each other by snapshot index through the local index table
+	std::vector<uint32_t> indexes;
+	std::vector<std::string> texts { std::string {} };
+
+	std::vector<BasicItem> items;
+	items.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		BasicItem item;
+		std::string text;
+		uint32_t children;
+		if (!stream.read(item.id) || !stream.read(item.charges) || !stream.read(item.actionId) || !stream.read(item.uniqueId) || !stream.read(item.destX) || !stream.read(item.destY) || !stream.read(item.destZ) || !stream.read(item.doorOrDepotId) || !stream.readString(text) || !stream.read(children) || children > std::numeric_limits<uint16_t>::max()) {
+			return corrupted();
+		}
+
+		if (!text.empty()) {
+			item.text = static_cast<uint32_t>(texts.size());
+			texts.emplace_back(std::move(text));
+		}
+
+		item.firstChild = static_cast<uint32_t>(indexes.size());
+		item.childCount = static_cast<uint16_t>(children);
+		for (uint32_t c = 0; c < children; ++c) {
+			uint32_t index;
+			if (!stream.read(index) || index >= items.size()) {
+				return corrupted();
+			}
+			indexes.emplace_back(index);
+		}
+
+		items.emplace_back(item);
+	}
+
+	if (!stream.read(count)) {
+		return corrupted();
+	}
+
+	std::vector<BasicTile> tiles;
+	tiles.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		BasicTile tile;
+		uint8_t isStatic;
+		uint32_t tileItems;
+		if (!stream.read(tile.ground) || !stream.read(tile.flags) || !stream.read(tile.houseId) || !stream.read(tile.type) || !stream.read(isStatic) || !stream.read(tileItems) || tileItems > std::numeric_limits<uint16_t>::max()) {
+			return corrupted();
+		}
+
+		if (tile.ground != NO_INDEX && tile.ground >= items.size()) {
+			return corrupted();
+		}
+		tile.isStatic = isStatic != 0;
+
+		tile.firstItem = static_cast<uint32_t>(indexes.size());
+		tile.itemCount = static_cast<uint16_t>(tileItems);
+		for (uint32_t c = 0; c < tileItems; ++c) {
+			uint32_t index;
+			if (!stream.read(index) || index >= items.size()) {
+				return corrupted();
+			}
+			indexes.emplace_back(index);
+		}
+
+		tiles.emplace_back(tile);
+	}
+
+	if (!stream.read(count)) {
+		return corrupted();
+	}
+
+	std::vector<std::pair<Position, uint32_t>> placements;
+	placements.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		Position tilePos;
+		uint32_t index;
+		if (!readPosition(stream, tilePos) || !stream.read(index) || index >= tiles.size() || tilePos.z >= MAP_MAX_LAYERS) {
+			return corrupted();
+		}
+		placements.emplace_back(tilePos, index);
+	}
+
+	MapSnapshotData data;
+	if (!stream.read(count)) {
+		return corrupted();
+	}
+	data.zones.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		Position zonePos;
+		uint16_t zoneId;
+		if (!readPosition(stream, zonePos) || !stream.read(zoneId) || zoneId == 0) {
+			return corrupted();
+		}
+		data.zones.emplace_back(zonePos, zoneId);
+	}
+
+	if (!stream.read(count)) {
+		return corrupted();
+	}
+	data.towns.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t townId;
+		std::string townName;
+		Position templePos;
+		if (!stream.read(townId) || !stream.readString(townName) || !readPosition(stream, templePos)) {
+			return corrupted();
+		}
+		data.towns.emplace_back(townId, std::move(townName), templePos);
+	}
+
+	if (!stream.read(count)) {
+		return corrupted();
+	}
+	data.waypoints.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		std::string name;
+		Position waypointPos;
+		if (!stream.readString(name) || !readPosition(stream, waypointPos)) {
+			return corrupted();
+		}
+		data.waypoints.emplace_back(std::move(name), waypointPos);
+	}
+
+	map.width = width;
+	map.height = height;
+	map.monsterfile = std::move(monsterfile);
+	map.npcfile = std::move(npcfile);
+	map.housefile = std::move(housefile);
+	map.zonesfile = std::move(zonesfile);
+
+	std::vector<BasicItemHandle> handles;
+	std::vector<BasicItemHandle> refs;
+	handles.reserve(items.size());
+	for (auto item : items) {
+		refs.clear();
+		for (uint16_t c = 0; c < item.childCount; ++c) {
+			refs.emplace_back(handles[indexes[item.firstChild + c]]);
+		}
+		item.text = MapCache::internText(texts[item.text]);
+		handles.emplace_back(map.tryReplaceItemFromCache(item, refs));
+	}
+
+	std::vector<BasicTileHandle> tileHandles;
+	tileHandles.reserve(tiles.size());
+	for (auto tile : tiles) {
+		refs.clear();
+		for (uint16_t c = 0; c < tile.itemCount; ++c) {
+			refs.emplace_back(handles[indexes[tile.firstItem + c]]);
+		}
+		tile.ground = tile.ground != NO_INDEX ? handles[tile.ground] : 0;
+		tileHandles.emplace_back(map.tryReplaceTileFromCache(tile, refs));
+	}
+
+	for (const auto &[tilePos, index] : placements) {
+		const auto &tile = tiles[index];
+		if (tile.isHouse()) {
+			map.houses.addHouse(tile.houseId);
+		}
+		map.getBestMapSector(tilePos.x, tilePos.y)->createFloor(tilePos.z)->setTileCache(tilePos.x, tilePos.y, tileHandles[index]);
+	}
+
+	map.pendingZones.insert(map.pendingZones.end(), data.zones.begin(), data.zones.end());
+
+	for (const auto &[townId, townName, templePos] : data.towns) {
+		const auto &town = map.towns.getOrCreateTown(townId);
+		town->setName(townName);
+		town->setTemplePos(templePos);
+	}
+
+	for (const auto &[name, waypointPos] : data.waypoints) {
+		map.waypoints[name] = waypointPos;
+	}
+
+	g_logger().debug("Map snapshot {} loaded ({} items, {} tiles, {} positions) in {} milliseconds", path, items.size(), tiles.size(), placements.size(), bm_snapshot.duration());
+	return true;
+}
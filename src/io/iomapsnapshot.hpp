@@ -0,0 +1,52 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "game/movement/position.hpp"
+
+class Map;
+using BasicTileHandle = uint32_t;
+
+/**
+ * Everything IOMap::loadMap produced from a single OTBM file.
+ * Filled while the OTBM is parsed and handed to IOMapSnapshot::save afterwards.
+ */
+struct MapSnapshotData {
+	std::vector<std::pair<Position, BasicTileHandle>> tiles;
+	std::vector<std::pair<Position, uint16_t>> zones;
+	std::vector<std::tuple<uint32_t, std::string, Position>> towns;
+	std::vector<std::pair<std::string, Position>> waypoints;
+};
+
+/**
+ * Precompiled world snapshot.
+ * Stores the deduplicated BasicItem/BasicTile tables of an OTBM file in a versioned binary
+ * file next to the map ("<map>.otbm.snapshot"). The snapshot is keyed by a hash of the
+ * OTBM, items.xml and appearances.dat contents, so it is rebuilt whenever any of them changes.
+ */
+class IOMapSnapshot {
+public:
+	static constexpr uint32_t VERSION = 1;
+
+	/**
+	 * Restores the map tiles, houses, zones, towns and waypoints from the snapshot.
+	 * \returns false if there is no valid snapshot for the current sources, the map is left untouched in that case
+	 */
+	static bool load(Map &map, const Position &pos);
+
+	/**
+	 * Writes the snapshot of the OTBM file that has just been parsed.
+	 */
+	static bool save(const Map &map, const Position &pos, const MapSnapshotData &data);
+
+private:
+	static std::string getSnapshotPath(const Map &map);
+	static uint64_t getSourceHash(const Map &map, const Position &pos);
+};
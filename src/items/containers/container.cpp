@@ -68,6 +68,7 @@ std::shared_ptr<Container> Container::createBrowseField(const std::shared_ptr<Ti
 			// Add the item to the new container and set its parent.
 			newContainer->itemlist.push_front(item);
 			item->setParent(newContainer);
+			newContainer->updateItemTypeCount(item, true);
 		}
 	}
 
@@ -150,6 +151,7 @@ bool Container::hasParent() {
 void Container::addItem(const std::shared_ptr<Item> &item) {
 	itemlist.push_back(item);
 	item->setParent(getContainer());
+	updateItemTypeCount(item, true);
 }
 
 StashContainerList Container::getStowableItems() {
@@ -234,6 +236,69 @@ void Container::updateItemWeight(int32_t diff) {
 	}
 }
 
+void Container::updateItemTypeCount(const std::shared_ptr<Item> &item, bool add) {
+	const auto &itemContainer = item->getContainer();
+	const auto update = [add](phmap::flat_hash_map<uint16_t, uint32_t> &counts, uint16_t itemId, uint32_t count) {
+		if (count == 0) {
+			return;
+		}
+
+		if (add) {
+			counts[itemId] += count;
+			return;
+		}
+
+		const auto it = counts.find(itemId);
+		if (it == counts.end()) {
+			return;
+		}
+		if (it->second <= count) {
+			counts.erase(it);
+		} else {
+			it->second -= count;
+		}
+	};
+
+	std::shared_ptr<Container> container = getContainer();
+	do {
+		update(container->itemTypeCounts, item->getID(), item->getItemCount());
+		if (itemContainer) {
+			for (const auto &[itemId, count] : itemContainer->itemTypeCounts) {
+				update(container->itemTypeCounts, itemId, count);
+			}
+		}
+	} while ((container = container->getParentContainer()) != nullptr);
+}
+
+uint32_t Container::getRecursiveItemTypeCount(uint16_t itemId) const {
+	const auto it = itemTypeCounts.find(itemId);
+	return it != itemTypeCounts.end() ? it->second : 0;
+}
+
+bool Container::checkItemTypeCounts() const {
+	phmap::flat_hash_map<uint16_t, uint32_t> counts;
+	for (const auto &item : itemlist) {
+		if (item->getItemCount() != 0) {
+			counts[item->getID()] += item->getItemCount();
+		}
+		if (const auto &itemContainer = item->getContainer()) {
+			if (!itemContainer->checkItemTypeCounts()) {
+				return false;
+			}
+			for (const auto &[itemId, count] : itemContainer->itemTypeCounts) {
+				counts[itemId] += count;
+			}
+		}
+	}
+
+	if (counts == itemTypeCounts) {
+		return true;
+	}
+
+	g_logger().error("[{}] item counts of container {} are out of sync with its contents", __FUNCTION__, getID());
+	return false;
+}
+
 uint32_t Container::getWeight() const {
 	return Item::getWeight() + totalWeight;
 }
@@ -736,6 +801,7 @@ void Container::addThing(int32_t index, const std::shared_ptr<Thing> &thing) {
 	item->setParent(getContainer());
 	itemlist.push_front(item);
 	updateItemWeight(item->getWeight());
+	updateItemTypeCount(item, true);
 
 	// send change to client
 	if (getParent() && (getParent() != VirtualCylinder::virtualCylinder)) {
@@ -765,9 +831,11 @@ void Container::updateThing(const std::shared_ptr<Thing> &thing, uint16_t itemId
 	}
 
 	const int32_t oldWeight = item->getWeight();
+	updateItemTypeCount(item, false);
 	item->setID(itemId);
 	item->setSubType(count);
 	updateItemWeight(-oldWeight + item->getWeight());
+	updateItemTypeCount(item, true);
 
 	// send change to client
 	if (getParent()) {
@@ -797,6 +865,8 @@ void Container::replaceThing(uint32_t index, const std::shared_ptr<Thing> &thing
 	itemlist[index] = item;
 	item->setParent(getContainer());
 	updateItemWeight(-static_cast<int32_t>(replacedItem->getWeight()) + item->getWeight());
+	updateItemTypeCount(replacedItem, false);
+	updateItemTypeCount(item, true);
 
 	// send change to client
 	if (getParent()) {
@@ -820,8 +890,10 @@ void Container::removeThing(const std::shared_ptr<Thing> &thing, uint32_t count)
 	if (item->isStackable() && count != item->getItemCount()) {
 		const auto newCount = static_cast<uint8_t>(std::max<int32_t>(0, item->getItemCount() - count));
 		const int32_t oldWeight = item->getWeight();
+		updateItemTypeCount(item, false);
 		item->setItemCount(newCount);
 		updateItemWeight(-oldWeight + item->getWeight());
+		updateItemTypeCount(item, true);
 
 		// send change to client
 		if (getParent()) {
@@ -829,6 +901,7 @@ void Container::removeThing(const std::shared_ptr<Thing> &thing, uint32_t count)
 		}
 	} else {
 		updateItemWeight(-static_cast<int32_t>(item->getWeight()));
+		updateItemTypeCount(item, false);
 
 		// send change to client
 		if (getParent()) {
@@ -943,6 +1016,7 @@ void Container::internalAddThing(uint32_t, const std::shared_ptr<Thing> &thing)
 	item->setParent(getContainer());
 	itemlist.push_front(item);
 	updateItemWeight(item->getWeight());
+	updateItemTypeCount(item, true);
 }
 
 uint16_t Container::getFreeSlots() const {
@@ -980,6 +1054,7 @@ void Container::removeItem(const std::shared_ptr<Thing> &thing, bool sendUpdateT
 
 		itemlist.erase(it);
 		itemToRemove->resetParent();
+		updateItemTypeCount(itemToRemove, false);
 
 		if (isCorpse() && empty()) {
 			clearLootHighlight();
@@ -238,6 +238,27 @@ public:
 
 	uint32_t getItemHoldingCount();
 	uint32_t getContainerHoldingCount();
+
+	/**
+	 * @brief Counts the items with the given id held by the container, nested containers included.
+	 *
+	 * The counts are kept up to date on every change of the container contents, so this doesn't walk the items.
+	 *
+	 * @param itemId The id of the items to count.
+	 * @return The summed item count (stack sizes) of the matching items.
+	 */
+	uint32_t getRecursiveItemTypeCount(uint16_t itemId) const;
+	const phmap::flat_hash_map<uint16_t, uint32_t> &getRecursiveItemTypeCounts() const {
+		return itemTypeCounts;
+	}
+	/**
+	 * @brief Recounts the items of the container and its nested containers and compares them with the kept counts.
+	 *
+	 * Meant for debug builds and tests, it walks the whole container tree.
+	 *
+	 * @return true if every nested container holds the right counts.
+	 */
+	bool checkItemTypeCounts() const;
 	uint16_t getFreeSlots() const;
 	uint32_t getWeight() const final;
 
@@ -313,6 +334,8 @@ protected:
 	uint32_t m_maxItems {};
 	uint32_t maxSize {};
 	uint32_t totalWeight {};
+	// Item count by id of the items held, nested containers included
+	phmap::flat_hash_map<uint16_t, uint32_t> itemTypeCounts;
 	ItemDeque itemlist;
 	uint32_t serializationCount = {};
 
@@ -320,6 +343,11 @@ protected:
 	bool pagination {};
 	bool m_lootHighlightActive { true };
 
+	/**
+	 * @brief Adds or removes the item, and its contents if it's a container, from the item counts of this container and its parents.
+	 */
+	void updateItemTypeCount(const std::shared_ptr<Item> &item, bool add);
+
 	friend class MapCache;
 
 private:
@@ -46,4 +46,5 @@ void DepotLocker::removeInbox(const std::shared_ptr<Inbox> &inbox) {
 		return;
 	}
 	itemlist.erase(cit);
+	updateItemTypeCount(inbox, false);
 }
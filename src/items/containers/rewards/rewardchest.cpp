@@ -53,5 +53,6 @@ void RewardChest::removeItem(const std::shared_ptr<Thing> &thing, bool /* sendTo
 	if (it != itemlist.end()) {
 		itemlist.erase(it);
 		itemToRemove->resetParent();
+		updateItemTypeCount(itemToRemove, false);
 	}
 }
@@ -694,6 +694,12 @@ Item::Item(const std::shared_ptr<Item> &i) :
 	}
 }
 
+Item::~Item() {
+	if (materializedFromCache) {
+		MapCache::onMaterializedItemDestroyed();
+	}
+}
+
 std::shared_ptr<Item> Item::clone() const {
 	const auto &item = Item::CreateItem(id, count);
 	if (item == nullptr) {
@@ -226,7 +226,7 @@ public:
 	explicit Item(const std::shared_ptr<Item> &i);
 	virtual std::shared_ptr<Item> clone() const;
 
-	~Item() override = default;
+	~Item() override;
 
 	// non-assignable
 	Item &operator=(const Item &) = delete;
@@ -777,6 +777,8 @@ protected:
 	bool isLootTrackeable = false;
 	bool decayDisabled = false;
 	bool m_hasActor = false;
+	// Counted by the map cache while alive, clones are not
+	bool materializedFromCache = false;
 
 private:
 	// Don't add variables here, use the ItemAttribute class.
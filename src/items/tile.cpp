@@ -28,6 +28,12 @@
 auto real_nullptr_tile = std::make_shared<StaticTile>(0xFFFF, 0xFFFF, 0xFF);
 const std::shared_ptr<Tile> &Tile::nullptr_tile = real_nullptr_tile;
 
+Tile::~Tile() {
+	if (materializedFromCache) {
+		MapCache::onMaterializedTileDestroyed();
+	}
+}
+
 bool Tile::hasProperty(ItemProperty prop) const {
 	switch (prop) {
 		case CONST_PROP_BLOCKSOLID:
@@ -374,6 +380,8 @@ void Tile::onAddTileItem(const std::shared_ptr<Item> &item) {
 		return;
 	}
 
+	modified = true;
+
 	if ((item->hasProperty(CONST_PROP_MOVABLE) || item->getContainer()) || (item->isWrapable() && !item->hasProperty(CONST_PROP_MOVABLE) && !item->hasProperty(CONST_PROP_BLOCKPATH))) {
 		const auto it = g_game().browseFields.find(static_self_cast<Tile>());
 		if (it != g_game().browseFields.end()) {
@@ -406,6 +414,7 @@ void Tile::onAddTileItem(const std::shared_ptr<Item> &item) {
 	if ((!hasFlag(TILESTATE_PROTECTIONZONE) || g_configManager().getBoolean(CLEAN_PROTECTION_ZONES))
 	    && item->isCleanable()) {
 		if (!this->getHouse()) {
+			++cleanableItems;
 			g_game().addTileToClean(static_self_cast<Tile>());
 		}
 	}
@@ -452,6 +461,8 @@ void Tile::onUpdateTileItem(const std::shared_ptr<Item> &oldItem, const ItemType
 		return;
 	}
 
+	modified = true;
+
 	if ((newItem->hasProperty(CONST_PROP_MOVABLE) || newItem->getContainer()) || (newItem->isWrapable() && newItem->hasProperty(CONST_PROP_MOVABLE) && !oldItem->hasProperty(CONST_PROP_BLOCKPATH))) {
 		const auto it = g_game().browseFields.find(getTile());
 		if (it != g_game().browseFields.end()) {
@@ -499,6 +510,8 @@ void Tile::onRemoveTileItem(const CreatureVector &spectators, const std::vector<
 		return;
 	}
 
+	modified = true;
+
 	if ((item->hasProperty(CONST_PROP_MOVABLE) || item->getContainer()) || (item->isWrapable() && !item->hasProperty(CONST_PROP_MOVABLE) && !item->hasProperty(CONST_PROP_BLOCKPATH))) {
 		const auto it = g_game().browseFields.find(getTile());
 		if (it != g_game().browseFields.end()) {
@@ -520,7 +533,7 @@ void Tile::onRemoveTileItem(const CreatureVector &spectators, const std::vector<
 	// send to client
 	size_t i = 0;
 	for (const auto &spectator : spectators) {
-		if (const auto &tmpPlayer = spectator->getPlayer()) {
+		if (const auto &tmpPlayer = spectator->getPlayer(); tmpPlayer && !batchRemove) {
 			tmpPlayer->sendRemoveTileThing(cylinderMapPos, oldStackPosVector[i++]);
 		}
 	}
@@ -533,19 +546,16 @@ void Tile::onRemoveTileItem(const CreatureVector &spectators, const std::vector<
 	if (!hasFlag(TILESTATE_PROTECTIONZONE) || g_configManager().getBoolean(CLEAN_PROTECTION_ZONES)) {
 		const auto &items = getItemList();
 		if (!items || items->empty()) {
+			cleanableItems = 0;
 			g_game().removeTileToClean(static_self_cast<Tile>());
 			return;
 		}
 
-		bool ret = false;
-		for (const auto &toCheck : *items) {
-			if (toCheck->isCleanable()) {
-				ret = true;
-				break;
-			}
+		if (item->isCleanable() && cleanableItems > 0) {
+			--cleanableItems;
 		}
 
-		if (!ret) {
+		if (cleanableItems == 0) {
 			g_game().removeTileToClean(static_self_cast<Tile>());
 		}
 	}
@@ -582,6 +592,8 @@ void Tile::onRemoveTileItem(const CreatureVector &spectators, const std::vector<
 }
 
 void Tile::onUpdateTile(const CreatureVector &spectators) {
+	modified = true;
+
 	const Position &cylinderMapPos = getPosition();
 
 	// send to clients
@@ -590,6 +602,15 @@ void Tile::onUpdateTile(const CreatureVector &spectators) {
 	}
 }
 
+void Tile::endBatchRemove() {
+	batchRemove = false;
+
+	const Position &cylinderMapPos = getPosition();
+	for (const auto &spectator : Spectators().find<Player>(cylinderMapPos, true)) {
+		spectator->getPlayer()->sendUpdateTile(getTile(), cylinderMapPos);
+	}
+}
+
 ReturnValue Tile::queryAdd(int32_t, const std::shared_ptr<Thing> &thing, uint32_t, uint32_t tileFlags, const std::shared_ptr<Creature> &) {
 	if (!thing) {
 		return RETURNVALUE_NOTPOSSIBLE;
@@ -1131,6 +1152,23 @@ void Tile::addThing(int32_t, const std::shared_ptr<Thing> &thing) {
 	}
 }
 
+void Tile::onUpdateCleanableItem(bool wasCleanable, bool isCleanable) {
+	if (wasCleanable == isCleanable || getHouse()) {
+		return;
+	}
+
+	if (hasFlag(TILESTATE_PROTECTIONZONE) && !g_configManager().getBoolean(CLEAN_PROTECTION_ZONES)) {
+		return;
+	}
+
+	if (isCleanable) {
+		++cleanableItems;
+		g_game().addTileToClean(static_self_cast<Tile>());
+	} else if (cleanableItems > 0 && --cleanableItems == 0) {
+		g_game().removeTileToClean(static_self_cast<Tile>());
+	}
+}
+
 void Tile::updateThing(const std::shared_ptr<Thing> &thing, uint16_t itemId, uint32_t count) {
 	if (!thing) {
 		return /*RETURNVALUE_NOTPOSSIBLE*/;
@@ -1148,10 +1186,12 @@ void Tile::updateThing(const std::shared_ptr<Thing> &thing, uint16_t itemId, uin
 
 	const ItemType &oldType = Item::items[item->getID()];
 	const ItemType &newType = Item::items[itemId];
+	const bool wasCleanable = item->isCleanable();
 	resetTileFlags(item);
 	item->setID(itemId);
 	item->setSubType(count);
 	setTileFlags(item);
+	onUpdateCleanableItem(wasCleanable, item->isCleanable());
 	onUpdateTileItem(item, oldType, item, newType);
 }
 
@@ -1221,6 +1261,7 @@ void Tile::replaceThing(uint32_t index, const std::shared_ptr<Thing> &thing) {
 
 		resetTileFlags(oldItem);
 		setTileFlags(item);
+		onUpdateCleanableItem(oldItem->isCleanable(), item->isCleanable());
 		const ItemType &oldType = Item::items[oldItem->getID()];
 		const ItemType &newType = Item::items[item->getID()];
 		onUpdateTileItem(oldItem, oldType, item, newType);
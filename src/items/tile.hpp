@@ -104,7 +104,7 @@ public:
 	static const std::shared_ptr<Tile> &nullptr_tile;
 	Tile(uint16_t x, uint16_t y, uint8_t z) :
 		tilePos(x, y, z) { }
-	~Tile() override = default;
+	~Tile() override;
 
 	// non-copyable
 	Tile(const Tile &) = delete;
@@ -198,6 +198,34 @@ public:
 
 	bool hasHeight(uint32_t n) const;
 
+	/**
+	 * Whether items were added, updated or removed since the tile was created.
+	 * Modified tiles are never evicted back to the map cache.
+	 */
+	bool isModified() const {
+		return modified;
+	}
+
+	/**
+	 * Number of cleanable items added to the tile, kept on add and remove so Map::clean
+	 * can skip tiles with nothing left to clean.
+	 */
+	uint32_t getCleanableItemCount() const {
+		return cleanableItems;
+	}
+	void setCleanableItemCount(uint32_t count) {
+		cleanableItems = count;
+	}
+
+	/**
+	 * While batching, removed items are not sent one by one to the spectators,
+	 * endBatchRemove sends the whole tile once instead.
+	 */
+	void beginBatchRemove() {
+		batchRemove = true;
+	}
+	void endBatchRemove();
+
 	std::string getDescription(int32_t lookDistance) final;
 
 	int32_t getClientIndexOfCreature(const std::shared_ptr<Player> &player, const std::shared_ptr<Creature> &creature) const;
@@ -267,6 +295,8 @@ private:
 	void onUpdateTileItem(const std::shared_ptr<Item> &oldItem, const ItemType &oldType, const std::shared_ptr<Item> &newItem, const ItemType &newType);
 	void onRemoveTileItem(const CreatureVector &spectators, const std::vector<int32_t> &oldStackPosVector, const std::shared_ptr<Item> &item);
 	void onUpdateTile(const CreatureVector &spectators);
+	// Keeps cleanableItems right when a transform or replace changes whether an item is cleanable
+	void onUpdateCleanableItem(bool wasCleanable, bool isCleanable);
 
 	void setTileFlags(const std::shared_ptr<Item> &item);
 	void resetTileFlags(const std::shared_ptr<Item> &item);
@@ -278,6 +308,13 @@ protected:
 	Position tilePos;
 	uint32_t flags = 0;
 	std::unordered_set<std::shared_ptr<Zone>> zones {};
+	uint32_t cleanableItems = 0;
+	bool modified = false;
+	bool batchRemove = false;
+	// Counted by the map cache while alive
+	bool materializedFromCache = false;
+
+	friend class MapCache;
 };
 
 // Used for walkable tiles, where there is high likeliness of
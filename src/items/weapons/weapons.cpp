@@ -430,7 +430,7 @@ bool Weapon::executeUseWeapon(const std::shared_ptr<Player> &player, const LuaVa
 
 	getScriptInterface()->pushFunction(getScriptId());
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 	LuaScriptInterface::pushVariant(L, var);
 
 	return getScriptInterface()->callFunction(2);
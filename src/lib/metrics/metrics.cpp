@@ -14,6 +14,89 @@
 
 using namespace metrics;
 
+namespace {
+	struct LatencyRegistry {
+		LatencyRegistry() {
+			sites.reserve(MAX_LATENCY_SITES);
+			// The first site of each family collects the samples of sites past MAX_LATENCY_SITES
+			for (size_t family = 0; family < static_cast<size_t>(LatencyFamily::Count); ++family) {
+				sites.push_back({ static_cast<LatencyFamily>(family), "other" });
+			}
+		}
+
+		std::mutex mutex;
+		std::vector<LatencyRecorder::SiteInfo> sites;
+		phmap::flat_hash_map<std::string, uint16_t> index;
+		std::vector<std::unique_ptr<ThreadLatencies>> threads;
+	};
+
+	LatencyRegistry &getLatencyRegistry() {
+		static LatencyRegistry registry;
+		return registry;
+	}
+
+	std::string getLatencySiteKey(LatencyFamily family, std::string_view name) {
+		std::string key;
+		key.reserve(name.size() + 1);
+		key.push_back(static_cast<char>('0' + static_cast<uint8_t>(family)));
+		key.append(name);
+		return key;
+	}
+
+	// Attribute keys of the scope of each family, in latencyNames order
+	const std::array<std::string, static_cast<size_t>(LatencyFamily::Count)> latencyScopeKeys {
+		"method",
+		"scope",
+		"truncated_query",
+		"task",
+		"scope",
+	};
+
+	const std::array<std::pair<double, std::string>, 4> latencyQuantiles { {
+		{ 0.5, "0.5" },
+		{ 0.9, "0.9" },
+		{ 0.99, "0.99" },
+		{ 1.0, "max" },
+	} };
+
+	double calibrateTicksPerMicrosecond() {
+		const auto wallBegin = std::chrono::steady_clock::now();
+		const auto ticksBegin = latencyTicks();
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		const auto ticks = static_cast<double>(latencyTicks() - ticksBegin);
+		const auto micros = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wallBegin).count()) / 1000;
+		return micros > 0 && ticks > 0 ? ticks / micros : 1.0;
+	}
+
+	// Midpoint of the bucket holding the quantile, in ticks
+	double latencyQuantile(const LatencyRecorder::SiteTotals &totals, double quantile) {
+		const auto target = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(totals.count)));
+		uint64_t seen = 0;
+		for (size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+			seen += totals.buckets[bucket];
+			if (seen >= target && totals.buckets[bucket] != 0) {
+				const auto lower = static_cast<double>(latencyBucketLowerBound(bucket));
+				const auto upper = bucket + 1 < LATENCY_BUCKETS ? static_cast<double>(latencyBucketLowerBound(bucket + 1)) : lower * 1.5;
+				return (lower + upper) / 2;
+			}
+		}
+		return 0;
+	}
+
+	template <typename F>
+	void forEachFamilySite(LatencyFamily family, const std::vector<LatencyRecorder::SiteTotals> &totals, F &&f) {
+		const auto sites = LatencyRecorder::getSites();
+		const auto &scopeKey = latencyScopeKeys[static_cast<size_t>(family)];
+		for (size_t site = 0; site < totals.size() && site < sites.size(); ++site) {
+			if (sites[site].family != family || totals[site].count == 0) {
+				continue;
+			}
+			std::map<std::string, std::string> attrs { { scopeKey, sites[site].name } };
+			f(site, attrs, totals[site]);
+		}
+	}
+}
+
 Metrics &Metrics::getInstance() {
 	return inject<Metrics>();
 }
@@ -44,71 +127,164 @@ void Metrics::init(Options opts) {
 }
 
 void Metrics::initHistograms() {
-	for (auto name : latencyNames) {
-		auto instrumentSelector = metrics_sdk::InstrumentSelectorFactory::Create(metrics_sdk::InstrumentType::kHistogram, name, "us");
-		auto meterSelector = metrics_sdk::MeterSelectorFactory::Create("performance", otelVersion, otelSchema);
-
-		auto aggregationConfig = std::make_shared<metrics_sdk::HistogramAggregationConfig>();
-		// TODO: migrate to ExponentialHistogramIndexer when that's available
-		// clang-format off
-		aggregationConfig->boundaries_ = {
-			// Ultra-fine granularity below 10µs
-			0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0,
-			12.0, 14.0, 16.0, 18.0, 20.0, 22.0, 24.0, 26.0, 28.0, 30.0,
-			35.0, 40.0, 45.0, 50.0, 55.0, 60.0, 65.0, 70.0, 75.0, 80.0,
-			85.0, 90.0, 95.0, 100.0,
-			// Fine granularity between 100µs and 500µs
-			120.0, 140.0, 160.0, 180.0, 200.0, 225.0, 250.0, 275.0, 300.0, 325.0, 350.0, 375.0, 400.0, 425.0, 450.0, 475.0, 500.0,
-			// Moderate granularity from 500µs to 1ms (1000µs)
-			550.0, 600.0, 650.0, 700.0, 750.0, 800.0, 850.0, 900.0, 950.0, 1000.0,
-			// Coarser granularity for higher latencies (in microseconds)
-			1100.0, 1200.0, 1300.0, 1400.0, 1500.0, 2000.0, 2500.0, 3000.0, 3500.0, 4000.0, 4500.0, 5000.0, 10000.0,
-			// Very coarse granularity for latencies in milliseconds
-			20000.0, 30000.0, 40000.0, 50000.0, 60000.0,70000.0, 80000.0, 90000.0, 100000.0,
-			200000.0, 300000.0, 400000.0, 500000.0, 600000.0,700000.0, 800000.0, 900000.0, 1000000.0,
-			// Even coarser granularity for latencies in seconds
-			2000000.0, 3000000.0, 4000000.0, 5000000.0, 6000000.0,7000000.0, 8000000.0, 9000000.0, 10000000.0,
-			20000000.0, 30000000.0, 40000000.0, 50000000.0, 60000000.0,70000000.0, 80000000.0, 90000000.0, 100000000.0,
-			// And finally a catch-all for anything else
-			std::numeric_limits<double>::infinity(),
-		};
-		// clang-format on
-
-		auto view = metrics_sdk::ViewFactory::Create(name, "Latency", metrics_sdk::AggregationType::kHistogram, std::move(aggregationConfig));
-		auto provider = metrics_api::Provider::GetMeterProvider();
-		auto* p = static_cast<metrics_sdk::MeterProvider*>(provider.get());
-		p->AddView(std::move(instrumentSelector), std::move(meterSelector), std::move(view));
-
-		latencyHistograms[name] = getMeter()->CreateDoubleHistogram(name, "Latency", "us");
+	ticksPerMicrosecond = calibrateTicksPerMicrosecond();
+
+	const auto meter = getMeter();
+	if (!meter) {
+		return;
+	}
+
+	for (size_t family = 0; family < latencyNames.size(); ++family) {
+		const auto &name = latencyNames[family];
+		auto &observer = latencyObservers[family];
+		observer.metrics = this;
+		observer.family = static_cast<LatencyFamily>(family);
+
+		auto count = meter->CreateInt64ObservableCounter(name + "_count", "Latency samples", "1");
+		count->AddCallback(observeLatencyCount, &observer);
+		auto sum = meter->CreateDoubleObservableCounter(name + "_sum", "Total latency", "us");
+		sum->AddCallback(observeLatencySum, &observer);
+		auto quantiles = meter->CreateDoubleObservableGauge(name, "Latency quantiles since the previous export", "us");
+		quantiles->AddCallback(observeLatencyQuantiles, &observer);
+
+		latencyInstruments.emplace_back(std::move(count));
+		latencyInstruments.emplace_back(std::move(sum));
+		latencyInstruments.emplace_back(std::move(quantiles));
 	}
+
+	LatencyRecorder::setEnabled(true);
+}
+
+void Metrics::observeLatencyCount(metrics_api::ObserverResult result, void* state) {
+	const auto &observer = *static_cast<LatencyObserver*>(state);
+	const auto &observerResult = opentelemetry::nostd::get<opentelemetry::nostd::shared_ptr<metrics_api::ObserverResultT<int64_t>>>(result);
+	forEachFamilySite(observer.family, LatencyRecorder::collect(), [&](size_t, const auto &attrs, const LatencyRecorder::SiteTotals &totals) {
+		observerResult->Observe(static_cast<int64_t>(totals.count), opentelemetry::common::KeyValueIterableView<std::map<std::string, std::string>> { attrs });
+	});
+}
+
+void Metrics::observeLatencySum(metrics_api::ObserverResult result, void* state) {
+	const auto &observer = *static_cast<LatencyObserver*>(state);
+	const auto ticksPerMicrosecond = observer.metrics->ticksPerMicrosecond;
+	const auto &observerResult = opentelemetry::nostd::get<opentelemetry::nostd::shared_ptr<metrics_api::ObserverResultT<double>>>(result);
+	forEachFamilySite(observer.family, LatencyRecorder::collect(), [&](size_t, const auto &attrs, const LatencyRecorder::SiteTotals &totals) {
+		observerResult->Observe(static_cast<double>(totals.ticks) / ticksPerMicrosecond, opentelemetry::common::KeyValueIterableView<std::map<std::string, std::string>> { attrs });
+	});
+}
+
+void Metrics::observeLatencyQuantiles(metrics_api::ObserverResult result, void* state) {
+	auto &observer = *static_cast<LatencyObserver*>(state);
+	std::scoped_lock lock(observer.metrics->latencyMutex);
+
+	const auto ticksPerMicrosecond = observer.metrics->ticksPerMicrosecond;
+	const auto &observerResult = opentelemetry::nostd::get<opentelemetry::nostd::shared_ptr<metrics_api::ObserverResultT<double>>>(result);
+	const auto totals = LatencyRecorder::collect();
+	observer.previous.resize(totals.size());
+
+	forEachFamilySite(observer.family, totals, [&](size_t site, auto attrs, const LatencyRecorder::SiteTotals &current) {
+		auto &previous = observer.previous[site];
+		if (current.count == previous.count) {
+			return;
+		}
+
+		LatencyRecorder::SiteTotals window;
+		for (size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+			window.buckets[bucket] = current.buckets[bucket] - previous.buckets[bucket];
+		}
+		window.count = current.count - previous.count;
+		previous = current;
+
+		for (const auto &[quantile, label] : latencyQuantiles) {
+			attrs["quantile"] = label;
+			observerResult->Observe(latencyQuantile(window, quantile) / ticksPerMicrosecond, opentelemetry::common::KeyValueIterableView<std::map<std::string, std::string>> { attrs });
+		}
+	});
 }
 
 void Metrics::shutdown() {
+	LatencyRecorder::setEnabled(false);
 	std::shared_ptr<metrics_api::MeterProvider> none;
 	metrics_api::Provider::SetMeterProvider(none);
 }
 
-ScopedLatency::ScopedLatency(std::string_view name, const std::string &histogramName, const std::string &scopeKey) :
-	ScopedLatency(name, g_metrics().latencyHistograms[histogramName], { { scopeKey, std::string(name) } }, g_metrics().defaultContext) {
-	if (histogram == nullptr) {
-		stopped = true;
-		return;
+ThreadLatencies::~ThreadLatencies() {
+	for (auto &site : sites) {
+		delete site.load(std::memory_order_acquire);
 	}
 }
 
-ScopedLatency::~ScopedLatency() {
-	stop();
+uint16_t LatencyRecorder::registerSite(LatencyFamily family, std::string_view name) {
+	auto &registry = getLatencyRegistry();
+	std::scoped_lock lock(registry.mutex);
+	auto key = getLatencySiteKey(family, name);
+	if (const auto it = registry.index.find(key); it != registry.index.end()) {
+		return it->second;
+	}
+
+	if (registry.sites.size() >= MAX_LATENCY_SITES) {
+		return static_cast<uint16_t>(family);
+	}
+
+	registry.sites.push_back({ family, std::string(name) });
+	const auto site = static_cast<uint16_t>(registry.sites.size() - 1);
+	registry.index.emplace(std::move(key), site);
+	return site;
 }
 
-void ScopedLatency::stop() {
-	if (stopped) {
-		return;
+uint16_t LatencyRecorder::getSite(LatencyFamily family, std::string_view name) {
+	thread_local std::array<phmap::flat_hash_map<std::string, uint16_t>, static_cast<size_t>(LatencyFamily::Count)> cache;
+	auto &familyCache = cache[static_cast<size_t>(family)];
+	if (const auto it = familyCache.find(name); it != familyCache.end()) {
+		return it->second;
 	}
-	stopped = true;
-	auto end = std::chrono::steady_clock::now();
-	double elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / 1000;
-	auto attrskv = opentelemetry::common::KeyValueIterableView<decltype(attrs)> { attrs };
-	histogram->Record(elapsed, attrskv, context);
+
+	const auto site = registerSite(family, name);
+	if (familyCache.size() < MAX_LATENCY_SITES) {
+		familyCache.emplace(name, site);
+	}
+	return site;
+}
+
+ThreadLatencies* LatencyRecorder::registerThread() {
+	auto &registry = getLatencyRegistry();
+	std::scoped_lock lock(registry.mutex);
+	// Kept after the thread exits, its samples still count towards the totals
+	return registry.threads.emplace_back(std::make_unique<ThreadLatencies>()).get();
+}
+
+LatencyHistogram* LatencyRecorder::createHistogram(uint16_t site) {
+	auto* histogram = new LatencyHistogram();
+	local->sites[site].store(histogram, std::memory_order_release);
+	return histogram;
+}
+
+std::vector<LatencyRecorder::SiteTotals> LatencyRecorder::collect() {
+	auto &registry = getLatencyRegistry();
+	std::scoped_lock lock(registry.mutex);
+	std::vector<SiteTotals> totals(registry.sites.size());
+	for (const auto &thread : registry.threads) {
+		for (size_t site = 0; site < totals.size(); ++site) {
+			const auto* histogram = thread->sites[site].load(std::memory_order_acquire);
+			if (!histogram) {
+				continue;
+			}
+
+			auto &siteTotals = totals[site];
+			for (size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+				const auto samples = histogram->buckets[bucket].load(std::memory_order_relaxed);
+				siteTotals.buckets[bucket] += samples;
+				siteTotals.count += samples;
+			}
+			siteTotals.ticks += histogram->ticks.load(std::memory_order_relaxed);
+		}
+	}
+	return totals;
+}
+
+std::vector<LatencyRecorder::SiteInfo> LatencyRecorder::getSites() {
+	auto &registry = getLatencyRegistry();
+	std::scoped_lock lock(registry.mutex);
+	return registry.sites;
 }
 
 #endif // FEATURE_METRICS
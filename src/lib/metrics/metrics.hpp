@@ -26,6 +26,10 @@
 	#include <opentelemetry/sdk/metrics/view/instrument_selector_factory.h>
 	#include <opentelemetry/sdk/metrics/view/meter_selector_factory.h>
 	#include <opentelemetry/sdk/metrics/view/view_factory.h>
+	#include <bit>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#endif
 
 namespace metrics_sdk = opentelemetry::sdk::metrics;
 namespace common = opentelemetry::common;
@@ -52,46 +56,187 @@ namespace metrics {
 		metrics_exporter::PrometheusExporterOptions prometheusOptions;
 	};
 
-	class ScopedLatency {
+	enum class LatencyFamily : uint8_t {
+		Method,
+		Lua,
+		Query,
+		Task,
+		Lock,
+		Count
+	};
+
+	const std::vector<std::string> latencyNames {
+		"method_latency",
+		"lua_latency",
+		"query_latency",
+		"task_latency",
+		"lock_latency",
+	};
+
+	// Call sites beyond this are recorded into the "other" site of their family
+	static constexpr size_t MAX_LATENCY_SITES = 4096;
+	// Two buckets per power of two ticks
+	static constexpr size_t LATENCY_BUCKETS = 96;
+
+	/**
+	 * Cheap monotonic timestamp, the cycle counter where available.
+	 * Converted to microseconds only when the histograms are exported.
+	 */
+	inline uint64_t latencyTicks() noexcept {
+	#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		return __rdtsc();
+	#elif defined(__x86_64__) || defined(__i386__)
+		return __builtin_ia32_rdtsc();
+	#else
+		return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+	#endif
+	}
+
+	constexpr size_t latencyBucket(uint64_t ticks) noexcept {
+		if (ticks < 2) {
+			return static_cast<size_t>(ticks);
+		}
+		const auto msb = static_cast<size_t>(std::bit_width(ticks) - 1);
+		const auto half = static_cast<size_t>((ticks >> (msb - 1)) & 1);
+		return std::min(msb * 2 + half, LATENCY_BUCKETS - 1);
+	}
+
+	constexpr uint64_t latencyBucketLowerBound(size_t bucket) noexcept {
+		if (bucket < 2) {
+			return bucket;
+		}
+		const size_t msb = bucket / 2;
+		return (uint64_t { 1 } << msb) + (bucket % 2) * (uint64_t { 1 } << (msb - 1));
+	}
+
+	/**
+	 * Log bucketed histogram of a single call site, owned and written by a single thread.
+	 * Counters only grow, so the exporter can read them at any time without resetting them.
+	 */
+	struct LatencyHistogram {
+		std::array<std::atomic<uint64_t>, LATENCY_BUCKETS> buckets {};
+		std::atomic<uint64_t> ticks { 0 };
+	};
+
+	struct ThreadLatencies {
+		~ThreadLatencies();
+
+		std::array<std::atomic<LatencyHistogram*>, MAX_LATENCY_SITES> sites {};
+	};
+
+	class LatencyRecorder {
 	public:
-		explicit ScopedLatency(std::string_view name, const std::string &histogramName, const std::string &scopeKey);
-		explicit ScopedLatency([[maybe_unused]] std::string_view name, Histogram<double> &histogram, std::map<std::string, std::string> attrs = {}, opentelemetry::context::Context context = opentelemetry::context::Context()) :
-			begin(std::chrono::steady_clock::now()), histogram(histogram), attrs(std::move(attrs)), context(std::move(context)) {
+		/**
+		 * Registers a call site, used once per site through a function local static.
+		 */
+		static uint16_t registerSite(LatencyFamily family, std::string_view name);
+		/**
+		 * Call site of a runtime name (lua scope, query, task context), cached per thread.
+		 */
+		static uint16_t getSite(LatencyFamily family, std::string_view name);
+
+		static void record(uint16_t site, uint64_t ticks) noexcept {
+			LatencyHistogram* histogram = getHistogram(site);
+			// Single writer, so plain loads and stores are enough
+			auto &bucket = histogram->buckets[latencyBucket(ticks)];
+			bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			histogram->ticks.store(histogram->ticks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
 		}
 
-		void stop();
+		static bool isEnabled() noexcept {
+			return enabled.load(std::memory_order_relaxed);
+		}
 
-		~ScopedLatency();
+		static void setEnabled(bool value) noexcept {
+			enabled.store(value, std::memory_order_relaxed);
+		}
+
+		struct SiteTotals {
+			std::array<uint64_t, LATENCY_BUCKETS> buckets {};
+			uint64_t count = 0;
+			uint64_t ticks = 0;
+		};
+
+		struct SiteInfo {
+			LatencyFamily family;
+			std::string name;
+		};
+
+		/**
+		 * Sums the histograms of every thread, indexed by site.
+		 */
+		static std::vector<SiteTotals> collect();
+		static std::vector<SiteInfo> getSites();
 
 	private:
-		std::chrono::steady_clock::time_point begin;
-		Histogram<double> &histogram;
-		std::map<std::string, std::string> attrs;
-		opentelemetry::context::Context context;
-		bool stopped { false };
+		static LatencyHistogram* getHistogram(uint16_t site) noexcept {
+			if (!local) {
+				local = registerThread();
+			}
+			LatencyHistogram* histogram = local->sites[site].load(std::memory_order_relaxed);
+			if (!histogram) {
+				histogram = createHistogram(site);
+			}
+			return histogram;
+		}
+
+		static ThreadLatencies* registerThread();
+		static LatencyHistogram* createHistogram(uint16_t site);
+
+		static inline std::atomic<bool> enabled { false };
+		static inline thread_local ThreadLatencies* local = nullptr;
 	};
 
-	#define DEFINE_LATENCY_CLASS(class_name, histogram_name, category)       \
-		class class_name##_latency final : public ScopedLatency {            \
-		public:                                                              \
-			class_name##_latency(std::string_view name) :                    \
-				ScopedLatency(name, histogram_name "_latency", category) { } \
+	class ScopedLatency {
+	public:
+		explicit ScopedLatency(uint16_t site) noexcept :
+			begin(LatencyRecorder::isEnabled() ? latencyTicks() : 0), site(site), stopped(!LatencyRecorder::isEnabled()) { }
+		explicit ScopedLatency(LatencyFamily family, std::string_view name) :
+			ScopedLatency(LatencyRecorder::isEnabled() ? LatencyRecorder::getSite(family, name) : uint16_t { 0 }) { }
+
+		void stop() noexcept {
+			if (stopped) {
+				return;
+			}
+			stopped = true;
+			LatencyRecorder::record(site, latencyTicks() - begin);
 		}
 
-	DEFINE_LATENCY_CLASS(method, "method", "method");
-	DEFINE_LATENCY_CLASS(lua, "lua", "scope");
-	DEFINE_LATENCY_CLASS(query, "query", "truncated_query");
-	DEFINE_LATENCY_CLASS(task, "task", "task");
-	DEFINE_LATENCY_CLASS(lock, "lock", "scope");
+		~ScopedLatency() {
+			stop();
+		}
 
-	const std::vector<std::string> latencyNames {
-		"method_latency",
-		"lua_latency",
-		"query_latency",
-		"task_latency",
-		"lock_latency",
+	private:
+		uint64_t begin;
+		uint16_t site;
+		bool stopped;
 	};
 
+	#define DEFINE_LATENCY_CLASS(class_name, family)                                        \
+		class class_name##_latency final : public ScopedLatency {                          \
+		public:                                                                            \
+			explicit class_name##_latency(uint16_t site) noexcept :                        \
+				ScopedLatency(site) { }                                                    \
+			explicit class_name##_latency(std::string_view name) :                         \
+				ScopedLatency(family, name) { }                                            \
+		}
+
+	DEFINE_LATENCY_CLASS(method, LatencyFamily::Method);
+	DEFINE_LATENCY_CLASS(lua, LatencyFamily::Lua);
+	DEFINE_LATENCY_CLASS(query, LatencyFamily::Query);
+	DEFINE_LATENCY_CLASS(task, LatencyFamily::Task);
+	DEFINE_LATENCY_CLASS(lock, LatencyFamily::Lock);
+
+	// Measures the enclosing function, the call site is registered once on its first call
+	#define METRICS_METHOD_LATENCY(var)                                                                                                      \
+		static const uint16_t var##_site = metrics::LatencyRecorder::registerSite(metrics::LatencyFamily::Method, __METRICS_METHOD_NAME__); \
+		metrics::method_latency var(var##_site)
+
+	// Same for a part of a function, measured under the given name
+	#define METRICS_METHOD_LATENCY_NAMED(var, name)                                                                          \
+		static const uint16_t var##_site = metrics::LatencyRecorder::registerSite(metrics::LatencyFamily::Method, name); \
+		metrics::method_latency var(var##_site)
+
 	class Metrics final {
 	public:
 		Metrics() = default;
@@ -129,11 +274,21 @@ namespace metrics {
 			upDownCounters[name]->Add(value, attrskv);
 		}
 
-		friend class ScopedLatency;
-
 	protected:
-		opentelemetry::context::Context defaultContext {};
-		phmap::parallel_flat_hash_map<std::string, Histogram<double>> latencyHistograms;
+		struct LatencyObserver {
+			Metrics* metrics;
+			LatencyFamily family;
+			std::vector<LatencyRecorder::SiteTotals> previous;
+		};
+
+		static void observeLatencyCount(metrics_api::ObserverResult result, void* state);
+		static void observeLatencySum(metrics_api::ObserverResult result, void* state);
+		static void observeLatencyQuantiles(metrics_api::ObserverResult result, void* state);
+
+		double ticksPerMicrosecond = 1.0;
+		std::mutex latencyMutex;
+		std::array<LatencyObserver, static_cast<size_t>(LatencyFamily::Count)> latencyObservers {};
+		std::vector<opentelemetry::nostd::shared_ptr<metrics_api::ObservableInstrument>> latencyInstruments;
 		phmap::flat_hash_map<std::string, UpDownCounter<int64_t>> upDownCounters;
 		phmap::flat_hash_map<std::string, Counter<double>> counters;
 
@@ -168,8 +323,8 @@ struct Options {
 
 class ScopedLatency {
 public:
-	explicit ScopedLatency([[maybe_unused]] std::string_view name, [[maybe_unused]] const std::string &histogramName, [[maybe_unused]] const std::string &scopeKey) {};
-	explicit ScopedLatency([[maybe_unused]] std::string_view name, [[maybe_unused]] std::set<double> &histogram, [[maybe_unused]] const std::map<std::string, std::string> &attrs = {}, [[maybe_unused]] const std::string &context = std::string()) {};
+	explicit ScopedLatency([[maybe_unused]] uint16_t site) noexcept {};
+	explicit ScopedLatency([[maybe_unused]] std::string_view name) noexcept {};
 
 	void stop() const {};
 
@@ -177,18 +332,23 @@ public:
 };
 
 namespace metrics {
-	#define DEFINE_LATENCY_CLASS(class_name, histogram_name, category)       \
-		class class_name##_latency final : public ScopedLatency {            \
-		public:                                                              \
-			class_name##_latency(std::string_view name) :                    \
-				ScopedLatency(name, histogram_name "_latency", category) { } \
+	#define DEFINE_LATENCY_CLASS(class_name)                         \
+		class class_name##_latency final : public ScopedLatency {    \
+		public:                                                      \
+			explicit class_name##_latency(uint16_t site) noexcept :  \
+				ScopedLatency(site) { }                              \
+			explicit class_name##_latency(std::string_view name) :   \
+				ScopedLatency(name) { }                              \
 		}
 
-	DEFINE_LATENCY_CLASS(method, "method", "method");
-	DEFINE_LATENCY_CLASS(lua, "lua", "scope");
-	DEFINE_LATENCY_CLASS(query, "query", "truncated_query");
-	DEFINE_LATENCY_CLASS(task, "task", "task");
-	DEFINE_LATENCY_CLASS(lock, "lock", "scope");
+	DEFINE_LATENCY_CLASS(method);
+	DEFINE_LATENCY_CLASS(lua);
+	DEFINE_LATENCY_CLASS(query);
+	DEFINE_LATENCY_CLASS(task);
+	DEFINE_LATENCY_CLASS(lock);
+
+	#define METRICS_METHOD_LATENCY(var) metrics::method_latency var(uint16_t { 0 })
+	#define METRICS_METHOD_LATENCY_NAMED(var, name) metrics::method_latency var(uint16_t { 0 })
 
 	const std::vector<std::string> latencyNames {
 		"method_latency",
@@ -11,6 +11,8 @@
 
 #include "creatures/players/grouping/party.hpp"
 #include "creatures/players/player.hpp"
+#include "creatures/monsters/monster.hpp"
+#include "creatures/npcs/npc.hpp"
 #include "creatures/creatures_definitions.hpp"
 #include "game/movement/position.hpp"
 #include "game/zones/zone.hpp"
@@ -105,6 +107,98 @@ void EventCallback::setType(EventCallback_t type) {
 	m_callbackType = type;
 }
 
+void EventCallback::addItemIdFilter(uint16_t fromId, uint16_t toId) {
+	m_filter.itemIdRanges.emplace_back(std::min(fromId, toId), std::max(fromId, toId));
+}
+
+void EventCallback::addCreatureTypeFilter(CreatureType_t type) {
+	m_filter.creatureTypes |= static_cast<uint8_t>(1 << type);
+}
+
+bool EventCallback::matchesFilter(const FilterSubject &subject) const {
+	if (!m_filter.itemIdRanges.empty() && subject.hasItemArgument) {
+		if (!subject.itemId) {
+			return false;
+		}
+
+		const auto itemId = *subject.itemId;
+		const bool inRange = std::ranges::any_of(m_filter.itemIdRanges, [itemId](const auto &range) {
+			return itemId >= range.first && itemId <= range.second;
+		});
+		if (!inRange) {
+			return false;
+		}
+	}
+
+	if (m_filter.creatureTypes != 0 && subject.hasCreatureArgument) {
+		if (!subject.creatureType || (m_filter.creatureTypes & (1 << *subject.creatureType)) == 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void EventCallback::setFilterItemId(uint16_t itemId, FilterSubject &subject) {
+	if (!subject.hasItemArgument) {
+		subject.hasItemArgument = true;
+		subject.itemId = itemId;
+	}
+}
+
+void EventCallback::setFilterCreature(const std::shared_ptr<Creature> &creature, FilterSubject &subject) {
+	if (!subject.hasCreatureArgument) {
+		subject.hasCreatureArgument = true;
+		if (creature) {
+			subject.creatureType = creature->getType();
+		}
+	}
+}
+
+void EventCallback::inspectFilterArgument(const std::shared_ptr<Item> &item, FilterSubject &subject) {
+	if (item) {
+		setFilterItemId(item->getID(), subject);
+	} else {
+		subject.hasItemArgument = true;
+	}
+}
+
+void EventCallback::inspectFilterArgument(const std::shared_ptr<Container> &container, FilterSubject &subject) {
+	inspectFilterArgument(std::static_pointer_cast<Item>(container), subject);
+}
+
+void EventCallback::inspectFilterArgument(const ItemType* itemType, FilterSubject &subject) {
+	if (itemType) {
+		setFilterItemId(itemType->id, subject);
+	} else {
+		subject.hasItemArgument = true;
+	}
+}
+
+void EventCallback::inspectFilterArgument(const std::shared_ptr<Thing> &thing, FilterSubject &subject) {
+	if (!thing) {
+		return;
+	}
+
+	if (const auto &item = thing->getItem()) {
+		inspectFilterArgument(item, subject);
+	} else if (const auto &creature = thing->getCreature()) {
+		setFilterCreature(creature, subject);
+	}
+}
+
+void EventCallback::inspectFilterArgument(const std::shared_ptr<Creature> &creature, FilterSubject &subject) {
+	setFilterCreature(creature, subject);
+}
+
+void EventCallback::inspectFilterArgument(const std::shared_ptr<Monster> &monster, FilterSubject &subject) {
+	setFilterCreature(monster, subject);
+}
+
+void EventCallback::inspectFilterArgument(const std::shared_ptr<Npc> &npc, FilterSubject &subject) {
+	setFilterCreature(npc, subject);
+}
+
 void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Player> &player) {
 	if (player) {
 		Lua::pushUserdata<Player>(L, player);
@@ -135,7 +229,7 @@ void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Creature> &
 void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Party> &party) {
 	if (party) {
 		Lua::pushUserdata<Party>(L, party);
-		Lua::setMetatable(L, -1, "Party");
+		Lua::setMetatable(L, -1, LuaData_t::Party);
 	} else {
 		lua_pushnil(L);
 	}
@@ -144,7 +238,7 @@ void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Party> &par
 void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Monster> &monster) {
 	if (monster) {
 		Lua::pushUserdata<Monster>(L, monster);
-		Lua::setMetatable(L, -1, "Monster");
+		Lua::setMetatable(L, -1, LuaData_t::Monster);
 	} else {
 		lua_pushnil(L);
 	}
@@ -153,7 +247,7 @@ void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Monster> &m
 void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Container> &container) {
 	if (container) {
 		Lua::pushUserdata<Container>(L, container);
-		Lua::setMetatable(L, -1, "Container");
+		Lua::setMetatable(L, -1, LuaData_t::Container);
 	} else {
 		lua_pushnil(L);
 	}
@@ -171,7 +265,7 @@ void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Zone> &zone
 void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Tile> &tile) {
 	if (tile) {
 		Lua::pushUserdata<Tile>(L, tile);
-		Lua::setMetatable(L, -1, "Tile");
+		Lua::setMetatable(L, -1, LuaData_t::Tile);
 	} else {
 		lua_pushnil(L);
 	}
@@ -196,7 +290,7 @@ void EventCallback::pushArgument(lua_State* L, const std::shared_ptr<Cylinder> &
 void EventCallback::pushArgument(lua_State* L, const ItemType* itemType) {
 	if (itemType) {
 		Lua::pushUserdata<const ItemType>(L, itemType);
-		Lua::setMetatable(L, -1, "ItemType");
+		Lua::setMetatable(L, -1, LuaData_t::ItemType);
 	} else {
 		lua_pushnil(L);
 	}
@@ -47,6 +47,36 @@ enum skills_t : int8_t;
 enum CombatType_t : uint8_t;
 enum CombatOrigin : uint8_t;
 enum TextColor_t : uint8_t;
+enum CreatureType_t : uint8_t;
+
+/**
+ * @struct EventCallbackFilter
+ * @brief Declarative pre-filter of an event callback, evaluated in C++ before entering Lua.
+ *
+ * @details The item id ranges are matched against the first item argument of the event and the creature
+ * types against its first Creature, Monster, Npc or Thing argument. Player arguments are skipped, but a player
+ * passed as a Creature or Thing is matched as CREATURETYPE_PLAYER. A callback whose arguments don't match is
+ * skipped, as if it had returned true. Events without such an argument ignore that part of the filter.
+ */
+struct EventCallbackFilter {
+	std::vector<std::pair<uint16_t, uint16_t>> itemIdRanges;
+	uint8_t creatureTypes = 0; ///< Bitmask of CreatureType_t.
+
+	[[nodiscard]] bool empty() const noexcept {
+		return itemIdRanges.empty() && creatureTypes == 0;
+	}
+};
+
+/**
+ * @struct EventCallbackStats
+ * @brief Invocation counters of an event callback.
+ */
+struct EventCallbackStats {
+	uint64_t calls = 0; ///< Number of times the Lua handler was entered.
+	uint64_t filtered = 0; ///< Number of times the pre-filter skipped the Lua handler.
+	uint64_t totalMicroseconds = 0;
+	uint64_t maxMicroseconds = 0;
+};
 
 /**
  * @class EventCallback
@@ -67,6 +97,34 @@ private:
 	bool m_enabled = true;
 	int32_t m_priority = 0;
 	LuaScriptInterface* m_scriptInterface = nullptr; ///< Non-owning pointer to script interface.
+	EventCallbackFilter m_filter;
+	mutable EventCallbackStats m_stats;
+
+	/**
+	 * @brief What the pre-filter is matched against, taken from the event arguments.
+	 */
+	struct FilterSubject {
+		bool hasItemArgument = false;
+		bool hasCreatureArgument = false;
+		std::optional<uint16_t> itemId;
+		std::optional<CreatureType_t> creatureType;
+	};
+
+	template <typename... Args>
+	[[nodiscard]] bool matchesFilter(const Args &... args) const;
+	[[nodiscard]] bool matchesFilter(const FilterSubject &subject) const;
+
+	template <typename ArgT>
+	static void inspectFilterArgument(const ArgT &arg, FilterSubject &subject);
+	static void inspectFilterArgument(const std::shared_ptr<Item> &item, FilterSubject &subject);
+	static void inspectFilterArgument(const std::shared_ptr<Container> &container, FilterSubject &subject);
+	static void inspectFilterArgument(const ItemType* itemType, FilterSubject &subject);
+	static void inspectFilterArgument(const std::shared_ptr<Thing> &thing, FilterSubject &subject);
+	static void inspectFilterArgument(const std::shared_ptr<Creature> &creature, FilterSubject &subject);
+	static void inspectFilterArgument(const std::shared_ptr<Monster> &monster, FilterSubject &subject);
+	static void inspectFilterArgument(const std::shared_ptr<Npc> &npc, FilterSubject &subject);
+	static void setFilterItemId(uint16_t itemId, FilterSubject &subject);
+	static void setFilterCreature(const std::shared_ptr<Creature> &creature, FilterSubject &subject);
 
 	struct DamageRef {
 		CombatDamage* damage;
@@ -143,6 +201,26 @@ public:
 	template <typename... Args>
 	[[nodiscard]] bool execute(Args &&... args) const;
 
+	/**
+	 * @brief Only enters Lua when the first item argument has an id within [fromId, toId].
+	 * @details Can be called several times to accept several ranges.
+	 */
+	void addItemIdFilter(uint16_t fromId, uint16_t toId);
+
+	/**
+	 * @brief Only enters Lua when the first Creature, Monster, Npc or Thing argument is of the given type.
+	 * @details Can be called several times to accept several types.
+	 */
+	void addCreatureTypeFilter(CreatureType_t type);
+
+	[[nodiscard]] const EventCallbackFilter &getFilter() const noexcept {
+		return m_filter;
+	}
+
+	[[nodiscard]] const EventCallbackStats &getStats() const noexcept {
+		return m_stats;
+	}
+
 	/**
 	 * @brief Retrieves the callback name.
 	 * @return The callback name as a string.
@@ -191,6 +269,10 @@ template <typename... Args>
 	if (!canExecute()) {
 		return false;
 	}
+	if (!matchesFilter(args...)) {
+		++m_stats.filtered;
+		return true;
+	}
 	if (!Lua::reserveScriptEnv()) {
 		g_logger().error("[EventCallback::execute] Call stack overflow. Too many lua script calls being nested.");
 		return false;
@@ -205,6 +287,8 @@ template <typename... Args>
 		return false;
 	}
 
+	const auto start = std::chrono::steady_clock::now();
+
 	std::vector<DamageRef> damageRefs;
 	int argc = 0;
 	(pushCallbackArgument(L, std::forward<Args>(args), damageRefs, argc), ...);
@@ -213,9 +297,34 @@ template <typename... Args>
 
 	applyDamageReferences(L, damageRefs);
 
+	const auto elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+	++m_stats.calls;
+	m_stats.totalMicroseconds += elapsed;
+	m_stats.maxMicroseconds = std::max(m_stats.maxMicroseconds, elapsed);
+
 	return result;
 }
 
+template <typename... Args>
+bool EventCallback::matchesFilter(const Args &... args) const {
+	if (m_filter.empty()) {
+		return true;
+	}
+
+	FilterSubject subject;
+	(inspectFilterArgument(args, subject), ...);
+	return matchesFilter(subject);
+}
+
+template <typename ArgT>
+void EventCallback::inspectFilterArgument(const ArgT &arg, FilterSubject &subject) {
+	// Only reached by the arguments the filter doesn't look at, players included: they are the acting side of the player events.
+	// Mutable item types would prefer this template over the const overload, so they are forwarded to it.
+	if constexpr (std::is_same_v<std::remove_cvref_t<ArgT>, ItemType*>) {
+		inspectFilterArgument(static_cast<const ItemType*>(arg), subject);
+	}
+}
+
 template <typename ArgT>
 void EventCallback::pushCallbackArgument(lua_State* L, ArgT &&arg, std::vector<DamageRef> &damageRefs, int &argc) {
 	using ValueT = std::remove_cvref_t<ArgT>;
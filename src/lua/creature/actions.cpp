@@ -565,7 +565,7 @@ bool Action::executeUse(const std::shared_ptr<Player> &player, const std::shared
 	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushThing(L, item);
 	LuaScriptInterface::pushPosition(L, fromPosition);
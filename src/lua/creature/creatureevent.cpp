@@ -212,7 +212,7 @@ bool CreatureEvent::executeOnLogin(const std::shared_ptr<Player> &player) const
 
 	getScriptInterface()->pushFunction(getScriptId());
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 	return getScriptInterface()->callFunction(1);
 }
 
@@ -232,7 +232,7 @@ bool CreatureEvent::executeOnLogout(const std::shared_ptr<Player> &player) const
 
 	getScriptInterface()->pushFunction(getScriptId());
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 	return getScriptInterface()->callFunction(1);
 }
 
@@ -345,7 +345,7 @@ bool CreatureEvent::executeAdvance(const std::shared_ptr<Player> &player, skills
 
 	getScriptInterface()->pushFunction(getScriptId());
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 	lua_pushnumber(L, static_cast<uint32_t>(skill));
 	lua_pushnumber(L, oldLevel);
 	lua_pushnumber(L, newLevel);
@@ -399,7 +399,7 @@ void CreatureEvent::executeModalWindow(const std::shared_ptr<Player> &player, ui
 	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, modalWindowId);
 	lua_pushnumber(L, buttonId);
@@ -424,7 +424,7 @@ bool CreatureEvent::executeTextEdit(const std::shared_ptr<Player> &player, const
 	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushThing(L, item);
 	LuaScriptInterface::pushString(L, text);
@@ -535,7 +535,7 @@ void CreatureEvent::executeExtendedOpcode(const std::shared_ptr<Player> &player,
 	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, opcode);
 	LuaScriptInterface::pushString(L, buffer);
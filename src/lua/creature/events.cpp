@@ -204,7 +204,7 @@ ReturnValue Events::eventCreatureOnAreaCombat(const std::shared_ptr<Creature> &c
 	}
 
 	LuaScriptInterface::pushUserdata<Tile>(L, tile);
-	LuaScriptInterface::setMetatable(L, -1, "Tile");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Tile);
 
 	LuaScriptInterface::pushBoolean(L, aggressive);
 
@@ -341,10 +341,10 @@ bool Events::eventPartyOnJoin(const std::shared_ptr<Party> &party, const std::sh
 	scriptInterface.pushFunction(info.partyOnJoin);
 
 	LuaScriptInterface::pushUserdata<Party>(L, party);
-	LuaScriptInterface::setMetatable(L, -1, "Party");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Party);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	return scriptInterface.callFunction(2);
 }
@@ -370,10 +370,10 @@ bool Events::eventPartyOnLeave(const std::shared_ptr<Party> &party, const std::s
 	scriptInterface.pushFunction(info.partyOnLeave);
 
 	LuaScriptInterface::pushUserdata<Party>(L, party);
-	LuaScriptInterface::setMetatable(L, -1, "Party");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Party);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	return scriptInterface.callFunction(2);
 }
@@ -398,7 +398,7 @@ bool Events::eventPartyOnDisband(const std::shared_ptr<Party> &party) {
 	scriptInterface.pushFunction(info.partyOnDisband);
 
 	LuaScriptInterface::pushUserdata<Party>(L, party);
-	LuaScriptInterface::setMetatable(L, -1, "Party");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Party);
 
 	return scriptInterface.callFunction(1);
 }
@@ -421,7 +421,7 @@ void Events::eventPartyOnShareExperience(const std::shared_ptr<Party> &party, ui
 	scriptInterface.pushFunction(info.partyOnShareExperience);
 
 	LuaScriptInterface::pushUserdata<Party>(L, party);
-	LuaScriptInterface::setMetatable(L, -1, "Party");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Party);
 
 	lua_pushnumber(L, exp);
 
@@ -457,7 +457,7 @@ bool Events::eventPlayerOnBrowseField(const std::shared_ptr<Player> &player, con
 	scriptInterface.pushFunction(info.playerOnBrowseField);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushPosition(L, position);
 
@@ -485,7 +485,7 @@ void Events::eventPlayerOnLook(const std::shared_ptr<Player> &player, const Posi
 	scriptInterface.pushFunction(info.playerOnLook);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	if (const std::shared_ptr<Creature> &creature = thing->getCreature()) {
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
@@ -524,7 +524,7 @@ void Events::eventPlayerOnLookInBattleList(const std::shared_ptr<Player> &player
 	scriptInterface.pushFunction(info.playerOnLookInBattleList);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -555,10 +555,10 @@ void Events::eventPlayerOnLookInTrade(const std::shared_ptr<Player> &player, con
 	scriptInterface.pushFunction(info.playerOnLookInTrade);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Player>(L, partner);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -589,10 +589,10 @@ bool Events::eventPlayerOnLookInShop(const std::shared_ptr<Player> &player, cons
 	scriptInterface.pushFunction(info.playerOnLookInShop);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<const ItemType>(L, itemType);
-	LuaScriptInterface::setMetatable(L, -1, "ItemType");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::ItemType);
 
 	lua_pushnumber(L, count);
 
@@ -620,7 +620,7 @@ bool Events::eventPlayerOnRemoveCount(const std::shared_ptr<Player> &player, con
 	scriptInterface.pushFunction(info.playerOnRemoveCount);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -649,7 +649,7 @@ bool Events::eventPlayerOnMoveItem(const std::shared_ptr<Player> &player, const
 	scriptInterface.pushFunction(info.playerOnMoveItem);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -685,7 +685,7 @@ void Events::eventPlayerOnItemMoved(const std::shared_ptr<Player> &player, const
 	scriptInterface.pushFunction(info.playerOnItemMoved);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -721,7 +721,7 @@ void Events::eventPlayerOnChangeZone(const std::shared_ptr<Player> &player, Zone
 	scriptInterface.pushFunction(info.playerOnChangeZone);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, zone);
 	scriptInterface.callVoidFunction(2);
@@ -748,7 +748,7 @@ bool Events::eventPlayerOnMoveCreature(const std::shared_ptr<Player> &player, co
 	scriptInterface.pushFunction(info.playerOnMoveCreature);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -780,7 +780,7 @@ void Events::eventPlayerOnReportRuleViolation(const std::shared_ptr<Player> &pla
 	scriptInterface.pushFunction(info.playerOnReportRuleViolation);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushString(L, targetName);
 
@@ -814,7 +814,7 @@ bool Events::eventPlayerOnReportBug(const std::shared_ptr<Player> &player, const
 	scriptInterface.pushFunction(info.playerOnReportBug);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushString(L, message);
 	LuaScriptInterface::pushPosition(L, position);
@@ -844,7 +844,7 @@ bool Events::eventPlayerOnTurn(const std::shared_ptr<Player> &player, Direction
 	scriptInterface.pushFunction(info.playerOnTurn);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, direction);
 
@@ -872,10 +872,10 @@ bool Events::eventPlayerOnTradeRequest(const std::shared_ptr<Player> &player, co
 	scriptInterface.pushFunction(info.playerOnTradeRequest);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Player>(L, target);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -904,10 +904,10 @@ bool Events::eventPlayerOnTradeAccept(const std::shared_ptr<Player> &player, con
 	scriptInterface.pushFunction(info.playerOnTradeAccept);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Player>(L, target);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -940,7 +940,7 @@ void Events::eventPlayerOnGainExperience(const std::shared_ptr<Player> &player,
 	scriptInterface.pushFunction(info.playerOnGainExperience);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	if (target) {
 		LuaScriptInterface::pushUserdata<Creature>(L, target);
@@ -983,7 +983,7 @@ void Events::eventPlayerOnLoseExperience(const std::shared_ptr<Player> &player,
 	scriptInterface.pushFunction(info.playerOnLoseExperience);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, exp);
 
@@ -1018,7 +1018,7 @@ void Events::eventPlayerOnGainSkillTries(const std::shared_ptr<Player> &player,
 	scriptInterface.pushFunction(info.playerOnGainSkillTries);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, skill);
 	lua_pushnumber(L, tries);
@@ -1054,7 +1054,7 @@ void Events::eventPlayerOnCombat(const std::shared_ptr<Player> &player, const st
 	scriptInterface.pushFunction(info.playerOnCombat);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	if (target) {
 		LuaScriptInterface::pushUserdata<Creature>(L, target);
@@ -1065,7 +1065,7 @@ void Events::eventPlayerOnCombat(const std::shared_ptr<Player> &player, const st
 
 	if (item) {
 		LuaScriptInterface::pushUserdata<Item>(L, item);
-		LuaScriptInterface::setMetatable(L, -1, "Item");
+		LuaScriptInterface::setMetatable(L, -1, LuaData_t::Item);
 	} else {
 		lua_pushnil(L);
 	}
@@ -1111,7 +1111,7 @@ void Events::eventPlayerOnRequestQuestLog(const std::shared_ptr<Player> &player)
 	scriptInterface.pushFunction(info.playerOnRequestQuestLog);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	scriptInterface.callVoidFunction(1);
 }
@@ -1137,7 +1137,7 @@ void Events::eventPlayerOnRequestQuestLine(const std::shared_ptr<Player> &player
 	scriptInterface.pushFunction(info.playerOnRequestQuestLine);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, questId);
 
@@ -1162,7 +1162,7 @@ void Events::eventPlayerOnInventoryUpdate(const std::shared_ptr<Player> &player,
 	scriptInterface.pushFunction(info.playerOnInventoryUpdate);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -1194,7 +1194,7 @@ void Events::eventOnStorageUpdate(const std::shared_ptr<Player> &player, const u
 	scriptInterface.pushFunction(info.playerOnStorageUpdate);
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	lua_pushnumber(L, key);
 	lua_pushnumber(L, value);
@@ -1226,10 +1226,10 @@ void Events::eventMonsterOnDropLoot(const std::shared_ptr<Monster> &monster, con
 	scriptInterface.pushFunction(info.monsterOnDropLoot);
 
 	LuaScriptInterface::pushUserdata<Monster>(L, monster);
-	LuaScriptInterface::setMetatable(L, -1, "Monster");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Monster);
 
 	LuaScriptInterface::pushUserdata<Container>(L, corpse);
-	LuaScriptInterface::setMetatable(L, -1, "Container");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Container);
 
 	return scriptInterface.callVoidFunction(2);
 }
@@ -152,7 +152,7 @@ bool TalkAction::executeSay(const std::shared_ptr<Player> &player, const std::st
 	getScriptInterface()->pushFunction(getScriptId());
 
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushString(L, words);
 	LuaScriptInterface::pushString(L, param);
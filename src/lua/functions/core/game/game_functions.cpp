@@ -17,6 +17,7 @@
 #include "game/functions/game_reload.hpp"
 #include "game/game.hpp"
 #include "game/scheduling/dispatcher.hpp"
+#include "game/scheduling/tick_profiler.hpp"
 #include "io/io_bosstiary.hpp"
 #include "io/iobestiary.hpp"
 #include "items/item.hpp"
@@ -80,6 +81,9 @@ void GameFunctions::init(lua_State* L) {
 	Lua::registerMethod(L, "Game", "getClientVersion", GameFunctions::luaGameGetClientVersion);
 
 	Lua::registerMethod(L, "Game", "reload", GameFunctions::luaGameReload);
+	Lua::registerMethod(L, "Game", "dumpTickProfile", GameFunctions::luaGameDumpTickProfile);
+	Lua::registerMethod(L, "Game", "getTimerEventStats", GameFunctions::luaGameGetTimerEventStats);
+	Lua::registerMethod(L, "Game", "callPureAsync", GameFunctions::luaGameCallPureAsync);
 
 	Lua::registerMethod(L, "Game", "hasDistanceEffect", GameFunctions::luaGameHasDistanceEffect);
 	Lua::registerMethod(L, "Game", "hasEffect", GameFunctions::luaGameHasEffect);
@@ -747,6 +751,87 @@ int GameFunctions::luaGameReload(lua_State* L) {
 	return 1;
 }
 
+int GameFunctions::luaGameDumpTickProfile(lua_State* L) {
+	// Game.dumpTickProfile([format = "folded"])
+	const auto formatName = Lua::getString(L, 1, "folded");
+	TickProfileFormat format;
+	if (formatName == "folded") {
+		format = TickProfileFormat::Folded;
+	} else if (formatName == "chrome") {
+		format = TickProfileFormat::ChromeTrace;
+	} else {
+		Lua::reportErrorFunc(fmt::format("Unknown tick profile format: {}", formatName));
+		lua_pushnil(L);
+		return 1;
+	}
+
+	const auto path = g_tickProfiler().dump(format);
+	if (path.empty()) {
+		lua_pushnil(L);
+	} else {
+		Lua::pushString(L, path);
+	}
+	return 1;
+}
+
+int GameFunctions::luaGameGetTimerEventStats(lua_State* L) {
+	// Game.getTimerEventStats()
+	std::vector<const LuaTimerScriptStats*> scripts;
+	for (const auto &stats : g_luaEnvironment().getTimerWheel().getScriptStats()) {
+		scripts.emplace_back(&stats);
+	}
+	std::ranges::sort(scripts, std::ranges::greater {}, [](const LuaTimerScriptStats* stats) {
+		return std::make_pair(stats->active, stats->created);
+	});
+
+	lua_createtable(L, scripts.size(), 0);
+	int index = 0;
+	for (const auto* stats : scripts) {
+		lua_createtable(L, 0, 3);
+		Lua::setField(L, "script", stats->name);
+		Lua::setField(L, "active", stats->active);
+		Lua::setField(L, "created", stats->created);
+		lua_rawseti(L, -2, ++index);
+	}
+	return 1;
+}
+
+int GameFunctions::luaGameCallPureAsync(lua_State* L) {
+	// Game.callPureAsync(functionName, callback, ...)
+	lua_State* globalState = g_luaEnvironment().getLuaState();
+	if (!globalState) {
+		Lua::reportErrorFunc("No valid script interface!");
+		Lua::pushBoolean(L, false);
+		return 1;
+	}
+
+	if (!Lua::isFunction(L, 2)) {
+		Lua::reportErrorFunc("callback parameter should be a function.");
+		Lua::pushBoolean(L, false);
+		return 1;
+	}
+
+	// Only plain values can reach the pure states
+	LuaPureValues arguments(std::max(0, lua_gettop(L) - 2));
+	for (int i = 3; i <= lua_gettop(L); ++i) {
+		std::string error;
+		if (!LuaStatePool::read(L, i, arguments[i - 3], error)) {
+			Lua::reportErrorFunc(fmt::format("argument #{}: {}", i, error));
+			Lua::pushBoolean(L, false);
+			return 1;
+		}
+	}
+
+	lua_pushvalue(L, 2);
+	if (globalState != L) {
+		lua_xmove(L, globalState, 1);
+	}
+	const int32_t callback = luaL_ref(globalState, LUA_REGISTRYINDEX);
+	g_luaEnvironment().addPureCall(Lua::getString(L, 1), std::move(arguments), callback, Lua::getScriptEnv()->getScriptId());
+	Lua::pushBoolean(L, true);
+	return 1;
+}
+
 int GameFunctions::luaGameHasEffect(lua_State* L) {
 	// Game.hasEffect(effectId)
 	const uint16_t effectId = Lua::getNumber<uint16_t>(L, 1);
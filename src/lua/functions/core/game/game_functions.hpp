@@ -62,6 +62,9 @@ private:
 	static int luaGameGetClientVersion(lua_State* L);
 
 	static int luaGameReload(lua_State* L);
+	static int luaGameDumpTickProfile(lua_State* L);
+	static int luaGameGetTimerEventStats(lua_State* L);
+	static int luaGameCallPureAsync(lua_State* L);
 
 	static int luaGameGetOfflinePlayer(lua_State* L);
 	static int luaGameGetNormalizedPlayerName(lua_State* L);
@@ -19,7 +19,6 @@
 #include "game/scheduling/save_manager.hpp"
 #include "items/containers/depot/depotlocker.hpp"
 #include "lua/global/globalevent.hpp"
-#include "lua/global/lua_timer_event_descr.hpp"
 #include "lua/scripts/lua_environment.hpp"
 #include "lua/scripts/script_environment.hpp"
 #include "server/network/protocol/protocolstatus.hpp"
@@ -694,27 +693,19 @@ int GlobalFunctions::luaAddEvent(lua_State* L) {
 		}
 	}
 
-	LuaTimerEventDesc eventDesc;
-	for (int i = 0; i < parameters - 2; ++i) { // -2 because addEvent needs at least two parameters
-		eventDesc.parameters.push_back(luaL_ref(globalState, LUA_REGISTRYINDEX));
+	// References are taken from the top of the stack, the last parameter first
+	std::vector<int32_t> eventParameters(parameters - 2); // -2 because addEvent needs at least two parameters
+	for (auto &parameter : std::views::reverse(eventParameters)) {
+		parameter = luaL_ref(globalState, LUA_REGISTRYINDEX);
 	}
 
 	const uint32_t delay = std::max<uint32_t>(100, Lua::getNumber<uint32_t>(globalState, 2));
 	lua_pop(globalState, 1);
 
-	eventDesc.function = luaL_ref(globalState, LUA_REGISTRYINDEX);
-	eventDesc.scriptId = Lua::getScriptEnv()->getScriptId();
-	eventDesc.scriptName = Lua::getScriptEnv()->getScriptInterface()->getLoadingScriptName();
-
-	auto &lastTimerEventId = g_luaEnvironment().lastEventTimerId;
-	eventDesc.eventId = g_dispatcher().scheduleEvent(
-		delay,
-		[lastTimerEventId] { g_luaEnvironment().executeTimerEvent(lastTimerEventId); },
-		"LuaEnvironment::executeTimerEvent"
-	);
-
-	g_luaEnvironment().timerEvents.try_emplace(lastTimerEventId, std::move(eventDesc));
-	lua_pushnumber(L, lastTimerEventId++);
+	const int32_t function = luaL_ref(globalState, LUA_REGISTRYINDEX);
+	const auto scriptEnv = Lua::getScriptEnv();
+	const auto eventId = g_luaEnvironment().addTimerEvent(delay, function, eventParameters, scriptEnv->getScriptId(), scriptEnv->getScriptInterface());
+	lua_pushnumber(L, eventId);
 	return 1;
 }
 
@@ -728,25 +719,7 @@ int GlobalFunctions::luaStopEvent(lua_State* L) {
 	}
 
 	const uint32_t eventId = Lua::getNumber<uint32_t>(L, 1);
-
-	auto &timerEvents = g_luaEnvironment().timerEvents;
-	const auto it = timerEvents.find(eventId);
-	if (it == timerEvents.end()) {
-		Lua::pushBoolean(L, false);
-		return 1;
-	}
-
-	const LuaTimerEventDesc timerEventDesc = std::move(it->second);
-	timerEvents.erase(it);
-
-	g_dispatcher().stopEvent(timerEventDesc.eventId);
-	luaL_unref(globalState, LUA_REGISTRYINDEX, timerEventDesc.function);
-
-	for (const auto parameter : timerEventDesc.parameters) {
-		luaL_unref(globalState, LUA_REGISTRYINDEX, parameter);
-	}
-
-	Lua::pushBoolean(L, true);
+	Lua::pushBoolean(L, g_luaEnvironment().stopTimerEvent(eventId));
 	return 1;
 }
 
@@ -758,7 +731,8 @@ int GlobalFunctions::luaSaveServer(lua_State* L) {
 }
 
 int GlobalFunctions::luaCleanMap(lua_State* L) {
-	lua_pushnumber(L, g_game().map.clean());
+	// cleanMap([wait = false])
+	lua_pushnumber(L, g_game().map.clean(Lua::getBoolean(L, 1, false)));
 	return 1;
 }
 
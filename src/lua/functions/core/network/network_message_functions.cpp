@@ -304,6 +304,13 @@ int NetworkMessageFunctions::luaNetworkMessageSkipBytes(lua_State* L) {
 	const int16_t number = Lua::getNumber<int16_t>(L, 2);
 	const auto &message = Lua::getUserdataShared<NetworkMessage>(L, 1, "NetworkMessage");
 	if (message) {
+		// The buffer isn't zeroed, the bytes skipped past what was written would reach the client as they are
+		const size_t written = NetworkMessage::INITIAL_BUFFER_POSITION + message->getLength();
+		const size_t from = std::max<size_t>(message->getBufferPosition(), written);
+		const size_t to = std::min<size_t>(message->getBufferPosition() + std::max<int16_t>(number, 0), NETWORKMESSAGE_MAXSIZE);
+		if (from < to) {
+			std::fill(message->getBuffer() + from, message->getBuffer() + to, 0);
+		}
 		message->skipBytes(number);
 		Lua::pushBoolean(L, true);
 	} else {
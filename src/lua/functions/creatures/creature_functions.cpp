@@ -136,12 +136,23 @@ int CreatureFunctions::luaCreatureGetEvents(lua_State* L) {
 		return 1;
 	}
 
-	const CreatureEventType_t eventType = Lua::getNumber<CreatureEventType_t>(L, 2);
-	const auto eventList = creature->getCreatureEvents(eventType);
-	lua_createtable(L, static_cast<int>(eventList.size()), 0);
+	// Read wider than the enum, so out of range values don't wrap into a valid type
+	const auto type = Lua::getNumber<int64_t>(L, 2);
+	if (type < 0 || type > std::numeric_limits<std::underlying_type_t<CreatureEventType_t>>::max() || !magic_enum::enum_contains<CreatureEventType_t>(static_cast<CreatureEventType_t>(type))) {
+		lua_newtable(L);
+		return 1;
+	}
+
+	const auto eventList = creature->getCreatureEvents(static_cast<CreatureEventType_t>(type));
+	if (!eventList) {
+		lua_newtable(L);
+		return 1;
+	}
+
+	lua_createtable(L, static_cast<int>(eventList->size()), 0);
 
 	int index = 0;
-	for (const auto &eventPtr : eventList) {
+	for (const auto &eventPtr : *eventList) {
 		Lua::pushString(L, eventPtr->getName());
 		lua_rawseti(L, -2, ++index);
 	}
@@ -30,6 +30,9 @@ void EventCallbackFunctions::init(lua_State* luaState) {
 	Lua::registerSharedClass(luaState, "EventCallback", "", EventCallbackFunctions::luaEventCallbackCreate);
 	Lua::registerMethod(luaState, "EventCallback", "type", EventCallbackFunctions::luaEventCallbackType);
 	Lua::registerMethod(luaState, "EventCallback", "register", EventCallbackFunctions::luaEventCallbackRegister);
+	Lua::registerMethod(luaState, "EventCallback", "itemId", EventCallbackFunctions::luaEventCallbackItemId);
+	Lua::registerMethod(luaState, "EventCallback", "creatureType", EventCallbackFunctions::luaEventCallbackCreatureType);
+	Lua::registerMethod(luaState, "EventCallback", "getStats", EventCallbackFunctions::luaEventCallbackGetStats);
 }
 
 int EventCallbackFunctions::luaEventCallbackCreate(lua_State* luaState) {
@@ -98,6 +101,58 @@ int EventCallbackFunctions::luaEventCallbackRegister(lua_State* luaState) {
 	return 1;
 }
 
+int EventCallbackFunctions::luaEventCallbackItemId(lua_State* luaState) {
+	// callback:itemId(fromId[, toId = fromId])
+	const auto &callback = Lua::getUserdataShared<EventCallback>(luaState, 1, "EventCallback");
+	if (!callback) {
+		Lua::reportErrorFunc("EventCallback is nil");
+		return 0;
+	}
+
+	const auto fromId = Lua::getNumber<uint16_t>(luaState, 2);
+	const auto toId = Lua::getNumber<uint16_t>(luaState, 3, fromId);
+	callback->addItemIdFilter(fromId, toId);
+	Lua::pushBoolean(luaState, true);
+	return 1;
+}
+
+int EventCallbackFunctions::luaEventCallbackCreatureType(lua_State* luaState) {
+	// callback:creatureType(type)
+	const auto &callback = Lua::getUserdataShared<EventCallback>(luaState, 1, "EventCallback");
+	if (!callback) {
+		Lua::reportErrorFunc("EventCallback is nil");
+		return 0;
+	}
+
+	const auto type = Lua::getNumber<CreatureType_t>(luaState, 2);
+	if (type > CREATURETYPE_HIDDEN) {
+		Lua::reportErrorFunc(fmt::format("Invalid creature type: {}", static_cast<uint8_t>(type)));
+		Lua::pushBoolean(luaState, false);
+		return 1;
+	}
+
+	callback->addCreatureTypeFilter(type);
+	Lua::pushBoolean(luaState, true);
+	return 1;
+}
+
+int EventCallbackFunctions::luaEventCallbackGetStats(lua_State* luaState) {
+	// callback:getStats()
+	const auto &callback = Lua::getUserdataShared<EventCallback>(luaState, 1, "EventCallback");
+	if (!callback) {
+		Lua::reportErrorFunc("EventCallback is nil");
+		return 0;
+	}
+
+	const auto &stats = callback->getStats();
+	lua_createtable(luaState, 0, 4);
+	Lua::setField(luaState, "calls", static_cast<lua_Number>(stats.calls));
+	Lua::setField(luaState, "filtered", static_cast<lua_Number>(stats.filtered));
+	Lua::setField(luaState, "totalTime", static_cast<lua_Number>(stats.totalMicroseconds));
+	Lua::setField(luaState, "maxTime", static_cast<lua_Number>(stats.maxMicroseconds));
+	return 1;
+}
+
 // Callback functions
 int EventCallbackFunctions::luaEventCallbackLoad(lua_State* luaState) {
 	const auto &callback = Lua::getUserdataShared<EventCallback>(luaState, 1, "EventCallback");
@@ -67,6 +67,30 @@ private:
 	 */
 	static int luaEventCallbackRegister(lua_State* luaState);
 
+	/**
+	 * @brief Restricts an EventCallback to an item id range, checked before entering Lua.
+	 *
+	 * @param luaState The Lua state.
+	 * @return Number of return values on the Lua stack.
+	 */
+	static int luaEventCallbackItemId(lua_State* luaState);
+
+	/**
+	 * @brief Restricts an EventCallback to a creature type, checked before entering Lua.
+	 *
+	 * @param luaState The Lua state.
+	 * @return Number of return values on the Lua stack.
+	 */
+	static int luaEventCallbackCreatureType(lua_State* luaState);
+
+	/**
+	 * @brief Gets the invocation counters of an EventCallback.
+	 *
+	 * @param luaState The Lua state.
+	 * @return Number of return values on the Lua stack.
+	 */
+	static int luaEventCallbackGetStats(lua_State* luaState);
+
 	/**
 	 * @note here end the lua binder functions }
 	 */
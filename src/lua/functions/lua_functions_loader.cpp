@@ -30,11 +30,41 @@
 
 class LuaScriptInterface;
 
+namespace {
+	// Registry references of the class metatables, resolved once by Lua::registerClass.
+	// They are only valid in the state the classes were registered into, other states and coroutines look them up by name.
+	lua_State* metatableRefsState = nullptr;
+	phmap::flat_hash_map<std::string, int> metatableRefs;
+	std::array<int, magic_enum::enum_count<LuaData_t>()> typedMetatableRefs;
+
+	// The Position metatable also holds the interned keys of the position fields,
+	// so pushPosition sets them with raw accesses instead of interning the key strings on every push
+	constexpr auto positionFields = std::to_array<std::pair<int, const char*>>({ { 'x', "x" }, { 'y', "y" }, { 'z', "z" }, { 's', "stackpos" } });
+
+	void pushClassMetatable(lua_State* L, LuaData_t type) {
+		const int ref = L == metatableRefsState ? typedMetatableRefs[static_cast<uint8_t>(type)] : LUA_NOREF;
+		if (ref != LUA_NOREF) {
+			lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+		} else {
+			luaL_getmetatable(L, std::string(magic_enum::enum_name(type)).c_str());
+		}
+	}
+
+	void setPositionField(lua_State* L, int metatable, int key, lua_Number value) {
+		// The position table is right below its metatable
+		lua_rawgeti(L, metatable, key);
+		lua_pushnumber(L, value);
+		lua_rawset(L, metatable - 1);
+	}
+}
+
 void Lua::load(lua_State* L) {
 	if (!L) {
 		g_game().dieSafely("Invalid lua state, cannot load lua functions.");
 	}
 
+	// A new state may get the address of a closed one, its references must not be reused
+	clearMetatableRefs(metatableRefsState);
 	luaL_openlibs(L);
 
 	CoreFunctions::init(L);
@@ -182,7 +212,7 @@ void Lua::pushVariant(lua_State* L, const LuaVariant &var) {
 	}
 	setField(L, "instantName", var.instantName);
 	setField(L, "runeName", var.runeName);
-	setMetatable(L, -1, "Variant");
+	setMetatable(L, -1, LuaData_t::Variant);
 }
 
 void Lua::pushThing(lua_State* L, const std::shared_ptr<Thing> &thing) {
@@ -223,7 +253,7 @@ void Lua::pushCylinder(lua_State* L, const std::shared_ptr<Cylinder> &cylinder)
 		setItemMetatable(L, -1, parentItem);
 	} else if (const auto &tile = cylinder->getTile()) {
 		pushUserdata<Tile>(L, tile);
-		setMetatable(L, -1, "Tile");
+		setMetatable(L, -1, LuaData_t::Tile);
 	} else if (cylinder == VirtualCylinder::virtualCylinder) {
 		pushBoolean(L, true);
 	} else {
@@ -270,12 +300,36 @@ int32_t Lua::popCallback(lua_State* L) {
 }
 
 // Metatables
+void Lua::clearMetatableRefs(lua_State* L) {
+	if (L == nullptr || L != metatableRefsState) {
+		return;
+	}
+
+	metatableRefsState = nullptr;
+	metatableRefs.clear();
+	typedMetatableRefs.fill(LUA_NOREF);
+}
+
 void Lua::setMetatable(lua_State* L, int32_t index, const std::string &name) {
 	if (validateDispatcherContext(__FUNCTION__)) {
 		return;
 	}
 
-	luaL_getmetatable(L, name.c_str());
+	const auto it = L == metatableRefsState ? metatableRefs.find(name) : metatableRefs.end();
+	if (it != metatableRefs.end()) {
+		lua_rawgeti(L, LUA_REGISTRYINDEX, it->second);
+	} else {
+		luaL_getmetatable(L, name.c_str());
+	}
+	lua_setmetatable(L, index - 1);
+}
+
+void Lua::setMetatable(lua_State* L, int32_t index, LuaData_t type) {
+	if (validateDispatcherContext(__FUNCTION__)) {
+		return;
+	}
+
+	pushClassMetatable(L, type);
 	lua_setmetatable(L, index - 1);
 }
 
@@ -326,11 +380,11 @@ void Lua::setItemMetatable(lua_State* L, int32_t index, const std::shared_ptr<It
 	}
 
 	if (item && item->getContainer()) {
-		luaL_getmetatable(L, "Container");
+		pushClassMetatable(L, LuaData_t::Container);
 	} else if (item && item->getTeleport()) {
-		luaL_getmetatable(L, "Teleport");
+		pushClassMetatable(L, LuaData_t::Teleport);
 	} else {
-		luaL_getmetatable(L, "Item");
+		pushClassMetatable(L, LuaData_t::Item);
 	}
 	lua_setmetatable(L, index - 1);
 }
@@ -341,11 +395,11 @@ void Lua::setCreatureMetatable(lua_State* L, int32_t index, const std::shared_pt
 	}
 
 	if (creature && creature->getPlayer()) {
-		luaL_getmetatable(L, "Player");
+		pushClassMetatable(L, LuaData_t::Player);
 	} else if (creature && creature->getMonster()) {
-		luaL_getmetatable(L, "Monster");
+		pushClassMetatable(L, LuaData_t::Monster);
 	} else {
-		luaL_getmetatable(L, "Npc");
+		pushClassMetatable(L, LuaData_t::Npc);
 	}
 	lua_setmetatable(L, index - 1);
 }
@@ -699,7 +753,7 @@ void Lua::pushInstantSpell(lua_State* L, const InstantSpell &spell) {
 	setField(L, "mana", spell.getMana());
 	setField(L, "manapercent", spell.getManaPercent());
 
-	setMetatable(L, -1, "Spell");
+	setMetatable(L, -1, LuaData_t::Spell);
 }
 
 void Lua::pushPosition(lua_State* L, const Position &position, int32_t stackpos /* = 0*/) {
@@ -709,12 +763,23 @@ void Lua::pushPosition(lua_State* L, const Position &position, int32_t stackpos
 
 	lua_createtable(L, 0, 4);
 
-	setField(L, "x", position.x);
-	setField(L, "y", position.y);
-	setField(L, "z", position.z);
-	setField(L, "stackpos", stackpos);
+	pushClassMetatable(L, LuaData_t::Position);
+	if (!lua_istable(L, -1)) {
+		// Position class is not registered in this state
+		lua_pop(L, 1);
+		setField(L, "x", position.x);
+		setField(L, "y", position.y);
+		setField(L, "z", position.z);
+		setField(L, "stackpos", stackpos);
+		return;
+	}
 
-	setMetatable(L, -1, "Position");
+	const int metatable = lua_gettop(L);
+	setPositionField(L, metatable, 'x', position.x);
+	setPositionField(L, metatable, 'y', position.y);
+	setPositionField(L, metatable, 'z', position.z);
+	setPositionField(L, metatable, 's', stackpos);
+	lua_setmetatable(L, -2);
 }
 
 void Lua::pushOutfit(lua_State* L, const Outfit_t &outfit) {
@@ -808,6 +873,27 @@ void Lua::registerClass(lua_State* L, const std::string &className, const std::s
 	}
 	lua_rawseti(L, metatable, 't');
 
+	if (userTypeEnum == LuaData_t::Position) {
+		// className.metatable[key] = "field"
+		for (const auto &[key, field] : positionFields) {
+			lua_pushstring(L, field);
+			lua_rawseti(L, metatable, key);
+		}
+	}
+
+	// Keep a reference to className.metatable, so pushing doesn't look it up by name
+	if (L != metatableRefsState) {
+		metatableRefsState = L;
+		metatableRefs.clear();
+		typedMetatableRefs.fill(LUA_NOREF);
+	}
+	lua_pushvalue(L, metatable);
+	const int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+	metatableRefs[className] = ref;
+	if (userTypeEnum.has_value()) {
+		typedMetatableRefs[static_cast<uint8_t>(userTypeEnum.value())] = ref;
+	}
+
 	// pop className, className.metatable
 	lua_pop(L, 2);
 }
@@ -35,6 +35,8 @@ struct LuaVariant;
 class Lua {
 public:
 	static void load(lua_State* L);
+	// Forgets the cached class metatables of L, before it is closed
+	static void clearMetatableRefs(lua_State* L);
 
 	static std::string getErrorDesc(ErrorCode_t code);
 
@@ -58,6 +60,7 @@ public:
 	}
 
 	static void setMetatable(lua_State* L, int32_t index, const std::string &name);
+	static void setMetatable(lua_State* L, int32_t index, LuaData_t type);
 	static void setWeakMetatable(lua_State* L, int32_t index, const std::string &name);
 	static void setItemMetatable(lua_State* L, int32_t index, const std::shared_ptr<Item> &item);
 	static void setCreatureMetatable(lua_State* L, int32_t index, const std::shared_ptr<Creature> &creature);
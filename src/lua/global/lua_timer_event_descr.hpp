@@ -11,17 +11,24 @@
 
 #ifndef USE_PRECOMPILED_HEADERS
 	#include <cstdint>
-	#include <list>
 	#include <string>
 #endif
 
 struct LuaTimerEventDesc {
+	uint32_t id = 0;
 	int32_t scriptId = -1;
-	std::string scriptName;
 	int32_t function = -1;
-	std::list<int32_t> parameters;
-	uint32_t eventId = 0;
+	// Milliseconds, same clock as OTSYS_TIME
+	int64_t expiresAt = 0;
+	// Registry references of the parameters, in call order, live in the parameter pool of the timer wheel
+	uint32_t parameterOffset = 0;
+	uint16_t parameterCount = 0;
+	// Index of the script that created the timer, see LuaTimerWheel::getScriptStats
+	uint32_t script = 0;
+};
 
-	LuaTimerEventDesc() = default;
-	LuaTimerEventDesc(LuaTimerEventDesc &&other) = default;
+struct LuaTimerScriptStats {
+	std::string name;
+	uint32_t active = 0;
+	uint64_t created = 0;
 };
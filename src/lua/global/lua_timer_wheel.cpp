@@ -0,0 +1,157 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/global/lua_timer_wheel.hpp"
+
+uint32_t LuaTimerWheel::add(int64_t now, uint32_t delay, int32_t scriptId, uint32_t script, int32_t function, std::span<const int32_t> parameters) {
+	// Nothing is pending, the wheel can jump to now instead of walking the idle ticks
+	if (timers.empty()) {
+		currentTick = now / RESOLUTION;
+	}
+
+	if (++lastTimerId == 0) {
+		lastTimerId = 1;
+	}
+
+	LuaTimerEventDesc timer;
+	timer.id = lastTimerId;
+	timer.scriptId = scriptId;
+	timer.function = function;
+	timer.expiresAt = now + delay;
+	timer.parameterOffset = allocateParameters(parameters);
+	timer.parameterCount = static_cast<uint16_t>(parameters.size());
+	timer.script = script;
+
+	auto &stats = scripts[timer.script];
+	++stats.active;
+	++stats.created;
+
+	// The current tick was already expired, the timer goes at least to the next one
+	const auto tick = std::max(getTick(timer.expiresAt), currentTick + 1);
+	slots[tick % SLOTS].emplace_back(timer.id);
+	timers.emplace(timer.id, timer);
+	return timer.id;
+}
+
+const LuaTimerEventDesc* LuaTimerWheel::find(uint32_t id) const {
+	const auto it = timers.find(id);
+	return it != timers.end() ? &it->second : nullptr;
+}
+
+std::span<const int32_t> LuaTimerWheel::getParameters(const LuaTimerEventDesc &timer) const {
+	if (timer.parameterCount == 0) {
+		return {};
+	}
+	return { parameterPool.data() + timer.parameterOffset, timer.parameterCount };
+}
+
+bool LuaTimerWheel::erase(uint32_t id) {
+	const auto it = timers.find(id);
+	if (it == timers.end()) {
+		return false;
+	}
+
+	// The id left in its slot is dropped when the slot comes around
+	releaseParameters(it->second);
+	--scripts[it->second.script].active;
+	timers.erase(it);
+	return true;
+}
+
+void LuaTimerWheel::advance(int64_t now, std::vector<uint32_t> &expired) {
+	if (currentTick == -1) {
+		return;
+	}
+
+	const auto targetTick = now / RESOLUTION;
+	if (targetTick <= currentTick) {
+		return;
+	}
+
+	const auto firstExpired = expired.size();
+
+	// After a full turn every slot has been visited, the due timers of the skipped turns included
+	const auto steps = std::min<int64_t>(targetTick - currentTick, SLOTS);
+	for (int64_t step = 1; step <= steps; ++step) {
+		auto &slot = slots[(currentTick + step) % SLOTS];
+		std::erase_if(slot, [&](uint32_t id) {
+			const auto it = timers.find(id);
+			if (it == timers.end()) {
+				return true;
+			}
+			if (getTick(it->second.expiresAt) > targetTick) {
+				return false;
+			}
+			expired.emplace_back(id);
+			return true;
+		});
+	}
+	currentTick = targetTick;
+
+	std::sort(expired.begin() + firstExpired, expired.end(), [this](uint32_t a, uint32_t b) {
+		const auto expiresA = timers.at(a).expiresAt;
+		const auto expiresB = timers.at(b).expiresAt;
+		return expiresA != expiresB ? expiresA < expiresB : a < b;
+	});
+}
+
+void LuaTimerWheel::clear() {
+	for (auto &slot : slots) {
+		slot.clear();
+	}
+	timers.clear();
+	parameterPool.clear();
+	freeParameterBlocks.clear();
+	for (auto &stats : scripts) {
+		stats.active = 0;
+	}
+	currentTick = -1;
+}
+
+uint32_t LuaTimerWheel::allocateParameters(std::span<const int32_t> parameters) {
+	const auto count = parameters.size();
+	if (count == 0) {
+		return 0;
+	}
+
+	uint32_t offset;
+	if (count < freeParameterBlocks.size() && !freeParameterBlocks[count].empty()) {
+		offset = freeParameterBlocks[count].back();
+		freeParameterBlocks[count].pop_back();
+	} else {
+		offset = static_cast<uint32_t>(parameterPool.size());
+		parameterPool.resize(parameterPool.size() + count);
+	}
+
+	std::ranges::copy(parameters, parameterPool.begin() + offset);
+	return offset;
+}
+
+void LuaTimerWheel::releaseParameters(const LuaTimerEventDesc &timer) {
+	if (timer.parameterCount == 0) {
+		return;
+	}
+
+	if (timer.parameterCount >= freeParameterBlocks.size()) {
+		freeParameterBlocks.resize(timer.parameterCount + 1);
+	}
+	freeParameterBlocks[timer.parameterCount].emplace_back(timer.parameterOffset);
+}
+
+uint32_t LuaTimerWheel::getScriptIndex(std::string_view scriptName) {
+	const auto it = scriptIndexes.find(scriptName);
+	if (it != scriptIndexes.end()) {
+		return it->second;
+	}
+
+	const auto index = static_cast<uint32_t>(scripts.size());
+	scripts.push_back({ std::string(scriptName), 0, 0 });
+	scriptIndexes.emplace(std::string(scriptName), index);
+	return index;
+}
@@ -0,0 +1,120 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "lua/global/lua_timer_event_descr.hpp"
+
+/**
+ * Hashed timer wheel of the Lua addEvent timers.
+ * Timers are bucketed by the tick they expire at, so adding, stopping and expiring a timer doesn't
+ * touch the dispatcher at all; the Lua environment advances the wheel from a single dispatcher event.
+ * The parameter references of all timers share one pool, recycled by parameter count.
+ * It only stores registry references, releasing them is up to the owner of the Lua state.
+ */
+class LuaTimerWheel {
+public:
+	// Milliseconds per tick, the same granularity as the dispatcher scheduler
+	static constexpr int64_t RESOLUTION = 50;
+	// Timers further away than a full turn stay in their slot until their turn comes
+	static constexpr size_t SLOTS = 1024;
+
+	LuaTimerWheel() = default;
+
+	// Ensures that we don't accidentally copy it
+	LuaTimerWheel(const LuaTimerWheel &) = delete;
+	LuaTimerWheel &operator=(const LuaTimerWheel &) = delete;
+
+	/**
+	 * \param parameters registry references of the parameters, in call order
+	 * \returns the id of the timer, never 0
+	 */
+	uint32_t add(int64_t now, uint32_t delay, int32_t scriptId, std::string_view scriptName, int32_t function, std::span<const int32_t> parameters) {
+		return add(now, delay, scriptId, getScriptIndex(scriptName), function, parameters);
+	}
+	/**
+	 * \param script index of the script stats, see getScriptIndex
+	 */
+	uint32_t add(int64_t now, uint32_t delay, int32_t scriptId, uint32_t script, int32_t function, std::span<const int32_t> parameters);
+
+	/**
+	 * Index of the stats of the script identified by scriptKey, its name is only resolved the first time the key is seen.
+	 * Keys resolving to the same name, e.g. the same file after a reload, share their stats.
+	 */
+	template <typename F>
+	uint32_t getScriptIndex(uint64_t scriptKey, F &&scriptName) {
+		const auto it = scriptKeyIndexes.find(scriptKey);
+		if (it != scriptKeyIndexes.end()) {
+			return it->second;
+		}
+		const auto index = getScriptIndex(std::string_view(scriptName()));
+		scriptKeyIndexes.emplace(scriptKey, index);
+		return index;
+	}
+
+	const LuaTimerEventDesc* find(uint32_t id) const;
+	std::span<const int32_t> getParameters(const LuaTimerEventDesc &timer) const;
+
+	/**
+	 * Removes the timer, its registry references must have been released or pushed beforehand.
+	 */
+	bool erase(uint32_t id);
+
+	/**
+	 * Moves the wheel up to now and appends the ids of the timers that expired to expired,
+	 * ordered by expiration time and then by creation.
+	 * The timers stay in the wheel until they are erased.
+	 */
+	void advance(int64_t now, std::vector<uint32_t> &expired);
+
+	template <typename F>
+	void forEach(F &&f) const {
+		for (const auto &[id, timer] : timers) {
+			f(timer, getParameters(timer));
+		}
+	}
+
+	void clear();
+
+	size_t size() const {
+		return timers.size();
+	}
+	bool empty() const {
+		return timers.empty();
+	}
+
+	const std::vector<LuaTimerScriptStats> &getScriptStats() const {
+		return scripts;
+	}
+
+private:
+	static int64_t getTick(int64_t time) {
+		// Rounded up, a timer never expires early
+		return (time + RESOLUTION - 1) / RESOLUTION;
+	}
+
+	uint32_t allocateParameters(std::span<const int32_t> parameters);
+	void releaseParameters(const LuaTimerEventDesc &timer);
+	uint32_t getScriptIndex(std::string_view scriptName);
+
+	std::array<std::vector<uint32_t>, SLOTS> slots;
+	phmap::flat_hash_map<uint32_t, LuaTimerEventDesc> timers;
+
+	std::vector<int32_t> parameterPool;
+	// Offsets of the released blocks of the pool, indexed by parameter count
+	std::vector<std::vector<uint32_t>> freeParameterBlocks;
+
+	std::vector<LuaTimerScriptStats> scripts;
+	phmap::flat_hash_map<std::string, uint32_t> scriptIndexes;
+	phmap::flat_hash_map<uint64_t, uint32_t> scriptKeyIndexes;
+
+	// Last tick the wheel was advanced to, -1 until the first timer is added
+	int64_t currentTick = -1;
+	uint32_t lastTimerId = 0;
+};
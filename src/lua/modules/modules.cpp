@@ -171,7 +171,7 @@ void Module::executeOnRecvbyte(const std::shared_ptr<Player> &player, NetworkMes
 
 	scriptInterface->pushFunction(scriptId);
 	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::setMetatable(L, -1, LuaData_t::Player);
 
 	LuaScriptInterface::pushUserdata<NetworkMessage>(L, std::shared_ptr<NetworkMessage>(&msg));
 	LuaScriptInterface::setWeakMetatable(L, -1, "NetworkMessage");
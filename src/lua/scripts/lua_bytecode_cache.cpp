@@ -0,0 +1,177 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/scripts/lua_bytecode_cache.hpp"
+
+#include "lib/di/container.hpp"
+#include "utils/benchmark.hpp"
+
+namespace {
+	struct CacheHeader {
+		std::array<char, 4> magic;
+		uint32_t luaVersion;
+		uint64_t contentHash;
+	};
+	static_assert(sizeof(CacheHeader) == 16);
+
+	constexpr std::array<char, 4> CACHE_MAGIC { 'C', 'L', 'B', 'C' };
+
+#ifdef LUAJIT_VERSION_NUM
+	constexpr uint32_t LUA_BUILD_VERSION = LUAJIT_VERSION_NUM;
+#else
+	constexpr uint32_t LUA_BUILD_VERSION = LUA_VERSION_NUM;
+#endif
+
+	int writeBytecode(lua_State*, const void* data, size_t size, void* userData) {
+		static_cast<std::string*>(userData)->append(static_cast<const char*>(data), size);
+		return 0;
+	}
+
+	bool readFile(const std::filesystem::path &path, std::string &content) {
+		std::ifstream input(path, std::ios::binary);
+		if (!input) {
+			return false;
+		}
+		content.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+		return !input.bad();
+	}
+}
+
+LuaBytecodeCache &LuaBytecodeCache::getInstance() {
+	return inject<LuaBytecodeCache>();
+}
+
+void LuaBytecodeCache::setDirectory(const std::string &cacheDirectory) {
+	directory.clear();
+	if (cacheDirectory.empty()) {
+		return;
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(cacheDirectory, error);
+	if (error) {
+		g_logger().warn("[LuaBytecodeCache::setDirectory] - Can not create the bytecode cache folder '{}': {}", cacheDirectory, error.message());
+		return;
+	}
+	directory = cacheDirectory;
+}
+
+int LuaBytecodeCache::loadFile(lua_State* L, const std::string &file) {
+	Benchmark benchmark;
+	const auto finish = [&](int ret, bool cacheHit) {
+		std::scoped_lock lock(statsMutex);
+		++stats.files;
+		stats.cacheHits += cacheHit ? 1 : 0;
+		stats.compileTime += benchmark.duration();
+		return ret;
+	};
+
+	std::string source;
+	// Lua skips a first line starting with '#' (and a byte order mark on newer versions), those files are left to it
+	if (!isEnabled() || !readFile(file, source) || source.starts_with('#') || source.starts_with("\xEF\xBB\xBF")) {
+		return finish(luaL_loadfile(L, file.c_str()), false);
+	}
+
+	const auto chunkName = "@" + file;
+	const auto contentHash = hash(source);
+	const auto cachePath = getCachePath(file);
+	if (loadCached(L, cachePath, contentHash, chunkName)) {
+		return finish(0, true);
+	}
+
+	const int ret = luaL_loadbuffer(L, source.data(), source.size(), chunkName.c_str());
+	if (ret == 0) {
+		store(L, cachePath, contentHash);
+	}
+	return finish(ret, false);
+}
+
+void LuaBytecodeCache::addExecuteTime(double milliseconds) {
+	std::scoped_lock lock(statsMutex);
+	stats.executeTime += milliseconds;
+}
+
+LuaLoadStats LuaBytecodeCache::takeStats() {
+	std::scoped_lock lock(statsMutex);
+	return std::exchange(stats, {});
+}
+
+void LuaBytecodeCache::logStats(std::string_view stage) {
+	const auto loadStats = takeStats();
+	if (loadStats.files == 0) {
+		return;
+	}
+
+	g_logger().info("{}: {} script files, {:.2f} ms compiling ({} from the bytecode cache), {:.2f} ms executing", stage, loadStats.files, loadStats.compileTime, loadStats.cacheHits, loadStats.executeTime);
+}
+
+uint64_t LuaBytecodeCache::hash(std::string_view content) {
+	uint64_t value = 14695981039346656037ULL;
+	for (const auto c : content) {
+		value ^= static_cast<uint8_t>(c);
+		value *= 1099511628211ULL;
+	}
+	return value;
+}
+
+std::filesystem::path LuaBytecodeCache::getCachePath(const std::string &file) const {
+	return directory / fmt::format("{:016x}.luac", hash(file));
+}
+
+bool LuaBytecodeCache::loadCached(lua_State* L, const std::filesystem::path &path, uint64_t contentHash, const std::string &chunkName) const {
+	std::string entry;
+	if (!readFile(path, entry) || entry.size() <= sizeof(CacheHeader)) {
+		return false;
+	}
+
+	CacheHeader header {};
+	std::memcpy(&header, entry.data(), sizeof(header));
+	if (header.magic != CACHE_MAGIC || header.luaVersion != LUA_BUILD_VERSION || header.contentHash != contentHash) {
+		return false;
+	}
+
+	if (luaL_loadbuffer(L, entry.data() + sizeof(header), entry.size() - sizeof(header), chunkName.c_str()) != 0) {
+		lua_pop(L, 1);
+		return false;
+	}
+	return true;
+}
+
+void LuaBytecodeCache::store(lua_State* L, const std::filesystem::path &path, uint64_t contentHash) const {
+	std::string bytecode;
+#if LUA_VERSION_NUM >= 503
+	const int ret = lua_dump(L, writeBytecode, &bytecode, 0);
+#else
+	const int ret = lua_dump(L, writeBytecode, &bytecode);
+#endif
+	if (ret != 0 || bytecode.empty()) {
+		return;
+	}
+
+	// Written aside and renamed, so a load never sees a partial entry
+	auto temporaryPath = path;
+	temporaryPath += fmt::format(".{}.tmp", std::hash<std::thread::id> {}(std::this_thread::get_id()));
+	bool written;
+	{
+		std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+		const CacheHeader header { CACHE_MAGIC, LUA_BUILD_VERSION, contentHash };
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		output.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+		written = static_cast<bool>(output);
+	}
+
+	std::error_code error;
+	if (written) {
+		std::filesystem::rename(temporaryPath, path, error);
+	}
+	if (!written || error) {
+		g_logger().debug("[LuaBytecodeCache::store] - Can not write the bytecode cache file '{}'", path.string());
+		std::filesystem::remove(temporaryPath, error);
+	}
+}
@@ -0,0 +1,67 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+struct LuaLoadStats {
+	uint32_t files = 0;
+	uint32_t cacheHits = 0;
+	// Milliseconds spent turning the files into chunks, from source or from the cache
+	double compileTime = 0;
+	// Milliseconds spent running the main chunks of the files
+	double executeTime = 0;
+};
+
+/**
+ * Cache of the compiled chunks of the script files.
+ * Every file loaded through it is dumped as bytecode to the cache directory, under a name derived from its path,
+ * and loaded back from there while the hash of its content stays the same. The bytecode belongs to the Lua build
+ * that wrote it, entries that the running Lua can't load are simply compiled again.
+ */
+class LuaBytecodeCache {
+public:
+	LuaBytecodeCache() = default;
+
+	// Ensures that we don't accidentally copy it
+	LuaBytecodeCache(const LuaBytecodeCache &) = delete;
+	LuaBytecodeCache &operator=(const LuaBytecodeCache &) = delete;
+
+	static LuaBytecodeCache &getInstance();
+
+	// An empty directory disables the cache, the load times are still collected
+	void setDirectory(const std::string &cacheDirectory);
+	bool isEnabled() const {
+		return !directory.empty();
+	}
+
+	/**
+	 * Same contract as luaL_loadfile: pushes the chunk and returns 0, or pushes the error message.
+	 */
+	int loadFile(lua_State* L, const std::string &file);
+
+	void addExecuteTime(double milliseconds);
+	// Returns the stats collected since the last call
+	LuaLoadStats takeStats();
+	void logStats(std::string_view stage);
+
+	// FNV-1a, stable between builds and platforms
+	static uint64_t hash(std::string_view content);
+
+private:
+	std::filesystem::path getCachePath(const std::string &file) const;
+	bool loadCached(lua_State* L, const std::filesystem::path &path, uint64_t contentHash, const std::string &chunkName) const;
+	void store(lua_State* L, const std::filesystem::path &path, uint64_t contentHash) const;
+
+	std::filesystem::path directory;
+
+	std::mutex statsMutex;
+	LuaLoadStats stats;
+};
+
+constexpr auto g_luaBytecodeCache = LuaBytecodeCache::getInstance;
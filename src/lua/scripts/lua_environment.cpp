@@ -12,7 +12,8 @@
 #include "declarations.hpp"
 #include "lua/functions/lua_functions_loader.hpp"
 #include "lua/scripts/script_environment.hpp"
-#include "lua/global/lua_timer_event_descr.hpp"
+#include "lua/global/lua_timer_wheel.hpp"
+#include "game/scheduling/dispatcher.hpp"
 #include "lib/di/container.hpp"
 
 bool LuaEnvironment::shuttingDown = false;
@@ -69,18 +70,25 @@ bool LuaEnvironment::closeState() {
 		clearAreaObjects(areaEntry.first);
 	}
 
-	for (auto &timerEntry : timerEvents) {
-		LuaTimerEventDesc timerEventDesc = std::move(timerEntry.second);
-		for (const int32_t parameter : timerEventDesc.parameters) {
-			luaL_unref(luaState, LUA_REGISTRYINDEX, parameter);
-		}
-		luaL_unref(luaState, LUA_REGISTRYINDEX, timerEventDesc.function);
+	timerWheel.forEach([this](const LuaTimerEventDesc &timer, std::span<const int32_t>) {
+		releaseTimerEvent(timer);
+	});
+	timerWheel.clear();
+	if (timerWheelEventId != 0 && !shuttingDown) {
+		g_dispatcher().stopEvent(timerWheelEventId);
+	}
+	timerWheelEventId = 0;
+
+	// Results of the calls still running are dropped when they arrive
+	for (const auto &[callId, callback] : pureCallbacks) {
+		luaL_unref(luaState, LUA_REGISTRYINDEX, callback.function);
 	}
+	pureCallbacks.clear();
 
 	areaIdMap.clear();
-	timerEvents.clear();
 	cacheFiles.clear();
 
+	Lua::clearMetatableRefs(luaState);
 	lua_close(luaState);
 	luaState = nullptr;
 	return true;
@@ -123,40 +131,137 @@ void LuaEnvironment::clearAreaObjects(LuaScriptInterface* interface) {
 	it->second.clear();
 }
 
-void LuaEnvironment::executeTimerEvent(uint32_t eventIndex) {
-	const auto it = timerEvents.find(eventIndex);
-	if (it == timerEvents.end()) {
-		return;
+uint32_t LuaEnvironment::addTimerEvent(uint32_t delay, int32_t function, std::span<const int32_t> parameters, int32_t scriptId, LuaScriptInterface* scriptInterface) {
+	// Script ids are only unique within their interface
+	const uint64_t scriptKey = static_cast<uint64_t>(scriptInterface ? scriptInterface->getScopeId() : 0) << 32 | static_cast<uint32_t>(scriptId);
+	const auto script = timerWheel.getScriptIndex(scriptKey, [scriptId, scriptInterface]() -> std::string {
+		if (!scriptInterface) {
+			return "unknown";
+		}
+		const auto &file = scriptInterface->getFileById(scriptId);
+		const auto pos = file.find("data");
+		return pos != std::string::npos ? file.substr(pos) : file;
+	});
+	const auto eventId = timerWheel.add(OTSYS_TIME(), delay, scriptId, script, function, parameters);
+	if (timerWheelEventId == 0) {
+		timerWheelEventId = g_dispatcher().cycleEvent(
+			LuaTimerWheel::RESOLUTION,
+			[this] { executeTimerEvents(); },
+			"LuaEnvironment::executeTimerEvents"
+		);
+	}
+	return eventId;
+}
+
+bool LuaEnvironment::stopTimerEvent(uint32_t eventId) {
+	const auto* timer = timerWheel.find(eventId);
+	if (!timer) {
+		return false;
+	}
+
+	releaseTimerEvent(*timer);
+	timerWheel.erase(eventId);
+	return true;
+}
+
+void LuaEnvironment::releaseTimerEvent(const LuaTimerEventDesc &timer) {
+	luaL_unref(luaState, LUA_REGISTRYINDEX, timer.function);
+	for (const auto parameter : timerWheel.getParameters(timer)) {
+		luaL_unref(luaState, LUA_REGISTRYINDEX, parameter);
+	}
+}
+
+void LuaEnvironment::executeTimerEvents() {
+	expiredTimers.clear();
+	timerWheel.advance(OTSYS_TIME(), expiredTimers);
+
+	if (!expiredTimers.empty()) {
+		// The whole batch runs inside a single script environment
+		if (reserveScriptEnv()) {
+			ScriptEnvironment* env = getScriptEnv();
+			for (const auto eventId : expiredTimers) {
+				// May have been stopped by a timer of the same batch
+				const auto* timer = timerWheel.find(eventId);
+				if (!timer) {
+					continue;
+				}
+
+				const auto scriptId = timer->scriptId;
+				const auto parameters = timer->parameterCount;
+
+				// push function and parameters, the references can be released once they are on the stack
+				lua_rawgeti(luaState, LUA_REGISTRYINDEX, timer->function);
+				for (const auto parameter : timerWheel.getParameters(*timer)) {
+					lua_rawgeti(luaState, LUA_REGISTRYINDEX, parameter);
+				}
+				releaseTimerEvent(*timer);
+				timerWheel.erase(eventId);
+
+				env->resetEnv();
+				env->setTimerEvent();
+				env->setScriptId(scriptId, this);
+				callVoidFunctionInReservedEnv(parameters);
+			}
+			resetScriptEnv();
+		} else {
+			g_logger().error("[LuaEnvironment::executeTimerEvents - Lua file {}] "
+			                 "Call stack overflow. Too many lua script calls being nested",
+			                 getLoadingFile());
+			for (const auto eventId : expiredTimers) {
+				if (const auto* timer = timerWheel.find(eventId)) {
+					releaseTimerEvent(*timer);
+					timerWheel.erase(eventId);
+				}
+			}
+		}
 	}
 
-	LuaTimerEventDesc timerEventDesc = std::move(it->second);
-	timerEvents.erase(it);
+	if (timerWheel.empty() && timerWheelEventId != 0) {
+		g_dispatcher().stopEvent(timerWheelEventId);
+		timerWheelEventId = 0;
+	}
+}
 
-	// push function
-	lua_rawgeti(luaState, LUA_REGISTRYINDEX, timerEventDesc.function);
+void LuaEnvironment::addPureCall(std::string function, LuaPureValues arguments, int32_t callback, int32_t scriptId) {
+	const auto callId = ++lastPureCallId;
+	pureCallbacks.try_emplace(callId, PureCallback { callback, scriptId });
+	g_luaStatePool().callAsync(std::move(function), std::move(arguments), [callId](bool success, LuaPureValues &&results) {
+		g_luaEnvironment().executePureCallback(callId, success, std::move(results));
+	});
+}
 
-	// push parameters
-	for (const auto parameter : std::views::reverse(timerEventDesc.parameters)) {
-		lua_rawgeti(luaState, LUA_REGISTRYINDEX, parameter);
+void LuaEnvironment::executePureCallback(uint32_t callId, bool success, LuaPureValues &&results) {
+	const auto it = pureCallbacks.find(callId);
+	if (it == pureCallbacks.end()) {
+		return;
 	}
 
-	// call the function
-	if (reserveScriptEnv()) {
-		ScriptEnvironment* env = getScriptEnv();
-		env->setTimerEvent();
-		env->setScriptId(timerEventDesc.scriptId, this);
-		callFunction(timerEventDesc.parameters.size());
-	} else {
-		g_logger().error("[LuaEnvironment::executeTimerEvent - Lua file {}] "
+	const auto [function, scriptId] = it->second;
+	pureCallbacks.erase(it);
+
+	// The failure was already logged by the pool
+	if (!success) {
+		luaL_unref(luaState, LUA_REGISTRYINDEX, function);
+		return;
+	}
+
+	if (!reserveScriptEnv()) {
+		g_logger().error("[LuaEnvironment::executePureCallback - Lua file {}] "
 		                 "Call stack overflow. Too many lua script calls being nested",
 		                 getLoadingFile());
+		luaL_unref(luaState, LUA_REGISTRYINDEX, function);
+		return;
 	}
 
-	// free resources
-	luaL_unref(luaState, LUA_REGISTRYINDEX, timerEventDesc.function);
-	for (const auto parameter : timerEventDesc.parameters) {
-		luaL_unref(luaState, LUA_REGISTRYINDEX, parameter);
+	lua_rawgeti(luaState, LUA_REGISTRYINDEX, function);
+	luaL_unref(luaState, LUA_REGISTRYINDEX, function);
+	for (const auto &result : results) {
+		LuaStatePool::push(luaState, result);
 	}
+
+	ScriptEnvironment* env = getScriptEnv();
+	env->setScriptId(scriptId, this);
+	callVoidFunction(static_cast<int>(results.size()));
 }
 
 void LuaEnvironment::collectGarbage() const {
@@ -14,7 +14,8 @@
 #include "lua/scripts/luascript.hpp"
 #include "items/weapons/weapons.hpp"
 
-#include "lua/global/lua_timer_event_descr.hpp"
+#include "lua/global/lua_timer_wheel.hpp"
+#include "lua/scripts/lua_state_pool.hpp"
 
 class AreaCombat;
 class Combat;
@@ -52,11 +53,39 @@ public:
 
 	void collectGarbage() const;
 
-private:
-	void executeTimerEvent(uint32_t eventIndex);
+	/**
+	 * Takes ownership of the registry references of the function and its parameters (in call order).
+	 * \returns the id of the timer event
+	 */
+	uint32_t addTimerEvent(uint32_t delay, int32_t function, std::span<const int32_t> parameters, int32_t scriptId, LuaScriptInterface* scriptInterface);
+	bool stopTimerEvent(uint32_t eventId);
+
+	const LuaTimerWheel &getTimerWheel() const {
+		return timerWheel;
+	}
 
-	std::unordered_map<uint32_t, LuaTimerEventDesc> timerEvents;
-	uint32_t lastEventTimerId = 1;
+	/**
+	 * Runs the function on the pure Lua states and calls callback with its results on the dispatcher.
+	 * Takes ownership of the registry reference of callback.
+	 */
+	void addPureCall(std::string function, LuaPureValues arguments, int32_t callback, int32_t scriptId);
+
+private:
+	void executeTimerEvents();
+	void releaseTimerEvent(const LuaTimerEventDesc &timer);
+	void executePureCallback(uint32_t callId, bool success, LuaPureValues &&results);
+
+	LuaTimerWheel timerWheel;
+	std::vector<uint32_t> expiredTimers;
+	uint64_t timerWheelEventId = 0;
+
+	struct PureCallback {
+		int32_t function;
+		int32_t scriptId;
+	};
+	// Callbacks of the pure calls in progress, by call id
+	phmap::flat_hash_map<uint32_t, PureCallback> pureCallbacks;
+	uint32_t lastPureCallId = 0;
 
 	phmap::flat_hash_map<uint32_t, std::unique_ptr<AreaCombat>> areaMap;
 	phmap::flat_hash_map<LuaScriptInterface*, std::vector<uint32_t>> areaIdMap;
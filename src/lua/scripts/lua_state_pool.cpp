@@ -0,0 +1,289 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/scripts/lua_state_pool.hpp"
+
+#include "game/scheduling/dispatcher.hpp"
+#include "lib/di/container.hpp"
+#include "lib/thread/thread_pool.hpp"
+
+LuaStatePool::~LuaStatePool() {
+	close();
+}
+
+LuaStatePool &LuaStatePool::getInstance() {
+	return inject<LuaStatePool>();
+}
+
+void LuaStatePool::init(size_t workerStates) {
+	std::unique_lock statesLock(statesMutex);
+	closeStates();
+
+	workers = workerStates > 0;
+	const auto count = std::max<size_t>(1, workerStates);
+	states.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		auto state = std::make_unique<State>();
+		state->L = createState();
+		states.emplace_back(std::move(state));
+	}
+}
+
+bool LuaStatePool::loadDirectory(const std::string &directory) {
+	if (!std::filesystem::is_directory(directory)) {
+		g_logger().warn("[LuaStatePool::loadDirectory] - Can not load folder '{}'", directory);
+		return false;
+	}
+
+	std::vector<std::filesystem::path> files;
+	for (const auto &entry : std::filesystem::recursive_directory_iterator(directory)) {
+		const auto &path = entry.path();
+		if (entry.is_regular_file() && path.extension() == ".lua" && !path.filename().string().starts_with('#')) {
+			files.emplace_back(path);
+		}
+	}
+	// Same load order on every platform and every state
+	std::ranges::sort(files);
+
+	std::shared_lock statesLock(statesMutex);
+	for (const auto &file : files) {
+		for (const auto &state : states) {
+			std::scoped_lock lock(state->mutex);
+			if (luaL_loadfile(state->L, file.string().c_str()) != 0 || lua_pcall(state->L, 0, 0, 0) != 0) {
+				g_logger().error("[LuaStatePool::loadDirectory] - {}", lua_tostring(state->L, -1));
+				lua_pop(state->L, 1);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool LuaStatePool::loadBuffer(std::string_view code, std::string_view chunkName) {
+	const std::string name(chunkName);
+	std::shared_lock statesLock(statesMutex);
+	for (const auto &state : states) {
+		std::scoped_lock lock(state->mutex);
+		if (luaL_loadbuffer(state->L, code.data(), code.size(), name.c_str()) != 0 || lua_pcall(state->L, 0, 0, 0) != 0) {
+			g_logger().error("[LuaStatePool::loadBuffer] - {}", lua_tostring(state->L, -1));
+			lua_pop(state->L, 1);
+			return false;
+		}
+	}
+	return true;
+}
+
+void LuaStatePool::close() {
+	std::unique_lock statesLock(statesMutex);
+	closeStates();
+}
+
+void LuaStatePool::closeStates() {
+	for (const auto &state : states) {
+		std::scoped_lock lock(state->mutex);
+		lua_close(state->L);
+		state->L = nullptr;
+	}
+	states.clear();
+	workers = false;
+}
+
+bool LuaStatePool::call(std::string_view function, const LuaPureValues &arguments, LuaPureValues &results, std::string &error) {
+	std::shared_lock statesLock(statesMutex);
+	if (states.empty()) {
+		error = "the pure Lua states are not initialized";
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lock;
+	lua_State* L = acquire(lock).L;
+	const int top = lua_gettop(L);
+
+	lua_getglobal(L, std::string(function).c_str());
+	if (!lua_isfunction(L, -1)) {
+		lua_settop(L, top);
+		error = fmt::format("function '{}' does not exist", function);
+		return false;
+	}
+
+	for (const auto &argument : arguments) {
+		push(L, argument);
+	}
+
+	if (lua_pcall(L, static_cast<int>(arguments.size()), LUA_MULTRET, 0) != 0) {
+		const char* message = lua_tostring(L, -1);
+		error = message ? message : "unknown error";
+		lua_settop(L, top);
+		return false;
+	}
+
+	const int resultCount = lua_gettop(L) - top;
+	results.clear();
+	results.resize(resultCount);
+
+	bool success = true;
+	for (int i = 0; success && i < resultCount; ++i) {
+		success = read(L, top + 1 + i, results[i], error);
+	}
+	lua_settop(L, top);
+	return success;
+}
+
+void LuaStatePool::callAsync(std::string function, LuaPureValues arguments, std::function<void(bool, LuaPureValues &&)> &&callback) {
+	auto task = [this, function = std::move(function), arguments = std::move(arguments), callback = std::move(callback)]() mutable {
+		LuaPureValues results;
+		std::string error;
+		const bool success = call(function, arguments, results, error);
+		if (!success) {
+			g_logger().error("[LuaStatePool::callAsync - {}] {}", function, error);
+			results.clear();
+		}
+
+		g_dispatcher().addEvent(
+			[callback = std::move(callback), success, results = std::move(results)]() mutable {
+				callback(success, std::move(results));
+			},
+			"LuaStatePool::callAsync"
+		);
+	};
+
+	if (workers) {
+		g_threadPool().detach_task(std::move(task));
+	} else {
+		task();
+	}
+}
+
+bool LuaStatePool::read(lua_State* L, int index, LuaPureValue &value, std::string &error, int depth /* = 0*/) {
+	if (index < 0) {
+		index = lua_gettop(L) + index + 1;
+	}
+
+	switch (lua_type(L, index)) {
+		case LUA_TNIL:
+			value.value = std::monostate {};
+			return true;
+
+		case LUA_TBOOLEAN:
+			value.value = lua_toboolean(L, index) != 0;
+			return true;
+
+		case LUA_TNUMBER:
+#if LUA_VERSION_NUM >= 503
+			if (lua_isinteger(L, index)) {
+				value.value = static_cast<int64_t>(lua_tointeger(L, index));
+				return true;
+			}
+#endif
+			value.value = static_cast<double>(lua_tonumber(L, index));
+			return true;
+
+		case LUA_TSTRING: {
+			size_t length;
+			const char* string = lua_tolstring(L, index, &length);
+			value.value = std::string(string, length);
+			return true;
+		}
+
+		case LUA_TTABLE: {
+			if (depth >= MAX_TABLE_DEPTH) {
+				error = "tables are nested too deep to be copied between Lua states";
+				return false;
+			}
+
+			LuaPureValue::Table table;
+			lua_pushnil(L);
+			while (lua_next(L, index) != 0) {
+				auto &[key, tableValue] = table.emplace_back();
+				if (!read(L, -2, key, error, depth + 1) || !read(L, -1, tableValue, error, depth + 1)) {
+					lua_pop(L, 2);
+					return false;
+				}
+				lua_pop(L, 1);
+			}
+			value.value = std::move(table);
+			return true;
+		}
+
+		default:
+			error = fmt::format("values of type {} can not be copied between Lua states", lua_typename(L, lua_type(L, index)));
+			return false;
+	}
+}
+
+void LuaStatePool::push(lua_State* L, const LuaPureValue &value) {
+	std::visit(
+		[L]<typename T>(const T &v) {
+			if constexpr (std::is_same_v<T, std::monostate>) {
+				lua_pushnil(L);
+			} else if constexpr (std::is_same_v<T, bool>) {
+				lua_pushboolean(L, v ? 1 : 0);
+			} else if constexpr (std::is_same_v<T, int64_t>) {
+				lua_pushinteger(L, static_cast<lua_Integer>(v));
+			} else if constexpr (std::is_same_v<T, double>) {
+				lua_pushnumber(L, v);
+			} else if constexpr (std::is_same_v<T, std::string>) {
+				lua_pushlstring(L, v.data(), v.size());
+			} else {
+				lua_createtable(L, 0, static_cast<int>(v.size()));
+				for (const auto &[key, tableValue] : v) {
+					push(L, key);
+					push(L, tableValue);
+					lua_rawset(L, -3);
+				}
+			}
+		},
+		value.value
+	);
+}
+
+lua_State* LuaStatePool::createState() {
+	lua_State* L = luaL_newstate();
+
+	// Only what a formula needs, no io, os, package, debug or jit
+	const std::array<std::pair<const char*, lua_CFunction>, 4> libraries { { { "_G", luaopen_base }, { LUA_STRLIBNAME, luaopen_string }, { LUA_TABLIBNAME, luaopen_table }, { LUA_MATHLIBNAME, luaopen_math } } };
+	for (const auto &[name, open] : libraries) {
+#if LUA_VERSION_NUM >= 502
+		luaL_requiref(L, name, open, 1);
+		lua_pop(L, 1);
+#else
+		lua_pushcfunction(L, open);
+		lua_pushstring(L, name);
+		lua_call(L, 1, 0);
+#endif
+	}
+
+	// The base functions that load code, reach the file system or drive the collector
+	for (const auto &name : { "dofile", "loadfile", "load", "loadstring", "collectgarbage", "coroutine" }) {
+		lua_pushnil(L);
+		lua_setglobal(L, name);
+	}
+
+	lua_getglobal(L, LUA_STRLIBNAME);
+	lua_pushnil(L);
+	lua_setfield(L, -2, "dump");
+	lua_pop(L, 1);
+	return L;
+}
+
+LuaStatePool::State &LuaStatePool::acquire(std::unique_lock<std::mutex> &lock) {
+	const auto first = nextState.fetch_add(1, std::memory_order_relaxed);
+	for (size_t i = 0; i < states.size(); ++i) {
+		auto &state = *states[(first + i) % states.size()];
+		lock = std::unique_lock(state.mutex, std::try_to_lock);
+		if (lock.owns_lock()) {
+			return state;
+		}
+	}
+
+	// Every state is busy, wait for the one that was next in line
+	auto &state = *states[first % states.size()];
+	lock = std::unique_lock(state.mutex);
+	return state;
+}
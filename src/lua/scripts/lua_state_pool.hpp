@@ -0,0 +1,93 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+/**
+ * Plain Lua value that can be copied between Lua states: nil, booleans, numbers, strings and tables of those.
+ */
+struct LuaPureValue {
+	using Table = std::vector<std::pair<LuaPureValue, LuaPureValue>>;
+
+	std::variant<std::monostate, bool, int64_t, double, std::string, Table> value;
+};
+
+using LuaPureValues = std::vector<LuaPureValue>;
+
+/**
+ * Pool of Lua states for side-effect-free script work, such as damage formulas.
+ * The states don't know the game at all: they only get the base, string, table and math libraries,
+ * without the functions that load code, and the scripts of the pure folder. Values are copied in and out of them,
+ * so any thread can run a function on a free state while the main state keeps running on the dispatcher.
+ */
+class LuaStatePool {
+public:
+	static constexpr int MAX_TABLE_DEPTH = 16;
+
+	LuaStatePool() = default;
+	~LuaStatePool();
+
+	// Ensures that we don't accidentally copy it
+	LuaStatePool(const LuaStatePool &) = delete;
+	LuaStatePool &operator=(const LuaStatePool &) = delete;
+
+	static LuaStatePool &getInstance();
+
+	/**
+	 * Creates the states, dropping the previous ones once the calls in progress are done.
+	 * \param workerStates states that run on the thread pool, 0 runs every call on the calling thread with a single state
+	 */
+	void init(size_t workerStates);
+	// Loads every .lua file of the directory (recursively) in each state
+	bool loadDirectory(const std::string &directory);
+	bool loadBuffer(std::string_view code, std::string_view chunkName);
+	// Waits for the calls in progress, calls made afterwards fail as if the pool was never initialized
+	void close();
+
+	size_t size() const {
+		return states.size();
+	}
+	bool hasWorkers() const {
+		return workers;
+	}
+
+	/**
+	 * Runs the global function on a free state, waiting for one if they are all busy. Thread safe.
+	 * \returns false with the error message if the function doesn't exist, fails or returns values that can't be copied
+	 */
+	bool call(std::string_view function, const LuaPureValues &arguments, LuaPureValues &results, std::string &error);
+
+	/**
+	 * Runs the function on the thread pool and hands its results to callback on the dispatcher.
+	 * Failures are logged and reported to callback with no results.
+	 */
+	void callAsync(std::string function, LuaPureValues arguments, std::function<void(bool, LuaPureValues &&)> &&callback);
+
+	static bool read(lua_State* L, int index, LuaPureValue &value, std::string &error, int depth = 0);
+	static void push(lua_State* L, const LuaPureValue &value);
+
+private:
+	struct State {
+		std::mutex mutex;
+		lua_State* L = nullptr;
+	};
+
+	static lua_State* createState();
+	State &acquire(std::unique_lock<std::mutex> &lock);
+	void closeStates();
+
+	// Held shared by every call and exclusively while the states are created or closed,
+	// so a task still queued on the thread pool never touches a closed state
+	mutable std::shared_mutex statesMutex;
+	std::vector<std::unique_ptr<State>> states;
+	std::atomic<size_t> nextState = 0;
+	bool workers = false;
+};
+
+constexpr auto g_luaStatePool = LuaStatePool::getInstance;
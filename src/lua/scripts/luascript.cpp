@@ -9,8 +9,11 @@
 
 #include "lua/scripts/luascript.hpp"
 
+#include "game/scheduling/tick_profiler.hpp"
+#include "lua/scripts/lua_bytecode_cache.hpp"
 #include "lua/scripts/lua_environment.hpp"
 #include "lib/metrics/metrics.hpp"
+#include "utils/benchmark.hpp"
 
 ScriptEnvironment::DBResultMap ScriptEnvironment::tempResults;
 uint32_t ScriptEnvironment::lastResultId = 0;
@@ -19,8 +22,15 @@ std::multimap<ScriptEnvironment*, std::shared_ptr<Item>> ScriptEnvironment::temp
 ScriptEnvironment Lua::scriptEnv[16];
 int32_t Lua::scriptEnvIndex = -1;
 
+namespace {
+	uint32_t nextScopeId() {
+		static std::atomic<uint32_t> lastScopeId = 0;
+		return ++lastScopeId;
+	}
+}
+
 LuaScriptInterface::LuaScriptInterface(std::string initInterfaceName) :
-	interfaceName(std::move(initInterfaceName)) {
+	interfaceName(std::move(initInterfaceName)), scopeId(nextScopeId()) {
 }
 
 LuaScriptInterface::~LuaScriptInterface() {
@@ -37,7 +47,7 @@ bool LuaScriptInterface::reInitState() {
 /// Same as lua_pcall, but adds stack trace to error strings in called function.
 int32_t LuaScriptInterface::loadFile(const std::string &file, const std::string &scriptName) {
 	// loads file as a chunk at stack top
-	int ret = luaL_loadfile(luaState, file.c_str());
+	int ret = g_luaBytecodeCache().loadFile(luaState, file);
 	if (ret != 0) {
 		lastLuaError = popString(luaState);
 		return -1;
@@ -60,7 +70,9 @@ int32_t LuaScriptInterface::loadFile(const std::string &file, const std::string
 	// env->setNpc(npc);
 
 	// execute it
+	Benchmark benchmark;
 	ret = protectedCall(luaState, 0, 0);
+	g_luaBytecodeCache().addExecuteTime(benchmark.duration());
 	if (ret != 0) {
 		reportError(nullptr, popString(luaState));
 		resetScriptEnv();
@@ -226,6 +238,8 @@ bool LuaScriptInterface::closeState() {
 	}
 
 	cacheFiles.clear();
+	// Script ids are reused by the next state, so are the cached profiler names of this id
+	scopeId = nextScopeId();
 	if (eventTableRef != -1) {
 		luaL_unref(luaState, LUA_REGISTRYINDEX, eventTableRef);
 		eventTableRef = -1;
@@ -237,7 +251,14 @@ bool LuaScriptInterface::closeState() {
 
 std::string LuaScriptInterface::getMetricsScope() const {
 #ifdef FEATURE_METRICS
-	metrics::method_latency measure(__METRICS_METHOD_NAME__);
+	METRICS_METHOD_LATENCY(measure);
+	return getScriptScope();
+#else
+	return {};
+#endif
+}
+
+std::string LuaScriptInterface::getScriptScope() const {
 	int32_t scriptId;
 	int32_t callbackId;
 	bool timerEvent;
@@ -261,13 +282,22 @@ std::string LuaScriptInterface::getMetricsScope() const {
 	}
 
 	return fmt::format("{}:{}", name, timerEvent ? "timer" : "<direct>");
-#else
-	return {};
-#endif
+}
+
+uint64_t LuaScriptInterface::getScriptScopeKey() const {
+	int32_t scriptId;
+	int32_t callbackId;
+	bool timerEvent;
+	LuaScriptInterface* scriptInterface;
+	getScriptEnv()->getEventInfo(scriptId, scriptInterface, callbackId, timerEvent);
+
+	const uint64_t interfaceId = scriptInterface ? scriptInterface->scopeId : 0;
+	return interfaceId << 33 | static_cast<uint64_t>(static_cast<uint32_t>(scriptId)) << 1 | (timerEvent ? 1 : 0);
 }
 
 bool LuaScriptInterface::callFunction(int params) const {
 	metrics::lua_latency measure(getMetricsScope());
+	TickProfiler::Frame profile(TickFrameType::Lua, [this] { return getScriptScopeKey(); }, [this] { return getScriptScope(); });
 	bool result = false;
 	const int size = lua_gettop(luaState);
 	if (protectedCall(luaState, params, 1) != 0) {
@@ -286,7 +316,13 @@ bool LuaScriptInterface::callFunction(int params) const {
 }
 
 void LuaScriptInterface::callVoidFunction(int params) const {
+	callVoidFunctionInReservedEnv(params);
+	resetScriptEnv();
+}
+
+void LuaScriptInterface::callVoidFunctionInReservedEnv(int params) const {
 	metrics::lua_latency measure(getMetricsScope());
+	TickProfiler::Frame profile(TickFrameType::Lua, [this] { return getScriptScopeKey(); }, [this] { return getScriptScope(); });
 	const int size = lua_gettop(luaState);
 	if (protectedCall(luaState, params, 0) != 0) {
 		LuaScriptInterface::reportError(nullptr, LuaScriptInterface::popString(luaState));
@@ -295,6 +331,4 @@ void LuaScriptInterface::callVoidFunction(int params) const {
 	if ((lua_gettop(luaState) + params + 1) != size) {
 		LuaScriptInterface::reportError(nullptr, "Stack size changed!");
 	}
-
-	resetScriptEnv();
 }
@@ -34,6 +34,10 @@ public:
 	const std::string &getInterfaceName() const {
 		return interfaceName;
 	}
+	// Changes whenever the state is closed, script ids are only meaningful together with it
+	uint32_t getScopeId() const {
+		return scopeId;
+	}
 	const std::string &getLastLuaError() const {
 		return lastLuaError;
 	}
@@ -66,6 +70,9 @@ public:
 
 protected:
 	virtual bool closeState();
+	// Same as callVoidFunction, but leaves the script environment reserved for the next call
+	void callVoidFunctionInReservedEnv(int params) const;
+
 	lua_State* luaState = nullptr;
 	int32_t eventTableRef = -1;
 	int32_t runningEventId = EVENT_ID_USER;
@@ -73,9 +80,13 @@ protected:
 
 private:
 	std::string getMetricsScope() const;
+	std::string getScriptScope() const;
+	// Identifies what getScriptScope returns without formatting it
+	uint64_t getScriptScopeKey() const;
 
 	std::string lastLuaError;
 	std::string interfaceName;
 	std::string loadingFile;
 	std::string loadedScriptName;
+	uint32_t scopeId = 0;
 };
@@ -30,6 +30,11 @@ void Map::load(const std::string &identifier, const Position &pos) {
 }
 
 void Map::loadMap(const std::string &identifier, bool mainMap /*= false*/, bool loadHouses /*= false*/, bool loadMonsters /*= false*/, bool loadNpcs /*= false*/, bool loadZones /*= false*/, const Position &pos /*= Position()*/) {
+	loadMapTiles(identifier, mainMap, pos);
+	loadMapData(mainMap, loadHouses, loadMonsters, loadNpcs, loadZones);
+}
+
+void Map::loadMapTiles(const std::string &identifier, bool mainMap /*= false*/, const Position &pos /*= Position()*/) {
 	// Only download map if is loading the main map and it is not already downloaded
 	if (mainMap && g_configManager().getBoolean(TOGGLE_DOWNLOAD_MAP) && !std::filesystem::exists(identifier)) {
 		const auto mapDownloadUrl = g_configManager().getString(MAP_DOWNLOAD_URL);
@@ -52,6 +57,10 @@ void Map::loadMap(const std::string &identifier, bool mainMap /*= false*/, bool
 
 	// Load the map
 	load(identifier, pos);
+}
+
+void Map::loadMapData(bool mainMap /*= false*/, bool loadHouses /*= false*/, bool loadMonsters /*= false*/, bool loadNpcs /*= false*/, bool loadZones /*= false*/) {
+	applyPendingZones();
 
 	// Only create items from lua functions if is loading main map
 	// It needs to be after the load map to ensure the map already exists before creating the items
@@ -102,6 +111,7 @@ void Map::loadMap(const std::string &identifier, bool mainMap /*= false*/, bool
 void Map::loadMapCustom(const std::string &mapName, bool loadHouses, bool loadMonsters, bool loadNpcs, bool loadZones, int customMapIndex) {
 	// Load the map
 	load(g_configManager().getString(DATA_DIRECTORY) + "/world/custom/" + mapName + ".otbm");
+	applyPendingZones();
 
 	if (loadMonsters && !IOMap::loadMonstersCustom(this, mapName, customMapIndex)) {
 		g_logger().warn("Failed to load monster custom data");
@@ -125,6 +135,14 @@ void Map::loadMapCustom(const std::string &mapName, bool loadHouses, bool loadMo
 	npcfile.clear();
 }
 
+void Map::applyPendingZones() {
+	for (const auto &[position, zoneId] : pendingZones) {
+		Zone::getZone(zoneId)->addPosition(position);
+	}
+	pendingZones.clear();
+	pendingZones.shrink_to_fit();
+}
+
 void Map::loadHouseInfo() {
 	IOMapSerialize::loadHouseInfo();
 	IOMapSerialize::loadHouseItems(this);
@@ -197,6 +215,7 @@ std::shared_ptr<Tile> Map::getTile(uint16_t x, uint16_t y, uint8_t z) {
 		return nullptr;
 	}
 
+	sector->touch();
 	return getOrCreateTileFromCache(floor, x, y);
 }
 
@@ -1036,44 +1055,115 @@ bool Map::getPathMatchingCond(const std::shared_ptr<Creature> &creature, const P
 	return true;
 }
 
-uint32_t Map::clean() const {
-	const uint64_t start = OTSYS_TIME();
-	size_t qntTiles = 0;
+uint32_t Map::clean(bool wait) {
+	uint32_t count = 0;
+	const bool idle = cleanQueueIndex >= cleanQueue.size();
+	if (idle) {
+		cleanQueue.clear();
+		cleanQueueIndex = 0;
+		cleanedItems = 0;
+		cleanedTiles = 0;
+		cleanStart = OTSYS_TIME(true);
+	}
 
-	if (g_game().getGameState() == GAME_STATE_NORMAL) {
-		g_game().setGameState(GAME_STATE_MAINTAIN);
+	for (const auto &tile : g_game().getTilesToClean()) {
+		if (tile && tile->getCleanableItemCount() != 0) {
+			count += tile->getCleanableItemCount();
+			cleanQueue.emplace_back(tile);
+		}
 	}
 
-	ItemVector toRemove;
-	toRemove.reserve(128);
+	g_game().clearTilesToClean();
 
-	for (const auto &tile : g_game().getTilesToClean()) {
-		if (!tile) {
-			continue;
+	if (wait) {
+		// A step still scheduled finds the queue empty
+		cleanQueuedTiles(std::numeric_limits<int64_t>::max());
+		return count;
+	}
+
+	// A pass already in progress picks the new tiles up
+	if (!cleanStepScheduled && !cleanQueue.empty()) {
+		cleanStepScheduled = true;
+		g_dispatcher().addEvent([this] { cleanStep(); }, "Map::cleanStep");
+	}
+	return count;
+}
+
+void Map::cleanStep() {
+	cleanStepScheduled = false;
+	if (cleanQueuedTiles(OTSYS_TIME(true) + MAP_CLEAN_TICK_BUDGET_MS)) {
+		return;
+	}
+
+	cleanStepScheduled = true;
+	g_dispatcher().scheduleEvent(
+		MAP_CLEAN_TICK_INTERVAL_MS, [this] { cleanStep(); }, "Map::cleanStep"
+	);
+}
+
+bool Map::cleanQueuedTiles(int64_t deadline) {
+	if (cleanQueue.empty()) {
+		return true;
+	}
+
+	while (cleanQueueIndex < cleanQueue.size()) {
+		const auto tile = std::move(cleanQueue[cleanQueueIndex++]);
+		if (const size_t removed = cleanTile(tile); removed != 0) {
+			cleanedItems += removed;
+			++cleanedTiles;
 		}
 
-		if (const auto &items = tile->getItemList()) {
-			++qntTiles;
-			for (const auto &item : *items) {
-				if (item->isCleanable()) {
-					toRemove.emplace_back(item);
-				}
-			}
+		if (OTSYS_TIME(true) >= deadline) {
+			break;
 		}
 	}
 
-	const size_t count = toRemove.size();
-	for (const auto &item : toRemove) {
-		g_game().internalRemoveItem(item, -1);
+	if (cleanQueueIndex < cleanQueue.size()) {
+		return false;
 	}
 
-	g_game().clearTilesToClean();
+	cleanQueue.clear();
+	cleanQueueIndex = 0;
+	g_logger().info("CLEAN: Removed {} item{} from {} tile{} in {} seconds", cleanedItems, (cleanedItems != 1 ? "s" : ""), cleanedTiles, (cleanedTiles != 1 ? "s" : ""), (OTSYS_TIME(true) - cleanStart) / (1000.f));
+	return true;
+}
 
-	if (g_game().getGameState() == GAME_STATE_MAINTAIN) {
-		g_game().setGameState(GAME_STATE_NORMAL);
+size_t Map::cleanTile(const std::shared_ptr<Tile> &tile) {
+	// Everything cleanable may have been picked up since the tile was queued
+	if (!tile || tile->getCleanableItemCount() == 0) {
+		return 0;
 	}
 
-	const uint64_t end = OTSYS_TIME();
-	g_logger().info("CLEAN: Removed {} item{} from {} tile{} in {} seconds", count, (count != 1 ? "s" : ""), qntTiles, (qntTiles != 1 ? "s" : ""), (end - start) / (1000.f));
-	return count;
+	const auto &items = tile->getItemList();
+	if (!items) {
+		tile->setCleanableItemCount(0);
+		return 0;
+	}
+
+	ItemVector toRemove;
+	for (const auto &item : *items) {
+		if (item->isCleanable()) {
+			toRemove.emplace_back(item);
+		}
+	}
+
+	// Send the tile once instead of one packet per removed item
+	const bool batch = toRemove.size() > 1;
+	if (batch) {
+		tile->beginBatchRemove();
+	}
+
+	size_t removed = 0;
+	for (const auto &item : toRemove) {
+		if (g_game().internalRemoveItem(item, -1) == RETURNVALUE_NOERROR) {
+			++removed;
+		}
+	}
+
+	if (batch) {
+		tile->endBatchRemove();
+	}
+
+	tile->setCleanableItemCount(static_cast<uint32_t>(toRemove.size() - removed));
+	return removed;
 }
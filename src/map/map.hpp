@@ -31,7 +31,13 @@ class FrozenPathingConditionCall;
  */
 class Map final : public MapCache {
 public:
-	uint32_t clean() const;
+	/**
+	 * Queues every tile with cleanable items to be cleaned incrementally, within a
+	 * time budget per tick, without pausing the game.
+	 * \param wait Cleans everything queued before returning, for callers that save or shut down right after
+	 * \returns The number of cleanable items queued
+	 */
+	uint32_t clean(bool wait = false);
 
 	std::filesystem::path getPath() const {
 		return path;
@@ -51,6 +57,16 @@ public:
 	 * \returns true if the main map was loaded successfully
 	 */
 	void loadMap(const std::string &identifier, bool mainMap = false, bool loadHouses = false, bool loadMonsters = false, bool loadNpcs = false, bool loadZones = false, const Position &pos = Position());
+	/**
+	 * Parses the map file only, which does not depend on scripts, so it can run
+	 * concurrently with them. loadMapData completes the load.
+	 * \param identifier Is the map file (name of file .otbm)
+	 */
+	void loadMapTiles(const std::string &identifier, bool mainMap = false, const Position &pos = Position());
+	/**
+	 * Loads everything of the map parsed by loadMapTiles that depends on scripts and the database.
+	 */
+	void loadMapData(bool mainMap = false, bool loadHouses = false, bool loadMonsters = false, bool loadNpcs = false, bool loadZones = false);
 	/**
 	 * Load the custom map
 	 * \param identifier Is the map custom folder
@@ -153,6 +169,17 @@ private:
 	}
 	std::shared_ptr<Tile> getLoadedTile(uint16_t x, uint16_t y, uint8_t z);
 
+	/**
+	 * Registers the zone positions read from the map file.
+	 * The zone registry is not thread safe, so the parser only collects them.
+	 */
+	void applyPendingZones();
+
+	void cleanStep();
+	// Cleans queued tiles until the deadline, returns whether the queue was finished
+	bool cleanQueuedTiles(int64_t deadline);
+	size_t cleanTile(const std::shared_ptr<Tile> &tile);
+
 	std::filesystem::path path;
 	std::string monsterfile;
 	std::string housefile;
@@ -162,7 +189,17 @@ private:
 	uint32_t width = 0;
 	uint32_t height = 0;
 
+	std::vector<std::pair<Position, uint16_t>> pendingZones;
+
+	std::vector<std::shared_ptr<Tile>> cleanQueue;
+	size_t cleanQueueIndex = 0;
+	size_t cleanedItems = 0;
+	size_t cleanedTiles = 0;
+	int64_t cleanStart = 0;
+	bool cleanStepScheduled = false;
+
 	friend class Game;
 	friend class IOMap;
+	friend class IOMapSnapshot;
 	friend class MapCache;
 };
@@ -18,6 +18,10 @@ static constexpr int8_t MAP_MAX_LAYERS = 16;
 static constexpr int8_t MAP_INIT_SURFACE_LAYER = 7; // (MAP_MAX_LAYERS / 2) -1
 static constexpr int8_t MAP_LAYER_VIEW_LIMIT = 2;
 
+// Map::clean removes cleanable items for at most this long per tick, then continues on the next one
+static constexpr int64_t MAP_CLEAN_TICK_BUDGET_MS = 5;
+static constexpr uint32_t MAP_CLEAN_TICK_INTERVAL_MS = 50;
+
 // SECTOR_SIZE must be power of 2 value
 // The bigger the SECTOR_SIZE is the less hash map collision there should be but it'll consume more memory
 static constexpr int32_t SECTOR_SIZE = 16;
@@ -9,6 +9,7 @@
 
 #include "map/mapcache.hpp"
 
+#include "config/configmanager.hpp"
 #include "game/movement/teleport.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "game/zones/zone.hpp"
@@ -18,67 +19,335 @@
 #include "items/item.hpp"
 #include "map/map.hpp"
 #include "utils/hash.hpp"
+#include "utils/tools.hpp"
+
+namespace {
+	struct BasicStorage {
+		// Entry 0 of each table is the reserved "none" handle
+		std::vector<BasicItem> items { BasicItem {} };
+		std::vector<BasicTile> tiles { BasicTile {} };
+		std::vector<std::string> texts { std::string {} };
+		// Children of items and items of tiles, referenced by offset and count
+		std::vector<BasicItemHandle> handles;
+
+		phmap::flat_hash_map<size_t, BasicItemHandle> itemIndex;
+		phmap::flat_hash_map<size_t, BasicTileHandle> tileIndex;
+		phmap::flat_hash_map<std::string, uint32_t> textIndex;
+
+		size_t references = 0;
+	};
+
+	BasicStorage basicStorage;
+
+	uint32_t storeHandles(std::span<const BasicItemHandle> refs) {
+		const auto offset = static_cast<uint32_t>(basicStorage.handles.size());
+		basicStorage.handles.insert(basicStorage.handles.end(), refs.begin(), refs.end());
+		return offset;
+	}
+
+	/**
+	 * Whether a materialized item is still exactly what its cache entry creates and nothing besides
+	 * its owners holds on to it (decay, unique ids, open containers, scripts...).
+	 * \param owners References expected to be held by the tile or container the item is in
+	 */
+	bool isPristineItem(const std::shared_ptr<Item> &item, long owners, BasicItemHandle handle) {
+		if (!item || item.use_count() != owners) {
+			return false;
+		}
+
+		const auto &basicItem = MapCache::getBasicItem(handle);
+		if (item->getID() != basicItem.id || basicItem.uniqueId != 0 || item->hasAttribute(ItemAttribute_t::UNIQUEID) || item->hasCustomAttribute()) {
+			return false;
+		}
+
+		if (item->getAttribute<uint16_t>(ItemAttribute_t::ACTIONID) != basicItem.actionId) {
+			return false;
+		}
+
+		if (basicItem.charges > 0 && item->getSubType() != basicItem.charges) {
+			return false;
+		}
+
+		if (item->getString(ItemAttribute_t::TEXT) != MapCache::getText(basicItem)) {
+			return false;
+		}
+
+		const auto children = MapCache::getChildren(basicItem);
+		const auto &container = item->getContainer();
+		if (!container) {
+			return children.empty();
+		}
 
-static phmap::flat_hash_map<size_t, std::shared_ptr<BasicItem>> items;
-static phmap::flat_hash_map<size_t, std::shared_ptr<BasicTile>> tiles;
+		if (container->size() != children.size()) {
+			return false;
+		}
 
-std::shared_ptr<BasicItem> static_tryGetItemFromCache(const std::shared_ptr<BasicItem> &ref) {
-	return ref ? items.try_emplace(ref->hash(), ref).first->second : nullptr;
+		// Children are added in cache order when the container is materialized
+		size_t index = 0;
+		for (const auto &child : container->getItemList()) {
+			if (!isPristineItem(child, 1, children[index++])) {
+				return false;
+			}
+		}
+		return true;
+	}
 }
 
-std::shared_ptr<BasicTile> static_tryGetTileFromCache(const std::shared_ptr<BasicTile> &ref) {
-	return ref ? tiles.try_emplace(ref->hash(), ref).first->second : nullptr;
+BasicItemHandle static_tryGetItemFromCache(const BasicItem &ref, std::span<const BasicItemHandle> children) {
+	const auto [it, inserted] = basicStorage.itemIndex.try_emplace(ref.hash(children), 0);
+	if (inserted) {
+		auto &item = basicStorage.items.emplace_back(ref);
+		item.childCount = static_cast<uint16_t>(children.size());
+		item.firstChild = children.empty() ? 0 : storeHandles(children);
+		it->second = static_cast<BasicItemHandle>(basicStorage.items.size() - 1);
+	}
+	++basicStorage.references;
+	return it->second;
+}
+
+BasicTileHandle static_tryGetTileFromCache(const BasicTile &ref, std::span<const BasicItemHandle> items) {
+	const auto [it, inserted] = basicStorage.tileIndex.try_emplace(ref.hash(items), 0);
+	if (inserted) {
+		auto &tile = basicStorage.tiles.emplace_back(ref);
+		tile.itemCount = static_cast<uint16_t>(items.size());
+		tile.firstItem = items.empty() ? 0 : storeHandles(items);
+		it->second = static_cast<BasicTileHandle>(basicStorage.tiles.size() - 1);
+	}
+	++basicStorage.references;
+	return it->second;
 }
 
 void MapCache::flush() const {
-	items.clear();
-	tiles.clear();
+	basicStorage.itemIndex.clear();
+	basicStorage.tileIndex.clear();
+	basicStorage.textIndex.clear();
+}
+
+const BasicItem &MapCache::getBasicItem(BasicItemHandle handle) {
+	return basicStorage.items[handle];
+}
+
+const BasicTile &MapCache::getBasicTile(BasicTileHandle handle) {
+	return basicStorage.tiles[handle];
 }
 
-void MapCache::parseItemAttr(const std::shared_ptr<BasicItem> &BasicItem, const std::shared_ptr<Item> &item) const {
-	if (BasicItem->charges > 0) {
-		item->setSubType(BasicItem->charges);
+std::span<const BasicItemHandle> MapCache::getChildren(const BasicItem &item) {
+	return { basicStorage.handles.data() + item.firstChild, item.childCount };
+}
+
+std::span<const BasicItemHandle> MapCache::getItems(const BasicTile &tile) {
+	return { basicStorage.handles.data() + tile.firstItem, tile.itemCount };
+}
+
+const std::string &MapCache::getText(const BasicItem &item) {
+	return basicStorage.texts[item.text];
+}
+
+uint32_t MapCache::internText(const std::string &text) {
+	if (text.empty()) {
+		return 0;
 	}
 
-	if (BasicItem->actionId > 0) {
-		item->setAttribute(ItemAttribute_t::ACTIONID, BasicItem->actionId);
+	const auto [it, inserted] = basicStorage.textIndex.try_emplace(text, 0);
+	if (inserted) {
+		basicStorage.texts.emplace_back(text);
+		it->second = static_cast<uint32_t>(basicStorage.texts.size() - 1);
 	}
+	return it->second;
+}
 
-	if (BasicItem->uniqueId > 0) {
-		item->addUniqueId(BasicItem->uniqueId);
+void MapCache::logMemoryUsage() const {
+	size_t textBytes = 0;
+	for (const auto &text : basicStorage.texts) {
+		textBytes += sizeof(std::string) + (text.capacity() > 15 ? text.capacity() : 0);
 	}
 
-	if (item->getTeleport() && (BasicItem->destX != 0 || BasicItem->destY != 0 || BasicItem->destZ != 0)) {
-		const auto dest = Position(BasicItem->destX, BasicItem->destY, BasicItem->destZ);
+	const size_t tableBytes = basicStorage.items.capacity() * sizeof(BasicItem)
+		+ basicStorage.tiles.capacity() * sizeof(BasicTile)
+		+ basicStorage.handles.capacity() * sizeof(BasicItemHandle)
+		+ textBytes;
+
+	// Every entry used to be a make_shared allocation (object + control block) holding its own
+	// string and vector, and every reference to it a 16 byte shared_ptr instead of a 4 byte handle.
+	constexpr size_t sharedEntryOverhead = 16 + sizeof(std::string) + sizeof(std::vector<BasicItemHandle>);
+	const size_t entries = basicStorage.items.size() + basicStorage.tiles.size() - 2;
+	const size_t references = basicStorage.references;
+	const size_t sharedBytes = (basicStorage.items.size() - 1) * sizeof(BasicItem)
+		+ (basicStorage.tiles.size() - 1) * sizeof(BasicTile)
+		+ entries * sharedEntryOverhead
+		+ references * sizeof(std::shared_ptr<BasicItem>);
+	const size_t handleBytes = tableBytes + references * sizeof(BasicItemHandle);
+
+	g_logger().info("Map cache: {} items, {} tiles, {} texts using {:.2f} MB ({:.2f} MB saved by pooled storage)", basicStorage.items.size() - 1, basicStorage.tiles.size() - 1, basicStorage.texts.size() - 1, handleBytes / 1048576.0, sharedBytes > handleBytes ? (sharedBytes - handleBytes) / 1048576.0 : 0.0);
+}
+
+size_t MapCache::getMaterializedMemoryUsage() const {
+	return materializedTiles.load(std::memory_order_relaxed) * sizeof(DynamicTile)
+		+ materializedItems.load(std::memory_order_relaxed) * sizeof(Item);
+}
+
+bool MapCache::hasPlayersNearby(uint32_t sectorX, uint32_t sectorY) const {
+	// Sectors are larger than the client view, so the surrounding ones cover everything a player sees
+	for (int32_t dx = -SECTOR_SIZE; dx <= SECTOR_SIZE; dx += SECTOR_SIZE) {
+		for (int32_t dy = -SECTOR_SIZE; dy <= SECTOR_SIZE; dy += SECTOR_SIZE) {
+			const int64_t x = static_cast<int64_t>(sectorX) + dx;
+			const int64_t y = static_cast<int64_t>(sectorY) + dy;
+			if (x < 0 || y < 0) {
+				continue;
+			}
+
+			const auto sector = getMapSector(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+			if (sector && !sector->player_list.empty()) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool MapCache::tryEvictTile(Floor &floor, uint16_t x, uint16_t y) {
+	const auto origin = floor.getMaterializedTileOrigin(x, y);
+	if (origin == 0) {
+		return false;
+	}
+
+	// Only the floor may hold the tile, anything else (spectator caches, pending tasks...) keeps it alive
+	const auto &tile = floor.getTileUnlocked(x, y);
+	if (!tile || tile.use_count() != 1 || tile->isModified() || tile->getCreatureCount() != 0) {
+		return false;
+	}
+
+	const auto &basicTile = getBasicTile(origin);
+	if (basicTile.isHouse() || tile->getHouse()) {
+		return false;
+	}
+
+	// getGround returns a copy, hence the extra owner
+	const auto ground = tile->getGround();
+	if ((ground == nullptr) != (basicTile.ground == 0) || (ground && !isPristineItem(ground, 2, basicTile.ground))) {
+		return false;
+	}
+
+	const auto basicItems = getItems(basicTile);
+	if (tile->getItemCount() != basicItems.size()) {
+		return false;
+	}
+
+	if (const auto items = tile->getItemList()) {
+		// Down items are stacked in reverse order, so match them regardless of position
+		std::vector<BasicItemHandle> pending(basicItems.begin(), basicItems.end());
+		for (const auto &item : *items) {
+			const auto it = std::ranges::find_if(pending, [&](BasicItemHandle handle) {
+				return item && item->getID() == getBasicItem(handle).id;
+			});
+			if (it == pending.end() || !isPristineItem(item, 1, *it)) {
+				return false;
+			}
+			pending.erase(it);
+		}
+	}
+
+	// The destructors of the tile and its items take them off the materialized counts
+	floor.evictTile(x, y);
+	return true;
+}
+
+void MapCache::evictColdTiles() {
+	const auto budget = static_cast<size_t>(std::max<int32_t>(0, g_configManager().getNumber(MAP_EVICTION_MEMORY_BUDGET))) * 1024 * 1024;
+	if (budget == 0 || getMaterializedMemoryUsage() <= budget) {
+		return;
+	}
+
+	Benchmark bm_evict;
+	const int64_t idleTime = static_cast<int64_t>(g_configManager().getNumber(MAP_EVICTION_IDLE_TIME)) * 1000;
+	const int64_t now = OTSYS_TIME();
+	const size_t usageBefore = getMaterializedMemoryUsage();
+
+	size_t evictedTiles = 0;
+	for (auto &[key, sector] : mapSectors) {
+		const int64_t lastAccess = sector.getLastAccess();
+		if (lastAccess == 0 || now - lastAccess < idleTime) {
+			continue;
+		}
+
+		const uint32_t sectorX = (key & 0xFFFF) * SECTOR_SIZE;
+		const uint32_t sectorY = (key >> 16) * SECTOR_SIZE;
+		if (hasPlayersNearby(sectorX, sectorY)) {
+			continue;
+		}
+
+		for (uint8_t z = 0; z < MAP_MAX_LAYERS; ++z) {
+			const auto &floor = sector.getFloor(z);
+			if (!floor) {
+				continue;
+			}
+
+			std::unique_lock l(floor->getMutex());
+			for (uint16_t x = 0; x < SECTOR_SIZE; ++x) {
+				for (uint16_t y = 0; y < SECTOR_SIZE; ++y) {
+					if (tryEvictTile(*floor, static_cast<uint16_t>(sectorX + x), static_cast<uint16_t>(sectorY + y))) {
+						++evictedTiles;
+					}
+				}
+			}
+		}
+
+		// Whatever is left is modified or in use, skip the sector until it is accessed again
+		sector.lastAccess.store(0, std::memory_order_relaxed);
+
+		if (getMaterializedMemoryUsage() <= budget) {
+			break;
+		}
+	}
+
+	g_logger().debug("Evicted {} cold map tiles ({:.2f} MB to {:.2f} MB) in {} milliseconds", evictedTiles, usageBefore / 1048576.0, getMaterializedMemoryUsage() / 1048576.0, bm_evict.duration());
+}
+
+void MapCache::parseItemAttr(const BasicItem &BasicItem, const std::shared_ptr<Item> &item) const {
+	if (BasicItem.charges > 0) {
+		item->setSubType(BasicItem.charges);
+	}
+
+	if (BasicItem.actionId > 0) {
+		item->setAttribute(ItemAttribute_t::ACTIONID, BasicItem.actionId);
+	}
+
+	if (BasicItem.uniqueId > 0) {
+		item->addUniqueId(BasicItem.uniqueId);
+	}
+
+	if (item->getTeleport() && (BasicItem.destX != 0 || BasicItem.destY != 0 || BasicItem.destZ != 0)) {
+		const auto dest = Position(BasicItem.destX, BasicItem.destY, BasicItem.destZ);
 		item->getTeleport()->setDestPos(dest);
 	}
 
-	if (item->getDoor() && BasicItem->doorOrDepotId != 0) {
-		item->getDoor()->setDoorId(BasicItem->doorOrDepotId);
+	if (item->getDoor() && BasicItem.doorOrDepotId != 0) {
+		item->getDoor()->setDoorId(BasicItem.doorOrDepotId);
 	}
 
-	if (item->getContainer() && item->getContainer()->getDepotLocker() && BasicItem->doorOrDepotId != 0) {
-		item->getContainer()->getDepotLocker()->setDepotId(BasicItem->doorOrDepotId);
+	if (item->getContainer() && item->getContainer()->getDepotLocker() && BasicItem.doorOrDepotId != 0) {
+		item->getContainer()->getDepotLocker()->setDepotId(BasicItem.doorOrDepotId);
 	}
 
-	if (!BasicItem->text.empty()) {
-		item->setAttribute(ItemAttribute_t::TEXT, BasicItem->text);
+	if (BasicItem.text != 0) {
+		item->setAttribute(ItemAttribute_t::TEXT, getText(BasicItem));
 	}
 
 	/* if (BasicItem.description != 0)
 	    item->setAttribute(ItemAttribute_t::DESCRIPTION, STRING_CACHE[BasicItem.description]);*/
 }
 
-std::shared_ptr<Item> MapCache::createItem(const std::shared_ptr<BasicItem> &BasicItem, Position position) {
-	const auto &item = Item::CreateItem(BasicItem->id, position);
+std::shared_ptr<Item> MapCache::createItem(BasicItemHandle handle, Position position) {
+	const auto &BasicItem = getBasicItem(handle);
+	const auto &item = Item::CreateItem(BasicItem.id, position);
 	if (!item) {
 		return nullptr;
 	}
 
 	parseItemAttr(BasicItem, item);
 
-	if (item->getContainer() && !BasicItem->items.empty()) {
-		for (const auto &BasicItemInside : BasicItem->items) {
+	if (item->getContainer() && BasicItem.childCount != 0) {
+		for (const auto BasicItemInside : getChildren(BasicItem)) {
 			if (auto itemInsede = createItem(BasicItemInside, position)) {
 				item->getContainer()->addItem(itemInsede);
 				item->getContainer()->updateItemWeight(itemInsede->getWeight());
@@ -95,17 +364,21 @@ std::shared_ptr<Item> MapCache::createItem(const std::shared_ptr<BasicItem> &Bas
 	}
 	item->loadedFromMap = true;
 	item->decayDisabled = Item::items[item->getID()].decayTo != -1;
+	item->materializedFromCache = true;
+	materializedItems.fetch_add(1, std::memory_order_relaxed);
 
 	return item;
 }
 
 std::shared_ptr<Tile> MapCache::getOrCreateTileFromCache(const std::shared_ptr<Floor> &floor, uint16_t x, uint16_t y) {
-	const auto &cachedTile = floor->getTileCache(x, y);
+	const auto cachedHandle = floor->getTileCache(x, y);
 	const auto oldTile = floor->getTile(x, y);
-	if (!cachedTile) {
+	if (cachedHandle == 0) {
 		return oldTile;
 	}
 
+	const auto* cachedTile = &getBasicTile(cachedHandle);
+
 	std::unique_lock l(floor->getMutex());
 
 	const uint8_t z = floor->getZ();
@@ -139,11 +412,11 @@ std::shared_ptr<Tile> MapCache::getOrCreateTileFromCache(const std::shared_ptr<F
 		tile = std::make_shared<DynamicTile>(pos);
 	}
 
-	if (cachedTile->ground != nullptr) {
+	if (cachedTile->ground != 0) {
 		tile->internalAddThing(createItem(cachedTile->ground, pos));
 	}
 
-	for (const auto &BasicItemd : cachedTile->items) {
+	for (const auto BasicItemd : getItems(*cachedTile)) {
 		tile->internalAddThing(createItem(BasicItemd, pos));
 	}
 
@@ -161,28 +434,35 @@ std::shared_ptr<Tile> MapCache::getOrCreateTileFromCache(const std::shared_ptr<F
 
 	floor->setTile(x, y, tile);
 
-	// Remove Tile from cache
-	floor->setTileCache(x, y, nullptr);
+	// Keep the cache entry, so the tile can be evicted back to it once its region is cold
+	floor->setTileMaterialized(x, y);
+	tile->materializedFromCache = true;
+	materializedTiles.fetch_add(1, std::memory_order_relaxed);
 
 	return tile;
 }
 
-void MapCache::setBasicTile(uint16_t x, uint16_t y, uint8_t z, const std::shared_ptr<BasicTile> &newTile) {
+BasicTileHandle MapCache::setBasicTile(uint16_t x, uint16_t y, uint8_t z, const BasicTile &newTile, std::span<const BasicItemHandle> items) {
 	if (z >= MAP_MAX_LAYERS) {
 		g_logger().error("Attempt to set tile on invalid coordinate: {}", Position(x, y, z).toString());
-		return;
+		return 0;
 	}
 
-	const auto &tile = static_tryGetTileFromCache(newTile);
+	const auto tile = static_tryGetTileFromCache(newTile, items);
 	if (const auto sector = getMapSector(x, y)) {
 		sector->createFloor(z)->setTileCache(x, y, tile);
 	} else {
 		getBestMapSector(x, y)->createFloor(z)->setTileCache(x, y, tile);
 	}
+	return tile;
+}
+
+BasicItemHandle MapCache::tryReplaceItemFromCache(const BasicItem &ref, std::span<const BasicItemHandle> children) const {
+	return static_tryGetItemFromCache(ref, children);
 }
 
-std::shared_ptr<BasicItem> MapCache::tryReplaceItemFromCache(const std::shared_ptr<BasicItem> &ref) const {
-	return static_tryGetItemFromCache(ref);
+BasicTileHandle MapCache::tryReplaceTileFromCache(const BasicTile &ref, std::span<const BasicItemHandle> items) const {
+	return static_tryGetTileFromCache(ref, items);
 }
 
 MapSector* MapCache::createMapSector(const uint32_t x, const uint32_t y) {
@@ -225,47 +505,46 @@ MapSector* MapCache::getBestMapSector(uint32_t x, uint32_t y) {
 	return sector;
 }
 
-void BasicTile::hash(size_t &h) const {
-	const std::array<uint32_t, 4> arr = { flags, houseId, type, isStatic };
+size_t BasicTile::hash(std::span<const BasicItemHandle> items) const {
+	size_t h = 0;
+	const std::array<uint32_t, 5> arr = { flags, houseId, type, isStatic, ground };
 	for (const auto v : arr) {
 		if (v > 0) {
 			stdext::hash_combine(h, v);
 		}
 	}
 
-	if (ground != nullptr) {
-		ground->hash(h);
-	}
-
+	// Items are already deduplicated, so equal handles mean equal content
 	if (!items.empty()) {
 		stdext::hash_combine(h, items.size());
-		for (const auto &item : items) {
-			item->hash(h);
+		for (const auto item : items) {
+			stdext::hash_combine(h, item);
 		}
 	}
+
+	return h;
 }
 
-void BasicItem::hash(size_t &h) const {
-	const std::array<uint32_t, 8> arr = { id, charges, actionId, uniqueId, destX, destY, destZ, doorOrDepotId };
+size_t BasicItem::hash(std::span<const BasicItemHandle> children) const {
+	size_t h = 0;
+	const std::array<uint32_t, 9> arr = { id, charges, actionId, uniqueId, destX, destY, destZ, doorOrDepotId, text };
 	for (const auto v : arr) {
 		if (v > 0) {
 			stdext::hash_combine(h, v);
 		}
 	}
 
-	if (!text.empty()) {
-		stdext::hash_combine(h, text);
-	}
-
-	if (!items.empty()) {
-		stdext::hash_combine(h, items.size());
-		for (const auto &item : items) {
-			item->hash(h);
+	if (!children.empty()) {
+		stdext::hash_combine(h, children.size());
+		for (const auto child : children) {
+			stdext::hash_combine(h, child);
 		}
 	}
+
+	return h;
 }
 
-bool BasicItem::unserializeItemNode(FileStream &stream, uint16_t x, uint16_t y, uint8_t z) {
+bool BasicItem::unserializeItemNode(FileStream &stream, uint16_t x, uint16_t y, uint8_t z, std::vector<BasicItemHandle> &children) {
 	if (stream.isProp(OTB::Node::END)) {
 		stream.back();
 		return true;
@@ -280,14 +559,15 @@ bool BasicItem::unserializeItemNode(FileStream &stream, uint16_t x, uint16_t y,
 
 		const uint16_t streamId = stream.getU16();
 
-		const auto item = std::make_shared<BasicItem>();
-		item->id = streamId;
+		BasicItem item;
+		item.id = streamId;
 
-		if (!item->unserializeItemNode(stream, x, y, z)) {
+		std::vector<BasicItemHandle> itemChildren;
+		if (!item.unserializeItemNode(stream, x, y, z, itemChildren)) {
 			throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Failed to load item.", x, y, z));
 		}
 
-		items.emplace_back(static_tryGetItemFromCache(item));
+		children.emplace_back(static_tryGetItemFromCache(item, itemChildren));
 
 		if (!stream.endNode()) {
 			throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not end node.", x, y, z));
@@ -335,7 +615,7 @@ void BasicItem::readAttr(FileStream &stream) {
 			case ATTR_TEXT: {
 				const auto str = stream.getString();
 				if (!str.empty()) {
-					text = str;
+					text = MapCache::internText(str);
 				}
 			} break;
 
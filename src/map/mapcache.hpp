@@ -18,11 +18,21 @@ class Item;
 struct Position;
 class FileStream;
 
+/**
+ * Handles into the contiguous BasicItem/BasicTile tables of the map cache.
+ * Handle 0 is reserved, so a zero-initialized handle never refers to an entry.
+ */
+using BasicItemHandle = uint32_t;
+using BasicTileHandle = uint32_t;
+
 #pragma pack(1)
 struct BasicItem {
-	std::string text;
+	uint32_t text { 0 }; // Interned string handle, 0 is an empty text
 	// size_t description { 0 };
 
+	uint32_t firstChild { 0 }; // Offset in the shared handle table
+	uint16_t childCount { 0 };
+
 	uint16_t id { 0 };
 
 	uint16_t charges { 0 }; // Runecharges and Count Too
@@ -33,26 +43,17 @@ struct BasicItem {
 
 	uint8_t destZ { 0 };
 
-	std::vector<std::shared_ptr<BasicItem>> items;
-
-	bool unserializeItemNode(FileStream &propStream, uint16_t x, uint16_t y, uint8_t z);
+	bool unserializeItemNode(FileStream &propStream, uint16_t x, uint16_t y, uint8_t z, std::vector<BasicItemHandle> &children);
 	void readAttr(FileStream &propStream);
 
-	size_t hash() const {
-		size_t h = 0;
-		hash(h);
-		return h;
-	}
-
-private:
-	void hash(size_t &h) const;
-
-	friend struct BasicTile;
+	size_t hash(std::span<const BasicItemHandle> children) const;
 };
 
 struct BasicTile {
-	std::shared_ptr<BasicItem> ground { nullptr };
-	std::vector<std::shared_ptr<BasicItem>> items;
+	BasicItemHandle ground { 0 };
+
+	uint32_t firstItem { 0 }; // Offset in the shared handle table
+	uint16_t itemCount { 0 };
 
 	uint32_t flags { 0 }, houseId { 0 };
 	uint8_t type { TILESTATE_NONE };
@@ -60,21 +61,14 @@ struct BasicTile {
 	bool isStatic { false };
 
 	bool isEmpty(bool ignoreFlag = false) const {
-		return (ignoreFlag || flags == 0) && ground == nullptr && items.empty();
+		return (ignoreFlag || flags == 0) && ground == 0 && itemCount == 0;
 	}
 
 	bool isHouse() const {
 		return houseId != 0;
 	}
 
-	size_t hash() const {
-		size_t h = 0;
-		hash(h);
-		return h;
-	}
-
-private:
-	void hash(size_t &h) const;
+	size_t hash(std::span<const BasicItemHandle> items) const;
 };
 
 #pragma pack()
@@ -83,12 +77,51 @@ class MapCache {
 public:
 	virtual ~MapCache() = default;
 
-	void setBasicTile(uint16_t x, uint16_t y, uint8_t z, const std::shared_ptr<BasicTile> &BasicTile);
+	BasicTileHandle setBasicTile(uint16_t x, uint16_t y, uint8_t z, const BasicTile &newTile, std::span<const BasicItemHandle> items);
 
-	std::shared_ptr<BasicItem> tryReplaceItemFromCache(const std::shared_ptr<BasicItem> &ref) const;
+	BasicItemHandle tryReplaceItemFromCache(const BasicItem &ref, std::span<const BasicItemHandle> children) const;
+	BasicTileHandle tryReplaceTileFromCache(const BasicTile &ref, std::span<const BasicItemHandle> items) const;
 
+	/**
+	 * Drops the deduplication indexes built while loading a map.
+	 * The item/tile tables are kept, since the map sectors refer to them by handle.
+	 */
 	void flush() const;
 
+	static const BasicItem &getBasicItem(BasicItemHandle handle);
+	static const BasicTile &getBasicTile(BasicTileHandle handle);
+	static std::span<const BasicItemHandle> getChildren(const BasicItem &item);
+	static std::span<const BasicItemHandle> getItems(const BasicTile &tile);
+	static const std::string &getText(const BasicItem &item);
+	static uint32_t internText(const std::string &text);
+
+	/**
+	 * Logs the size of the item/tile tables and the memory saved compared to
+	 * individually allocated, reference counted entries.
+	 */
+	void logMemoryUsage() const;
+
+	/**
+	 * Estimated memory used by the tiles and items materialized from the cache.
+	 */
+	size_t getMaterializedMemoryUsage() const;
+
+	// Called when an item or tile created from the cache is destroyed, however it left the map
+	static void onMaterializedItemDestroyed() {
+		materializedItems.fetch_sub(1, std::memory_order_relaxed);
+	}
+	static void onMaterializedTileDestroyed() {
+		materializedTiles.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Returns materialized tiles of cold regions back to their BasicTile cache entry while the
+	 * materialized tiles are over the configured memory budget.
+	 * A region is cold when it was not accessed for the configured idle time and has no players nearby;
+	 * only tiles without creatures whose items are untouched and not referenced anywhere else are evicted.
+	 */
+	void evictColdTiles();
+
 	/**
 	 * Creates a map sector.
 	 * \returns A pointer to that map sector.
@@ -116,6 +149,12 @@ protected:
 	std::unordered_map<uint32_t, MapSector> mapSectors;
 
 private:
-	void parseItemAttr(const std::shared_ptr<BasicItem> &BasicItem, const std::shared_ptr<Item> &item) const;
-	std::shared_ptr<Item> createItem(const std::shared_ptr<BasicItem> &BasicItem, Position position);
+	bool tryEvictTile(Floor &floor, uint16_t x, uint16_t y);
+	bool hasPlayersNearby(uint32_t sectorX, uint32_t sectorY) const;
+
+	void parseItemAttr(const BasicItem &BasicItem, const std::shared_ptr<Item> &item) const;
+	std::shared_ptr<Item> createItem(BasicItemHandle handle, Position position);
+
+	inline static std::atomic<size_t> materializedTiles { 0 };
+	inline static std::atomic<size_t> materializedItems { 0 };
 };
@@ -10,9 +10,14 @@
 #include "map/utils/mapsector.hpp"
 
 #include "creatures/creature.hpp"
+#include "utils/tools.hpp"
 
 bool MapSector::newSector = false;
 
+void MapSector::touch() {
+	lastAccess.store(OTSYS_TIME(), std::memory_order_relaxed);
+}
+
 void MapSector::addCreature(const std::shared_ptr<Creature> &c) {
 	creature_list.emplace_back(c);
 	if (c->getPlayer()) {
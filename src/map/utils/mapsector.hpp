@@ -13,7 +13,7 @@
 
 class Creature;
 class Tile;
-struct BasicTile;
+using BasicTileHandle = uint32_t;
 
 struct Floor {
 	explicit Floor(uint8_t z) :
@@ -21,20 +21,49 @@ struct Floor {
 
 	std::shared_ptr<Tile> getTile(uint16_t x, uint16_t y) const {
 		std::shared_lock<std::shared_mutex> sl(mutex);
-		return tiles[x & SECTOR_MASK][y & SECTOR_MASK].first;
+		return tiles[x & SECTOR_MASK][y & SECTOR_MASK];
 	}
 
 	void setTile(uint16_t x, uint16_t y, std::shared_ptr<Tile> tile) {
-		tiles[x & SECTOR_MASK][y & SECTOR_MASK].first = std::move(tile);
+		tiles[x & SECTOR_MASK][y & SECTOR_MASK] = std::move(tile);
 	}
 
-	std::shared_ptr<BasicTile> getTileCache(uint16_t x, uint16_t y) const {
+	/**
+	 * \returns The cache entry still waiting to be materialized, or 0 if the tile was already created.
+	 */
+	BasicTileHandle getTileCache(uint16_t x, uint16_t y) const {
 		std::shared_lock<std::shared_mutex> sl(mutex);
-		return tiles[x & SECTOR_MASK][y & SECTOR_MASK].second;
+		const auto handle = tileCache[x & SECTOR_MASK][y & SECTOR_MASK];
+		return (handle & MATERIALIZED_TILE) != 0 ? 0 : handle;
 	}
 
-	void setTileCache(uint16_t x, uint16_t y, const std::shared_ptr<BasicTile> &newTile) {
-		tiles[x & SECTOR_MASK][y & SECTOR_MASK].second = newTile;
+	void setTileCache(uint16_t x, uint16_t y, BasicTileHandle newTile) {
+		tileCache[x & SECTOR_MASK][y & SECTOR_MASK] = newTile;
+	}
+
+	/**
+	 * Marks the cache entry as materialized, the handle is kept so the tile can be evicted back to it.
+	 */
+	void setTileMaterialized(uint16_t x, uint16_t y) {
+		auto &handle = tileCache[x & SECTOR_MASK][y & SECTOR_MASK];
+		if (handle != 0) {
+			handle |= MATERIALIZED_TILE;
+		}
+	}
+
+	// The following accessors do not lock, the caller must hold the floor mutex.
+	const std::shared_ptr<Tile> &getTileUnlocked(uint16_t x, uint16_t y) const {
+		return tiles[x & SECTOR_MASK][y & SECTOR_MASK];
+	}
+
+	BasicTileHandle getMaterializedTileOrigin(uint16_t x, uint16_t y) const {
+		const auto handle = tileCache[x & SECTOR_MASK][y & SECTOR_MASK];
+		return (handle & MATERIALIZED_TILE) != 0 ? handle & ~MATERIALIZED_TILE : 0;
+	}
+
+	void evictTile(uint16_t x, uint16_t y) {
+		tiles[x & SECTOR_MASK][y & SECTOR_MASK].reset();
+		tileCache[x & SECTOR_MASK][y & SECTOR_MASK] &= ~MATERIALIZED_TILE;
 	}
 
 	const auto &getTiles() const {
@@ -51,7 +80,10 @@ struct Floor {
 	}
 
 private:
-	std::pair<std::shared_ptr<Tile>, std::shared_ptr<BasicTile>> tiles[SECTOR_SIZE][SECTOR_SIZE] = {};
+	static constexpr BasicTileHandle MATERIALIZED_TILE = 1u << 31;
+
+	std::shared_ptr<Tile> tiles[SECTOR_SIZE][SECTOR_SIZE] = {};
+	BasicTileHandle tileCache[SECTOR_SIZE][SECTOR_SIZE] = {};
 
 	mutable std::shared_mutex mutex;
 
@@ -88,6 +120,15 @@ public:
 		return floors[z];
 	}
 
+	/**
+	 * Stamps the sector as accessed, cold sectors are candidates for tile eviction.
+	 */
+	void touch();
+
+	int64_t getLastAccess() const {
+		return lastAccess.load(std::memory_order_relaxed);
+	}
+
 	void addCreature(const std::shared_ptr<Creature> &c);
 
 	void removeCreature(const std::shared_ptr<Creature> &c);
@@ -109,6 +150,8 @@ private:
 
 	uint32_t floorBits = 0;
 
+	std::atomic<int64_t> lastAccess { 0 };
+
 	friend class Spectators;
 	friend class MapCache;
 };
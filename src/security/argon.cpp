@@ -14,6 +14,9 @@
 
 #include <argon2.h>
 
+// Built once, constructing it is much slower than matching a hash
+const std::regex Argon2::re("\\$([A-Za-z0-9+/]+)\\$([A-Za-z0-9+/]+)");
+
 Argon2::Argon2() {
 	updateConstants();
 }
@@ -53,7 +56,6 @@ uint32_t Argon2::parseBitShift(const std::string &bitShiftStr) const {
 }
 
 bool Argon2::verifyPassword(const std::string &password, const std::string &phash) const {
-	const std::regex re("\\$([A-Za-z0-9+/]+)\\$([A-Za-z0-9+/]+)");
 	std::smatch match;
 	if (!std::regex_search(phash, match, re)) {
 		g_logger().debug("No argon2 hash found in string");
@@ -23,8 +23,8 @@ ConnectionManager &ConnectionManager::getInstance() {
 	return inject<ConnectionManager>();
 }
 
-Connection_ptr ConnectionManager::createConnection(asio::io_service &io_service, const ConstServicePort_ptr &servicePort) {
-	auto connection = std::make_shared<Connection>(io_service, servicePort);
+Connection_ptr ConnectionManager::createConnection(asio::io_service &io_service, const ConstServicePort_ptr &servicePort, const std::shared_ptr<NetworkReactor> &reactor /* = nullptr*/) {
+	auto connection = std::make_shared<Connection>(reactor ? reactor->getIoContext() : io_service, servicePort, reactor);
 	connections.emplace(connection);
 	return connection;
 }
@@ -51,11 +51,25 @@ void ConnectionManager::closeAll() {
 	connections.clear();
 }
 
-Connection::Connection(asio::io_service &initIoService, ConstServicePort_ptr initservicePort) :
+Connection::Connection(asio::io_service &initIoService, ConstServicePort_ptr initservicePort, std::shared_ptr<NetworkReactor> initReactor /* = nullptr*/) :
+	reactor(std::move(initReactor)),
 	readTimer(initIoService),
 	writeTimer(initIoService),
 	service_port(std::move(initservicePort)),
 	socket(initIoService), m_msg() {
+	if (reactor) {
+		reactor->onConnectionOpen();
+	}
+	if (g_configManager().getBoolean(COALESCE_SOCKET_IO)) {
+		receiveBuffer = std::make_unique<ReceiveBuffer>(CONNECTION_RECEIVE_BUFFER_SIZE);
+		coalesceWrites = true;
+	}
+}
+
+Connection::~Connection() {
+	if (reactor) {
+		reactor->onConnectionClose();
+	}
 }
 
 void Connection::close(bool force) {
@@ -116,7 +130,7 @@ void Connection::acceptInternal(bool toggleParseHeader) {
 	readTimer.async_wait([self = std::weak_ptr<Connection>(shared_from_this())](const std::error_code &error) { Connection::handleTimeout(self, error); });
 
 	try {
-		asio::async_read(socket, asio::buffer(m_msg.getBuffer(), HEADER_LENGTH), [self = shared_from_this(), toggleParseHeader](const std::error_code &error, std::size_t N) {
+		asyncRead(m_msg.getBuffer(), HEADER_LENGTH, [self = shared_from_this(), toggleParseHeader](const std::error_code &error) {
 			if (toggleParseHeader) {
 				self->parseHeader(error);
 			} else {
@@ -159,7 +173,7 @@ void Connection::parseProxyIdentification(const std::error_code &error) {
 					readTimer.async_wait([self = std::weak_ptr<Connection>(shared_from_this())](const std::error_code &error) { Connection::handleTimeout(self, error); });
 
 					// Read the remainder of proxy identification
-					asio::async_read(socket, asio::buffer(m_msg.getBuffer(), remainder), [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->parseProxyIdentification(error); });
+					asyncRead(m_msg.getBuffer(), remainder, [self = shared_from_this()](const std::error_code &error) { self->parseProxyIdentification(error); });
 				} catch (const std::system_error &e) {
 					g_logger().error("Connection::parseProxyIdentification] - error: {}", e.what());
 					close(FORCE_CLOSE);
@@ -226,7 +240,7 @@ void Connection::parseHeader(const std::error_code &error) {
 		// Read packet content
 		m_msg.setLength(size + HEADER_LENGTH);
 		// Read the remainder of proxy identification
-		asio::async_read(socket, asio::buffer(m_msg.getBodyBuffer(), size), [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->parsePacket(error); });
+		asyncRead(m_msg.getBodyBuffer(), size, [self = shared_from_this()](const std::error_code &error) { self->parsePacket(error); });
 	} catch (const std::system_error &e) {
 		g_logger().error("[Connection::parseHeader] - error: {}", e.what());
 		close(FORCE_CLOSE);
@@ -245,6 +259,7 @@ void Connection::parsePacket(const std::error_code &error) {
 		return;
 	}
 
+	const auto wireLength = m_msg.getLength();
 	bool skipReadingNextPacket = false;
 	if (!receivedFirst) {
 		// First message received
@@ -280,11 +295,12 @@ void Connection::parsePacket(const std::error_code &error) {
 			m_msg.skipBytes(2);
 		}
 
-		protocol->onRecvFirstMessage(m_msg);
+		skipReadingNextPacket = protocol->onRecvFirstMessage(m_msg);
 	} else {
 		// Send the packet to the current protocol
 		skipReadingNextPacket = protocol->onRecvMessage(m_msg);
 	}
+	protocol->getTraffic().addWireBytes(TrafficDirection::Inbound, wireLength);
 
 	try {
 		readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
@@ -292,7 +308,7 @@ void Connection::parsePacket(const std::error_code &error) {
 
 		if (!skipReadingNextPacket) {
 			// Wait to the next packet
-			asio::async_read(socket, asio::buffer(m_msg.getBuffer(), HEADER_LENGTH), [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->parseHeader(error); });
+			asyncRead(m_msg.getBuffer(), HEADER_LENGTH, [self = shared_from_this()](const std::error_code &error) { self->parseHeader(error); });
 		}
 	} catch (const std::system_error &e) {
 		g_logger().error("[Connection::parsePacket] - error: {}", e.what());
@@ -301,17 +317,40 @@ void Connection::parsePacket(const std::error_code &error) {
 }
 
 void Connection::resumeWork() {
+	// Called from the dispatcher and the auth workers while the network thread may be handling this connection
+	std::scoped_lock lock(connectionLock);
 	readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
 	readTimer.async_wait([self = std::weak_ptr<Connection>(shared_from_this())](const std::error_code &error) { Connection::handleTimeout(self, error); });
 
 	try {
-		asio::async_read(socket, asio::buffer(m_msg.getBuffer(), HEADER_LENGTH), [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->parseHeader(error); });
+		asyncRead(m_msg.getBuffer(), HEADER_LENGTH, [self = shared_from_this()](const std::error_code &error) { self->parseHeader(error); });
 	} catch (const std::system_error &e) {
 		g_logger().error("[Connection::resumeWork] - Exception in async_read: {}", e.what());
 		close(FORCE_CLOSE);
 	}
 }
 
+void Connection::asyncRead(uint8_t* destination, size_t size, ReadHandler &&handler) {
+	if (!receiveBuffer) {
+		asio::async_read(socket, asio::buffer(destination, size), [handler = std::move(handler)](const std::error_code &error, std::size_t) { handler(error); });
+		return;
+	}
+
+	const auto read = receiveBuffer->beginRead(destination, size);
+	if (read.minimum == 0) {
+		// Already read along with a previous packet, no need to touch the socket
+		asio::post(socket.get_executor(), [handler = std::move(handler)] { handler({}); });
+		return;
+	}
+
+	asio::async_read(socket, asio::buffer(read.target, read.maximum), asio::transfer_at_least(read.minimum), [self = shared_from_this(), read, handler = std::move(handler)](const std::error_code &error, std::size_t bytes) {
+		if (!error) {
+			self->receiveBuffer->endRead(read, bytes);
+		}
+		handler(error);
+	});
+}
+
 void Connection::send(const OutputMessage_ptr &outputMessage) {
 	std::scoped_lock lock(connectionLock);
 	if (connectionState == CONNECTION_STATE_CLOSED) {
@@ -320,6 +359,7 @@ void Connection::send(const OutputMessage_ptr &outputMessage) {
 
 	bool noPendingWrite = messageQueue.empty();
 	messageQueue.emplace_back(outputMessage);
+	writePending.store(true, std::memory_order_relaxed);
 
 	if (noPendingWrite) {
 		if (socket.is_open()) {
@@ -345,12 +385,33 @@ void Connection::internalWorker() {
 		return;
 	}
 
-	const auto &outputMessage = messageQueue.front();
+	writeQueuedMessages(lock);
+}
+
+void Connection::writeQueuedMessages(std::unique_lock<std::recursive_mutex> &lock) {
+	// The messages stay at the front of the queue until their write completes, send only appends to it
+	const size_t count = coalesceWrites ? std::min(messageQueue.size(), CONNECTION_MAX_GATHERED_WRITES) : 1;
+	writingMessages.assign(messageQueue.begin(), std::next(messageQueue.begin(), static_cast<std::ptrdiff_t>(count)));
+
 	lock.unlock();
-	protocol->onSendMessage(outputMessage);
+	for (const auto &outputMessage : writingMessages) {
+		encodeMessage(outputMessage);
+	}
 	lock.lock();
 
-	internalSend(outputMessage);
+	internalSend();
+}
+
+void Connection::encodeMessage(const OutputMessage_ptr &outputMessage) {
+	if (!reactor) {
+		protocol->onSendMessage(outputMessage);
+		return;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	protocol->onSendMessage(outputMessage);
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	reactor->onMessageSent(outputMessage->getLength(), static_cast<uint64_t>(elapsed.count()));
 }
 
 uint32_t Connection::getIP() {
@@ -369,12 +430,22 @@ uint32_t Connection::getIP() {
 	return ip;
 }
 
-void Connection::internalSend(const OutputMessage_ptr &outputMessage) {
+void Connection::internalSend() {
+	// A single write for every message taken by writeQueuedMessages
+	writeBuffers.clear();
+	size_t bytes = 0;
+	for (const auto &outputMessage : writingMessages) {
+		writeBuffers.emplace_back(outputMessage->getOutputBuffer(), outputMessage->getLength());
+		bytes += outputMessage->getLength();
+	}
+	protocol->getTraffic().addWrite();
+	protocol->getTraffic().addWireBytes(TrafficDirection::Outbound, bytes);
+
 	writeTimer.expires_from_now(std::chrono::seconds(CONNECTION_WRITE_TIMEOUT));
 	writeTimer.async_wait([self = std::weak_ptr<Connection>(shared_from_this())](const std::error_code &error) { Connection::handleTimeout(self, error); });
 
 	try {
-		asio::async_write(socket, asio::buffer(outputMessage->getOutputBuffer(), outputMessage->getLength()), [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->onWriteOperation(error); });
+		asio::async_write(socket, writeBuffers, [self = shared_from_this()](const std::error_code &error, std::size_t N) { self->onWriteOperation(error); });
 	} catch (const std::system_error &e) {
 		g_logger().error("[Connection::internalSend] - Exception in async_write: {}", e.what());
 		close(FORCE_CLOSE);
@@ -388,18 +459,18 @@ void Connection::onWriteOperation(const std::error_code &error) {
 	if (error) {
 		g_logger().error("[Connection::onWriteOperation] - Write error: {}", error.message());
 		messageQueue.clear();
+		writingMessages.clear();
+		writePending.store(false, std::memory_order_relaxed);
 		close(FORCE_CLOSE);
 		return;
 	}
 
-	messageQueue.pop_front();
+	messageQueue.erase(messageQueue.begin(), std::next(messageQueue.begin(), static_cast<std::ptrdiff_t>(writingMessages.size())));
+	writingMessages.clear();
+	writePending.store(!messageQueue.empty(), std::memory_order_relaxed);
 
 	if (!messageQueue.empty()) {
-		const auto &outputMessage = messageQueue.front();
-		lock.unlock();
-		protocol->onSendMessage(outputMessage);
-		lock.lock();
-		internalSend(outputMessage);
+		writeQueuedMessages(lock);
 	} else if (connectionState == CONNECTION_STATE_CLOSED) {
 		closeSocket();
 	}
@@ -12,9 +12,13 @@
 #include "declarations.hpp"
 // TODO: Remove circular includes (maybe shared_ptr?)
 #include "server/network/message/networkmessage.hpp"
+#include "server/network/connection/receivebuffer.hpp"
 
 static constexpr int32_t CONNECTION_WRITE_TIMEOUT = 30;
 static constexpr int32_t CONNECTION_READ_TIMEOUT = 30;
+// Room for the packets a client sends in a burst, larger bodies are read straight into the message
+static constexpr size_t CONNECTION_RECEIVE_BUFFER_SIZE = 4096;
+static constexpr size_t CONNECTION_MAX_GATHERED_WRITES = 16;
 
 class Protocol;
 using Protocol_ptr = std::shared_ptr<Protocol>;
@@ -28,6 +32,7 @@ using ConnectionWeak_ptr = std::weak_ptr<Connection>;
 class ServiceBase;
 using Service_ptr = std::shared_ptr<ServiceBase>;
 class ServicePort;
+class NetworkReactor;
 using ServicePort_ptr = std::shared_ptr<ServicePort>;
 using ConstServicePort_ptr = std::shared_ptr<const ServicePort>;
 class NetworkMessage;
@@ -38,7 +43,8 @@ public:
 
 	static ConnectionManager &getInstance();
 
-	Connection_ptr createConnection(asio::io_service &io_service, const ConstServicePort_ptr &servicePort);
+	// The socket belongs to the io_context of reactor, or to io_service without one
+	Connection_ptr createConnection(asio::io_service &io_service, const ConstServicePort_ptr &servicePort, const std::shared_ptr<NetworkReactor> &reactor = nullptr);
 	void releaseConnection(const Connection_ptr &connection);
 	void closeAll();
 
@@ -49,11 +55,11 @@ private:
 class Connection : public std::enable_shared_from_this<Connection> {
 public:
 	// Constructor
-	Connection(asio::io_service &initIoService, ConstServicePort_ptr initservicePort);
+	Connection(asio::io_service &initIoService, ConstServicePort_ptr initservicePort, std::shared_ptr<NetworkReactor> initReactor = nullptr);
 	// Constructor end
 
 	// Destructor
-	~Connection() = default;
+	~Connection();
 
 	// Singleton - ensures we don't accidentally copy it
 	Connection(const Connection &) = delete;
@@ -67,6 +73,10 @@ public:
 	void resumeWork();
 
 	void send(const OutputMessage_ptr &outputMessage);
+	// A write is still in flight, the client doesn't keep up with what is sent. Doesn't take the connection lock.
+	bool hasPendingWrite() const {
+		return writePending.load(std::memory_order_relaxed);
+	}
 
 	uint32_t getIP();
 
@@ -79,20 +89,37 @@ private:
 
 	static void handleTimeout(ConnectionWeak_ptr connectionWeak, const std::error_code &error);
 
+	using ReadHandler = std::function<void(const std::error_code &)>;
+	// Reads exactly size bytes, from what was read ahead when the socket reads are coalesced
+	void asyncRead(uint8_t* destination, size_t size, ReadHandler &&handler);
+
 	void closeSocket();
+	void encodeMessage(const OutputMessage_ptr &outputMessage);
 	void internalWorker();
-	void internalSend(const OutputMessage_ptr &outputMessage);
+	// Encodes the messages at the front of the queue, as many as a write gathers, and writes them
+	void writeQueuedMessages(std::unique_lock<std::recursive_mutex> &lock);
+	void internalSend();
 
 	asio::ip::tcp::socket &getSocket() {
 		return socket;
 	}
 
+	// Declared first so it is released last, the timers and the socket below belong to its io_context
+	std::shared_ptr<NetworkReactor> reactor;
+
 	asio::high_resolution_timer readTimer;
 	asio::high_resolution_timer writeTimer;
 
 	std::recursive_mutex connectionLock;
 
 	std::list<OutputMessage_ptr> messageQueue;
+	// Whether messageQueue has messages, for the autosend that checks every connection on every tick
+	std::atomic<bool> writePending = false;
+	// The front of the queue being written, only touched by the write handlers
+	std::vector<OutputMessage_ptr> writingMessages;
+	std::vector<asio::const_buffer> writeBuffers;
+	bool coalesceWrites = false;
+	std::unique_ptr<ReceiveBuffer> receiveBuffer;
 
 	ConstServicePort_ptr service_port;
 	Protocol_ptr protocol;
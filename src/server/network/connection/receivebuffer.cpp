@@ -0,0 +1,47 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/connection/receivebuffer.hpp"
+
+size_t ReceiveBuffer::take(uint8_t* destination, size_t size) {
+	const size_t bytes = std::min(size, available());
+	if (bytes > 0) {
+		std::memcpy(destination, data.data() + begin, bytes);
+		begin += bytes;
+	}
+
+	if (begin == end) {
+		// Drained, the next read starts from the front again
+		begin = 0;
+		end = 0;
+	}
+	return bytes;
+}
+
+ReceiveBuffer::PendingRead ReceiveBuffer::beginRead(uint8_t* destination, size_t size) {
+	const size_t buffered = take(destination, size);
+	const size_t missing = size - buffered;
+	if (missing == 0) {
+		// Already read along with a previous packet, no need to touch the socket
+		return {};
+	}
+
+	if (missing > writableBytes()) {
+		return { destination + buffered, missing, missing, nullptr };
+	}
+	return { writePosition(), missing, writableBytes(), destination + buffered };
+}
+
+void ReceiveBuffer::endRead(const PendingRead &read, size_t bytes) {
+	if (!read.destination) {
+		return;
+	}
+	commit(bytes);
+	take(read.destination, read.minimum);
+}
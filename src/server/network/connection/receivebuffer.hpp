@@ -0,0 +1,67 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+/**
+ * Bytes read from a socket ahead of the parser. One read takes whatever the client has sent, often several packets,
+ * and the headers and bodies are then taken from here instead of costing a read each.
+ */
+class ReceiveBuffer {
+public:
+	// A socket read that waits for at least minimum bytes and takes up to maximum, written to target
+	struct PendingRead {
+		uint8_t* target = nullptr;
+		size_t minimum = 0;
+		size_t maximum = 0;
+		// Where the missing bytes go once they are read into the buffer, null when target is already the destination
+		uint8_t* destination = nullptr;
+	};
+
+	explicit ReceiveBuffer(size_t capacity) :
+		data(capacity) { }
+
+	size_t capacity() const {
+		return data.size();
+	}
+	size_t available() const {
+		return end - begin;
+	}
+
+	/**
+	 * Copies up to size buffered bytes to destination.
+	 * \returns the number of bytes copied
+	 */
+	size_t take(uint8_t* destination, size_t size);
+
+	// Where the next read writes to, the whole buffer once the buffered bytes are taken
+	uint8_t* writePosition() {
+		return data.data() + end;
+	}
+	size_t writableBytes() const {
+		return data.size() - end;
+	}
+	void commit(size_t bytes) {
+		end += bytes;
+	}
+
+	/**
+	 * Takes what is buffered of the size bytes wanted at destination and tells what the socket must read for the rest:
+	 * nothing (minimum 0) when they were all buffered, the missing bytes straight to destination when they don't fit,
+	 * or the missing bytes and whatever else the client has sent already, into the buffer.
+	 */
+	PendingRead beginRead(uint8_t* destination, size_t size);
+	// Hands over the bytes the read of beginRead got, copying the missing ones to their destination
+	void endRead(const PendingRead &read, size_t bytes);
+
+private:
+	std::vector<uint8_t> data;
+	size_t begin = 0;
+	size_t end = 0;
+};
@@ -0,0 +1,36 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/message/broadcastmessage.hpp"
+
+const BroadcastMessage::Fragment* BroadcastMessage::getFragment(bool oldProtocol) {
+	const size_t variant = oldProtocol ? 1 : 0;
+	auto &state = states[variant];
+	auto &fragment = fragments[variant];
+
+	if (state == State::Pending) {
+		// Scratch message, the fragments only keep the bytes they use
+		static thread_local NetworkMessage msg;
+		msg.reset();
+
+		if (encoder(msg, fragment, oldProtocol)) {
+			const auto* body = msg.getBuffer() + NetworkMessage::INITIAL_BUFFER_POSITION;
+			fragment.bytes.assign(body, body + msg.getLength());
+			state = State::Encoded;
+		} else {
+			state = State::Empty;
+		}
+	}
+
+	return state == State::Encoded ? &fragment : nullptr;
+}
+
+size_t BroadcastMessage::getEncodeCount() const {
+	return std::ranges::count_if(states, [](State state) { return state != State::Pending; });
+}
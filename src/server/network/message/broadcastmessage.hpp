@@ -0,0 +1,74 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "game/movement/position.hpp"
+#include "server/network/message/networkmessage.hpp"
+
+/**
+ * Protocol fragment sent to every spectator of an event, encoded once instead of once per spectator.
+ * Each protocol variant (current and old protocol) is encoded the first time one of its viewers needs it,
+ * the bytes are then appended as they are to the output buffer of every viewer of that variant.
+ * The few fields that differ per viewer are listed in the patch table and written on append.
+ */
+class BroadcastMessage {
+public:
+	enum class Patch : uint8_t {
+		// uint32_t, taken from the counter of the viewer protocol
+		StatementId,
+	};
+
+	struct Fragment {
+		// Writes a placeholder for a per viewer field
+		void addPatch(NetworkMessage &msg, Patch patch) {
+			patches.emplace_back(msg.getLength(), patch);
+			msg.add<uint32_t>(0);
+		}
+
+		std::vector<uint8_t> bytes;
+		// Offsets in bytes of the per viewer fields
+		std::vector<std::pair<NetworkMessage::MsgSize_t, Patch>> patches;
+	};
+
+	/**
+	 * Writes the fragment of a variant.
+	 * \returns false when the variant has nothing to send
+	 */
+	using Encoder = std::function<bool(NetworkMessage &msg, Fragment &fragment, bool oldProtocol)>;
+
+	explicit BroadcastMessage(Encoder encoder, std::optional<Position> visiblePosition = std::nullopt) :
+		encoder(std::move(encoder)), visiblePosition(visiblePosition) { }
+
+	/**
+	 * Fragment of the variant, encoded on first use.
+	 * \returns nullptr when the variant has nothing to send
+	 */
+	const Fragment* getFragment(bool oldProtocol);
+
+	// Only viewers that can see this position get the message
+	const std::optional<Position> &getVisiblePosition() const {
+		return visiblePosition;
+	}
+
+	// Number of variants encoded so far
+	size_t getEncodeCount() const;
+
+private:
+	enum class State : uint8_t {
+		Pending,
+		Encoded,
+		Empty,
+	};
+
+	Encoder encoder;
+	std::optional<Position> visiblePosition;
+	std::array<Fragment, 2> fragments;
+	std::array<State, 2> states { State::Pending, State::Pending };
+};
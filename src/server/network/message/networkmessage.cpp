@@ -133,7 +133,7 @@ void NetworkMessage::addString(const std::string &value, const std::source_locat
 			g_logger().debug("[{}] attempted to add an empty string. Called line '{}:{}' in '{}'", __FUNCTION__, location.line(), location.column(), location.function_name());
 		}
 
-		// Add a 0 length string, the std::array will be filled with 0s
+		// Add a 0 length string
 		add<uint16_t>(uint16_t());
 		return;
 	}
@@ -19,6 +19,7 @@ struct Position;
 
 class NetworkMessage {
 public:
+	NetworkMessage();
 	virtual ~NetworkMessage() = default;
 
 	using MsgSize_t = uint16_t;
@@ -47,17 +48,10 @@ public:
 			return T();
 		}
 
-		// Create a temporary byte array to store the value read from the buffer.
-		std::array<unsigned char, sizeof(T)> tempBuffer;
-		// Copy data from the buffer to the temporary array
-		if (std::memcpy(tempBuffer.data(), buffer.data() + info.position, sizeof(T)) == nullptr) {
-			g_logger().error("[{}] memcpy failed while reading message buffer", __FUNCTION__);
-			return T();
-		}
-		// Update the read position in the buffer
+		T value;
+		std::memcpy(&value, buffer.data() + info.position, sizeof(T));
 		info.position += sizeof(T);
-		// Convert the byte array to type T using std::bit_cast and return the result
-		return std::bit_cast<T>(tempBuffer);
+		return value;
 	}
 
 	std::string getString(uint16_t stringLen = 0, const std::source_location &location = std::source_location::current());
@@ -100,35 +94,39 @@ public:
 		static_assert(!std::is_same_v<T, double>, "Error: get<double>() is not allowed. Use addDouble() instead.");
 		static_assert(std::is_trivially_copyable_v<T>, "Type T must be trivially copyable");
 
+		// canAdd keeps the position below MAX_BODY_LENGTH, well inside the buffer
 		if (!canAdd(sizeof(T))) {
 			g_logger().error("Cannot add value of size '{}', buffer size: '{}' overflow. Called at line '{}:{}' in '{}'", sizeof(T), buffer.size(), location.line(), location.column(), location.function_name());
 			return;
 		}
 
-		if (info.position + sizeof(T) > buffer.size()) {
-			g_logger().error("Buffer overflow detected, current position: '{}', value size: '{}', buffer size: '{}'. Called at line '{}:{}' in '{}'", info.position, sizeof(T), buffer.size(), location.line(), location.column(), location.function_name());
-			return;
-		}
-
-		// Convert the value to an array of unsigned char using std::bit_cast
-		auto byteArray = std::bit_cast<std::array<unsigned char, sizeof(T)>>(value);
+		g_logger().trace("[{}] called at line '{}:{}' in '{}'", __FUNCTION__, location.line(), location.column(), location.function_name());
 
-		// Create a span from the byte array
-		// Check if the size of byteArray can fit into the buffer
-		if (byteArray.size() > (buffer.size() - info.position)) {
-			g_logger().error("Buffer overflow during span copy. Source span size: {}, buffer available space: {}", byteArray.size(), buffer.size() - info.position);
-			return;
-		}
+		std::memcpy(buffer.data() + info.position, &value, sizeof(T));
+		info.position += sizeof(T);
+		info.length += sizeof(T);
+	}
 
-		g_logger().trace("[{}] called at line '{}:{}' in '{}'", __FUNCTION__, location.line(), location.column(), location.function_name());
+	/**
+	 * Reserves room for a value only known after the bytes that follow it, such as the count of a list.
+	 * \returns the position to patch the value at
+	 */
+	template <typename T>
+	MsgSize_t reserve(std::source_location location = std::source_location::current()) {
+		const auto position = info.position;
+		add<T>(T(), location);
+		return position;
+	}
 
-		if (std::memcpy(buffer.data() + info.position, byteArray.data(), byteArray.size()) == nullptr) {
-			g_logger().error("[{}] memcpy failed while writing message buffer", __FUNCTION__);
+	// Writes over bytes added before, without moving the position
+	template <typename T>
+	void patch(MsgSize_t position, T value) {
+		static_assert(std::is_trivially_copyable_v<T>, "Type T must be trivially copyable");
+		if (position < INITIAL_BUFFER_POSITION || position + sizeof(T) > info.position) {
+			g_logger().error("[{}] position {} is outside of the written bytes", __FUNCTION__, position);
 			return;
 		}
-
-		info.position += sizeof(T);
-		info.length += sizeof(T);
+		std::memcpy(buffer.data() + position, &value, sizeof(T));
 	}
 
 	void addBytes(const char* bytes, size_t size);
@@ -205,5 +203,9 @@ protected:
 	};
 
 	NetworkMessageInfo info;
-	std::array<uint8_t, NETWORKMESSAGE_MAXSIZE> buffer = {};
+	// Left uninitialized, only the bytes below the length are ever read or sent
+	std::array<uint8_t, NETWORKMESSAGE_MAXSIZE> buffer;
 };
+
+// Defaulted here and not on the declaration, so that value-initialization (make_shared, allocate_shared) doesn't zero the buffer either
+inline NetworkMessage::NetworkMessage() = default;
@@ -9,13 +9,19 @@
 
 #include "server/network/message/outputmessage.hpp"
 
+#include "config/configmanager.hpp"
 #include "lib/di/container.hpp"
 #include "server/network/protocol/protocol.hpp"
 #include "game/scheduling/dispatcher.hpp"
+#include "lib/metrics/metrics.hpp"
 #include "utils/lockfree.hpp"
 
 constexpr uint16_t OUTPUTMESSAGE_FREE_LIST_CAPACITY = 2048;
 constexpr std::chrono::milliseconds OUTPUTMESSAGE_AUTOSEND_DELAY { 10 };
+// Smaller flushes are left to the network threads, the thread pool would cost more than it saves
+constexpr size_t OUTPUTMESSAGE_PARALLEL_ENCODE_MIN = 16;
+// The traffic of the sessions is handed to the metrics every 5 seconds
+constexpr uint32_t OUTPUTMESSAGE_PUBLISH_TICKS = 500;
 
 OutputMessagePool &OutputMessagePool::getInstance() {
 	return inject<OutputMessagePool>();
@@ -29,10 +35,40 @@ void OutputMessagePool::scheduleSendAll() {
 
 void OutputMessagePool::sendAll() {
 	// dispatcher thread
+	METRICS_METHOD_LATENCY_NAMED(collectLatency, "OutputMessagePool::sendAll::collect");
+	const auto maxBatchTicks = static_cast<uint32_t>(std::max<int32_t>(1, g_configManager().getNumber(AUTOSEND_MAX_BATCH_TICKS)));
+	pendingMessages.clear();
 	for (const auto &protocol : bufferedProtocols) {
 		auto &msg = protocol->getCurrentBuffer();
-		if (msg) {
-			protocol->send(std::move(msg));
+		if (msg && protocol->isAutosendDue(maxBatchTicks)) {
+			pendingMessages.emplace_back(protocol, std::move(msg));
+		}
+	}
+	collectLatency.stop();
+
+	if (pendingMessages.size() >= OUTPUTMESSAGE_PARALLEL_ENCODE_MIN) {
+		METRICS_METHOD_LATENCY_NAMED(encodeLatency, "OutputMessagePool::sendAll::encode");
+		g_dispatcher().asyncWait(pendingMessages.size(), [this](size_t i) {
+			const auto &[protocol, msg] = pendingMessages[i];
+			protocol->encodeMessage(*msg);
+		});
+	}
+
+	METRICS_METHOD_LATENCY_NAMED(sendLatency, "OutputMessagePool::sendAll::send");
+	for (auto &[protocol, msg] : pendingMessages) {
+		protocol->send(std::move(msg));
+	}
+	sendLatency.stop();
+
+	if (!pendingMessages.empty()) {
+		g_metrics().addCounter("autosend_messages", static_cast<double>(pendingMessages.size()));
+	}
+	pendingMessages.clear();
+
+	if (++ticksSincePublish >= OUTPUTMESSAGE_PUBLISH_TICKS) {
+		ticksSincePublish = 0;
+		for (const auto &protocol : bufferedProtocols) {
+			protocol->publishTrafficMetrics();
 		}
 	}
 
@@ -53,11 +89,29 @@ void OutputMessagePool::removeProtocolFromAutosend(const Protocol_ptr &protocol)
 	// dispatcher thread
 	const auto it = std::ranges::find(bufferedProtocols, protocol);
 	if (it != bufferedProtocols.end()) {
+		protocol->publishTrafficMetrics();
 		*it = bufferedProtocols.back();
 		bufferedProtocols.pop_back();
 	}
 }
 
+void OutputMessagePool::addFlushRequest(const Protocol_ptr &protocol) {
+	// dispatcher thread
+	if (flushRequests.empty()) {
+		g_dispatcher().addEvent([this] { sendFlushRequests(); }, "OutputMessagePool::sendFlushRequests");
+	}
+	flushRequests.emplace_back(protocol);
+}
+
+void OutputMessagePool::sendFlushRequests() {
+	// dispatcher thread
+	for (const auto &protocol : flushRequests) {
+		protocol->flushOutputBuffer();
+	}
+	g_metrics().addCounter("autosend_flush_requests", static_cast<double>(flushRequests.size()));
+	flushRequests.clear();
+}
+
 OutputMessage_ptr OutputMessagePool::getOutputMessage() {
 	return std::allocate_shared<OutputMessage>(LockfreePoolingAllocator<OutputMessage, OUTPUTMESSAGE_FREE_LIST_CAPACITY>());
 }
@@ -16,7 +16,7 @@ class Protocol;
 
 class OutputMessage : public NetworkMessage {
 public:
-	OutputMessage() = default;
+	OutputMessage();
 	virtual ~OutputMessage() = default;
 
 	// non-copyable
@@ -37,6 +37,18 @@ public:
 		add_header(static_cast<uint16_t>((info.length - 4) / 8));
 	}
 
+	// Compressed, padded and encrypted already, only the headers are left to write
+	bool isEncoded() const {
+		return encoded;
+	}
+	bool isCompressed() const {
+		return compressed;
+	}
+	void setEncoded(bool isCompressed) {
+		encoded = true;
+		compressed = isCompressed;
+	}
+
 	void addCryptoHeader(bool addChecksum, uint32_t checksum) {
 		if (addChecksum) {
 			add_header(checksum);
@@ -93,8 +105,13 @@ private:
 	}
 
 	MsgSize_t outputBufferStart = INITIAL_BUFFER_POSITION;
+	bool encoded = false;
+	bool compressed = false;
 };
 
+// Same as NetworkMessage, not defaulted on the declaration so that allocate_shared doesn't zero the buffer
+inline OutputMessage::OutputMessage() = default;
+
 class OutputMessagePool {
 public:
 	OutputMessagePool() = default;
@@ -113,8 +130,18 @@ public:
 	void addProtocolToAutosend(const Protocol_ptr &protocol);
 	void removeProtocolFromAutosend(const Protocol_ptr &protocol);
 
+	// See Protocol::requestFlush
+	void addFlushRequest(const Protocol_ptr &protocol);
+
 private:
+	void sendFlushRequests();
+
+	// Buffers taken from the protocols by the current flush, kept to reuse its memory
+	std::vector<std::pair<Protocol_ptr, OutputMessage_ptr>> pendingMessages;
+
 	// NOTE: A vector is used here because this container is mostly read
 	// and relatively rarely modified (only when a client connects/disconnects)
 	std::vector<Protocol_ptr> bufferedProtocols;
+	std::vector<Protocol_ptr> flushRequests;
+	uint32_t ticksSincePublish = 0;
 };
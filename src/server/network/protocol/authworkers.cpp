@@ -0,0 +1,101 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/protocol/authworkers.hpp"
+
+#include "lib/di/container.hpp"
+#include "lib/metrics/metrics.hpp"
+
+AuthWorkers::~AuthWorkers() {
+	stop();
+}
+
+AuthWorkers &AuthWorkers::getInstance() {
+	return inject<AuthWorkers>();
+}
+
+void AuthWorkers::start(size_t threadCount, size_t queueSize) {
+	stop();
+
+	{
+		std::scoped_lock lock(mutex);
+		stopping = false;
+		maxQueued = std::max<size_t>(1, queueSize);
+	}
+
+	threads.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; ++i) {
+		threads.emplace_back([this] { run(); });
+	}
+	if (threadCount > 0) {
+		g_logger().info("Authenticating the logins on {} threads", threadCount);
+	}
+}
+
+void AuthWorkers::stop() {
+	{
+		std::scoped_lock lock(mutex);
+		stopping = true;
+	}
+	condition.notify_all();
+
+	for (auto &thread : threads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+	threads.clear();
+}
+
+bool AuthWorkers::submit(std::function<void()> &&job) {
+	if (threads.empty()) {
+		job();
+		return true;
+	}
+
+	{
+		std::scoped_lock lock(mutex);
+		if (stopping || jobs.size() >= maxQueued) {
+			g_metrics().addCounter("auth_rejected", 1);
+			return false;
+		}
+		jobs.emplace_back(std::move(job));
+	}
+	g_metrics().addUpDownCounter("auth_queue_depth", 1);
+	condition.notify_one();
+	return true;
+}
+
+size_t AuthWorkers::getQueueDepth() {
+	std::scoped_lock lock(mutex);
+	return jobs.size();
+}
+
+void AuthWorkers::run() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock lock(mutex);
+			condition.wait(lock, [this] { return stopping || !jobs.empty(); });
+			if (jobs.empty()) {
+				return;
+			}
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+		g_metrics().addUpDownCounter("auth_queue_depth", -1);
+
+		METRICS_METHOD_LATENCY_NAMED(measure, "AuthWorkers::job");
+		try {
+			job();
+		} catch (const std::exception &exception) {
+			g_logger().error("[AuthWorkers::run] - Authentication job failed: {}", exception.what());
+		}
+	}
+}
@@ -0,0 +1,59 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+/**
+ * Stage for the part of a login that doesn't need the game: the RSA block of the first message, the account
+ * queries and the password hash. It has its own threads and a bounded queue, so a burst of logins after a restart
+ * holds neither the network threads nor the dispatcher, and jobs beyond the queue size are refused right away.
+ */
+class AuthWorkers {
+public:
+	AuthWorkers() = default;
+	~AuthWorkers();
+
+	// Ensures that we don't accidentally copy it
+	AuthWorkers(const AuthWorkers &) = delete;
+	AuthWorkers &operator=(const AuthWorkers &) = delete;
+
+	static AuthWorkers &getInstance();
+
+	/**
+	 * Starts the worker threads, replacing the previous ones.
+	 * \param threads the parallelism limit, 0 runs every job on the thread that submits it
+	 * \param queueSize jobs that can wait for a free worker
+	 */
+	void start(size_t threads, size_t queueSize);
+	// Runs the jobs already queued and joins the threads
+	void stop();
+
+	/**
+	 * Queues the job for the next free worker.
+	 * \returns false if the queue is full, the job is dropped
+	 */
+	bool submit(std::function<void()> &&job);
+
+	size_t getThreadCount() const {
+		return threads.size();
+	}
+	size_t getQueueDepth();
+
+private:
+	void run();
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<std::function<void()>> jobs;
+	std::vector<std::thread> threads;
+	size_t maxQueued = 0;
+	bool stopping = false;
+};
+
+constexpr auto g_authWorkers = AuthWorkers::getInstance;
@@ -0,0 +1,79 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/protocol/knowncreaturecache.hpp"
+
+bool KnownCreatureCache::insert(uint32_t id) {
+	if (id == 0) {
+		return false;
+	}
+
+	size_t slot = home(id);
+	while (ids[slot] != 0) {
+		if (ids[slot] == id) {
+			referenced[slot] = true;
+			return false;
+		}
+		slot = (slot + 1) & (SLOTS - 1);
+	}
+
+	ids[slot] = id;
+	// New creatures wait for the next sweep before getting their second chance
+	referenced[slot] = false;
+	++count;
+	return true;
+}
+
+bool KnownCreatureCache::erase(uint32_t id) {
+	const size_t slot = find(id);
+	if (slot == NOT_FOUND) {
+		return false;
+	}
+	eraseSlot(slot);
+	return true;
+}
+
+void KnownCreatureCache::clear() {
+	ids.fill(0);
+	referenced.reset();
+	count = 0;
+	hand = 0;
+}
+
+size_t KnownCreatureCache::find(uint32_t id) const {
+	if (id == 0) {
+		return NOT_FOUND;
+	}
+
+	size_t slot = home(id);
+	while (ids[slot] != 0) {
+		if (ids[slot] == id) {
+			return slot;
+		}
+		slot = (slot + 1) & (SLOTS - 1);
+	}
+	return NOT_FOUND;
+}
+
+void KnownCreatureCache::eraseSlot(size_t slot) {
+	// Backward shift: the entries after the hole that probed past it move into it, so no tombstones are needed
+	size_t hole = slot;
+	for (size_t next = (hole + 1) & (SLOTS - 1); ids[next] != 0; next = (next + 1) & (SLOTS - 1)) {
+		const size_t distance = (next - home(ids[next])) & (SLOTS - 1);
+		if (distance >= ((next - hole) & (SLOTS - 1))) {
+			ids[hole] = ids[next];
+			referenced[hole] = referenced[next];
+			hole = next;
+		}
+	}
+
+	ids[hole] = 0;
+	referenced[hole] = false;
+	--count;
+}
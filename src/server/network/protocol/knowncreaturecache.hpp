@@ -0,0 +1,105 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+/**
+ * Ids of the creatures a client knows, the ones it gets by id instead of the full description.
+ * It is an open-addressing table of fixed size with linear probing, so lookups touch one or two
+ * cache lines and nothing is allocated after construction. When the client knows too many creatures,
+ * the one to forget is chosen by a clock: the hand sweeps the table and creatures seen again since
+ * its last pass get a second chance.
+ */
+class KnownCreatureCache {
+public:
+	// Creatures the client keeps track of, one more can be inserted before evicting
+	static constexpr size_t CAPACITY = 1300;
+
+	bool contains(uint32_t id) const {
+		return find(id) != NOT_FOUND;
+	}
+
+	/**
+	 * Inserts the id, or marks it as used again if it is already known.
+	 * \returns true if the id was not known yet
+	 */
+	bool insert(uint32_t id);
+	bool erase(uint32_t id);
+	void clear();
+
+	size_t size() const {
+		return count;
+	}
+	bool isOverCapacity() const {
+		return count > CAPACITY;
+	}
+
+	/**
+	 * Removes one creature other than keep, preferring those canEvict accepts and those not used since the
+	 * last sweep of the clock. canEvict is only asked about creatures that already spent their second chance.
+	 * \returns the removed id, 0 if there is nothing but keep
+	 */
+	template <typename Predicate>
+	uint32_t evict(uint32_t keep, Predicate &&canEvict) {
+		// The first sweep clears the used marks, the second one finds an evictable creature if there is any
+		for (size_t step = 0; step < SLOTS * 2; ++step) {
+			const size_t slot = advanceHand();
+			const uint32_t id = ids[slot];
+			if (id == 0 || id == keep) {
+				continue;
+			}
+			if (referenced[slot]) {
+				referenced[slot] = false;
+				continue;
+			}
+			if (canEvict(id)) {
+				eraseSlot(slot);
+				return id;
+			}
+		}
+
+		// Bad situation, every creature is protected. Let's just remove anyone.
+		for (size_t step = 0; step < SLOTS; ++step) {
+			const size_t slot = advanceHand();
+			const uint32_t id = ids[slot];
+			if (id != 0 && id != keep) {
+				eraseSlot(slot);
+				return id;
+			}
+		}
+		return 0;
+	}
+
+private:
+	// Power of two, kept above three times the capacity so the probe sequences stay short
+	static constexpr size_t SLOTS = 4096;
+	static constexpr size_t NOT_FOUND = SLOTS;
+	static constexpr uint32_t HASH_SHIFT = 20;
+	static_assert(SLOTS == (static_cast<size_t>(1) << (32 - HASH_SHIFT)) && SLOTS > (CAPACITY + 1) * 3);
+
+	static size_t home(uint32_t id) {
+		// Fibonacci hashing, creature ids are sequential
+		return (id * 2654435769U) >> HASH_SHIFT;
+	}
+
+	size_t advanceHand() {
+		const size_t slot = hand;
+		hand = (hand + 1) & (SLOTS - 1);
+		return slot;
+	}
+
+	size_t find(uint32_t id) const;
+	void eraseSlot(size_t slot);
+
+	// 0 marks a free slot, no creature gets that id
+	std::array<uint32_t, SLOTS> ids {};
+	std::bitset<SLOTS> referenced;
+	size_t count = 0;
+	size_t hand = 0;
+};
@@ -12,6 +12,7 @@
 #include "config/configmanager.hpp"
 #include "server/network/connection/connection.hpp"
 #include "server/network/message/outputmessage.hpp"
+#include "server/network/protocol/authworkers.hpp"
 #include "security/rsa.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "utils/tools.hpp"
@@ -20,49 +21,142 @@ Protocol::Protocol(const Connection_ptr &initConnection) :
 	connectionPtr(initConnection) { }
 
 void Protocol::onSendMessage(const OutputMessage_ptr &msg) {
-	if (!rawMessages) {
-		const uint32_t sendMessageChecksum = msg->getLength() >= 128 && compression(*msg) ? (1U << 31) : 0;
+	if (rawMessages) {
+		return;
+	}
 
-		if (!encryptionEnabled) {
-			msg->writeMessageLength();
-			return;
-		}
+	encodeMessage(*msg);
+	if (!encryptionEnabled) {
+		msg->writeMessageLength();
+		return;
+	}
 
-		msg->writePaddingAmount();
-
-		XTEA_encrypt(*msg);
-		if (checksumMethod == CHECKSUM_METHOD_NONE) {
-			msg->addCryptoHeader(false, 0);
-		} else if (checksumMethod == CHECKSUM_METHOD_ADLER32) {
-			msg->addCryptoHeader(true, adlerChecksum(msg->getOutputBuffer(), msg->getLength()));
-		} else if (checksumMethod == CHECKSUM_METHOD_SEQUENCE) {
-			msg->addCryptoHeader(true, sendMessageChecksum | (++serverSequenceNumber));
-			if (serverSequenceNumber >= 0x7FFFFFFF) {
-				serverSequenceNumber = 0;
-			}
+	// The sequence follows the write order, so the headers are only added here
+	if (checksumMethod == CHECKSUM_METHOD_NONE) {
+		msg->addCryptoHeader(false, 0);
+	} else if (checksumMethod == CHECKSUM_METHOD_ADLER32) {
+		msg->addCryptoHeader(true, adlerChecksum(msg->getOutputBuffer(), msg->getLength()));
+	} else if (checksumMethod == CHECKSUM_METHOD_SEQUENCE) {
+		const uint32_t sendMessageChecksum = msg->isCompressed() ? (1U << 31) : 0;
+		msg->addCryptoHeader(true, sendMessageChecksum | (++serverSequenceNumber));
+		if (serverSequenceNumber >= 0x7FFFFFFF) {
+			serverSequenceNumber = 0;
 		}
 	}
 }
 
+void Protocol::encodeMessage(OutputMessage &msg) const {
+	if (rawMessages || msg.isEncoded()) {
+		return;
+	}
+
+	const bool compressed = msg.getLength() >= 128 && compression(msg);
+	if (encryptionEnabled) {
+		msg.writePaddingAmount();
+		XTEA_encrypt(msg);
+	}
+	msg.setEncoded(compressed);
+}
+
 bool Protocol::sendRecvMessageCallback(NetworkMessage &msg) {
 	if (encryptionEnabled && !XTEA_decrypt(msg)) {
 		g_logger().error("[Protocol::onRecvMessage] - XTEA_decrypt Failed");
 		return false;
 	}
 
+	return queueInboundPacket(msg);
+}
+
+bool Protocol::queueInboundPacket(const NetworkMessage &msg) {
+	// network thread
+	std::scoped_lock lock(inboundMutex);
+	if (inboundPackets.empty()) {
+		inboundPackets.resize(std::max<int32_t>(1, g_configManager().getNumber(INBOUND_PACKET_QUEUE_SIZE)));
+	}
+
+	if (inboundCount == inboundPackets.size()) {
+		// Only reached when full queues disconnect, otherwise the reads stop before
+		g_logger().warn("[Protocol::queueInboundPacket] - {} disconnected for flooding the packet queue", convertIPToString(getIP()));
+		disconnect();
+		return true;
+	}
+
+	auto &packet = inboundPackets[(inboundHead + inboundCount) % inboundPackets.size()];
+	const auto end = std::min<size_t>(NetworkMessage::INITIAL_BUFFER_POSITION + msg.getLength(), NETWORKMESSAGE_MAXSIZE);
+	packet.data.assign(msg.getBuffer(), msg.getBuffer() + end);
+	packet.length = msg.getLength();
+	packet.position = msg.getBufferPosition();
+	++inboundCount;
+
+	if (!inboundScheduled) {
+		inboundScheduled = true;
+		g_dispatcher().addEvent(
+			[protocolWeak = std::weak_ptr<Protocol>(shared_from_this())]() {
+				if (const auto &protocol = protocolWeak.lock()) {
+					protocol->parseInboundPackets();
+				}
+			},
+			"Protocol::sendRecvMessageCallback"
+		);
+	}
+
+	inboundPaused = inboundCount == inboundPackets.size() && !g_configManager().getBoolean(INBOUND_PACKET_QUEUE_DISCONNECT);
+	return inboundPaused;
+}
+
+void Protocol::parseInboundPackets() {
+	// dispatcher thread
+	static NetworkMessage msg;
+
+	const auto &connection = getConnection();
+	if (!connection) {
+		return;
+	}
+
+	// Only the packets already queued, the ones read meanwhile get their own event
+	size_t pending;
+	{
+		std::scoped_lock lock(inboundMutex);
+		pending = inboundCount;
+	}
+
+	for (; pending > 0; --pending) {
+		bool resume;
+		{
+			std::scoped_lock lock(inboundMutex);
+			const auto &packet = inboundPackets[inboundHead];
+			std::memcpy(msg.getBuffer(), packet.data.data(), packet.data.size());
+			msg.setLength(packet.length);
+			msg.setBufferPosition(packet.position);
+
+			inboundHead = (inboundHead + 1) % inboundPackets.size();
+			--inboundCount;
+			resume = std::exchange(inboundPaused, false);
+		}
+
+		if (msg.getLength() > msg.getBufferPosition()) {
+			traffic.addPacket(TrafficDirection::Inbound, msg.getBuffer()[msg.getBufferPosition()], msg.getLength() - msg.getBufferPosition());
+		}
+		parsePacket(msg);
+		if (resume) {
+			connection->resumeWork();
+		}
+	}
+
+	std::scoped_lock lock(inboundMutex);
+	if (inboundCount == 0) {
+		inboundScheduled = false;
+		return;
+	}
+
 	g_dispatcher().addEvent(
-		[&msg, protocolWeak = std::weak_ptr<Protocol>(shared_from_this())]() {
+		[protocolWeak = std::weak_ptr<Protocol>(shared_from_this())]() {
 			if (const auto &protocol = protocolWeak.lock()) {
-				if (const auto &protocolConnection = protocol->getConnection()) {
-					protocol->parsePacket(msg);
-					protocolConnection->resumeWork();
-				}
+				protocol->parseInboundPackets();
 			}
 		},
-		__FUNCTION__
+		"Protocol::sendRecvMessageCallback"
 	);
-
-	return true;
 }
 
 bool Protocol::onRecvMessage(NetworkMessage &msg) {
@@ -114,6 +208,39 @@ OutputMessage_ptr Protocol::getOutputBuffer(int32_t size) {
 	return outputBuffer;
 }
 
+bool Protocol::isAutosendDue(uint32_t maxBatchTicks) {
+	// dispatcher thread
+	uint32_t batchTicks = 1;
+	if (maxBatchTicks > 1) {
+		const auto connection = getConnection();
+		batchTicks = traffic.getBatchTicks(connection && connection->hasPendingWrite(), maxBatchTicks);
+	}
+
+	if (++autosendHeldTicks < batchTicks) {
+		return false;
+	}
+	autosendHeldTicks = 0;
+	return true;
+}
+
+void Protocol::requestFlush() {
+	// dispatcher thread
+	if (flushRequested) {
+		return;
+	}
+	flushRequested = true;
+	OutputMessagePool::getInstance().addFlushRequest(shared_from_this());
+}
+
+void Protocol::flushOutputBuffer() {
+	// dispatcher thread
+	flushRequested = false;
+	autosendHeldTicks = 0;
+	if (outputBuffer) {
+		send(std::move(outputBuffer));
+	}
+}
+
 void Protocol::send(OutputMessage_ptr msg) const {
 	if (auto connection = getConnection()) {
 		connection->send(msg);
@@ -126,6 +253,35 @@ void Protocol::disconnect() const {
 	}
 }
 
+bool Protocol::parseOnAuthWorkers(NetworkMessage &msg, std::function<bool(NetworkMessage &)> &&parse) {
+	if (g_authWorkers().getThreadCount() == 0) {
+		return !parse(msg);
+	}
+
+	// The connection reuses its message for the next header, the job keeps its own copy
+	const auto copy = std::make_shared<NetworkMessage>();
+	const size_t bytes = std::min<size_t>(std::max(msg.getLength(), msg.getBufferPosition()), NETWORKMESSAGE_MAXSIZE);
+	std::memcpy(copy->getBuffer(), msg.getBuffer(), bytes);
+	copy->setLength(msg.getLength());
+	copy->setBufferPosition(msg.getBufferPosition());
+
+	const bool queued = g_authWorkers().submit([self = shared_from_this(), copy, parse = std::move(parse)] {
+		const auto connection = self->getConnection();
+		if (!connection) {
+			return;
+		}
+		if (parse(*copy)) {
+			connection->resumeWork();
+		}
+	});
+	if (!queued) {
+		g_logger().debug("[Protocol::parseOnAuthWorkers] - Authentication queue is full, dropping the connection from {}", convertIPToString(getIP()));
+		disconnect();
+		return false;
+	}
+	return true;
+}
+
 void Protocol::XTEA_transform(uint8_t* buffer, size_t messageLength, bool encrypt) const {
 	constexpr uint32_t delta = 0x61C88647;
 	size_t readPos = 0;
@@ -261,8 +417,8 @@ bool Protocol::compression(OutputMessage &outputMessage) const {
 		return false;
 	}
 
-	static thread_local auto compress_ptr = std::make_unique<ZStream>();
-	static const auto &compress = compress_ptr;
+	// One stream per thread, the connections are encoded on several network threads
+	static thread_local const auto compress = std::make_unique<ZStream>();
 
 	if (!compress->stream) {
 		return false;
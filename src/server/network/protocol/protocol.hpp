@@ -10,6 +10,7 @@
 #pragma once
 
 #include "server/server_definitions.hpp"
+#include "server/network/protocol/sessiontraffic.hpp"
 
 class OutputMessage;
 using OutputMessage_ptr = std::shared_ptr<OutputMessage>;
@@ -32,9 +33,18 @@ public:
 	virtual void parsePacket(NetworkMessage &) { }
 
 	virtual void onSendMessage(const OutputMessage_ptr &msg);
+	/**
+	 * Compresses, pads and encrypts the message, the part of onSendMessage that doesn't depend on the send order.
+	 * Safe to run on any thread before the message is handed to the connection.
+	 */
+	void encodeMessage(OutputMessage &msg) const;
 	bool onRecvMessage(NetworkMessage &msg);
 	bool sendRecvMessageCallback(NetworkMessage &msg);
-	virtual void onRecvFirstMessage(NetworkMessage &msg) = 0;
+	/**
+	 * Handles the first message of the connection.
+	 * \returns true if the connection must stop reading until resumeWork is called
+	 */
+	virtual bool onRecvFirstMessage(NetworkMessage &msg) = 0;
 	virtual void sendLoginChallenge() { }
 
 	bool isConnectionExpired() const;
@@ -52,9 +62,33 @@ public:
 
 	void send(OutputMessage_ptr msg) const;
 
+	SessionTraffic &getTraffic() {
+		return traffic;
+	}
+	// Hands the traffic counted since the last call to the metrics
+	virtual void publishTrafficMetrics() {
+		traffic.publishMetrics({});
+	}
+
+	/**
+	 * Called by the autosend on every tick the output buffer has data.
+	 * \returns true when the buffer must be sent on this tick, false to let it batch more
+	 */
+	bool isAutosendDue(uint32_t maxBatchTicks);
+	// Sends the output buffer once the dispatcher is done with the current events, without waiting for the autosend
+	void requestFlush();
+	void flushOutputBuffer();
+
 protected:
 	void disconnect() const;
 
+	/**
+	 * Parses a copy of the first message on the auth workers, the connection stops reading meanwhile and
+	 * resumes if parse returns true. A full queue drops the connection.
+	 * \returns true if the connection must stop reading, what onRecvFirstMessage returns
+	 */
+	bool parseOnAuthWorkers(NetworkMessage &msg, std::function<bool(NetworkMessage &)> &&parse);
+
 	void enableXTEAEncryption() {
 		encryptionEnabled = true;
 	}
@@ -77,7 +111,22 @@ protected:
 
 	virtual void release() { }
 
+	/**
+	 * Copies the packet to the inbound queue and schedules its parsing on the dispatcher.
+	 * \returns true when the connection must stop reading until the dispatcher makes room
+	 */
+	bool queueInboundPacket(const NetworkMessage &msg);
+	// Parses the packets queued so far, resuming the reads if the queue was full
+	void parseInboundPackets();
+
 private:
+	// A decoded packet waiting for the dispatcher, with the readable part of the connection buffer
+	struct InboundPacket {
+		std::vector<uint8_t> data;
+		NetworkMessage::MsgSize_t length = 0;
+		NetworkMessage::MsgSize_t position = 0;
+	};
+
 	struct ZStream {
 		ZStream() noexcept;
 
@@ -95,9 +144,22 @@ private:
 	bool compression(OutputMessage &msg) const;
 
 	OutputMessage_ptr outputBuffer;
+	SessionTraffic traffic;
+	// Autosend ticks the output buffer has waited, and whether it is already waiting for a flush
+	uint32_t autosendHeldTicks = 0;
+	bool flushRequested = false;
 
 	const ConnectionWeak_ptr connectionPtr;
 	std::array<uint32_t, 4> key = {};
+
+	// Ring of the packets read ahead, filled by the network thread and drained by the dispatcher
+	std::mutex inboundMutex;
+	std::vector<InboundPacket> inboundPackets;
+	size_t inboundHead = 0;
+	size_t inboundCount = 0;
+	bool inboundScheduled = false;
+	bool inboundPaused = false;
+
 	uint32_t serverSequenceNumber = 0;
 	uint32_t clientSequenceNumber = 0;
 	std::underlying_type_t<ChecksumMethods_t> checksumMethod = CHECKSUM_METHOD_NONE;
@@ -65,6 +65,12 @@
 namespace {
 	constexpr uint64_t PARTY_ANALYZER_THROTTLE_MS = 1000;
 
+	// Shared by the creature speech sent to each viewer and the broadcast ones
+	uint32_t nextCreatureSayStatementId() {
+		static uint32_t statementId = 0;
+		return ++statementId;
+	}
+
 	template <typename T>
 	uint16_t getVectorIterationIncreaseCount(T &vector) {
 		uint16_t totalIterationCount = 0;
@@ -508,16 +514,45 @@ void ProtocolGame::AddItem(NetworkMessage &msg, const std::shared_ptr<Item> &ite
 
 void ProtocolGame::release() {
 	// dispatcher thread
+	// Before the player is gone, the last traffic is still published with its name
+	OutputMessagePool::getInstance().removeProtocolFromAutosend(shared_from_this());
+
 	if (player && player->client == shared_from_this()) {
 		player->client.reset();
 		player = nullptr;
 	}
 
-	OutputMessagePool::getInstance().removeProtocolFromAutosend(shared_from_this());
 	Protocol::release();
 }
 
 void ProtocolGame::login(const std::string &name, uint32_t accountId, OperatingSystem_t operatingSystem) {
+	// dispatcher thread, the auth workers only decrypt the first message and check the account
+	if (g_game().getGameState() == GAME_STATE_STARTUP) {
+		disconnectClient("Gameworld is starting up. Please wait.");
+		return;
+	}
+
+	if (g_game().getGameState() == GAME_STATE_MAINTAIN) {
+		disconnectClient("Gameworld is under maintenance. Please re-connect in a while.");
+		return;
+	}
+
+	const auto &onlinePlayer = g_game().getPlayerByName(name);
+	const auto &otherSession = !onlinePlayer ? g_game().getDeadPlayer(name) : onlinePlayer;
+	if (otherSession && otherSession->client) {
+		if (otherSession->isDead()) {
+			disconnectClient("You are already logged in.");
+			return;
+		}
+
+		auto message = fmt::format("You are already connected through another client. Please use only one client at a time!");
+		if (otherSession->getProtocolVersion() != getVersion() && otherSession->isOldProtocol() != oldProtocol) {
+			message = fmt::format("You are already logged in using protocol '{}'. Please log out from the other session to connect here.", otherSession->getProtocolVersion());
+		}
+
+		otherSession->client->disconnectClient(message);
+	}
+
 	// OTCV8 features
 	if (otclientV8 > 0) {
 		sendFeatures();
@@ -538,7 +573,6 @@ void ProtocolGame::login(const std::string &name, uint32_t accountId, OperatingS
 
 	g_logger().debug("Player logging in in version '{}' and oldProtocol '{}'", getVersion(), oldProtocol);
 
-	// dispatcher thread
 	std::shared_ptr<Player> foundPlayer = g_game().getPlayerByName(name);
 	if (!foundPlayer) {
 		player = std::make_shared<Player>(getThis());
@@ -748,12 +782,18 @@ void ProtocolGame::logout(bool displayEffect, bool forced) {
 	g_game().removeCreature(player, true);
 }
 
-void ProtocolGame::onRecvFirstMessage(NetworkMessage &msg) {
+bool ProtocolGame::onRecvFirstMessage(NetworkMessage &msg) {
 	if (g_game().getGameState() == GAME_STATE_SHUTDOWN) {
 		disconnect();
-		return;
+		return false;
 	}
 
+	return parseOnAuthWorkers(msg, [self = getThis()](NetworkMessage &firstMessage) {
+		return self->parseFirstMessage(firstMessage);
+	});
+}
+
+bool ProtocolGame::parseFirstMessage(NetworkMessage &msg) {
 	auto operatingSystem = static_cast<OperatingSystem_t>(msg.get<uint16_t>());
 	version = msg.get<uint16_t>(); // Protocol version
 	g_logger().trace("Protocol version: {}", version);
@@ -787,9 +827,9 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage &msg) {
 	g_logger().trace("Game preview state: {}", gamePreviewState);
 
 	if (!Protocol::RSA_decrypt(msg)) {
-		g_logger().warn("[ProtocolGame::onRecvFirstMessage] - RSA Decrypt Failed");
+		g_logger().warn("[ProtocolGame::parseFirstMessage] - RSA Decrypt Failed");
 		disconnect();
-		return;
+		return false;
 	}
 
 	std::array<uint32_t, 4> key = {
@@ -816,14 +856,14 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage &msg) {
 		if (pos == std::string::npos) {
 			ss << "You must enter your " << (oldProtocol ? "username" : "email") << ".";
 			disconnectClient(ss.str());
-			return;
+			return false;
 		}
 		accountDescriptor = sessionKey.substr(0, pos);
 		if (accountDescriptor.empty()) {
 			ss.str(std::string());
 			ss << "You must enter your " << (oldProtocol ? "username" : "email") << ".";
 			disconnectClient(ss.str());
-			return;
+			return false;
 		}
 		password = sessionKey.substr(pos + 1);
 	}
@@ -836,27 +876,11 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage &msg) {
 
 	std::string characterName = msg.getString();
 
-	const auto &onlinePlayer = g_game().getPlayerByName(characterName);
-	const auto &foundPlayer = !onlinePlayer ? g_game().getDeadPlayer(characterName) : onlinePlayer;
-	if (foundPlayer && foundPlayer->client) {
-		if (foundPlayer->isDead()) {
-			disconnectClient("You are already logged in.");
-			return;
-		}
-
-		auto message = fmt::format("You are already connected through another client. Please use only one client at a time!");
-		if (foundPlayer->getProtocolVersion() != getVersion() && foundPlayer->isOldProtocol() != oldProtocol) {
-			message = fmt::format("You are already logged in using protocol '{}'. Please log out from the other session to connect here.", foundPlayer->getProtocolVersion());
-		}
-
-		foundPlayer->client->disconnectClient(message);
-	}
-
 	auto timeStamp = msg.get<uint32_t>();
 	uint8_t randNumber = msg.getByte();
 	if (challengeTimestamp != timeStamp || challengeRandom != randNumber) {
 		disconnect();
-		return;
+		return false;
 	}
 
 	// OTCv8 version detection
@@ -873,17 +897,7 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage &msg) {
 		}
 		ss << " allowed!";
 		disconnectClient(ss.str());
-		return;
-	}
-
-	if (g_game().getGameState() == GAME_STATE_STARTUP) {
-		disconnectClient("Gameworld is starting up. Please wait.");
-		return;
-	}
-
-	if (g_game().getGameState() == GAME_STATE_MAINTAIN) {
-		disconnectClient("Gameworld is under maintenance. Please re-connect in a while.");
-		return;
+		return false;
 	}
 
 	BanInfo banInfo;
@@ -896,7 +910,7 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage &msg) {
 		ss << "Your IP has been banned until " << formatDateShort(banInfo.expiresAt) << " by " << banInfo.bannedBy << ".\n\nReason specified:\n"
 		   << banInfo.reason;
 		disconnectClient(ss.str());
-		return;
+		return false;
 	}
 
 	uint32_t accountId;
@@ -915,10 +929,11 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage &msg) {
 		g_dispatcher().scheduleEvent(
 			1000, [self = getThis()] { self->disconnect(); }, "ProtocolGame::disconnect"
 		);
-		return;
+		return false;
 	}
 
 	g_dispatcher().addEvent([self = getThis(), characterName, accountId, operatingSystem] { self->login(characterName, accountId, operatingSystem); }, __FUNCTION__);
+	return true;
 }
 
 void ProtocolGame::sendLoginChallenge() {
@@ -927,8 +942,8 @@ void ProtocolGame::sendLoginChallenge() {
 	static std::ranlux24 generator(rd());
 	static std::uniform_int_distribution<uint16_t> randNumber(0x00, 0xFF);
 
-	// Skip checksum
-	output->skipBytes(sizeof(uint32_t));
+	// Checksum, written once the rest is known
+	const auto checksumPosition = output->reserve<uint32_t>();
 
 	// Packet length & type
 	output->addByte(0x01);
@@ -941,10 +956,8 @@ void ProtocolGame::sendLoginChallenge() {
 	output->addByte(challengeRandom);
 	output->addByte(0x71);
 
-	// Go back and write checksum
-	output->skipBytes(-12);
 	// To support 11.10-, not have problems with 11.11+
-	output->add<uint32_t>(adlerChecksum(output->getOutputBuffer() + sizeof(uint32_t), 8));
+	output->patch<uint32_t>(checksumPosition, adlerChecksum(output->getOutputBuffer() + sizeof(uint32_t), 8));
 
 	send(output);
 }
@@ -958,13 +971,76 @@ void ProtocolGame::disconnectClient(const std::string &message) const {
 }
 
 void ProtocolGame::writeToOutputBuffer(NetworkMessage &msg) {
+	if (msg.getLength() == 0) {
+		return;
+	}
+
 	if (g_dispatcher().context().isAsync()) {
 		g_dispatcher().addEvent([self = getThis(), msg] {
 			self->getOutputBuffer(msg.getLength())->append(msg);
+			self->onOutputWritten(msg.getBuffer()[NetworkMessage::INITIAL_BUFFER_POSITION], msg.getLength());
 		},
 		                        __FUNCTION__);
 	} else {
 		getOutputBuffer(msg.getLength())->append(msg);
+		onOutputWritten(msg.getBuffer()[NetworkMessage::INITIAL_BUFFER_POSITION], msg.getLength());
+	}
+}
+
+void ProtocolGame::onOutputWritten(uint8_t opcode, size_t bytes) {
+	// A message written by one send function is counted under its first opcode
+	getTraffic().addPacket(TrafficDirection::Outbound, opcode, bytes);
+	if (opcode == 0x1D) {
+		// The client answers the ping with the same opcode, see parsePacketFromDispatcher
+		getTraffic().onPingSent();
+	}
+	if (SessionTraffic::isInteractive(opcode)) {
+		requestFlush();
+	}
+}
+
+void ProtocolGame::publishTrafficMetrics() {
+	if (!player) {
+		Protocol::publishTrafficMetrics();
+		return;
+	}
+	getTraffic().publishMetrics({ { "player", player->getName() } });
+}
+
+void ProtocolGame::sendBroadcast(BroadcastMessage &broadcast) {
+	if (const auto &position = broadcast.getVisiblePosition(); position && !canSee(*position)) {
+		return;
+	}
+
+	const auto* fragment = broadcast.getFragment(oldProtocol);
+	if (!fragment) {
+		return;
+	}
+
+	if (g_dispatcher().context().isAsync()) {
+		g_dispatcher().addEvent([self = getThis(), fragment = *fragment] {
+			self->writeBroadcast(fragment);
+		},
+		                        __FUNCTION__);
+	} else {
+		writeBroadcast(*fragment);
+	}
+}
+
+void ProtocolGame::writeBroadcast(const BroadcastMessage::Fragment &fragment) {
+	const auto &output = getOutputBuffer(static_cast<int32_t>(fragment.bytes.size()));
+	const auto start = output->getBufferPosition();
+	output->addBytes(reinterpret_cast<const char*>(fragment.bytes.data()), fragment.bytes.size());
+	if (!fragment.bytes.empty()) {
+		onOutputWritten(fragment.bytes.front(), fragment.bytes.size());
+	}
+
+	for (const auto &[offset, patch] : fragment.patches) {
+		switch (patch) {
+			case BroadcastMessage::Patch::StatementId:
+				output->patch<uint32_t>(start + offset, nextCreatureSayStatementId());
+				break;
+		}
 	}
 }
 
@@ -1064,6 +1140,7 @@ void ProtocolGame::parsePacketFromDispatcher(NetworkMessage &msg, uint8_t recvby
 			logout(true, false);
 			break;
 		case 0x1D:
+			getTraffic().onPingReceived();
 			g_game().playerReceivePingBack(player->getID());
 			break;
 		case 0x1E:
@@ -1584,45 +1661,25 @@ void ProtocolGame::GetFloorDescription(NetworkMessage &msg, int32_t x, int32_t y
 }
 
 void ProtocolGame::checkCreatureAsKnown(uint32_t id, bool &known, uint32_t &removedKnown) {
-	if (auto [creatureKnown, creatureInserted] = knownCreatureSet.insert(id);
-	    !creatureInserted) {
+	if (!knownCreatures.insert(id)) {
 		known = true;
 		return;
 	}
 	known = false;
-	if (knownCreatureSet.size() > 1300) {
-		// Look for a creature to remove
-		for (auto it = knownCreatureSet.begin(), end = knownCreatureSet.end(); it != end; ++it) {
-			if (*it == id) {
-				continue;
-			}
-			// We need to protect party players from removing
-			const auto &creature = g_game().getCreatureByID(*it);
-			const auto &checkPlayer = creature ? creature->getPlayer() : nullptr;
-			if (checkPlayer) {
-				if (player->getParty() != checkPlayer->getParty() && !canSee(creature)) {
-					removedKnown = *it;
-					knownCreatureSet.erase(it);
-					return;
-				}
-			} else if (!canSee(creature)) {
-				removedKnown = *it;
-				knownCreatureSet.erase(it);
-				return;
-			}
-		}
-
-		// Bad situation. Let's just remove anyone.
-		auto it = knownCreatureSet.begin();
-		if (*it == id) {
-			++it;
-		}
-
-		removedKnown = *it;
-		knownCreatureSet.erase(it);
-	} else {
+	if (!knownCreatures.isOverCapacity()) {
 		removedKnown = 0;
+		return;
 	}
+
+	removedKnown = knownCreatures.evict(id, [this](uint32_t knownId) {
+		// We need to protect party players from removing
+		const auto &creature = g_game().getCreatureByID(knownId);
+		const auto &checkPlayer = creature ? creature->getPlayer() : nullptr;
+		if (checkPlayer) {
+			return player->getParty() != checkPlayer->getParty() && !canSee(creature);
+		}
+		return !canSee(creature);
+	});
 }
 
 bool ProtocolGame::canSee(const std::shared_ptr<Creature> &c) const {
@@ -2306,10 +2363,9 @@ void ProtocolGame::sendHighscores(const std::vector<HighscoreCharacter> &charact
 	msg.addByte(0); // Game World Category: 0xFF(-1) - Selected World
 	msg.addByte(0); // BattlEye World Type
 
-	auto vocationPosition = msg.getBufferPosition();
+	const auto vocationPosition = msg.reserve<uint8_t>(); // Vocation Count
 	uint8_t vocations = 1;
 
-	msg.skipBytes(1); // Vocation Count
 	msg.add<uint32_t>(0xFFFFFFFF); // All Vocations - hardcoded
 	msg.addString("(all)"); // All Vocations - hardcoded
 
@@ -2362,8 +2418,7 @@ void ProtocolGame::sendHighscores(const std::vector<HighscoreCharacter> &charact
 	msg.addByte(0); // ??
 	msg.addByte(1); // ??
 	msg.add<uint32_t>(updateTimer); // Last Update
-	msg.setBufferPosition(vocationPosition);
-	msg.addByte(vocations);
+	msg.patch<uint8_t>(vocationPosition, vocations);
 	writeToOutputBuffer(msg);
 }
 
@@ -3646,8 +3701,7 @@ void ProtocolGame::sendCyclopediaCharacterGeneralStats() {
 		msg.add<uint16_t>(player->getSkillPercent(skill) * 100);
 	}
 
-	auto bufferPosition = msg.getBufferPosition();
-	msg.skipBytes(1);
+	const auto totalPosition = msg.reserve<uint8_t>();
 	uint8_t total = 0;
 	for (size_t i = 0; i < COMBAT_COUNT; i++) {
 		auto specializedMagicLevel = player->getSpecializedMagicLevel(indexToCombatType(i));
@@ -3657,8 +3711,7 @@ void ProtocolGame::sendCyclopediaCharacterGeneralStats() {
 			msg.add<uint16_t>(specializedMagicLevel);
 		}
 	}
-	msg.setBufferPosition(bufferPosition);
-	msg.addByte(total);
+	msg.patch<uint8_t>(totalPosition, total);
 	writeToOutputBuffer(msg);
 }
 
@@ -3741,8 +3794,7 @@ void ProtocolGame::sendCyclopediaCharacterItemSummary(const ItemsTierCountList &
 	msg.addByte(0x00); // 0x00 Here means 'no error'
 
 	auto writeItemList = [&](const ItemsTierCountList &items, uint16_t &itemCount) {
-		const auto startPosition = msg.getBufferPosition();
-		msg.skipBytes(2);
+		const auto startPosition = msg.reserve<uint16_t>();
 
 		for (const auto &[key, count] : items) {
 			const auto &[itemID, tier] = key;
@@ -3758,10 +3810,7 @@ void ProtocolGame::sendCyclopediaCharacterItemSummary(const ItemsTierCountList &
 			++itemCount;
 		}
 
-		const auto endPosition = msg.getBufferPosition();
-		msg.setBufferPosition(startPosition);
-		msg.add<uint16_t>(itemCount);
-		msg.setBufferPosition(endPosition);
+		msg.patch<uint16_t>(startPosition, itemCount);
 	};
 
 	// Inventory Items
@@ -3806,8 +3855,7 @@ void ProtocolGame::sendCyclopediaCharacterOutfitsMounts() {
 	Outfit_t currentOutfit = player->getDefaultOutfit();
 
 	uint16_t outfitSize = 0;
-	auto startOutfits = msg.getBufferPosition();
-	msg.skipBytes(2);
+	const auto startOutfits = msg.reserve<uint16_t>();
 
 	const auto outfits = Outfits::getInstance().getOutfits(player->getSex());
 	for (const auto &outfit : outfits) {
@@ -3842,8 +3890,7 @@ void ProtocolGame::sendCyclopediaCharacterOutfitsMounts() {
 	}
 
 	uint16_t mountSize = 0;
-	auto startMounts = msg.getBufferPosition();
-	msg.skipBytes(2);
+	const auto startMounts = msg.reserve<uint16_t>();
 	for (const auto &mount : g_game().mounts->getMounts()) {
 		const std::string type = mount->type;
 		if (player->hasMount(mount)) {
@@ -3869,8 +3916,7 @@ void ProtocolGame::sendCyclopediaCharacterOutfitsMounts() {
 	}
 
 	uint16_t familiarsSize = 0;
-	auto startFamiliars = msg.getBufferPosition();
-	msg.skipBytes(2);
+	const auto startFamiliars = msg.reserve<uint16_t>();
 	const auto familiars = Familiars::getInstance().getFamiliars(player->getVocationId());
 	for (const auto &familiar : familiars) {
 		const std::string type = familiar->type;
@@ -3888,12 +3934,9 @@ void ProtocolGame::sendCyclopediaCharacterOutfitsMounts() {
 		msg.add<uint32_t>(0);
 	}
 
-	msg.setBufferPosition(startOutfits);
-	msg.add<uint16_t>(outfitSize);
-	msg.setBufferPosition(startMounts);
-	msg.add<uint16_t>(mountSize);
-	msg.setBufferPosition(startFamiliars);
-	msg.add<uint16_t>(familiarsSize);
+	msg.patch<uint16_t>(startOutfits, outfitSize);
+	msg.patch<uint16_t>(startMounts, mountSize);
+	msg.patch<uint16_t>(startFamiliars, familiarsSize);
 	writeToOutputBuffer(msg);
 }
 
@@ -3989,8 +4032,7 @@ void ProtocolGame::sendCyclopediaCharacterInspection() {
 	msg.addByte(CYCLOPEDIA_CHARACTERINFO_INSPECTION);
 	msg.addByte(0x00);
 	uint8_t inventoryItems = 0;
-	auto startInventory = msg.getBufferPosition();
-	msg.skipBytes(1);
+	const auto startInventory = msg.reserve<uint8_t>();
 	for (std::underlying_type<Slots_t>::type slot = CONST_SLOT_FIRST; slot <= CONST_SLOT_LAST; slot++) {
 		std::shared_ptr<Item> inventoryItem = player->getInventoryItem(static_cast<Slots_t>(slot));
 		if (inventoryItem) {
@@ -4001,8 +4043,7 @@ void ProtocolGame::sendCyclopediaCharacterInspection() {
 			AddItem(msg, inventoryItem);
 
 			uint8_t itemImbuements = 0;
-			auto startImbuements = msg.getBufferPosition();
-			msg.skipBytes(1);
+			const auto startImbuements = msg.reserve<uint8_t>();
 			for (uint8_t slotid = 0; slotid < inventoryItem->getImbuementSlot(); slotid++) {
 				ImbuementInfo imbuementInfo;
 				if (!inventoryItem->getImbuementInfo(slotid, &imbuementInfo)) {
@@ -4013,10 +4054,7 @@ void ProtocolGame::sendCyclopediaCharacterInspection() {
 				itemImbuements++;
 			}
 
-			auto endImbuements = msg.getBufferPosition();
-			msg.setBufferPosition(startImbuements);
-			msg.addByte(itemImbuements);
-			msg.setBufferPosition(endImbuements);
+			msg.patch<uint8_t>(startImbuements, itemImbuements);
 
 			auto descriptions = Item::getDescriptions(Item::items[inventoryItem->getID()], inventoryItem);
 			msg.addByte(descriptions.size());
@@ -4031,8 +4069,7 @@ void ProtocolGame::sendCyclopediaCharacterInspection() {
 
 	// Player overall summary
 	uint8_t playerDescriptionSize = 0;
-	auto playerDescriptionPosition = msg.getBufferPosition();
-	msg.skipBytes(1);
+	const auto playerDescriptionPosition = msg.reserve<uint8_t>();
 
 	// Player title
 	if (player->title().getCurrentTitle() != 0) {
@@ -4108,11 +4145,8 @@ void ProtocolGame::sendCyclopediaCharacterInspection() {
 		msg.addString("unknown");
 	}
 
-	msg.setBufferPosition(startInventory);
-	msg.addByte(inventoryItems);
-
-	msg.setBufferPosition(playerDescriptionPosition);
-	msg.addByte(playerDescriptionSize);
+	msg.patch<uint8_t>(startInventory, inventoryItems);
+	msg.patch<uint8_t>(playerDescriptionPosition, playerDescriptionSize);
 
 	writeToOutputBuffer(msg);
 }
@@ -4135,8 +4169,7 @@ void ProtocolGame::sendCyclopediaCharacterBadges() {
 	msg.addString(player->getLoyaltyTitle());
 
 	uint8_t badgesSize = 0;
-	auto badgesSizePosition = msg.getBufferPosition();
-	msg.skipBytes(1);
+	const auto badgesSizePosition = msg.reserve<uint8_t>();
 	for (const auto &badge : g_game().getBadges()) {
 		if (player->badge().hasBadge(badge.m_id)) {
 			msg.add<uint32_t>(badge.m_id);
@@ -4145,8 +4178,7 @@ void ProtocolGame::sendCyclopediaCharacterBadges() {
 		}
 	}
 
-	msg.setBufferPosition(badgesSizePosition);
-	msg.addByte(badgesSize);
+	msg.patch<uint8_t>(badgesSizePosition, badgesSize);
 
 	writeToOutputBuffer(msg);
 }
@@ -4376,17 +4408,13 @@ void ProtocolGame::sendCyclopediaCharacterDefenceStats() {
 
 	// Store the "combats" to increase in absorb values function and send to client later
 	uint8_t combats = 0;
-	auto startCombats = msg.getBufferPosition();
-	msg.skipBytes(1);
+	const auto startCombats = msg.reserve<uint8_t>();
 
 	// Calculate and parse the combat absorbs values
 	calculateAbsorbValues(player, msg, combats);
 
-	// Now set the buffer position skiped and send the total combats count
-	auto endCombats = msg.getBufferPosition();
-	msg.setBufferPosition(startCombats);
-	msg.addByte(combats);
-	msg.setBufferPosition(endCombats);
+	// Now write the total combats count on the reserved byte
+	msg.patch<uint8_t>(startCombats, combats);
 
 	writeToOutputBuffer(msg);
 }
@@ -5025,8 +5053,7 @@ void ProtocolGame::sendLootContainers() {
 		}
 	}
 
-	auto msgPosition = msg.getBufferPosition();
-	msg.skipBytes(1);
+	const auto containersPosition = msg.reserve<uint8_t>();
 	uint8_t containers = 0;
 	for (const auto &[category, containersPair] : managedContainersMap) {
 		if (!isValidObjectCategory(category)) {
@@ -5039,8 +5066,7 @@ void ProtocolGame::sendLootContainers() {
 		msg.add<uint16_t>(lootContainerId);
 		msg.add<uint16_t>(obtainContainerId);
 	}
-	msg.setBufferPosition(msgPosition);
-	msg.addByte(containers);
+	msg.patch<uint8_t>(containersPosition, containers);
 
 	writeToOutputBuffer(msg);
 }
@@ -5222,8 +5248,7 @@ void ProtocolGame::sendSaleItemList(const std::vector<ShopBlock> &shopVector, co
 
 	uint16_t itemsToSend = 0;
 	const uint16_t ItemsToSendLimit = oldProtocol ? 0xFF : 0xFFFF;
-	auto msgPosition = msg.getBufferPosition();
-	msg.skipBytes(oldProtocol ? 1 : 2);
+	const auto itemsToSendPosition = oldProtocol ? msg.reserve<uint8_t>() : msg.reserve<uint16_t>();
 
 	for (const ShopBlock &shopBlock : shopVector) {
 		if (shopBlock.itemSellPrice == 0) {
@@ -5244,11 +5269,10 @@ void ProtocolGame::sendSaleItemList(const std::vector<ShopBlock> &shopVector, co
 		}
 	}
 
-	msg.setBufferPosition(msgPosition);
 	if (oldProtocol) {
-		msg.addByte(static_cast<uint8_t>(itemsToSend));
+		msg.patch<uint8_t>(itemsToSendPosition, static_cast<uint8_t>(itemsToSend));
 	} else {
-		msg.add<uint16_t>(itemsToSend);
+		msg.patch<uint16_t>(itemsToSendPosition, itemsToSend);
 	}
 	writeToOutputBuffer(msg);
 }
@@ -5274,8 +5298,7 @@ void ProtocolGame::sendMarketEnter(uint32_t depotId) {
 
 	// Only use here locker items, itemVector is for use of Game::createMarketOffer
 	auto [itemVector, lockerItems] = player->requestLockerItems(depotLocker, true);
-	auto totalItemsCountPosition = msg.getBufferPosition();
-	msg.skipBytes(2); // Total items count
+	const auto totalItemsCountPosition = msg.reserve<uint16_t>(); // Total items count
 
 	const uint16_t entriesLimit = std::numeric_limits<uint16_t>::max();
 	uint16_t entriesSent = 0;
@@ -5298,10 +5321,7 @@ void ProtocolGame::sendMarketEnter(uint32_t depotId) {
 		}
 	}
 
-	auto endPosition = msg.getBufferPosition();
-	msg.setBufferPosition(totalItemsCountPosition);
-	msg.add<uint16_t>(entriesSent);
-	msg.setBufferPosition(endPosition);
+	msg.patch<uint16_t>(totalItemsCountPosition, entriesSent);
 
 	writeToOutputBuffer(msg);
 
@@ -5749,8 +5769,7 @@ void ProtocolGame::sendOpenForge() {
 	}
 
 	// msg.add<uint16_t>(convergenceItemsMap.size());
-	auto convergenceFusionCountPosition = msg.getBufferPosition();
-	msg.skipBytes(2);
+	const auto convergenceFusionCountPosition = msg.reserve<uint16_t>();
 	uint16_t convergenceFusionCount = 0;
 	/*
 	for each convergence fusion (1 per item slot, only class 4):
@@ -5761,33 +5780,34 @@ void ProtocolGame::sendOpenForge() {
 	    2 bytes: count
 	*/
 	for (const auto &[slot, itemMap] : convergenceFusionItemsMap) {
+		// Counted first, a slot without fusable items is left out entirely
 		uint8_t totalItemsCount = 0;
-		auto totalItemsCountPosition = msg.getBufferPosition();
-		msg.skipBytes(1); // Total items count
+		for (const auto &[itemId, tierAndCountMap] : itemMap) {
+			for (const auto &[tier, itemCount] : tierAndCountMap) {
+				if (tier < maxConfigTier) {
+					totalItemsCount++;
+				}
+			}
+		}
+		if (totalItemsCount == 0) {
+			continue;
+		}
+
+		msg.addByte(totalItemsCount);
 		for (const auto &[itemId, tierAndCountMap] : itemMap) {
 			for (const auto &[tier, itemCount] : tierAndCountMap) {
 				if (tier >= maxConfigTier) {
 					continue;
 				}
-				totalItemsCount++;
 				msg.add<uint16_t>(itemId);
 				msg.addByte(tier);
 				msg.add<uint16_t>(itemCount);
 			}
 		}
-		auto endPosition = msg.getBufferPosition();
-		msg.setBufferPosition(totalItemsCountPosition);
-		if (totalItemsCount > 0) {
-			msg.addByte(totalItemsCount);
-			msg.setBufferPosition(endPosition);
-			convergenceFusionCount++;
-		}
+		convergenceFusionCount++;
 	}
 
-	auto transferTotalCountPosition = msg.getBufferPosition();
-	msg.setBufferPosition(convergenceFusionCountPosition);
-	msg.add<uint16_t>(convergenceFusionCount);
-	msg.setBufferPosition(transferTotalCountPosition);
+	msg.patch<uint16_t>(convergenceFusionCountPosition, convergenceFusionCount);
 
 	auto transferTotalCount = donorTierItemMap.size();
 	msg.addByte(transferTotalCount);
@@ -5844,8 +5864,7 @@ void ProtocolGame::sendOpenForge() {
 		}
 	}
 
-	auto convergenceCountPosition = msg.getBufferPosition();
-	msg.skipBytes(1);
+	const auto convergenceCountPosition = msg.reserve<uint8_t>();
 	uint8_t convergenceTransferCount = 0;
 
 	/*
@@ -5861,31 +5880,33 @@ void ProtocolGame::sendOpenForge() {
 	        2 bytes: count
 	*/
 	for (const auto &[slot, itemMap] : convergenceTransferItemsMap) {
+		// Counted first, a slot without items is left out entirely
 		uint16_t donorCount = 0;
 		uint16_t receiverCount = 0;
-		auto donorCountPosition = msg.getBufferPosition();
-		msg.skipBytes(2); // Donor count
 		for (const auto &[itemId, tierAndCountMap] : itemMap) {
 			for (const auto [tier, itemCount] : tierAndCountMap) {
 				if (tier >= 1) {
 					donorCount++;
-					msg.add<uint16_t>(itemId);
-					msg.addByte(tier);
-					msg.add<uint16_t>(itemCount);
 				} else {
 					receiverCount++;
 				}
 			}
 		}
 		if (donorCount == 0 && receiverCount == 0) {
-			msg.setBufferPosition(donorCountPosition);
 			continue;
 		}
-		auto receiverCountPosition = msg.getBufferPosition();
-		msg.setBufferPosition(donorCountPosition);
+
 		msg.add<uint16_t>(donorCount);
+		for (const auto &[itemId, tierAndCountMap] : itemMap) {
+			for (const auto [tier, itemCount] : tierAndCountMap) {
+				if (tier >= 1) {
+					msg.add<uint16_t>(itemId);
+					msg.addByte(tier);
+					msg.add<uint16_t>(itemCount);
+				}
+			}
+		}
 		++convergenceTransferCount;
-		msg.setBufferPosition(receiverCountPosition);
 		msg.add<uint16_t>(receiverCount);
 		for (const auto &[itemId, tierAndCountMap] : itemMap) {
 			for (const auto [tier, itemCount] : tierAndCountMap) {
@@ -5896,10 +5917,7 @@ void ProtocolGame::sendOpenForge() {
 			}
 		}
 	}
-	auto dustLevelPosition = msg.getBufferPosition();
-	msg.setBufferPosition(convergenceCountPosition);
-	msg.addByte(convergenceTransferCount);
-	msg.setBufferPosition(dustLevelPosition);
+	msg.patch<uint8_t>(convergenceCountPosition, convergenceTransferCount);
 
 	msg.add<uint16_t>(player->getForgeDustLevel()); // Player dust limit
 	writeToOutputBuffer(msg);
@@ -6513,10 +6531,23 @@ void ProtocolGame::sendCreatureTurn(const std::shared_ptr<Creature> &creature, u
 void ProtocolGame::sendCreatureSay(const std::shared_ptr<Creature> &creature, SpeakClasses type, const std::string &text, const Position* pos /* = nullptr*/) {
 	NetworkMessage msg;
 	msg.addByte(0xAA);
+	msg.add<uint32_t>(nextCreatureSayStatementId());
+	AddCreatureSay(msg, creature, type, text, pos, oldProtocol);
+	writeToOutputBuffer(msg);
+}
 
-	static uint32_t statementId = 0;
-	msg.add<uint32_t>(++statementId);
+BroadcastMessage ProtocolGame::broadcastCreatureSay(const std::shared_ptr<Creature> &creature, SpeakClasses type, const std::string &text, const Position* pos /* = nullptr*/) {
+	const Position position = pos ? *pos : creature->getPosition();
+	return BroadcastMessage([creature, type, text, position](NetworkMessage &msg, BroadcastMessage::Fragment &fragment, bool oldProtocol) {
+		msg.addByte(0xAA);
+		// Every viewer gets its own statement id
+		fragment.addPatch(msg, BroadcastMessage::Patch::StatementId);
+		AddCreatureSay(msg, creature, type, text, &position, oldProtocol);
+		return true;
+	});
+}
 
+void ProtocolGame::AddCreatureSay(NetworkMessage &msg, const std::shared_ptr<Creature> &creature, SpeakClasses type, const std::string &text, const Position* pos, bool oldProtocol) {
 	msg.addString(creature->getName());
 
 	if (!oldProtocol) {
@@ -6543,7 +6574,6 @@ void ProtocolGame::sendCreatureSay(const std::shared_ptr<Creature> &creature, Sp
 	}
 
 	msg.addString(text);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendToChannel(const std::shared_ptr<Creature> &creature, SpeakClasses type, const std::string &text, uint16_t channelId) {
@@ -6625,11 +6655,22 @@ void ProtocolGame::sendCancelTarget() {
 
 void ProtocolGame::sendChangeSpeed(const std::shared_ptr<Creature> &creature, uint16_t speed) {
 	NetworkMessage msg;
+	AddChangeSpeed(msg, creature, speed);
+	writeToOutputBuffer(msg);
+}
+
+void ProtocolGame::AddChangeSpeed(NetworkMessage &msg, const std::shared_ptr<Creature> &creature, uint16_t speed) {
 	msg.addByte(0x8F);
 	msg.add<uint32_t>(creature->getID());
 	msg.add<uint16_t>(creature->getBaseSpeed());
 	msg.add<uint16_t>(speed);
-	writeToOutputBuffer(msg);
+}
+
+BroadcastMessage ProtocolGame::broadcastChangeSpeed(const std::shared_ptr<Creature> &creature, uint16_t speed) {
+	return BroadcastMessage([creature, speed](NetworkMessage &msg, BroadcastMessage::Fragment &, bool) {
+		AddChangeSpeed(msg, creature, speed);
+		return true;
+	});
 }
 
 void ProtocolGame::sendCancelWalk() {
@@ -6662,10 +6703,23 @@ void ProtocolGame::sendPingBack() {
 }
 
 void ProtocolGame::sendDistanceShoot(const Position &from, const Position &to, uint16_t type) {
+	NetworkMessage msg;
+	if (AddDistanceShoot(msg, from, to, type, oldProtocol)) {
+		writeToOutputBuffer(msg);
+	}
+}
+
+BroadcastMessage ProtocolGame::broadcastDistanceShoot(const Position &from, const Position &to, uint16_t type) {
+	return BroadcastMessage([from, to, type](NetworkMessage &msg, BroadcastMessage::Fragment &, bool oldProtocol) {
+		return AddDistanceShoot(msg, from, to, type, oldProtocol);
+	});
+}
+
+bool ProtocolGame::AddDistanceShoot(NetworkMessage &msg, const Position &from, const Position &to, uint16_t type, bool oldProtocol) {
 	if (oldProtocol && type > 0xFF) {
-		return;
+		return false;
 	}
-	NetworkMessage msg;
+
 	if (oldProtocol) {
 		msg.addByte(0x85);
 		msg.addPosition(from);
@@ -6680,7 +6734,7 @@ void ProtocolGame::sendDistanceShoot(const Position &from, const Position &to, u
 		msg.addByte(static_cast<uint8_t>(static_cast<int8_t>(static_cast<int32_t>(to.y) - static_cast<int32_t>(from.y))));
 		msg.addByte(MAGIC_EFFECTS_END_LOOP);
 	}
-	writeToOutputBuffer(msg);
+	return true;
 }
 
 void ProtocolGame::sendRestingStatus(uint8_t protection) {
@@ -6729,11 +6783,21 @@ void ProtocolGame::sendRestingStatus(uint8_t protection) {
 }
 
 void ProtocolGame::sendMagicEffect(const Position &pos, uint16_t type) {
-	if (!canSee(pos) || (oldProtocol && type > 0xFF)) {
+	if (!canSee(pos)) {
 		return;
 	}
 
 	NetworkMessage msg;
+	if (AddMagicEffect(msg, pos, type, oldProtocol)) {
+		writeToOutputBuffer(msg);
+	}
+}
+
+bool ProtocolGame::AddMagicEffect(NetworkMessage &msg, const Position &pos, uint16_t type, bool oldProtocol) {
+	if (oldProtocol && type > 0xFF) {
+		return false;
+	}
+
 	if (oldProtocol) {
 		msg.addByte(0x83);
 		msg.addPosition(pos);
@@ -6745,7 +6809,16 @@ void ProtocolGame::sendMagicEffect(const Position &pos, uint16_t type) {
 		msg.add<uint16_t>(type);
 		msg.addByte(MAGIC_EFFECTS_END_LOOP);
 	}
-	writeToOutputBuffer(msg);
+	return true;
+}
+
+BroadcastMessage ProtocolGame::broadcastMagicEffect(const Position &pos, uint16_t type) {
+	return BroadcastMessage(
+		[pos, type](NetworkMessage &msg, BroadcastMessage::Fragment &, bool oldProtocol) {
+			return AddMagicEffect(msg, pos, type, oldProtocol);
+		},
+		pos
+	);
 }
 
 void ProtocolGame::removeMagicEffect(const Position &pos, uint16_t type) {
@@ -6769,6 +6842,11 @@ void ProtocolGame::sendCreatureHealth(const std::shared_ptr<Creature> &creature)
 	}
 
 	NetworkMessage msg;
+	AddCreatureHealth(msg, creature);
+	writeToOutputBuffer(msg);
+}
+
+void ProtocolGame::AddCreatureHealth(NetworkMessage &msg, const std::shared_ptr<Creature> &creature) {
 	msg.addByte(0x8C);
 	msg.add<uint32_t>(creature->getID());
 	if (creature->isHealthHidden()) {
@@ -6776,8 +6854,16 @@ void ProtocolGame::sendCreatureHealth(const std::shared_ptr<Creature> &creature)
 	} else {
 		msg.addByte(static_cast<uint8_t>(std::min<double>(100, std::ceil((static_cast<double>(creature->getHealth()) / std::max<int32_t>(creature->getMaxHealth(), 1)) * 100))));
 	}
+}
 
-	writeToOutputBuffer(msg);
+BroadcastMessage ProtocolGame::broadcastCreatureHealth(const std::shared_ptr<Creature> &creature) {
+	return BroadcastMessage([creature](NetworkMessage &msg, BroadcastMessage::Fragment &, bool) {
+		if (creature->isHealthHidden()) {
+			return false;
+		}
+		AddCreatureHealth(msg, creature);
+		return true;
+	});
 }
 
 void ProtocolGame::sendPartyCreatureUpdate(const std::shared_ptr<Creature> &target) {
@@ -6800,7 +6886,7 @@ void ProtocolGame::sendPartyCreatureUpdate(const std::shared_ptr<Creature> &targ
 
 void ProtocolGame::sendPartyCreatureShield(const std::shared_ptr<Creature> &target) {
 	uint32_t cid = target->getID();
-	if (!knownCreatureSet.contains(cid)) {
+	if (!knownCreatures.contains(cid)) {
 		sendPartyCreatureUpdate(target);
 		return;
 	}
@@ -6818,7 +6904,7 @@ void ProtocolGame::sendPartyCreatureSkull(const std::shared_ptr<Creature> &targe
 	}
 
 	uint32_t cid = target->getID();
-	if (!knownCreatureSet.contains(cid)) {
+	if (!knownCreatures.contains(cid)) {
 		sendPartyCreatureUpdate(target);
 		return;
 	}
@@ -6832,7 +6918,7 @@ void ProtocolGame::sendPartyCreatureSkull(const std::shared_ptr<Creature> &targe
 
 void ProtocolGame::sendPartyCreatureHealth(const std::shared_ptr<Creature> &target, uint8_t healthPercent) {
 	uint32_t cid = target->getID();
-	if (!knownCreatureSet.contains(cid)) {
+	if (!knownCreatures.contains(cid)) {
 		sendPartyCreatureUpdate(target);
 		return;
 	}
@@ -6846,7 +6932,7 @@ void ProtocolGame::sendPartyCreatureHealth(const std::shared_ptr<Creature> &targ
 
 void ProtocolGame::sendPartyPlayerMana(const std::shared_ptr<Player> &target, uint8_t manaPercent) {
 	uint32_t cid = target->getID();
-	if (!knownCreatureSet.contains(cid)) {
+	if (!knownCreatures.contains(cid)) {
 		sendPartyCreatureUpdate(target);
 	}
 
@@ -6864,7 +6950,7 @@ void ProtocolGame::sendPartyPlayerMana(const std::shared_ptr<Player> &target, ui
 
 void ProtocolGame::sendPartyCreatureShowStatus(const std::shared_ptr<Creature> &target, bool showStatus) {
 	uint32_t cid = target->getID();
-	if (!knownCreatureSet.contains(cid)) {
+	if (!knownCreatures.contains(cid)) {
 		sendPartyCreatureUpdate(target);
 	}
 
@@ -6886,7 +6972,7 @@ void ProtocolGame::sendPartyPlayerVocation(const std::shared_ptr<Player> &target
 	}
 
 	uint32_t cid = target->getID();
-	if (!knownCreatureSet.contains(cid)) {
+	if (!knownCreatures.contains(cid)) {
 		sendPartyCreatureUpdate(target);
 		return;
 	}
@@ -6925,11 +7011,24 @@ void ProtocolGame::sendFYIBox(const std::string &message) {
 
 // tile
 void ProtocolGame::sendMapDescription(const Position &pos) {
-	NetworkMessage msg;
-	msg.addByte(0x64);
-	msg.addPosition(player->getPosition());
-	GetMapDescription(pos.x - MAP_MAX_CLIENT_VIEW_PORT_X, pos.y - MAP_MAX_CLIENT_VIEW_PORT_Y, pos.z, (MAP_MAX_CLIENT_VIEW_PORT_X + 1) * 2, (MAP_MAX_CLIENT_VIEW_PORT_Y + 1) * 2, msg);
-	writeToOutputBuffer(msg);
+	const auto writeDescription = [&](NetworkMessage &msg) {
+		msg.addByte(0x64);
+		msg.addPosition(player->getPosition());
+		GetMapDescription(pos.x - MAP_MAX_CLIENT_VIEW_PORT_X, pos.y - MAP_MAX_CLIENT_VIEW_PORT_Y, pos.z, (MAP_MAX_CLIENT_VIEW_PORT_X + 1) * 2, (MAP_MAX_CLIENT_VIEW_PORT_Y + 1) * 2, msg);
+	};
+
+	if (g_dispatcher().context().isAsync()) {
+		NetworkMessage msg;
+		writeDescription(msg);
+		writeToOutputBuffer(msg);
+		return;
+	}
+
+	// The largest message of all, written straight into an output buffer with the whole body free instead of being built aside and copied
+	const auto &output = getOutputBuffer(MAX_PROTOCOL_BODY_LENGTH);
+	const auto start = output->getLength();
+	writeDescription(*output);
+	onOutputWritten(0x64, output->getLength() - start);
 }
 
 void ProtocolGame::sendAddTileItem(const Position &pos, uint32_t stackpos, const std::shared_ptr<Item> &item) {
@@ -7249,6 +7348,8 @@ void ProtocolGame::sendMoveCreature(const std::shared_ptr<Creature> &creature, c
 				GetMapDescription(newPos.x - MAP_MAX_CLIENT_VIEW_PORT_X, newPos.y - MAP_MAX_CLIENT_VIEW_PORT_Y, newPos.z, 1, (MAP_MAX_CLIENT_VIEW_PORT_Y + 1) * 2, msg);
 			}
 			writeToOutputBuffer(msg);
+			// The client waits for its own step before walking the next one
+			requestFlush();
 		}
 	} else if (canSee(oldPos) && canSee(newPos)) {
 		if (teleport || (oldPos.z == MAP_INIT_SURFACE_LAYER && newPos.z >= MAP_INIT_SURFACE_LAYER + 1) || oldStackPos >= 10) {
@@ -7291,8 +7392,7 @@ void ProtocolGame::sendInventoryIds() {
 
 	NetworkMessage msg;
 	msg.addByte(0xF5);
-	const auto countPosition = msg.getBufferPosition();
-	msg.skipBytes(2); // Total items count
+	const auto countPosition = msg.reserve<uint16_t>(); // Total items count
 
 	uint16_t totalItemsCount = 0;
 
@@ -7314,8 +7414,7 @@ void ProtocolGame::sendInventoryIds() {
 		++totalItemsCount;
 	}
 
-	msg.setBufferPosition(countPosition);
-	msg.add<uint16_t>(totalItemsCount);
+	msg.patch<uint16_t>(countPosition, totalItemsCount);
 
 	writeToOutputBuffer(msg);
 }
@@ -7506,11 +7605,10 @@ void ProtocolGame::sendOutfitWindow() {
 	}
 	msg.add<uint16_t>(currentOutfit.lookFamiliarsType);
 
-	auto startOutfits = msg.getBufferPosition();
 	// 100 is the limit of old protocol clients.
 	uint16_t limitOutfits = std::numeric_limits<uint16_t>::max();
 	uint16_t outfitSize = 0;
-	msg.skipBytes(2);
+	const auto startOutfits = msg.reserve<uint16_t>();
 
 	if (player->isAccessPlayer() && g_configManager().getBoolean(ENABLE_SUPPORT_OUTFIT)) {
 		msg.add<uint16_t>(75);
@@ -7572,15 +7670,11 @@ void ProtocolGame::sendOutfitWindow() {
 		}
 	}
 
-	auto endOutfits = msg.getBufferPosition();
-	msg.setBufferPosition(startOutfits);
-	msg.add<uint16_t>(outfitSize);
-	msg.setBufferPosition(endOutfits);
+	msg.patch<uint16_t>(startOutfits, outfitSize);
 
-	auto startMounts = msg.getBufferPosition();
 	uint16_t limitMounts = std::numeric_limits<uint16_t>::max();
 	uint16_t mountSize = 0;
-	msg.skipBytes(2);
+	const auto startMounts = msg.reserve<uint16_t>();
 
 	const auto mounts = g_game().mounts->getMounts();
 	for (const auto &mount : mounts) {
@@ -7602,15 +7696,11 @@ void ProtocolGame::sendOutfitWindow() {
 		}
 	}
 
-	auto endMounts = msg.getBufferPosition();
-	msg.setBufferPosition(startMounts);
-	msg.add<uint16_t>(mountSize);
-	msg.setBufferPosition(endMounts);
+	msg.patch<uint16_t>(startMounts, mountSize);
 
-	auto startFamiliars = msg.getBufferPosition();
 	uint16_t limitFamiliars = std::numeric_limits<uint16_t>::max();
 	uint16_t familiarSize = 0;
-	msg.skipBytes(2);
+	const auto startFamiliars = msg.reserve<uint16_t>();
 
 	const auto familiars = Familiars::getInstance().getFamiliars(player->getVocationId());
 
@@ -7627,10 +7717,7 @@ void ProtocolGame::sendOutfitWindow() {
 		}
 	}
 
-	auto endFamiliars = msg.getBufferPosition();
-	msg.setBufferPosition(startFamiliars);
-	msg.add<uint16_t>(familiarSize);
-	msg.setBufferPosition(endFamiliars);
+	msg.patch<uint16_t>(startFamiliars, familiarSize);
 
 	msg.addByte(0x00); // Try outfit
 	msg.addByte(mounted ? 0x01 : 0x00);
@@ -7674,10 +7761,9 @@ void ProtocolGame::sendPodiumWindow(const std::shared_ptr<Item> &podium, const P
 	}
 	msg.add<uint16_t>(0);
 
-	auto startOutfits = msg.getBufferPosition();
 	uint16_t limitOutfits = std::numeric_limits<uint16_t>::max();
 	uint16_t outfitSize = 0;
-	msg.skipBytes(2);
+	const auto startOutfits = msg.reserve<uint16_t>();
 
 	const auto outfits = Outfits::getInstance().getOutfits(player->getSex());
 	for (const auto &outfit : outfits) {
@@ -7695,15 +7781,11 @@ void ProtocolGame::sendPodiumWindow(const std::shared_ptr<Item> &podium, const P
 		}
 	}
 
-	auto endOutfits = msg.getBufferPosition();
-	msg.setBufferPosition(startOutfits);
-	msg.add<uint16_t>(outfitSize);
-	msg.setBufferPosition(endOutfits);
+	msg.patch<uint16_t>(startOutfits, outfitSize);
 
-	auto startMounts = msg.getBufferPosition();
 	uint16_t limitMounts = std::numeric_limits<uint16_t>::max();
 	uint16_t mountSize = 0;
-	msg.skipBytes(2);
+	const auto startMounts = msg.reserve<uint16_t>();
 
 	const auto mounts = g_game().mounts->getMounts();
 	for (const auto &mount : mounts) {
@@ -7717,10 +7799,7 @@ void ProtocolGame::sendPodiumWindow(const std::shared_ptr<Item> &podium, const P
 		}
 	}
 
-	auto endMounts = msg.getBufferPosition();
-	msg.setBufferPosition(startMounts);
-	msg.add<uint16_t>(mountSize);
-	msg.setBufferPosition(endMounts);
+	msg.patch<uint16_t>(startMounts, mountSize);
 
 	msg.add<uint16_t>(0);
 
@@ -8333,17 +8412,13 @@ void ProtocolGame::AddPlayerSkills(NetworkMessage &msg) {
 
 	// Store the "combats" to increase in absorb values function and send to client later
 	uint8_t combats = 0;
-	auto startCombats = msg.getBufferPosition();
-	msg.skipBytes(1);
+	const auto startCombats = msg.reserve<uint8_t>();
 
 	// Calculate and parse the combat absorbs values
 	calculateAbsorbValues(player, msg, combats, true);
 
-	// Now set the buffer position skiped and send the total combats count
-	auto endCombats = msg.getBufferPosition();
-	msg.setBufferPosition(startCombats);
-	msg.addByte(combats);
-	msg.setBufferPosition(endCombats);
+	// Now write the total combats count on the reserved byte
+	msg.patch<uint8_t>(startCombats, combats);
 
 	// Forge Bonus
 	msg.addDouble(getForgeSkillStat(CONST_SLOT_HEAD)); // Momentum
@@ -8984,9 +9059,8 @@ void ProtocolGame::sendItemsPrice() {
 	NetworkMessage msg;
 	msg.addByte(0xCD);
 
-	auto countBuffer = msg.getBufferPosition();
+	const auto countPosition = msg.reserve<uint16_t>();
 	uint16_t count = 0;
-	msg.skipBytes(2);
 	for (const auto &[itemId, tierAndPriceMap] : g_game().getItemsPrice()) {
 		for (const auto &[tier, price] : tierAndPriceMap) {
 			msg.add<uint16_t>(itemId);
@@ -8997,8 +9071,7 @@ void ProtocolGame::sendItemsPrice() {
 			count++;
 		}
 	}
-	msg.setBufferPosition(countBuffer);
-	msg.add<uint16_t>(count);
+	msg.patch<uint16_t>(countPosition, count);
 
 	writeToOutputBuffer(msg);
 }
@@ -9021,7 +9094,7 @@ void ProtocolGame::reloadCreature(const std::shared_ptr<Creature> &creature) {
 
 	NetworkMessage msg;
 
-	if (knownCreatureSet.contains(creature->getID())) {
+	if (knownCreatures.contains(creature->getID())) {
 		msg.addByte(0x6B);
 		msg.addPosition(creature->getPosition());
 		msg.addByte(static_cast<uint8_t>(stackpos));
@@ -9392,9 +9465,8 @@ void ProtocolGame::parseSendBosstiary() {
 	msg.addByte(0x73);
 
 	auto mtype_map = g_ioBosstiary().getBosstiaryMap();
-	auto bossesBuffer = msg.getBufferPosition();
+	const auto bossesCountPosition = msg.reserve<uint16_t>();
 	uint16_t bossesCount = 0;
-	msg.skipBytes(2);
 
 	for (const auto &[bossid, name] : mtype_map) {
 		const auto mType = g_monsters().getMonsterType(name);
@@ -9417,8 +9489,7 @@ void ProtocolGame::parseSendBosstiary() {
 		++bossesCount;
 	}
 
-	msg.setBufferPosition(bossesBuffer);
-	msg.add<uint16_t>(bossesCount);
+	msg.patch<uint16_t>(bossesCountPosition, bossesCount);
 
 	writeToOutputBuffer(msg);
 }
@@ -9526,9 +9597,8 @@ void ProtocolGame::parseSendBosstiarySlots() {
 
 	msg.addByte(bossesUnlockedSize != 0 ? 1 : 0);
 	if (bossesUnlockedSize != 0) {
-		auto unlockCountBuffer = msg.getBufferPosition();
+		const auto unlockCountPosition = msg.reserve<uint16_t>();
 		uint16_t bossesCount = 0;
-		msg.skipBytes(2);
 		for (const auto &bossId : bossesUnlockedList) {
 			if (bossId == bossIdSlotOne || bossId == bossIdSlotTwo) {
 				continue;
@@ -9550,8 +9620,7 @@ void ProtocolGame::parseSendBosstiarySlots() {
 			msg.addByte(static_cast<uint8_t>(bossRace));
 			bossesCount++;
 		}
-		msg.setBufferPosition(unlockCountBuffer);
-		msg.add<uint16_t>(bossesCount);
+		msg.patch<uint16_t>(unlockCountPosition, bossesCount);
 	}
 
 	writeToOutputBuffer(msg);
@@ -9691,8 +9760,7 @@ void ProtocolGame::sendBosstiaryCooldownTimer() {
 	NetworkMessage msg;
 	msg.addByte(0xBD);
 
-	auto startBosses = msg.getBufferPosition();
-	msg.skipBytes(2); // Boss count
+	const auto startBosses = msg.reserve<uint16_t>(); // Boss count
 	uint16_t bossesCount = 0;
 	for (std::map<uint16_t, std::string> bossesMap = g_ioBosstiary().getBosstiaryMap();
 	     const auto &[bossRaceId, _] : bossesMap) {
@@ -9722,10 +9790,7 @@ void ProtocolGame::sendBosstiaryCooldownTimer() {
 		msg.add<uint64_t>(sendTimer); // Boss cooldown in seconds
 		bossesCount++;
 	}
-	auto endBosses = msg.getBufferPosition();
-	msg.setBufferPosition(startBosses);
-	msg.add<uint16_t>(bossesCount);
-	msg.setBufferPosition(endBosses);
+	msg.patch<uint16_t>(startBosses, bossesCount);
 
 	writeToOutputBuffer(msg);
 }
@@ -9944,10 +10009,9 @@ void ProtocolGame::sendOutfitWindowCustomOTCR(NetworkMessage &msg) {
 		return;
 	}
 	// wings
-	auto startWings = msg.getBufferPosition();
 	uint16_t limitWings = std::numeric_limits<uint16_t>::max();
 	uint16_t wingSize = 0;
-	msg.skipBytes(1);
+	const auto startWings = msg.reserve<uint8_t>();
 	const auto &wings = g_game().getAttachedEffects()->getWings();
 	for (const auto &wing : wings) {
 		if (player->attachedEffects().hasWing(wing)) {
@@ -9959,15 +10023,11 @@ void ProtocolGame::sendOutfitWindowCustomOTCR(NetworkMessage &msg) {
 			break;
 		}
 	}
-	auto endWings = msg.getBufferPosition();
-	msg.setBufferPosition(startWings);
-	msg.add<uint8_t>(wingSize);
-	msg.setBufferPosition(endWings);
+	msg.patch<uint8_t>(startWings, wingSize);
 	// auras
-	auto startAuras = msg.getBufferPosition();
 	uint16_t limitAuras = std::numeric_limits<uint16_t>::max();
 	uint16_t auraSize = 0;
-	msg.skipBytes(1);
+	const auto startAuras = msg.reserve<uint8_t>();
 	const auto &auras = g_game().getAttachedEffects()->getAuras();
 	for (const auto &aura : auras) {
 		if (player->attachedEffects().hasAura(aura)) {
@@ -9979,15 +10039,11 @@ void ProtocolGame::sendOutfitWindowCustomOTCR(NetworkMessage &msg) {
 			break;
 		}
 	}
-	auto endAuras = msg.getBufferPosition();
-	msg.setBufferPosition(startAuras);
-	msg.add<uint8_t>(auraSize);
-	msg.setBufferPosition(endAuras);
+	msg.patch<uint8_t>(startAuras, auraSize);
 	// effects
-	auto startEffects = msg.getBufferPosition();
 	uint16_t limitEffects = std::numeric_limits<uint16_t>::max();
 	uint16_t effectSize = 0;
-	msg.skipBytes(1);
+	const auto startEffects = msg.reserve<uint8_t>();
 	const auto &effects = g_game().getAttachedEffects()->getEffects();
 	for (const auto &effect : effects) {
 		if (player->attachedEffects().hasEffect(effect)) {
@@ -9999,10 +10055,7 @@ void ProtocolGame::sendOutfitWindowCustomOTCR(NetworkMessage &msg) {
 			break;
 		}
 	}
-	auto endEffects = msg.getBufferPosition();
-	msg.setBufferPosition(startEffects);
-	msg.add<uint8_t>(effectSize);
-	msg.setBufferPosition(endEffects);
+	msg.patch<uint8_t>(startEffects, effectSize);
 	// shader
 	std::vector<const Shader*> shaders;
 	for (const auto &shader : g_game().getAttachedEffects()->getShaders()) {
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "server/network/message/broadcastmessage.hpp"
+#include "server/network/protocol/knowncreaturecache.hpp"
 #include "server/network/protocol/protocol.hpp"
 #include "game/movement/position.hpp"
 #include "utils/utils_definitions.hpp"
@@ -115,6 +117,13 @@ public:
 		return version;
 	}
 
+	// Fragments shared by the spectators of an event, see BroadcastMessage
+	static BroadcastMessage broadcastMagicEffect(const Position &pos, uint16_t type);
+	static BroadcastMessage broadcastDistanceShoot(const Position &from, const Position &to, uint16_t type);
+	static BroadcastMessage broadcastCreatureHealth(const std::shared_ptr<Creature> &creature);
+	static BroadcastMessage broadcastChangeSpeed(const std::shared_ptr<Creature> &creature, uint16_t speed);
+	static BroadcastMessage broadcastCreatureSay(const std::shared_ptr<Creature> &creature, SpeakClasses type, const std::string &text, const Position* pos = nullptr);
+
 private:
 	ProtocolGame_ptr getThis() {
 		return std::static_pointer_cast<ProtocolGame>(shared_from_this());
@@ -122,8 +131,20 @@ private:
 	void connect(const std::string &playerName, OperatingSystem_t operatingSystem);
 	void disconnectClient(const std::string &message) const;
 	void writeToOutputBuffer(NetworkMessage &msg);
+	// Counts what was written to the output buffer and flushes it right away for interactive messages
+	void onOutputWritten(uint8_t opcode, size_t bytes);
+	void sendBroadcast(BroadcastMessage &broadcast);
+	void writeBroadcast(const BroadcastMessage::Fragment &fragment);
+
+	static bool AddMagicEffect(NetworkMessage &msg, const Position &pos, uint16_t type, bool oldProtocol);
+	static bool AddDistanceShoot(NetworkMessage &msg, const Position &from, const Position &to, uint16_t type, bool oldProtocol);
+	static void AddCreatureHealth(NetworkMessage &msg, const std::shared_ptr<Creature> &creature);
+	static void AddChangeSpeed(NetworkMessage &msg, const std::shared_ptr<Creature> &creature, uint16_t speed);
+	// Everything after the statement id
+	static void AddCreatureSay(NetworkMessage &msg, const std::shared_ptr<Creature> &creature, SpeakClasses type, const std::string &text, const Position* pos, bool oldProtocol);
 
 	void release() override;
+	void publishTrafficMetrics() override;
 
 	void checkCreatureAsKnown(uint32_t id, bool &known, uint32_t &removedKnown);
 
@@ -134,7 +155,9 @@ private:
 	// we have all the parse methods
 	void parsePacket(NetworkMessage &msg) override;
 	void parsePacketFromDispatcher(NetworkMessage &msg, uint8_t recvbyte);
-	void onRecvFirstMessage(NetworkMessage &msg) override;
+	bool onRecvFirstMessage(NetworkMessage &msg) override;
+	// Runs on the auth workers, only decrypts and authenticates, login checks the game and the other sessions on the dispatcher
+	bool parseFirstMessage(NetworkMessage &msg);
 	void sendLoginChallenge() override;
 
 	// Parse methods
@@ -557,7 +580,7 @@ private:
 	friend class PlayerVIP;
 	friend class PlayerAttachedEffects;
 
-	std::unordered_set<uint32_t> knownCreatureSet;
+	KnownCreatureCache knownCreatures;
 	std::shared_ptr<Player> player = nullptr;
 
 	uint32_t eventConnect = 0;
@@ -11,6 +11,7 @@
 
 #include "config/configmanager.hpp"
 #include "server/network/message/outputmessage.hpp"
+#include "server/network/protocol/authworkers.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "account/account.hpp"
 #include "io/iologindata.hpp"
@@ -29,7 +30,7 @@ void ProtocolLogin::disconnectClient(const std::string &message) const {
 	disconnect();
 }
 
-void ProtocolLogin::getCharacterList(const std::string &accountDescriptor, const std::string &password) const {
+void ProtocolLogin::getCharacterList(const std::string &accountDescriptor, const std::string &password, uint32_t motdNum) const {
 	Account account(accountDescriptor);
 	account.setProtocolCompat(oldProtocol);
 
@@ -55,7 +56,7 @@ void ProtocolLogin::getCharacterList(const std::string &accountDescriptor, const
 		output->addByte(0x14);
 
 		std::ostringstream ss;
-		ss << g_game().getMotdNum() << "\n"
+		ss << motdNum << "\n"
 		   << motd;
 		output->addString(ss.str());
 	}
@@ -99,12 +100,21 @@ void ProtocolLogin::getCharacterList(const std::string &accountDescriptor, const
 	disconnect();
 }
 
-void ProtocolLogin::onRecvFirstMessage(NetworkMessage &msg) {
-	if (g_game().getGameState() == GAME_STATE_SHUTDOWN) {
+bool ProtocolLogin::onRecvFirstMessage(NetworkMessage &msg) {
+	const auto gameState = g_game().getGameState();
+	if (gameState == GAME_STATE_SHUTDOWN) {
 		disconnect();
-		return;
+		return false;
 	}
 
+	return parseOnAuthWorkers(msg, [self = std::static_pointer_cast<ProtocolLogin>(shared_from_this()), gameState, motdNum = g_game().getMotdNum()](NetworkMessage &firstMessage) {
+		self->parseFirstMessage(firstMessage, gameState, motdNum);
+		// The connection is closed once the character list is sent
+		return false;
+	});
+}
+
+void ProtocolLogin::parseFirstMessage(NetworkMessage &msg, GameState_t gameState, uint32_t motdNum) {
 	msg.skipBytes(2); // client OS
 
 	auto version = msg.get<uint16_t>();
@@ -121,7 +131,7 @@ void ProtocolLogin::onRecvFirstMessage(NetworkMessage &msg) {
 	 */
 
 	if (!Protocol::RSA_decrypt(msg)) {
-		g_logger().warn("[ProtocolLogin::onRecvFirstMessage] - RSA Decrypt Failed");
+		g_logger().warn("[ProtocolLogin::parseFirstMessage] - RSA Decrypt Failed");
 		disconnect();
 		return;
 	}
@@ -132,12 +142,12 @@ void ProtocolLogin::onRecvFirstMessage(NetworkMessage &msg) {
 
 	setChecksumMethod(CHECKSUM_METHOD_ADLER32);
 
-	if (g_game().getGameState() == GAME_STATE_STARTUP) {
+	if (gameState == GAME_STATE_STARTUP) {
 		disconnectClient("Gameworld is starting up. Please wait.");
 		return;
 	}
 
-	if (g_game().getGameState() == GAME_STATE_MAINTAIN) {
+	if (gameState == GAME_STATE_MAINTAIN) {
 		disconnectClient("Gameworld is under maintenance.\nPlease re-connect in a while.");
 		return;
 	}
@@ -174,10 +184,17 @@ void ProtocolLogin::onRecvFirstMessage(NetworkMessage &msg) {
 		return;
 	}
 
-	g_dispatcher().addEvent(
-		[self = std::static_pointer_cast<ProtocolLogin>(shared_from_this()), accountDescriptor, password] {
-			self->getCharacterList(accountDescriptor, password);
-		},
-		__FUNCTION__
-	);
+	if (g_authWorkers().getThreadCount() == 0) {
+		// Parsed on the network thread, the account queries and the password hash stay off it
+		g_dispatcher().addEvent(
+			[self = std::static_pointer_cast<ProtocolLogin>(shared_from_this()), accountDescriptor, password, motdNum] {
+				self->getCharacterList(accountDescriptor, password, motdNum);
+			},
+			__FUNCTION__
+		);
+		return;
+	}
+
+	// Already on the auth workers, the account queries and the password hash don't need the dispatcher
+	getCharacterList(accountDescriptor, password, motdNum);
 }
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "game/game_definitions.hpp"
 #include "server/network/protocol/protocol.hpp"
 
 class NetworkMessage;
@@ -27,12 +28,14 @@ public:
 	explicit ProtocolLogin(const Connection_ptr &loginConnection) :
 		Protocol(loginConnection) { }
 
-	void onRecvFirstMessage(NetworkMessage &msg) override;
+	bool onRecvFirstMessage(NetworkMessage &msg) override;
 
 private:
+	// May run on the auth workers, the game state and MOTD number are read before by onRecvFirstMessage
+	void parseFirstMessage(NetworkMessage &msg, GameState_t gameState, uint32_t motdNum);
 	void disconnectClient(const std::string &message) const;
 
-	void getCharacterList(const std::string &accountDescriptor, const std::string &password) const;
+	void getCharacterList(const std::string &accountDescriptor, const std::string &password, uint32_t motdNum) const;
 
 	bool oldProtocol = false;
 };
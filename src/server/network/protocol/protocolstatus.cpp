@@ -20,23 +20,31 @@ std::string ProtocolStatus::SERVER_NAME = "Canary";
 std::string ProtocolStatus::SERVER_VERSION = "3.0";
 std::string ProtocolStatus::SERVER_DEVELOPERS = "OpenTibiaBR Organization";
 
+std::mutex ProtocolStatus::ipConnectMutex;
 std::map<uint32_t, int64_t> ProtocolStatus::ipConnectMap;
 const uint64_t ProtocolStatus::start = OTSYS_TIME(true);
 
-void ProtocolStatus::onRecvFirstMessage(NetworkMessage &msg) {
-	const uint32_t ip = getIP();
-	if (ip != 0x0100007F) {
-		const std::string ipStr = convertIPToString(ip);
-		if (ipStr != g_configManager().getString(IP)) {
-			const auto it = ipConnectMap.find(ip);
-			if (it != ipConnectMap.end() && (OTSYS_TIME() < (it->second + g_configManager().getNumber(STATUSQUERY_TIMEOUT)))) {
-				disconnect();
-				return;
-			}
+bool ProtocolStatus::acceptQuery(uint32_t ip) {
+	const bool limited = ip != 0x0100007F && convertIPToString(ip) != g_configManager().getString(IP);
+	const int64_t now = OTSYS_TIME();
+
+	std::scoped_lock lock(ipConnectMutex);
+	if (limited) {
+		const auto it = ipConnectMap.find(ip);
+		if (it != ipConnectMap.end() && now < it->second + g_configManager().getNumber(STATUSQUERY_TIMEOUT)) {
+			return false;
 		}
 	}
 
-	ipConnectMap[ip] = OTSYS_TIME();
+	ipConnectMap[ip] = now;
+	return true;
+}
+
+bool ProtocolStatus::onRecvFirstMessage(NetworkMessage &msg) {
+	if (!acceptQuery(getIP())) {
+		disconnect();
+		return false;
+	}
 
 	switch (msg.getByte()) {
 		// XML info protocol
@@ -48,7 +56,7 @@ void ProtocolStatus::onRecvFirstMessage(NetworkMessage &msg) {
 					},
 					__FUNCTION__
 				);
-				return;
+				return false;
 			}
 			break;
 		}
@@ -67,13 +75,14 @@ void ProtocolStatus::onRecvFirstMessage(NetworkMessage &msg) {
 				__FUNCTION__
 			);
 
-			return;
+			return false;
 		}
 
 		default:
 			break;
 	}
 	disconnect();
+	return false;
 }
 
 void ProtocolStatus::sendStatusString() {
@@ -25,7 +25,7 @@ public:
 	explicit ProtocolStatus(const Connection_ptr &conn) :
 		Protocol(conn) { }
 
-	void onRecvFirstMessage(NetworkMessage &msg) override;
+	bool onRecvFirstMessage(NetworkMessage &msg) override;
 
 	void sendStatusString();
 	void sendInfo(uint16_t requestedInfo, const std::string &characterName) const;
@@ -37,5 +37,10 @@ public:
 	static std::string SERVER_DEVELOPERS;
 
 private:
+	// Records the query, false when the ip already queried within the status query timeout
+	static bool acceptQuery(uint32_t ip);
+
+	// Status queries come in on every network reactor
+	static std::mutex ipConnectMutex;
 	static std::map<uint32_t, int64_t> ipConnectMap;
 };
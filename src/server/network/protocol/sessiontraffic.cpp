@@ -0,0 +1,110 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/protocol/sessiontraffic.hpp"
+
+#include "lib/metrics/metrics.hpp"
+
+namespace {
+	// Only answers to what the client itself did, what it sees of the world around it waits for the autosend.
+	// Its own steps start with the creature move opcode of everyone else's, sendMoveCreature flushes them.
+	std::bitset<256> makeInteractiveOpcodes() {
+		std::bitset<256> opcodes;
+		for (const uint8_t opcode : {
+				 0x0F, // enter world
+				 0x17, // login
+				 0x1D, // ping
+				 0x1E, // ping back
+				 0x64, // map description, on login and teleport
+				 0xB5, // cancel walk
+			 }) {
+			opcodes.set(opcode);
+		}
+		return opcodes;
+	}
+
+	const std::bitset<256> INTERACTIVE_OPCODES = makeInteractiveOpcodes();
+
+	const char* directionName(size_t direction) {
+		return direction == 0 ? "in" : "out";
+	}
+}
+
+void SessionTraffic::addPacket(TrafficDirection direction, uint8_t opcode, size_t bytes) {
+	auto &opcodeCounters = counters[index(direction)];
+	opcodeCounters.bytes[opcode] += bytes;
+	++opcodeCounters.packets[opcode];
+	changed[index(direction)].set(opcode);
+}
+
+void SessionTraffic::onPingSent() {
+	// Only the oldest ping without an answer is timed
+	if (pingSentAt == std::chrono::steady_clock::time_point {}) {
+		pingSentAt = std::chrono::steady_clock::now();
+	}
+}
+
+void SessionTraffic::onPingReceived() {
+	if (pingSentAt == std::chrono::steady_clock::time_point {}) {
+		return;
+	}
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - pingSentAt);
+	pingSentAt = {};
+	addRoundTrip(static_cast<uint32_t>(std::min<int64_t>(elapsed.count(), std::numeric_limits<uint16_t>::max())));
+}
+
+void SessionTraffic::addRoundTrip(uint32_t milliseconds) {
+	// Same smoothing as the TCP round trip estimate, one spike doesn't change the batching
+	roundTrip = roundTrip == 0 ? std::max<uint32_t>(1, milliseconds) : (roundTrip * 7 + milliseconds) / 8;
+}
+
+uint32_t SessionTraffic::getBatchTicks(bool writePending, uint32_t maxTicks) const {
+	if (maxTicks <= 1) {
+		return 1;
+	}
+	if (writePending) {
+		return maxTicks;
+	}
+	return std::clamp<uint32_t>(1 + roundTrip / ROUND_TRIP_PER_BATCH_TICK, 1, maxTicks);
+}
+
+bool SessionTraffic::isInteractive(uint8_t opcode) {
+	return INTERACTIVE_OPCODES.test(opcode);
+}
+
+void SessionTraffic::publishMetrics(const std::map<std::string, std::string> &attrs) {
+	for (size_t direction = 0; direction < counters.size(); ++direction) {
+		const auto &current = counters[direction];
+		auto &previous = published[direction];
+		auto &opcodes = changed[direction];
+		// Summed by opcode over every session, a series per player and opcode would be too many
+		for (size_t opcode = 0; opcodes.any() && opcode < opcodes.size(); ++opcode) {
+			if (!opcodes.test(opcode)) {
+				continue;
+			}
+			opcodes.reset(opcode);
+			const std::map<std::string, std::string> opcodeAttrs { { "direction", directionName(direction) }, { "opcode", fmt::format("0x{:02X}", opcode) } };
+			g_metrics().addCounter("network_opcode_packets", static_cast<double>(current.packets[opcode] - previous.packets[opcode]), opcodeAttrs);
+			g_metrics().addCounter("network_opcode_bytes", static_cast<double>(current.bytes[opcode] - previous.bytes[opcode]), opcodeAttrs);
+			previous.packets[opcode] = current.packets[opcode];
+			previous.bytes[opcode] = current.bytes[opcode];
+		}
+
+		auto sessionAttrs = attrs;
+		sessionAttrs.emplace("direction", directionName(direction));
+		const auto currentWireBytes = wireBytes[direction].load(std::memory_order_relaxed);
+		g_metrics().addCounter("network_session_bytes", static_cast<double>(currentWireBytes - publishedWireBytes[direction]), sessionAttrs);
+		publishedWireBytes[direction] = currentWireBytes;
+	}
+
+	const auto currentWrites = writes.load(std::memory_order_relaxed);
+	g_metrics().addCounter("network_session_writes", static_cast<double>(currentWrites - publishedWrites), attrs);
+	publishedWrites = currentWrites;
+}
@@ -0,0 +1,91 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+enum class TrafficDirection : uint8_t {
+	Inbound,
+	Outbound,
+};
+
+/**
+ * Traffic of one connection, by direction and opcode, and what the autosend needs to know about its client.
+ * The packets are counted by the dispatcher when they are parsed or written to the output buffer, the bytes on
+ * the wire and the writes by the network thread of the connection.
+ */
+class SessionTraffic {
+public:
+	// Round trip that lets the client wait one more autosend tick, the delay disappears in its latency
+	static constexpr uint32_t ROUND_TRIP_PER_BATCH_TICK = 100;
+
+	void addPacket(TrafficDirection direction, uint8_t opcode, size_t bytes);
+	void addWireBytes(TrafficDirection direction, size_t bytes) {
+		wireBytes[index(direction)].fetch_add(bytes, std::memory_order_relaxed);
+	}
+	void addWrite() {
+		writes.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint64_t getBytes(TrafficDirection direction, uint8_t opcode) const {
+		return counters[index(direction)].bytes[opcode];
+	}
+	uint64_t getPackets(TrafficDirection direction, uint8_t opcode) const {
+		return counters[index(direction)].packets[opcode];
+	}
+	uint64_t getWireBytes(TrafficDirection direction) const {
+		return wireBytes[index(direction)].load(std::memory_order_relaxed);
+	}
+	uint64_t getWrites() const {
+		return writes.load(std::memory_order_relaxed);
+	}
+
+	void onPingSent();
+	void onPingReceived();
+	void addRoundTrip(uint32_t milliseconds);
+	// Smoothed round trip in milliseconds, 0 until the first ping comes back
+	uint32_t getRoundTrip() const {
+		return roundTrip;
+	}
+
+	/**
+	 * Autosend ticks the output buffer of the client can wait, 1 flushes it on every tick.
+	 * Clients with a long round trip batch more, and so do clients whose previous write is still in flight,
+	 * their socket doesn't take more data anyway.
+	 */
+	uint32_t getBatchTicks(bool writePending, uint32_t maxTicks) const;
+
+	// Messages the client is waiting for to react to its own actions, flushed without waiting for the autosend
+	static bool isInteractive(uint8_t opcode);
+
+	// Reports what changed since the previous call, from the dispatcher thread
+	void publishMetrics(const std::map<std::string, std::string> &attrs);
+
+private:
+	struct OpcodeCounters {
+		std::array<uint64_t, 256> bytes {};
+		std::array<uint32_t, 256> packets {};
+	};
+
+	static size_t index(TrafficDirection direction) {
+		return static_cast<size_t>(direction);
+	}
+
+	std::array<OpcodeCounters, 2> counters;
+	std::array<OpcodeCounters, 2> published;
+	// Opcodes counted since the last publish
+	std::array<std::bitset<256>, 2> changed;
+
+	std::array<std::atomic<uint64_t>, 2> wireBytes {};
+	std::atomic<uint64_t> writes = 0;
+	std::array<uint64_t, 2> publishedWireBytes {};
+	uint64_t publishedWrites = 0;
+
+	std::chrono::steady_clock::time_point pingSentAt;
+	uint32_t roundTrip = 0;
+};
@@ -24,6 +24,7 @@ ServiceManager::~ServiceManager() {
 
 void ServiceManager::die() {
 	io_service.stop();
+	reactors.stop();
 }
 
 void ServiceManager::run() {
@@ -34,9 +35,32 @@ void ServiceManager::run() {
 
 	assert(!running);
 	running = true;
+
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_DISABLE_EPOLL)
+	g_logger().info("Socket operations go through io_uring");
+#endif
+
+	const auto reactorCount = std::max<int32_t>(0, g_configManager().getNumber(NETWORK_REACTORS));
+	if (reactorCount > 0) {
+		reactors.start(static_cast<size_t>(reactorCount));
+		g_logger().info("Serving the connections on {} network threads", reactorCount);
+		scheduleMetrics();
+	}
+
 	io_service.run();
 }
 
+void ServiceManager::scheduleMetrics() {
+	metrics_timer.expires_from_now(std::chrono::seconds(NETWORK_REACTOR_METRICS_INTERVAL));
+	metrics_timer.async_wait([this](const std::error_code &error) {
+		if (error == asio::error::operation_aborted) {
+			return;
+		}
+		reactors.publishMetrics();
+		scheduleMetrics();
+	});
+}
+
 void ServiceManager::stop() {
 	if (!running) {
 		return;
@@ -53,6 +77,7 @@ void ServiceManager::stop() {
 	}
 
 	acceptors.clear();
+	metrics_timer.cancel();
 
 	death_timer.expires_from_now(std::chrono::seconds(3));
 	death_timer.async_wait([this](const std::error_code &err) {
@@ -60,6 +85,83 @@ void ServiceManager::stop() {
 	});
 }
 
+NetworkReactor::NetworkReactor(size_t id) :
+	work(asio::make_work_guard(ioContext)), id(id) { }
+
+NetworkReactor::~NetworkReactor() {
+	stop();
+}
+
+void NetworkReactor::start() {
+	thread = std::thread([this] {
+		try {
+			ioContext.run();
+		} catch (const std::exception &exception) {
+			g_logger().error("[NetworkReactor::start] - Network thread {} stopped: {}", id, exception.what());
+		}
+	});
+}
+
+void NetworkReactor::stop() {
+	work.reset();
+	ioContext.stop();
+	if (thread.joinable()) {
+		thread.join();
+	}
+}
+
+void NetworkReactor::publishMetrics() {
+	const std::map<std::string, std::string> attrs { { "reactor", std::to_string(id) } };
+
+	const auto currentConnections = getConnections();
+	const auto currentMessages = sentMessages.load(std::memory_order_relaxed);
+	const auto currentBytes = sentBytes.load(std::memory_order_relaxed);
+	const auto currentEncodeTime = encodeTime.load(std::memory_order_relaxed);
+
+	g_metrics().addUpDownCounter("network_reactor_connections", currentConnections - publishedConnections, attrs);
+	g_metrics().addCounter("network_reactor_sent_messages", static_cast<double>(currentMessages - publishedMessages), attrs);
+	g_metrics().addCounter("network_reactor_sent_bytes", static_cast<double>(currentBytes - publishedBytes), attrs);
+	g_metrics().addCounter("network_reactor_encode_us", static_cast<double>(currentEncodeTime - publishedEncodeTime), attrs);
+
+	publishedConnections = currentConnections;
+	publishedMessages = currentMessages;
+	publishedBytes = currentBytes;
+	publishedEncodeTime = currentEncodeTime;
+}
+
+void NetworkReactorPool::start(size_t count) {
+	stop();
+
+	reactors.reserve(count);
+	for (size_t id = 0; id < count; ++id) {
+		const auto &reactor = reactors.emplace_back(std::make_shared<NetworkReactor>(id));
+		reactor->start();
+	}
+}
+
+void NetworkReactorPool::stop() {
+	// Every thread is joined while the pool still holds the reactors, so the connection that releases
+	// a reactor last never does it from a handler running on that reactor
+	for (const auto &reactor : reactors) {
+		reactor->stop();
+	}
+	reactors.clear();
+	nextReactor = 0;
+}
+
+void NetworkReactorPool::publishMetrics() const {
+	for (const auto &reactor : reactors) {
+		reactor->publishMetrics();
+	}
+}
+
+std::shared_ptr<NetworkReactor> NetworkReactorPool::next() {
+	if (reactors.empty()) {
+		return nullptr;
+	}
+	return reactors[nextReactor++ % reactors.size()];
+}
+
 ServicePort::~ServicePort() {
 	close();
 }
@@ -87,7 +189,7 @@ void ServicePort::accept() {
 		return;
 	}
 
-	auto connection = ConnectionManager::getInstance().createConnection(io_service, shared_from_this());
+	auto connection = ConnectionManager::getInstance().createConnection(io_service, shared_from_this(), reactors.next());
 	acceptor->async_accept(connection->getSocket(), [self = shared_from_this(), connection](const std::error_code &error) { self->onAccept(connection, error); });
 }
 
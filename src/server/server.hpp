@@ -15,6 +15,9 @@
 
 class Protocol;
 
+// Seconds between two reports of the network reactors to the metrics
+static constexpr int32_t NETWORK_REACTOR_METRICS_INTERVAL = 10;
+
 class ServiceBase {
 public:
 	virtual ~ServiceBase() = default;
@@ -47,10 +50,89 @@ public:
 	}
 };
 
+/**
+ * io_context served by its own thread. The sockets of the connections assigned to it are read,
+ * encoded (compression, XTEA, checksum) and written there, instead of on the thread of the acceptors.
+ */
+class NetworkReactor {
+public:
+	explicit NetworkReactor(size_t id);
+	~NetworkReactor();
+
+	// non-copyable
+	NetworkReactor(const NetworkReactor &) = delete;
+	NetworkReactor &operator=(const NetworkReactor &) = delete;
+
+	void start();
+	void stop();
+
+	asio::io_context &getIoContext() {
+		return ioContext;
+	}
+	size_t getId() const {
+		return id;
+	}
+	int32_t getConnections() const {
+		return connections.load(std::memory_order_relaxed);
+	}
+
+	void onConnectionOpen() {
+		connections.fetch_add(1, std::memory_order_relaxed);
+	}
+	void onConnectionClose() {
+		connections.fetch_sub(1, std::memory_order_relaxed);
+	}
+	void onMessageSent(size_t bytes, uint64_t encodeMicroseconds) {
+		sentMessages.fetch_add(1, std::memory_order_relaxed);
+		sentBytes.fetch_add(bytes, std::memory_order_relaxed);
+		encodeTime.fetch_add(encodeMicroseconds, std::memory_order_relaxed);
+	}
+
+	// Reports what changed since the previous call, from the thread of the acceptors
+	void publishMetrics();
+
+private:
+	asio::io_context ioContext;
+	asio::executor_work_guard<asio::io_context::executor_type> work;
+	std::thread thread;
+	size_t id;
+
+	std::atomic<int32_t> connections = 0;
+	std::atomic<uint64_t> sentMessages = 0;
+	std::atomic<uint64_t> sentBytes = 0;
+	std::atomic<uint64_t> encodeTime = 0;
+
+	int32_t publishedConnections = 0;
+	uint64_t publishedMessages = 0;
+	uint64_t publishedBytes = 0;
+	uint64_t publishedEncodeTime = 0;
+};
+
+class NetworkReactorPool {
+public:
+	void start(size_t count);
+	void stop();
+	void publishMetrics() const;
+
+	bool empty() const {
+		return reactors.empty();
+	}
+
+	/**
+	 * Reactor of the next accepted connection, round robin. Only called by the acceptors.
+	 * \returns nullptr when there are no reactors and the sockets stay on the thread of the acceptors
+	 */
+	std::shared_ptr<NetworkReactor> next();
+
+private:
+	std::vector<std::shared_ptr<NetworkReactor>> reactors;
+	size_t nextReactor = 0;
+};
+
 class ServicePort : public std::enable_shared_from_this<ServicePort> {
 public:
-	explicit ServicePort(asio::io_service &init_io_service) :
-		io_service(init_io_service) { }
+	ServicePort(asio::io_service &init_io_service, NetworkReactorPool &init_reactors) :
+		io_service(init_io_service), reactors(init_reactors) { }
 	~ServicePort();
 
 	// non-copyable
@@ -73,6 +155,7 @@ private:
 	void accept();
 
 	asio::io_service &io_service;
+	NetworkReactorPool &reactors;
 	std::unique_ptr<asio::ip::tcp::acceptor> acceptor;
 	std::vector<Service_ptr> services;
 
@@ -101,12 +184,15 @@ public:
 
 private:
 	void die();
+	void scheduleMetrics();
 
 	phmap::flat_hash_map<uint16_t, ServicePort_ptr> acceptors;
 
 	asio::io_service io_service;
+	NetworkReactorPool reactors;
 	Signals signals { io_service };
 	asio::high_resolution_timer death_timer { io_service };
+	asio::high_resolution_timer metrics_timer { io_service };
 	bool running = false;
 };
 
@@ -124,7 +210,7 @@ bool ServiceManager::add(uint16_t port) {
 	const auto foundServicePort = acceptors.find(port);
 
 	if (foundServicePort == acceptors.end()) {
-		service_port = std::make_shared<ServicePort>(io_service);
+		service_port = std::make_shared<ServicePort>(io_service, reactors);
 		service_port->open(port);
 		acceptors[port] = service_port;
 	} else {
@@ -15,6 +15,7 @@
 #include "game/game.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/save_manager.hpp"
+#include "game/scheduling/tick_profiler.hpp"
 #include "lib/thread/thread_pool.hpp"
 #include "lua/creature/events.hpp"
 #include "lua/global/globalevent.hpp"
@@ -27,6 +28,7 @@ Signals::Signals(asio::io_service &service) :
 	set.add(SIGTERM);
 #ifndef _WIN32
 	set.add(SIGUSR1);
+	set.add(SIGUSR2);
 	set.add(SIGHUP);
 #else
 	// This must be a blocking call as Windows calls it in a new thread and terminates
@@ -77,6 +79,9 @@ void Signals::dispatchSignalHandler(int signal) {
 		case SIGUSR1: // Saves game state
 			g_dispatcher().addEvent(sigusr1Handler, __FUNCTION__);
 			break;
+		case SIGUSR2: // Dumps the slowest ticks
+			g_dispatcher().addEvent(sigusr2Handler, __FUNCTION__);
+			break;
 #else
 		case SIGBREAK: // Shuts the server down
 			g_dispatcher().addEvent(sigbreakHandler, __FUNCTION__);
@@ -108,6 +113,18 @@ void Signals::sigusr1Handler() {
 	g_saveManager().scheduleAll();
 }
 
+void Signals::sigusr2Handler() {
+	// Dispatcher thread
+	g_logger().info("SIGUSR2 received, dumping the slowest ticks...");
+	if (g_tickProfiler().getSampleCount() == 0) {
+		g_logger().info("No slow tick has been recorded yet");
+		return;
+	}
+
+	g_tickProfiler().dump(TickProfileFormat::Folded);
+	g_tickProfiler().dump(TickProfileFormat::ChromeTrace);
+}
+
 void Signals::sighupHandler() {
 	// Dispatcher thread
 	g_logger().info("SIGHUP received, reloading config files...");
@@ -0,0 +1,111 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/functions/lua_functions_loader.hpp"
+#include "game/movement/position.hpp"
+
+namespace {
+	constexpr int ITERATIONS = 100000;
+
+	// What pushPosition and the metatable setters did before the metatables were cached
+	void pushPositionByName(lua_State* L, const Position &position, int32_t stackpos) {
+		lua_createtable(L, 0, 4);
+		Lua::setField(L, "x", position.x);
+		Lua::setField(L, "y", position.y);
+		Lua::setField(L, "z", position.z);
+		Lua::setField(L, "stackpos", stackpos);
+		luaL_getmetatable(L, "Position");
+		lua_setmetatable(L, -2);
+	}
+
+	void pushUserdataByName(lua_State* L, void* value, const char* className) {
+		Lua::pushUserdata<void>(L, value);
+		luaL_getmetatable(L, className);
+		lua_setmetatable(L, -2);
+	}
+
+	void pushUserdataCached(lua_State* L, void* value, LuaData_t type) {
+		Lua::pushUserdata<void>(L, value);
+		Lua::setMetatable(L, -1, type);
+	}
+
+	template <typename F>
+	double measureNanoseconds(F &&f) {
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < ITERATIONS; ++i) {
+			f(i);
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::nano>(elapsed).count() / ITERATIONS;
+	}
+
+	class LuaPushBenchmark : public ::testing::Test {
+	protected:
+		void SetUp() override {
+			L = luaL_newstate();
+			luaL_openlibs(L);
+			for (const auto &className : { "Position", "Player", "Item", "Tile" }) {
+				Lua::registerClass(L, className, "");
+			}
+		}
+
+		void TearDown() override {
+			Lua::clearMetatableRefs(L);
+			lua_close(L);
+		}
+
+		lua_State* L = nullptr;
+	};
+}
+
+TEST_F(LuaPushBenchmark, EventCallbackDispatchCost) {
+	// Same arguments as Events::eventPlayerOnMoveItem
+	ASSERT_EQ(0, luaL_dostring(L, "return function(player, item, count, fromPosition, toPosition, fromCylinder, toCylinder) return fromPosition.x + toPosition.y + count end"));
+	const int function = luaL_ref(L, LUA_REGISTRYINDEX);
+
+	int player = 0;
+	int item = 0;
+	int tile = 0;
+	const Position fromPosition(1000, 1000, 7);
+	const Position toPosition(1001, 1000, 7);
+
+	auto call = [&](int i) {
+		EXPECT_EQ(0, lua_pcall(L, 7, 1, 0));
+		EXPECT_EQ(fromPosition.x + toPosition.y + i, lua_tointeger(L, -1));
+		lua_pop(L, 1);
+	};
+
+	const auto byName = measureNanoseconds([&](int i) {
+		lua_rawgeti(L, LUA_REGISTRYINDEX, function);
+		pushUserdataByName(L, &player, "Player");
+		pushUserdataByName(L, &item, "Item");
+		lua_pushnumber(L, i);
+		pushPositionByName(L, fromPosition, 0);
+		pushPositionByName(L, toPosition, 0);
+		pushUserdataByName(L, &tile, "Tile");
+		pushUserdataByName(L, &tile, "Tile");
+		call(i);
+	});
+
+	const auto cached = measureNanoseconds([&](int i) {
+		lua_rawgeti(L, LUA_REGISTRYINDEX, function);
+		pushUserdataCached(L, &player, LuaData_t::Player);
+		pushUserdataCached(L, &item, LuaData_t::Item);
+		lua_pushnumber(L, i);
+		Lua::pushPosition(L, fromPosition);
+		Lua::pushPosition(L, toPosition);
+		pushUserdataCached(L, &tile, LuaData_t::Tile);
+		pushUserdataCached(L, &tile, LuaData_t::Tile);
+		call(i);
+	});
+
+	std::cout << fmt::format("event callback dispatch: {:.1f} ns/call by name, {:.1f} ns/call cached\n", byName, cached);
+	EXPECT_EQ(0, lua_gettop(L));
+	luaL_unref(L, LUA_REGISTRYINDEX, function);
+}
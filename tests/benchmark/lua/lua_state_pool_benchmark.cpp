@@ -0,0 +1,31 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/area_spell.hpp"
+
+TEST(LuaStatePoolBenchmark, FormulaHeavySpellsInParallel) {
+	constexpr size_t CASTS = 20000;
+	const size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+
+	LuaStatePool single;
+	single.init(1);
+	ASSERT_TRUE(single.loadBuffer(tests::AREA_SPELL_SCRIPT, "spell"));
+
+	LuaStatePool parallel;
+	parallel.init(threads);
+	ASSERT_TRUE(parallel.loadBuffer(tests::AREA_SPELL_SCRIPT, "spell"));
+
+	std::vector<double> serialTotals;
+	std::vector<double> parallelTotals;
+	const auto serialTime = tests::castSpells(single, 1, CASTS, serialTotals);
+	const auto parallelTime = tests::castSpells(parallel, threads, CASTS, parallelTotals);
+
+	std::cout << fmt::format("{} area spell formulas: {:.1f} ms on the main state, {:.1f} ms on {} pure states\n", CASTS, serialTime, parallelTime, threads);
+	EXPECT_EQ(serialTotals, parallelTotals);
+}
@@ -0,0 +1,49 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/receive_stream.hpp"
+
+TEST(ReceiveBufferBenchmark, CoalescedReadsOverLoopback) {
+	constexpr size_t PACKETS = 20000;
+	std::mt19937 random(7);
+	std::vector<std::vector<uint8_t>> sent;
+	const auto stream = tests::makeStream(PACKETS, random, sent);
+
+	const auto run = [&stream, &sent](bool buffered) {
+		asio::io_context context;
+		asio::ip::tcp::acceptor acceptor(context, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+		asio::ip::tcp::socket client(context);
+		client.connect(acceptor.local_endpoint());
+		asio::ip::tcp::socket server(context);
+		acceptor.accept(server);
+
+		std::thread writer([&client, &stream] {
+			asio::write(client, asio::buffer(stream));
+		});
+
+		size_t reads = 0;
+		ReceiveBuffer buffer(buffered ? 4096 : 0);
+		const auto read = [&server](uint8_t* destination, size_t size) {
+			return server.read_some(asio::buffer(destination, size));
+		};
+		const auto start = std::chrono::steady_clock::now();
+		const auto received = tests::parseStream(buffer, sent.size(), read, reads);
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		writer.join();
+
+		EXPECT_EQ(received, sent);
+		return std::make_pair(reads, elapsed.count());
+	};
+
+	const auto [exactReads, exactTime] = run(false);
+	const auto [coalescedReads, coalescedTime] = run(true);
+	std::cout << fmt::format("{} packets: {} reads in {} us reading each header and body, {} reads in {} us coalesced\n", PACKETS, exactReads, exactTime, coalescedReads, coalescedTime);
+	EXPECT_GE(exactReads, PACKETS * 2);
+	EXPECT_LT(coalescedReads * 4, exactReads);
+}
@@ -0,0 +1,96 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/message/networkmessage.hpp"
+#include "server/network/message/outputmessage.hpp"
+#include "map/map_const.hpp"
+
+namespace {
+	/**
+	 * Writes what a full map description looks like on a crowded surface floor: the 18x14 client view of
+	 * the eight floors down to the ground, tiles with a ground and a few items, a creature every few tiles
+	 * and skip markers for the empty ones.
+	 */
+	void writeMapDescription(NetworkMessage &msg) {
+		constexpr int32_t width = (MAP_MAX_CLIENT_VIEW_PORT_X + 1) * 2;
+		constexpr int32_t height = (MAP_MAX_CLIENT_VIEW_PORT_Y + 1) * 2;
+		msg.addByte(0x64);
+		msg.addPosition(Position { 1000, 1000, 7 });
+
+		uint32_t tile = 0;
+		for (int32_t z = 7; z >= 0; --z) {
+			for (int32_t x = 0; x < width; ++x) {
+				for (int32_t y = 0; y < height; ++y, ++tile) {
+					if (z < 6 && tile % 3 != 0) {
+						msg.addByte(0);
+						msg.addByte(0xFF);
+						continue;
+					}
+
+					msg.add<uint16_t>(0);
+					msg.add<uint16_t>(static_cast<uint16_t>(100 + tile % 400));
+					for (uint32_t item = 0; item < tile % 4; ++item) {
+						msg.add<uint16_t>(static_cast<uint16_t>(2000 + item));
+						msg.addByte(0xFF);
+					}
+
+					if (tile % 5 == 0) {
+						msg.add<uint16_t>(0x61);
+						msg.add<uint32_t>(0);
+						msg.add<uint32_t>(0x10000000 + tile);
+						msg.addByte(0);
+						msg.addString("Player Name");
+						msg.addByte(100);
+						msg.addByte(2);
+						msg.add<uint16_t>(128);
+						for (uint8_t part = 0; part < 5; ++part) {
+							msg.addByte(part);
+						}
+						msg.add<uint16_t>(0);
+						msg.add<uint16_t>(220);
+						msg.addByte(0);
+						msg.addByte(0);
+						msg.addByte(0);
+					}
+					msg.addByte(0);
+					msg.addByte(0xFF);
+				}
+			}
+		}
+	}
+
+	double encodeMapDescriptions(size_t descriptions, bool direct, size_t &bytes) {
+		bytes = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < descriptions; ++i) {
+			const auto output = OutputMessagePool::getOutputMessage();
+			if (direct) {
+				writeMapDescription(*output);
+			} else {
+				NetworkMessage msg;
+				writeMapDescription(msg);
+				output->append(msg);
+			}
+			bytes += output->getLength();
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double>(elapsed).count();
+	}
+}
+
+TEST(NetworkMessageBenchmark, MapDescriptionEncodeThroughput) {
+	constexpr size_t DESCRIPTIONS = 2000;
+	size_t copiedBytes;
+	size_t directBytes;
+	const auto copiedSeconds = encodeMapDescriptions(DESCRIPTIONS, false, copiedBytes);
+	const auto directSeconds = encodeMapDescriptions(DESCRIPTIONS, true, directBytes);
+
+	std::cout << fmt::format("{} map descriptions of {} bytes: {:.1f} MB/s built aside and appended, {:.1f} MB/s written into the output message\n", DESCRIPTIONS, directBytes / DESCRIPTIONS, copiedBytes / copiedSeconds / 1e6, directBytes / directSeconds / 1e6);
+	EXPECT_EQ(copiedBytes, directBytes);
+}
@@ -0,0 +1,28 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/login_burst.hpp"
+
+TEST(AuthWorkersBenchmark, LoginBurstAfterRestart) {
+	constexpr size_t LOGINS = 400;
+	const size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+
+	AuthWorkers single;
+	single.start(1, LOGINS);
+	AuthWorkers parallel;
+	parallel.start(threads, LOGINS);
+
+	std::vector<uint64_t> serialResults;
+	std::vector<uint64_t> parallelResults;
+	const auto serialTime = tests::loginBurst(single, LOGINS, serialResults);
+	const auto parallelTime = tests::loginBurst(parallel, LOGINS, parallelResults);
+
+	std::cout << fmt::format("{} logins: {:.1f} ms on one thread, {:.1f} ms on {} auth workers\n", LOGINS, serialTime, parallelTime, threads);
+	EXPECT_EQ(serialResults, parallelResults);
+}
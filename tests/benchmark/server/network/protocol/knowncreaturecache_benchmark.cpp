@@ -0,0 +1,117 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/protocol/knowncreaturecache.hpp"
+
+namespace {
+	constexpr uint32_t FIRST_ID = 0x10000000;
+
+	// What ProtocolGame did before the cache: a hash set scanned from the start to find a creature to forget
+	class LegacyKnownCreatures {
+	public:
+		template <typename Predicate>
+		uint32_t check(uint32_t id, Predicate &&canEvict) {
+			if (!set.insert(id).second || set.size() <= KnownCreatureCache::CAPACITY) {
+				return 0;
+			}
+			for (auto it = set.begin(); it != set.end(); ++it) {
+				if (*it != id && canEvict(*it)) {
+					const auto removed = *it;
+					set.erase(it);
+					return removed;
+				}
+			}
+			auto it = set.begin();
+			if (*it == id) {
+				++it;
+			}
+			const auto removed = *it;
+			set.erase(it);
+			return removed;
+		}
+
+		bool contains(uint32_t id) const {
+			return set.contains(id);
+		}
+
+	private:
+		std::unordered_set<uint32_t> set;
+	};
+
+	struct CacheKnownCreatures {
+		template <typename Predicate>
+		uint32_t check(uint32_t id, Predicate &&canEvict) {
+			if (!cache.insert(id) || !cache.isOverCapacity()) {
+				return 0;
+			}
+			return cache.evict(id, canEvict);
+		}
+
+		bool contains(uint32_t id) const {
+			return cache.contains(id);
+		}
+
+		KnownCreatureCache cache;
+	};
+
+	struct SimulationResult {
+		double milliseconds = 0;
+		uint64_t knownUpdates = 0;
+		uint64_t evictedOnScreen = 0;
+	};
+
+	/**
+	 * Every round the player sees the creatures of its screen again (one check each) and gets a few updates
+	 * for each of them (the contains lookups of the send functions). New creatures keep walking in, so the
+	 * known list stays full and every new creature evicts one that walked out of the screen.
+	 */
+	template <typename Known>
+	SimulationResult simulate(Known &known, uint32_t onScreen, uint32_t arrivalsPerRound, uint32_t rounds) {
+		SimulationResult result;
+		const auto start = std::chrono::steady_clock::now();
+		uint32_t nextId = FIRST_ID;
+		for (uint32_t round = 0; round < rounds; ++round) {
+			nextId += arrivalsPerRound;
+			const uint32_t firstOnScreen = nextId - std::min(nextId - FIRST_ID, onScreen);
+			const auto canEvict = [firstOnScreen](uint32_t id) {
+				return id < firstOnScreen;
+			};
+
+			for (uint32_t id = firstOnScreen; id < nextId; ++id) {
+				const auto removed = known.check(id, canEvict);
+				result.evictedOnScreen += removed >= firstOnScreen ? 1 : 0;
+				for (uint32_t update = 0; update < 4; ++update) {
+					result.knownUpdates += known.contains(id) ? 1 : 0;
+				}
+			}
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		result.milliseconds = std::chrono::duration<double, std::milli>(elapsed).count();
+		return result;
+	}
+
+	void benchmark(std::string_view scenario, uint32_t onScreen, uint32_t arrivalsPerRound, uint32_t rounds) {
+		LegacyKnownCreatures legacy;
+		const auto legacyResult = simulate(legacy, onScreen, arrivalsPerRound, rounds);
+		auto cache = std::make_unique<CacheKnownCreatures>();
+		const auto cacheResult = simulate(*cache, onScreen, arrivalsPerRound, rounds);
+
+		std::cout << fmt::format("{}: {:.1f} ms with the hash set, {:.1f} ms with the cache\n", scenario, legacyResult.milliseconds, cacheResult.milliseconds);
+		EXPECT_EQ(cache->cache.size(), KnownCreatureCache::CAPACITY);
+		EXPECT_EQ(cacheResult.knownUpdates, legacyResult.knownUpdates);
+		EXPECT_EQ(cacheResult.evictedOnScreen, 0u);
+	}
+}
+
+TEST(KnownCreatureCacheBenchmark, CrowdedDepotAndBossRoom) {
+	// A full depot: hundreds of players on screen, a few logging in every round
+	benchmark("Crowded depot", 600, 4, 2000);
+	// A boss room: the boss keeps summoning, the summons die quickly and the known list churns all the time
+	benchmark("Boss room", 250, 40, 2000);
+}
@@ -0,0 +1,20 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/autosend_simulation.hpp"
+
+TEST(SessionTrafficBenchmark, AdaptiveAutosendOnACrowdedServer) {
+	constexpr uint32_t TICKS = 2000;
+	const auto fixed = tests::simulateAutosend(1, TICKS);
+	const auto adaptive = tests::simulateAutosend(3, TICKS);
+
+	std::cout << fmt::format("{} messages: {} writes with the fixed autosend, {} adaptive ({:.2f} ticks of wait per message against {:.2f})\n", adaptive.messages, fixed.writes, adaptive.writes, static_cast<double>(adaptive.waitedTicks) / adaptive.messages, static_cast<double>(fixed.waitedTicks) / fixed.messages);
+	EXPECT_EQ(fixed.messages, adaptive.messages);
+	EXPECT_LT(adaptive.writes, fixed.writes);
+}
@@ -0,0 +1,70 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#pragma once
+
+#include "lua/scripts/lua_state_pool.hpp"
+
+namespace tests {
+	// An area spell resolving the formula of every target it hits, what data/pure/formulas.lua is meant for
+	constexpr std::string_view AREA_SPELL_SCRIPT = R"(
+		function castAreaSpell(level, magicLevel, targets)
+			local total = 0
+			for target = 1, targets do
+				local min = (level / 5) + (magicLevel * 1.403) + 8
+				local max = (level / 5) + (magicLevel * 2.203) + 13
+				local damage = min + (max - min) * ((target * 7919) % 100) / 100
+				for _ = 1, 20 do
+					damage = damage * (1 + math.sin(damage) * 0.01)
+				end
+				total = total + math.floor(damage)
+			end
+			return total
+		end
+	)";
+
+	inline LuaPureValue number(int64_t value) {
+		return { value };
+	}
+
+	inline double toNumber(const LuaPureValue &value) {
+		if (const auto* integer = std::get_if<int64_t>(&value.value)) {
+			return static_cast<double>(*integer);
+		}
+		return std::get<double>(value.value);
+	}
+
+	/**
+	 * Casts the area spell on the pool from the given number of threads, the total of each cast is stored at its index.
+	 * \returns how long the casts took, in milliseconds
+	 */
+	inline double castSpells(LuaStatePool &pool, size_t threads, size_t casts, std::vector<double> &totals) {
+		totals.assign(casts, 0);
+		const auto start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> workers;
+		for (size_t worker = 0; worker < threads; ++worker) {
+			workers.emplace_back([&, worker] {
+				LuaPureValues results;
+				std::string error;
+				for (size_t cast = worker; cast < casts; cast += threads) {
+					const LuaPureValues arguments { number(100 + cast % 300), number(50 + cast % 80), number(40) };
+					if (pool.call("castAreaSpell", arguments, results, error) && results.size() == 1) {
+						totals[cast] = toNumber(results[0]);
+					}
+				}
+			});
+		}
+		for (auto &worker : workers) {
+			worker.join();
+		}
+
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+}
@@ -0,0 +1,102 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#pragma once
+
+#include "server/network/connection/connection.hpp"
+#include "server/network/message/outputmessage.hpp"
+#include "server/network/protocol/protocol.hpp"
+
+namespace tests {
+	class AutosendTestProtocol final : public Protocol {
+	public:
+		using Protocol::Protocol;
+
+		bool onRecvFirstMessage(NetworkMessage &) override {
+			return false;
+		}
+	};
+
+	struct AutosendSimulationResult {
+		uint64_t writes = 0;
+		uint64_t messages = 0;
+		uint64_t waitedTicks = 0;
+	};
+
+	/**
+	 * The output buffers of a crowded server on the real Protocol: interactive messages are flushed once the tick is done,
+	 * as OutputMessagePool::sendFlushRequests does, the others are sent when OutputMessagePool::sendAll finds them due.
+	 * A tenth of the clients have a connection whose first write never completes, a link that can't take what is sent.
+	 */
+	inline AutosendSimulationResult simulateAutosend(uint32_t maxBatchTicks, uint32_t ticks) {
+		struct Client {
+			Connection_ptr connection;
+			std::shared_ptr<AutosendTestProtocol> protocol;
+			// Tick each message of the output buffer was written on
+			std::vector<uint32_t> bufferedAt;
+		};
+
+		asio::io_context ioContext;
+		std::vector<Client> clients(500);
+		for (size_t i = 0; i < clients.size(); ++i) {
+			auto &client = clients[i];
+			if (i % 10 == 0) {
+				// The socket was never opened, sending closes the connection with the write still pending
+				client.connection = ConnectionManager::getInstance().createConnection(ioContext, nullptr);
+				client.connection->send(OutputMessagePool::getOutputMessage());
+			}
+			client.protocol = std::make_shared<AutosendTestProtocol>(client.connection);
+			// Players from around the world
+			client.protocol->getTraffic().addRoundTrip(std::array<uint32_t, 4> { 20, 60, 150, 280 }[i % 4]);
+		}
+
+		AutosendSimulationResult result;
+		const auto onSent = [&result](Client &client, uint32_t tick) {
+			++result.writes;
+			for (const auto bufferedAt : client.bufferedAt) {
+				result.waitedTicks += tick - bufferedAt;
+			}
+			client.bufferedAt.clear();
+		};
+
+		std::mt19937 random(11);
+		for (uint32_t tick = 0; tick < ticks; ++tick) {
+			for (auto &client : clients) {
+				bool flush = false;
+				for (uint32_t message = random() % 4; message > 0; --message) {
+					// Most of what a client gets is the world around it, the creatures walking and talking on its screen,
+					// a fraction answers its own actions
+					const uint8_t opcode = random() % 20 == 0 ? 0x1E : std::array<uint8_t, 3> { 0x6D, 0xAA, 0x8C }[random() % 3];
+					const auto &msg = client.protocol->getOutputBuffer(16);
+					msg->addByte(opcode);
+					msg->addPaddingBytes(15);
+					client.protocol->getTraffic().addPacket(TrafficDirection::Outbound, opcode, 16);
+					client.bufferedAt.emplace_back(tick);
+					++result.messages;
+					flush = flush || SessionTraffic::isInteractive(opcode);
+				}
+
+				// What ProtocolGame::onOutputWritten requests
+				if (flush) {
+					client.protocol->flushOutputBuffer();
+					onSent(client, tick);
+				}
+			}
+
+			for (auto &client : clients) {
+				auto &msg = client.protocol->getCurrentBuffer();
+				if (msg && client.protocol->isAutosendDue(maxBatchTicks)) {
+					client.protocol->send(std::move(msg));
+					onSent(client, tick);
+				}
+			}
+		}
+
+		return result;
+	}
+}
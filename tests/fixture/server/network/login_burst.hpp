@@ -0,0 +1,45 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#pragma once
+
+#include "server/network/protocol/authworkers.hpp"
+
+namespace tests {
+	// Stands for the RSA block and the password hash of a login, pure CPU work
+	inline uint64_t authenticate(uint64_t seed) {
+		uint64_t value = seed;
+		for (uint32_t round = 0; round < 200000; ++round) {
+			value ^= value << 13;
+			value ^= value >> 7;
+			value ^= value << 17;
+		}
+		return value;
+	}
+
+	/**
+	 * Authenticates every login on the workers at once, the result of each login is stored at its index.
+	 * \returns how long the burst took, in milliseconds
+	 */
+	inline double loginBurst(AuthWorkers &workers, size_t logins, std::vector<uint64_t> &results) {
+		results.assign(logins, 0);
+		std::atomic<size_t> done = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t login = 0; login < logins; ++login) {
+			EXPECT_TRUE(workers.submit([&results, &done, login] {
+				results[login] = authenticate(login + 1);
+				done.fetch_add(1);
+			}));
+		}
+		while (done.load() < logins) {
+			std::this_thread::yield();
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::milli>(elapsed).count();
+	}
+}
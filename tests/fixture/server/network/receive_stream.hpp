@@ -0,0 +1,56 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+#pragma once
+
+#include "server/network/connection/receivebuffer.hpp"
+
+namespace tests {
+	// Packets as the client sends them, a two byte length and the body
+	inline std::vector<uint8_t> makeStream(size_t packets, std::mt19937 &random, std::vector<std::vector<uint8_t>> &bodies) {
+		std::vector<uint8_t> stream;
+		for (size_t i = 0; i < packets; ++i) {
+			std::vector<uint8_t> body(1 + random() % 64);
+			for (auto &byte : body) {
+				byte = static_cast<uint8_t>(random());
+			}
+			stream.emplace_back(static_cast<uint8_t>(body.size()));
+			stream.emplace_back(static_cast<uint8_t>(body.size() >> 8));
+			stream.insert(stream.end(), body.begin(), body.end());
+			bodies.emplace_back(std::move(body));
+		}
+		return stream;
+	}
+
+	// Connection::asyncRead, with read standing for the socket that async_read keeps reading until minimum is reached
+	template <typename Read>
+	size_t readExactly(ReceiveBuffer &buffer, uint8_t* destination, size_t size, Read &&read) {
+		const auto pending = buffer.beginRead(destination, size);
+		size_t bytes = 0;
+		size_t reads = 0;
+		while (bytes < pending.minimum) {
+			bytes += read(pending.target + bytes, pending.maximum - bytes);
+			++reads;
+		}
+		buffer.endRead(pending, bytes);
+		return reads;
+	}
+
+	template <typename Read>
+	std::vector<std::vector<uint8_t>> parseStream(ReceiveBuffer &buffer, size_t packets, Read &&read, size_t &reads) {
+		std::vector<std::vector<uint8_t>> bodies;
+		for (size_t i = 0; i < packets; ++i) {
+			std::array<uint8_t, 2> header {};
+			reads += readExactly(buffer, header.data(), header.size(), read);
+			std::vector<uint8_t> body(header[0] | header[1] << 8);
+			reads += readExactly(buffer, body.data(), body.size(), read);
+			bodies.emplace_back(std::move(body));
+		}
+		return bodies;
+	}
+}
@@ -0,0 +1,220 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "clientcodec.hpp"
+
+#include <cstring>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+
+namespace {
+	constexpr uint32_t XTEA_DELTA = 0x61C88647;
+	constexpr size_t MAX_PAYLOAD_LENGTH = 65535;
+
+	// The primes of the standard key, what RSAManager falls back to without key.pem
+	constexpr const char* STANDARD_P = "14299623962416399520070177382898895550795403345466153217470516082934737582776038882967213386204600674145392845853859217990626450972452084065728686565928113";
+	constexpr const char* STANDARD_Q = "7630979195970404721891201847792002125535401292779123937207447574596692788513647179235335529307251350570728407373705564708871762033017096809910315212884101";
+
+	uint32_t readU32(const uint8_t* data) {
+		return data[0] | data[1] << 8 | data[2] << 16 | static_cast<uint32_t>(data[3]) << 24;
+	}
+
+	void writeU32(uint8_t* data, uint32_t value) {
+		for (size_t i = 0; i < 4; ++i) {
+			data[i] = static_cast<uint8_t>(value >> (i * 8));
+		}
+	}
+
+	// Length in blocks of 8 bytes, checksum or sequence number and the body
+	std::vector<uint8_t> makePacket(uint32_t checksum, const std::vector<uint8_t> &body) {
+		std::vector<uint8_t> packet(ClientCodec::HEADER_LENGTH + ClientCodec::CHECKSUM_LENGTH + body.size());
+		packet[0] = static_cast<uint8_t>(body.size() / 8);
+		packet[1] = static_cast<uint8_t>((body.size() / 8) >> 8);
+		writeU32(packet.data() + ClientCodec::HEADER_LENGTH, checksum);
+		std::memcpy(packet.data() + ClientCodec::HEADER_LENGTH + ClientCodec::CHECKSUM_LENGTH, body.data(), body.size());
+		return packet;
+	}
+
+	BIGNUM* readModulus(const std::string &pemFile) {
+		BIO* bio = BIO_new_file(pemFile.c_str(), "r");
+		if (!bio) {
+			return nullptr;
+		}
+
+		EVP_PKEY* key = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+		BIO_free(bio);
+		if (!key) {
+			return nullptr;
+		}
+
+		BIGNUM* n = nullptr;
+		if (!EVP_PKEY_get_bn_param(key, "n", &n)) {
+			n = nullptr;
+		}
+		EVP_PKEY_free(key);
+		return n;
+	}
+
+	BIGNUM* standardModulus() {
+		BIGNUM* p = nullptr;
+		BIGNUM* q = nullptr;
+		BIGNUM* n = BN_new();
+		BN_CTX* ctx = BN_CTX_new();
+		BN_dec2bn(&p, STANDARD_P);
+		BN_dec2bn(&q, STANDARD_Q);
+		BN_mul(n, p, q, ctx);
+		BN_CTX_free(ctx);
+		BN_free(p);
+		BN_free(q);
+		return n;
+	}
+}
+
+RsaPublicKey::RsaPublicKey(const std::string &pemFile) :
+	n(pemFile.empty() ? nullptr : readModulus(pemFile)), e(BN_new()) {
+	if (!n) {
+		n.reset(standardModulus());
+	}
+	BN_set_word(e.get(), 65537);
+}
+
+bool RsaPublicKey::encrypt(uint8_t* block) const {
+	BN_CTX* ctx = BN_CTX_new();
+	BIGNUM* m = BN_bin2bn(block, BLOCK_SIZE, nullptr);
+	BIGNUM* c = BN_new();
+	const bool encrypted = ctx && m && c && BN_mod_exp(c, m, e.get(), n.get(), ctx) && BN_bn2binpad(c, block, BLOCK_SIZE) == BLOCK_SIZE;
+	BN_free(c);
+	BN_free(m);
+	BN_CTX_free(ctx);
+	return encrypted;
+}
+
+ClientCodec::ClientCodec(const std::array<uint32_t, 4> &key) :
+	key(key) {
+	inflateReady = inflateInit2(&inflateStream, -15) == Z_OK;
+}
+
+ClientCodec::~ClientCodec() {
+	if (inflateReady) {
+		inflateEnd(&inflateStream);
+	}
+}
+
+std::optional<std::pair<uint32_t, uint8_t>> ClientCodec::parseChallenge(const uint8_t* body, size_t size) {
+	// Checksum, padding amount, 0x1F, timestamp and random number
+	if (size < CHECKSUM_LENGTH + 7 || body[CHECKSUM_LENGTH + 1] != 0x1F) {
+		return std::nullopt;
+	}
+	return std::make_pair(readU32(body + CHECKSUM_LENGTH + 2), body[CHECKSUM_LENGTH + 6]);
+}
+
+std::vector<uint8_t> ClientCodec::pad(const std::vector<uint8_t> &payload) {
+	// Same padding as OutputMessage::writePaddingAmount, the amount goes first
+	const auto padding = static_cast<uint8_t>((8 - (payload.size() + 1) % 8) % 8);
+	std::vector<uint8_t> body;
+	body.reserve(1 + payload.size() + padding);
+	body.emplace_back(padding);
+	body.insert(body.end(), payload.begin(), payload.end());
+	body.resize(body.size() + padding, 0x33);
+	return body;
+}
+
+std::vector<uint8_t> ClientCodec::frameFirstMessage(const std::vector<uint8_t> &payload) {
+	const auto body = pad(payload);
+	return makePacket(adlerChecksum(body.data(), body.size()), body);
+}
+
+std::vector<uint8_t> ClientCodec::frame(const std::vector<uint8_t> &payload) {
+	auto body = pad(payload);
+	xteaEncrypt(key, body.data(), body.size());
+
+	// Counted like Protocol::onRecvMessage does, from 1 as 0 is a connection ping it skips
+	const uint32_t sequence = ++sequenceNumber;
+	if (sequenceNumber >= 0x7FFFFFFF) {
+		sequenceNumber = 0;
+	}
+	return makePacket(sequence, body);
+}
+
+bool ClientCodec::unframe(uint8_t* body, size_t size, std::vector<uint8_t> &payload) {
+	if (size < CHECKSUM_LENGTH + 8 || (size - CHECKSUM_LENGTH) % 8 != 0) {
+		return false;
+	}
+
+	const bool compressed = (readU32(body) & (1U << 31)) != 0;
+	uint8_t* encrypted = body + CHECKSUM_LENGTH;
+	const size_t encryptedSize = size - CHECKSUM_LENGTH;
+	xteaDecrypt(key, encrypted, encryptedSize);
+
+	const uint8_t padding = encrypted[0];
+	if (static_cast<size_t>(padding) + 1 > encryptedSize) {
+		return false;
+	}
+	const uint8_t* data = encrypted + 1;
+	const size_t dataSize = encryptedSize - 1 - padding;
+
+	if (!compressed) {
+		payload.assign(data, data + dataSize);
+		return true;
+	}
+
+	if (!inflateReady) {
+		return false;
+	}
+
+	// Every message is deflated on its own, the stream starts over each time
+	payload.resize(MAX_PAYLOAD_LENGTH);
+	inflateStream.next_in = const_cast<Bytef*>(data);
+	inflateStream.avail_in = static_cast<uInt>(dataSize);
+	inflateStream.next_out = payload.data();
+	inflateStream.avail_out = static_cast<uInt>(payload.size());
+	const int ret = inflate(&inflateStream, Z_FINISH);
+	const auto inflated = inflateStream.total_out;
+	inflateReset(&inflateStream);
+	if (ret != Z_STREAM_END) {
+		return false;
+	}
+	payload.resize(inflated);
+	return true;
+}
+
+void ClientCodec::xteaEncrypt(const std::array<uint32_t, 4> &key, uint8_t* data, size_t size) {
+	for (size_t position = 0; position + 8 <= size; position += 8) {
+		uint32_t v0 = readU32(data + position);
+		uint32_t v1 = readU32(data + position + 4);
+		uint32_t sum = 0;
+		for (size_t round = 0; round < 32; ++round) {
+			v0 += ((v1 << 4 ^ v1 >> 5) + v1) ^ (sum + key[sum & 3]);
+			sum -= XTEA_DELTA;
+			v1 += ((v0 << 4 ^ v0 >> 5) + v0) ^ (sum + key[(sum >> 11) & 3]);
+		}
+		writeU32(data + position, v0);
+		writeU32(data + position + 4, v1);
+	}
+}
+
+void ClientCodec::xteaDecrypt(const std::array<uint32_t, 4> &key, uint8_t* data, size_t size) {
+	for (size_t position = 0; position + 8 <= size; position += 8) {
+		uint32_t v0 = readU32(data + position);
+		uint32_t v1 = readU32(data + position + 4);
+		uint32_t sum = 0xC6EF3720;
+		for (size_t round = 0; round < 32; ++round) {
+			v1 -= ((v0 << 4 ^ v0 >> 5) + v0) ^ (sum + key[(sum >> 11) & 3]);
+			sum += XTEA_DELTA;
+			v0 -= ((v1 << 4 ^ v1 >> 5) + v1) ^ (sum + key[sum & 3]);
+		}
+		writeU32(data + position, v0);
+		writeU32(data + position + 4, v1);
+	}
+}
+
+uint32_t ClientCodec::adlerChecksum(const uint8_t* data, size_t size) {
+	return static_cast<uint32_t>(adler32(1, data, static_cast<uInt>(size)));
+}
@@ -0,0 +1,141 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <openssl/bn.h>
+#include <zlib.h>
+
+/**
+ * Client side of a game packet, written the way the client does it: little endian values, strings with a
+ * two byte length and positions as x, y and z.
+ */
+class ClientMessage {
+public:
+	void addByte(uint8_t value) {
+		bytes.emplace_back(value);
+	}
+
+	template <typename T>
+	void add(T value) {
+		for (size_t i = 0; i < sizeof(T); ++i) {
+			bytes.emplace_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (i * 8)));
+		}
+	}
+
+	void addString(const std::string &value) {
+		add<uint16_t>(static_cast<uint16_t>(value.size()));
+		bytes.insert(bytes.end(), value.begin(), value.end());
+	}
+
+	void addPosition(uint16_t x, uint16_t y, uint8_t z) {
+		add<uint16_t>(x);
+		add<uint16_t>(y);
+		addByte(z);
+	}
+
+	void addBytes(const uint8_t* data, size_t size) {
+		bytes.insert(bytes.end(), data, data + size);
+	}
+
+	size_t size() const {
+		return bytes.size();
+	}
+	const std::vector<uint8_t> &getBytes() const {
+		return bytes;
+	}
+	std::vector<uint8_t> &getBytes() {
+		return bytes;
+	}
+
+private:
+	std::vector<uint8_t> bytes;
+};
+
+/**
+ * Public half of the server key, what the client encrypts the first message of a login with.
+ */
+class RsaPublicKey {
+public:
+	static constexpr size_t BLOCK_SIZE = 128;
+
+	// Reads the modulus from the private key the server loads, or uses the standard key without one
+	explicit RsaPublicKey(const std::string &pemFile);
+
+	bool encrypt(uint8_t* block) const;
+
+private:
+	struct BnDeleter {
+		void operator()(BIGNUM* bn) const {
+			BN_free(bn);
+		}
+	};
+
+	std::unique_ptr<BIGNUM, BnDeleter> n;
+	std::unique_ptr<BIGNUM, BnDeleter> e;
+};
+
+/**
+ * Framing, XTEA and sequence numbers of a game connection, the counterpart of Protocol and Connection.
+ * Packets are a two byte length in blocks of 8 bytes, a checksum or sequence number and the encrypted body,
+ * which holds its padding amount, the payload and the padding.
+ */
+class ClientCodec {
+public:
+	static constexpr size_t HEADER_LENGTH = 2;
+	static constexpr size_t CHECKSUM_LENGTH = 4;
+
+	explicit ClientCodec(const std::array<uint32_t, 4> &key);
+	~ClientCodec();
+
+	ClientCodec(const ClientCodec &) = delete;
+	ClientCodec &operator=(const ClientCodec &) = delete;
+
+	const std::array<uint32_t, 4> &getKey() const {
+		return key;
+	}
+
+	// Bytes to read after the length header of an incoming packet
+	static size_t getBodyLength(const uint8_t* header) {
+		return (header[0] | header[1] << 8) * 8 + CHECKSUM_LENGTH;
+	}
+
+	// The challenge sent by the server when the connection opens, before anything is encrypted
+	static std::optional<std::pair<uint32_t, uint8_t>> parseChallenge(const uint8_t* body, size_t size);
+
+	// Padded and checksummed with adler32 but not encrypted, the key is inside its RSA block
+	static std::vector<uint8_t> frameFirstMessage(const std::vector<uint8_t> &payload);
+
+	std::vector<uint8_t> frame(const std::vector<uint8_t> &payload);
+
+	/**
+	 * Decrypts, and inflates when compressed, the body of a packet sent after the login.
+	 * \returns false when the body is not a valid packet for this key
+	 */
+	bool unframe(uint8_t* body, size_t size, std::vector<uint8_t> &payload);
+
+	static void xteaEncrypt(const std::array<uint32_t, 4> &key, uint8_t* data, size_t size);
+	static void xteaDecrypt(const std::array<uint32_t, 4> &key, uint8_t* data, size_t size);
+	static uint32_t adlerChecksum(const uint8_t* data, size_t size);
+
+private:
+	static std::vector<uint8_t> pad(const std::vector<uint8_t> &payload);
+
+	std::array<uint32_t, 4> key;
+	uint32_t sequenceNumber = 0;
+	z_stream inflateStream {};
+	bool inflateReady = false;
+};
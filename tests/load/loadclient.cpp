@@ -0,0 +1,453 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "loadclient.hpp"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "core.hpp"
+
+namespace {
+	// An OTClient on Linux: sequence numbers and compression, without the extra strings of the new Linux client
+	constexpr uint16_t CLIENT_OS = 10;
+	constexpr uint8_t TALKTYPE_SAY = 1;
+	constexpr uint8_t SLOT_RIGHT = 5;
+	constexpr uint8_t SLOT_LEFT = 6;
+	// Printed as they happen, the rest only counted
+	constexpr uint64_t MAX_REPORTED_FAILURES = 10;
+
+	// Key, game master flag, session, character, challenge and the OTCv8 marker, after the leading zero
+	size_t loginBlockLength(const std::string &account, const std::string &password, const std::string &character) {
+		return 1 + 16 + 1 + (2 + account.size() + 1 + password.size()) + (2 + character.size()) + 5 + 2;
+	}
+
+	std::string readString(const std::vector<uint8_t> &payload, size_t position) {
+		if (position + 2 > payload.size()) {
+			return {};
+		}
+		const size_t length = payload[position] | payload[position + 1] << 8;
+		const size_t end = std::min(payload.size(), position + 2 + length);
+		return { payload.begin() + static_cast<std::ptrdiff_t>(position + 2), payload.begin() + static_cast<std::ptrdiff_t>(end) };
+	}
+}
+
+void PlayerDirectory::add(uint32_t id) {
+	std::scoped_lock lock(mutex);
+	ids.emplace_back(id);
+}
+
+void PlayerDirectory::remove(uint32_t id) {
+	std::scoped_lock lock(mutex);
+	std::erase(ids, id);
+}
+
+uint32_t PlayerDirectory::pick(uint32_t exclude, std::mt19937 &random) const {
+	std::scoped_lock lock(mutex);
+	if (ids.size() < 2) {
+		return 0;
+	}
+	const uint32_t id = ids[random() % ids.size()];
+	return id != exclude ? id : ids[(std::ranges::find(ids, id) - ids.begin() + 1) % ids.size()];
+}
+
+LoadClient::LoadClient(asio::io_context &context, LoadRun &run, size_t index, std::string account, std::string character) :
+	strand(asio::make_strand(context)),
+	socket(strand),
+	tickTimer(strand),
+	run(run),
+	index(index),
+	account(std::move(account)),
+	character(std::move(character)),
+	random(static_cast<uint32_t>(index * 7919 + std::random_device {}())) { }
+
+bool LoadClient::fitsLoginBlock(const std::string &account, const std::string &password, const std::string &character) {
+	return loginBlockLength(account, password, character) <= RsaPublicKey::BLOCK_SIZE;
+}
+
+void LoadClient::start() {
+	connectedAt = Clock::now();
+	++run.stats.connecting;
+
+	std::error_code error;
+	const auto address = asio::ip::make_address(run.settings.host, error);
+	if (error) {
+		fail(fmt::format("invalid address {}", run.settings.host));
+		return;
+	}
+
+	socket.async_connect(asio::ip::tcp::endpoint(address, run.settings.port), [self = shared_from_this()](const std::error_code &error) {
+		if (error) {
+			self->fail(fmt::format("connect failed: {}", error.message()));
+			return;
+		}
+		std::error_code ignored;
+		self->socket.set_option(asio::ip::tcp::no_delay(true), ignored);
+		self->state = State::WaitingChallenge;
+		self->readHeader();
+	});
+}
+
+void LoadClient::stop() {
+	asio::post(strand, [self = shared_from_this()] {
+		if (self->state == State::Closed) {
+			return;
+		}
+		self->stopping = true;
+		if (self->state != State::InGame) {
+			self->close();
+			return;
+		}
+
+		// Logout, the connection is closed once it is written
+		ClientMessage msg;
+		msg.addByte(0x14);
+		self->send(msg, false);
+	});
+}
+
+void LoadClient::readHeader() {
+	asio::async_read(socket, asio::buffer(header), [self = shared_from_this()](const std::error_code &error, std::size_t) {
+		if (error) {
+			self->fail(error.message());
+			return;
+		}
+		self->readBody();
+	});
+}
+
+void LoadClient::readBody() {
+	body.resize(ClientCodec::getBodyLength(header.data()));
+	asio::async_read(socket, asio::buffer(body), [self = shared_from_this()](const std::error_code &error, std::size_t) {
+		if (error) {
+			self->fail(error.message());
+			return;
+		}
+		self->onPacket();
+		if (self->state != State::Closed) {
+			self->readHeader();
+		}
+	});
+}
+
+void LoadClient::onPacket() {
+	++run.stats.packetsReceived;
+	run.stats.bytesReceived += header.size() + body.size();
+
+	if (state == State::WaitingChallenge) {
+		const auto challenge = ClientCodec::parseChallenge(body.data(), body.size());
+		if (!challenge) {
+			fail("the server didn't send a login challenge, is this the game port?");
+			return;
+		}
+		onChallenge(challenge->first, challenge->second);
+		return;
+	}
+
+	if (!codec->unframe(body.data(), body.size(), payload)) {
+		fail("invalid packet from the server");
+		return;
+	}
+	run.stats.payloadBytesReceived += payload.size();
+
+	if (state == State::LoggingIn) {
+		onLoginPayload(payload);
+	} else if (state == State::InGame) {
+		onGamePayload(payload);
+	}
+}
+
+void LoadClient::onChallenge(uint32_t timestamp, uint8_t challengeRandom) {
+	std::array<uint32_t, 4> key {};
+	for (auto &part : key) {
+		part = random();
+	}
+	codec = std::make_unique<ClientCodec>(key);
+
+	ClientMessage msg;
+	msg.addByte(0x0A);
+	msg.add<uint16_t>(CLIENT_OS);
+	msg.add<uint16_t>(CLIENT_VERSION);
+	msg.add<uint32_t>(CLIENT_VERSION);
+	msg.addString(fmt::format("{}.{:02}", CLIENT_VERSION_UPPER, CLIENT_VERSION_LOWER));
+	// Assets hash and game preview state
+	msg.addString("");
+	msg.addByte(0);
+
+	ClientMessage block;
+	block.addByte(0);
+	for (const auto part : key) {
+		block.add<uint32_t>(part);
+	}
+	// Not a game master
+	block.addByte(0);
+	block.addString(account + "\n" + run.settings.password);
+	block.addString(character);
+	block.add<uint32_t>(timestamp);
+	block.addByte(challengeRandom);
+	// No OTCv8 marker
+	block.add<uint16_t>(0);
+	while (block.size() < RsaPublicKey::BLOCK_SIZE) {
+		block.addByte(static_cast<uint8_t>(random()));
+	}
+	if (block.size() != RsaPublicKey::BLOCK_SIZE || !run.key.encrypt(block.getBytes().data())) {
+		fail("the login doesn't fit the RSA block");
+		return;
+	}
+	msg.addBytes(block.getBytes().data(), block.size());
+
+	state = State::LoggingIn;
+	sendRaw(ClientCodec::frameFirstMessage(msg.getBytes()));
+}
+
+void LoadClient::onLoginPayload(const std::vector<uint8_t> &loginPayload) {
+	if (loginPayload.empty()) {
+		return;
+	}
+
+	// Messages that end the login come alone
+	if (loginPayload[0] == 0x14) {
+		fail(fmt::format("login refused: {}", readString(loginPayload, 1)));
+		return;
+	}
+	if (loginPayload[0] == 0x16) {
+		fail(fmt::format("waiting list: {}", readString(loginPayload, 1)));
+		return;
+	}
+
+	// The login message: 0x17, the id of the player and the beat duration
+	for (size_t position = 0; position + 7 <= loginPayload.size(); ++position) {
+		if (loginPayload[position] != 0x17 || loginPayload[position + 5] != 0x32 || loginPayload[position + 6] != 0x00) {
+			continue;
+		}
+
+		playerId = loginPayload[position + 1] | loginPayload[position + 2] << 8 | loginPayload[position + 3] << 16 | static_cast<uint32_t>(loginPayload[position + 4]) << 24;
+		state = State::InGame;
+		loggedInAt = Clock::now();
+		--run.stats.connecting;
+		++run.stats.inGame;
+		++run.stats.loggedIn;
+		run.stats.addLoginTime(std::chrono::duration_cast<std::chrono::microseconds>(loggedInAt - connectedAt));
+		run.players.add(playerId);
+
+		// Spread the actions of the clients that logged in together
+		const auto spread = [this](std::chrono::milliseconds interval) {
+			return loggedInAt + std::chrono::milliseconds(interval.count() > 0 ? random() % interval.count() : 0);
+		};
+		const auto &script = run.settings.script;
+		nextWalk = spread(script.walkInterval);
+		nextTalk = spread(script.talkInterval);
+		nextAttack = spread(script.attackInterval);
+		nextMove = spread(script.moveInterval);
+		nextKeepalive = loggedInAt + KEEPALIVE_INTERVAL;
+		replayStartedAt = loggedInAt;
+		scheduleTick();
+		onGamePayload(loginPayload);
+		return;
+	}
+}
+
+void LoadClient::onGamePayload(const std::vector<uint8_t> &gamePayload) {
+	// A ping flushed on its own, the client answers it
+	if (gamePayload.size() == 1 && gamePayload[0] == 0x1D) {
+		ClientMessage msg;
+		msg.addByte(0x1D);
+		send(msg, false);
+		return;
+	}
+
+	if (probes.empty()) {
+		return;
+	}
+
+	const auto now = Clock::now();
+	std::erase_if(probes, [this, &gamePayload, now](const auto &probe) {
+		if (std::ranges::search(gamePayload, probe.first).empty()) {
+			return false;
+		}
+		run.stats.addLatency(std::chrono::duration_cast<std::chrono::microseconds>(now - probe.second));
+		return true;
+	});
+}
+
+void LoadClient::send(const ClientMessage &msg, bool record) {
+	if (record && run.capture && state == State::InGame) {
+		run.capture->write(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - loggedInAt).count()), msg.getBytes());
+	}
+	sendRaw(codec->frame(msg.getBytes()));
+}
+
+void LoadClient::sendRaw(std::vector<uint8_t> &&packet) {
+	writeQueue.emplace_back(std::move(packet));
+	if (writeQueue.size() == 1) {
+		writeNext();
+	}
+}
+
+void LoadClient::writeNext() {
+	asio::async_write(socket, asio::buffer(writeQueue.front()), [self = shared_from_this()](const std::error_code &error, std::size_t bytes) {
+		if (error) {
+			self->fail(error.message());
+			return;
+		}
+
+		++self->run.stats.packetsSent;
+		self->run.stats.bytesSent += bytes;
+		self->writeQueue.pop_front();
+		if (!self->writeQueue.empty()) {
+			self->writeNext();
+		} else if (self->stopping) {
+			self->close();
+		}
+	});
+}
+
+void LoadClient::scheduleTick() {
+	tickTimer.expires_after(TICK_INTERVAL);
+	tickTimer.async_wait([self = shared_from_this()](const std::error_code &error) {
+		if (error || self->state != State::InGame || self->stopping) {
+			return;
+		}
+		self->onTick();
+		self->scheduleTick();
+	});
+}
+
+void LoadClient::onTick() {
+	const auto now = Clock::now();
+	if (now >= nextKeepalive) {
+		// Ping, it keeps the character online even when the pings of the server are answered late
+		ClientMessage msg;
+		msg.addByte(0x1E);
+		send(msg, false);
+		nextKeepalive = now + KEEPALIVE_INTERVAL;
+	}
+
+	while (!probes.empty() && now - probes.front().second > PROBE_TIMEOUT) {
+		++run.stats.probesLost;
+		probes.pop_front();
+	}
+
+	if (run.settings.replay.empty()) {
+		playScript(now);
+	} else {
+		playReplay(now);
+	}
+}
+
+void LoadClient::playScript(Clock::time_point now) {
+	const auto &script = run.settings.script;
+
+	if (script.walkInterval.count() > 0 && now >= nextWalk) {
+		// North, east, south and west are 0x65 to 0x68
+		const uint8_t direction = stepBack != 0 ? stepBack : static_cast<uint8_t>(random() % 4);
+		stepBack = stepBack != 0 ? 0 : static_cast<uint8_t>((direction + 2) % 4);
+		ClientMessage msg;
+		msg.addByte(static_cast<uint8_t>(0x65 + direction));
+		send(msg);
+		nextWalk = now + script.walkInterval;
+	}
+
+	if (script.talkInterval.count() > 0 && now >= nextTalk) {
+		auto text = fmt::format("load {} {}", index, ++probeSequence);
+		ClientMessage msg;
+		msg.addByte(0x96);
+		msg.addByte(TALKTYPE_SAY);
+		msg.addString(text);
+		send(msg);
+		probes.emplace_back(std::move(text), now);
+		nextTalk = now + script.talkInterval;
+	}
+
+	if (script.attackInterval.count() > 0 && now >= nextAttack) {
+		if (const uint32_t target = run.players.pick(playerId, random); target != 0) {
+			ClientMessage msg;
+			msg.addByte(0xA1);
+			msg.add<uint32_t>(target);
+			msg.add<uint32_t>(++attackSequence);
+			send(msg);
+		}
+		nextAttack = now + script.attackInterval;
+	}
+
+	if (script.moveInterval.count() > 0 && script.moveItemId != 0 && now >= nextMove) {
+		const uint8_t from = itemInLeftHand ? SLOT_LEFT : SLOT_RIGHT;
+		const uint8_t to = itemInLeftHand ? SLOT_RIGHT : SLOT_LEFT;
+		itemInLeftHand = !itemInLeftHand;
+		ClientMessage msg;
+		msg.addByte(0x78);
+		msg.addPosition(0xFFFF, from, 0);
+		msg.add<uint16_t>(script.moveItemId);
+		msg.addByte(0);
+		msg.addPosition(0xFFFF, to, 0);
+		msg.addByte(1);
+		send(msg);
+		nextMove = now + script.moveInterval;
+	}
+}
+
+void LoadClient::playReplay(Clock::time_point now) {
+	const auto &packets = run.settings.replay;
+	const auto elapsed = std::chrono::duration<double, std::milli>(now - replayStartedAt).count() * run.settings.replaySpeed;
+	while (replayPosition < packets.size() && packets[replayPosition].offset <= elapsed) {
+		const auto &packet = packets[replayPosition++];
+		ClientMessage msg;
+		msg.addBytes(packet.payload.data(), packet.payload.size());
+		// The probes of the capture are probes of this client too
+		if (packet.payload.size() > 4 && packet.payload[0] == 0x96 && packet.payload[1] == TALKTYPE_SAY) {
+			probes.emplace_back(readString(packet.payload, 2), now);
+		}
+		send(msg, false);
+	}
+
+	// The capture plays in a loop until the run ends
+	if (replayPosition == packets.size()) {
+		replayPosition = 0;
+		replayStartedAt = now;
+	}
+}
+
+void LoadClient::fail(const std::string &reason) {
+	if (state == State::Closed) {
+		return;
+	}
+
+	if (state == State::InGame) {
+		if (!stopping) {
+			++run.stats.disconnects;
+			fmt::print(stderr, "[load] {} disconnected: {}\n", character, reason);
+		}
+	} else if (!stopping) {
+		--run.stats.connecting;
+		if (++run.stats.loginFailures <= MAX_REPORTED_FAILURES) {
+			fmt::print(stderr, "[load] {} couldn't log in: {}\n", character, reason);
+		}
+	}
+	close();
+}
+
+void LoadClient::close() {
+	if (state == State::Closed) {
+		return;
+	}
+
+	if (state == State::InGame) {
+		--run.stats.inGame;
+		run.players.remove(playerId);
+	} else if (stopping) {
+		--run.stats.connecting;
+	}
+	state = State::Closed;
+
+	std::error_code error;
+	tickTimer.cancel();
+	socket.shutdown(asio::ip::tcp::socket::shutdown_both, error);
+	socket.close(error);
+}
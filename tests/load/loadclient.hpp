@@ -0,0 +1,167 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include <utility>
+
+#include <asio.hpp>
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "clientcodec.hpp"
+#include "loadstats.hpp"
+#include "packetcapture.hpp"
+
+/**
+ * What the clients do once in the game. An interval of zero turns the action off.
+ */
+struct LoadScript {
+	// A step in a random direction, then the step back, so the clients stay around where they logged in
+	std::chrono::milliseconds walkInterval { 600 };
+	// Said out loud, every message is also a latency probe
+	std::chrono::milliseconds talkInterval { 5000 };
+	// Targets another client of the run
+	std::chrono::milliseconds attackInterval { 3000 };
+	// Moves moveItemId between the hands, a move of an item the character doesn't have fails on the server
+	std::chrono::milliseconds moveInterval { 2000 };
+	uint16_t moveItemId = 0;
+};
+
+struct LoadSettings {
+	std::string host = "127.0.0.1";
+	uint16_t port = 7172;
+	std::string password;
+	LoadScript script;
+	// Played instead of the script when not empty
+	std::vector<CapturedPacket> replay;
+	double replaySpeed = 1.0;
+};
+
+/**
+ * Ids of the characters in the game, what the clients attack.
+ */
+class PlayerDirectory {
+public:
+	void add(uint32_t id);
+	void remove(uint32_t id);
+	// Any id but exclude, 0 when there is none
+	uint32_t pick(uint32_t exclude, std::mt19937 &random) const;
+
+private:
+	mutable std::mutex mutex;
+	std::vector<uint32_t> ids;
+};
+
+/**
+ * Shared by the clients of a run.
+ */
+struct LoadRun {
+	const LoadSettings &settings;
+	const RsaPublicKey &key;
+	LoadStats &stats;
+	PlayerDirectory &players;
+	// Where the first client writes what it sends, when recording
+	PacketCapture* capture = nullptr;
+};
+
+/**
+ * A headless game client. It connects straight to the game port with the account and password of its
+ * character, like the client does after the character list, and then plays the script or the replay.
+ * It doesn't parse what the server sends, it only looks for what it waits for: the login, the pings and
+ * its own messages.
+ */
+class LoadClient : public std::enable_shared_from_this<LoadClient> {
+public:
+	LoadClient(asio::io_context &context, LoadRun &run, size_t index, std::string account, std::string character);
+
+	void start();
+	// Logs out and closes the connection, from any thread
+	void stop();
+
+	// The key, session and name have to fit in the RSA block of the first message
+	static bool fitsLoginBlock(const std::string &account, const std::string &password, const std::string &character);
+
+private:
+	enum class State : uint8_t {
+		Connecting,
+		WaitingChallenge,
+		LoggingIn,
+		InGame,
+		Closed,
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr std::chrono::milliseconds TICK_INTERVAL { 50 };
+	static constexpr std::chrono::milliseconds KEEPALIVE_INTERVAL { 10000 };
+	static constexpr std::chrono::milliseconds PROBE_TIMEOUT { 10000 };
+
+	void readHeader();
+	void readBody();
+	void onPacket();
+	void onChallenge(uint32_t timestamp, uint8_t random);
+	void onLoginPayload(const std::vector<uint8_t> &payload);
+	void onGamePayload(const std::vector<uint8_t> &payload);
+
+	void send(const ClientMessage &msg, bool record = true);
+	void sendRaw(std::vector<uint8_t> &&packet);
+	void writeNext();
+
+	void scheduleTick();
+	void onTick();
+	void playScript(Clock::time_point now);
+	void playReplay(Clock::time_point now);
+
+	void fail(const std::string &reason);
+	void close();
+
+	asio::strand<asio::io_context::executor_type> strand;
+	asio::ip::tcp::socket socket;
+	asio::steady_timer tickTimer;
+	LoadRun &run;
+	const size_t index;
+	const std::string account;
+	const std::string character;
+
+	std::mt19937 random;
+	std::unique_ptr<ClientCodec> codec;
+	State state = State::Connecting;
+	bool stopping = false;
+
+	std::array<uint8_t, ClientCodec::HEADER_LENGTH> header {};
+	std::vector<uint8_t> body;
+	std::vector<uint8_t> payload;
+	std::deque<std::vector<uint8_t>> writeQueue;
+
+	uint32_t playerId = 0;
+	Clock::time_point connectedAt;
+	Clock::time_point loggedInAt;
+
+	Clock::time_point nextWalk;
+	Clock::time_point nextTalk;
+	Clock::time_point nextAttack;
+	Clock::time_point nextMove;
+	Clock::time_point nextKeepalive;
+	uint8_t stepBack = 0;
+	bool itemInLeftHand = true;
+	uint32_t attackSequence = 0;
+	uint32_t probeSequence = 0;
+	std::deque<std::pair<std::string, Clock::time_point>> probes;
+
+	Clock::time_point replayStartedAt;
+	size_t replayPosition = 0;
+};
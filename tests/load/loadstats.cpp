@@ -0,0 +1,159 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "loadstats.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <fmt/format.h>
+
+#if defined(__linux__)
+	#include <unistd.h>
+#endif
+
+std::optional<double> ProcessCpu::getSeconds() const {
+#if defined(__linux__)
+	if (pid == 0) {
+		return std::nullopt;
+	}
+
+	std::ifstream stat(fmt::format("/proc/{}/stat", pid));
+	std::string content;
+	if (!std::getline(stat, content)) {
+		return std::nullopt;
+	}
+
+	// The name of the process can hold spaces, the fields are counted from the parenthesis closing it
+	const auto nameEnd = content.rfind(')');
+	if (nameEnd == std::string::npos) {
+		return std::nullopt;
+	}
+	std::istringstream fields(content.substr(nameEnd + 2));
+	std::string field;
+	uint64_t userTicks = 0;
+	uint64_t systemTicks = 0;
+	// utime and stime are the 14th and 15th fields, the 12th and 13th after the name
+	for (size_t index = 3; index <= 15 && fields >> field; ++index) {
+		if (index == 14) {
+			userTicks = std::stoull(field);
+		} else if (index == 15) {
+			systemTicks = std::stoull(field);
+		}
+	}
+	return static_cast<double>(userTicks + systemTicks) / static_cast<double>(sysconf(_SC_CLK_TCK));
+#else
+	return std::nullopt;
+#endif
+}
+
+void LoadStats::addLatency(std::chrono::microseconds latency) {
+	std::scoped_lock lock(samplesMutex);
+	latencies.emplace_back(static_cast<uint32_t>(latency.count()));
+}
+
+void LoadStats::addLoginTime(std::chrono::microseconds time) {
+	std::scoped_lock lock(samplesMutex);
+	loginTimes.emplace_back(static_cast<uint32_t>(time.count()));
+}
+
+LoadStats::Snapshot LoadStats::takeSnapshot() {
+	Snapshot snapshot;
+	snapshot.connecting = connecting.load();
+	snapshot.inGame = inGame.load();
+	snapshot.loggedIn = loggedIn.load();
+	snapshot.loginFailures = loginFailures.load();
+	snapshot.disconnects = disconnects.load();
+	snapshot.packetsSent = packetsSent.load();
+	snapshot.packetsReceived = packetsReceived.load();
+	snapshot.bytesSent = bytesSent.load();
+	snapshot.bytesReceived = bytesReceived.load();
+	snapshot.payloadBytesReceived = payloadBytesReceived.load();
+	snapshot.probesLost = probesLost.load();
+
+	std::scoped_lock lock(samplesMutex);
+	snapshot.latencies.swap(latencies);
+	snapshot.loginTimes.swap(loginTimes);
+	std::ranges::sort(snapshot.latencies);
+	std::ranges::sort(snapshot.loginTimes);
+	return snapshot;
+}
+
+uint32_t LoadStats::percentile(const std::vector<uint32_t> &sorted, double p) {
+	if (sorted.empty()) {
+		return 0;
+	}
+	const auto index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+namespace {
+	std::string formatLatencies(const std::vector<uint32_t> &sorted) {
+		if (sorted.empty()) {
+			return "no samples";
+		}
+		return fmt::format(
+			"p50 {:.1f} ms, p90 {:.1f} ms, p99 {:.1f} ms, max {:.1f} ms",
+			LoadStats::percentile(sorted, 0.5) / 1000.0,
+			LoadStats::percentile(sorted, 0.9) / 1000.0,
+			LoadStats::percentile(sorted, 0.99) / 1000.0,
+			sorted.back() / 1000.0
+		);
+	}
+
+	std::string formatCpu(std::optional<double> serverCpu) {
+		return serverCpu ? fmt::format("{:.0f}%", *serverCpu * 100) : "n/a";
+	}
+}
+
+std::string LoadStats::formatInterval(const Snapshot &previous, const Snapshot &current, double seconds, std::optional<double> serverCpu) {
+	seconds = std::max(seconds, 0.001);
+	return fmt::format(
+		"{} in game, {} logging in | out {:.1f} KB/s {:.0f} packets/s, in {:.1f} KB/s {:.0f} packets/s | latency {} | server cpu {}",
+		current.inGame,
+		current.connecting,
+		(current.bytesSent - previous.bytesSent) / 1024.0 / seconds,
+		(current.packetsSent - previous.packetsSent) / seconds,
+		(current.bytesReceived - previous.bytesReceived) / 1024.0 / seconds,
+		(current.packetsReceived - previous.packetsReceived) / seconds,
+		formatLatencies(current.latencies),
+		formatCpu(serverCpu)
+	);
+}
+
+std::string LoadStats::formatSummary(const Snapshot &total, double seconds, std::optional<double> serverCpu, size_t clients) {
+	seconds = std::max(seconds, 0.001);
+	const double received = static_cast<double>(std::max<uint64_t>(total.payloadBytesReceived, 1));
+	return fmt::format(
+		"Clients: {} of {} logged in, {} login failures, {} disconnected\n"
+		"Login time: {}\n"
+		"Latency: {} ({} samples, {} without answer)\n"
+		"Sent by the clients: {} packets, {} bytes ({:.1f} KB/s)\n"
+		"Sent by the server: {} packets, {} bytes ({:.1f} KB/s, {:.1f} KB/s per client), {:.0f}% of the uncompressed size\n"
+		"Server cpu: {}\n",
+		total.loggedIn,
+		clients,
+		total.loginFailures,
+		total.disconnects,
+		formatLatencies(total.loginTimes),
+		formatLatencies(total.latencies),
+		total.latencies.size(),
+		total.probesLost,
+		total.packetsSent,
+		total.bytesSent,
+		total.bytesSent / 1024.0 / seconds,
+		total.packetsReceived,
+		total.bytesReceived,
+		total.bytesReceived / 1024.0 / seconds,
+		total.bytesReceived / 1024.0 / seconds / static_cast<double>(std::max<uint64_t>(total.loggedIn, 1)),
+		100.0 * static_cast<double>(total.bytesReceived) / received,
+		formatCpu(serverCpu)
+	);
+}
@@ -0,0 +1,93 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * CPU time a process has used so far, read from /proc on Linux.
+ */
+class ProcessCpu {
+public:
+	explicit ProcessCpu(uint32_t pid) :
+		pid(pid) { }
+
+	// Nothing when there is no process to watch or the platform doesn't tell
+	std::optional<double> getSeconds() const;
+
+private:
+	uint32_t pid;
+};
+
+/**
+ * What the clients of a run measured, shared by all of them.
+ * The latency is the time between a client saying something and the server sending it back: the packet goes
+ * through the network thread, waits for the dispatcher and the answer for the next write, so it follows how
+ * busy the dispatcher is.
+ */
+class LoadStats {
+public:
+	struct Snapshot {
+		uint64_t connecting = 0;
+		uint64_t inGame = 0;
+		uint64_t loggedIn = 0;
+		uint64_t loginFailures = 0;
+		uint64_t disconnects = 0;
+		uint64_t packetsSent = 0;
+		uint64_t packetsReceived = 0;
+		uint64_t bytesSent = 0;
+		uint64_t bytesReceived = 0;
+		uint64_t payloadBytesReceived = 0;
+		uint64_t probesLost = 0;
+		std::vector<uint32_t> latencies;
+		std::vector<uint32_t> loginTimes;
+	};
+
+	// Clients between the connect and the end of their login, and clients in the game right now
+	std::atomic<uint64_t> connecting = 0;
+	std::atomic<uint64_t> inGame = 0;
+	// Totals of the run
+	std::atomic<uint64_t> loggedIn = 0;
+	std::atomic<uint64_t> loginFailures = 0;
+	std::atomic<uint64_t> disconnects = 0;
+	std::atomic<uint64_t> packetsSent = 0;
+	std::atomic<uint64_t> packetsReceived = 0;
+	std::atomic<uint64_t> bytesSent = 0;
+	std::atomic<uint64_t> bytesReceived = 0;
+	std::atomic<uint64_t> payloadBytesReceived = 0;
+	std::atomic<uint64_t> probesLost = 0;
+
+	void addLatency(std::chrono::microseconds latency);
+	void addLoginTime(std::chrono::microseconds time);
+
+	// The samples taken since the previous call go to this snapshot only
+	Snapshot takeSnapshot();
+
+	/**
+	 * One line for the interval between two snapshots, the latencies are the ones of the current snapshot.
+	 * serverCpu is the share of a core the server used meanwhile.
+	 */
+	static std::string formatInterval(const Snapshot &previous, const Snapshot &current, double seconds, std::optional<double> serverCpu);
+	static std::string formatSummary(const Snapshot &total, double seconds, std::optional<double> serverCpu, size_t clients);
+
+	// p between 0 and 1, of samples already sorted
+	static uint32_t percentile(const std::vector<uint32_t> &sorted, double p);
+
+private:
+	std::mutex samplesMutex;
+	std::vector<uint32_t> latencies;
+	std::vector<uint32_t> loginTimes;
+};
@@ -0,0 +1,279 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "loadclient.hpp"
+
+#include <csignal>
+#include <functional>
+#include <map>
+#include <thread>
+
+#include <fmt/format.h>
+
+namespace {
+	struct Options {
+		LoadSettings settings;
+		size_t clients = 10;
+		size_t firstClient = 1;
+		std::string account = "loadbot{}@load.test";
+		std::string character = "Load Bot {}";
+		std::string keyFile = "key.pem";
+		std::chrono::seconds duration { 60 };
+		std::chrono::milliseconds loginInterval { 20 };
+		std::chrono::seconds reportInterval { 10 };
+		size_t threads = 1;
+		uint32_t serverPid = 0;
+		std::string record;
+		std::string replay;
+		bool printSql = false;
+		bool printHelp = false;
+		uint16_t townId = 8;
+	};
+
+	constexpr auto USAGE = R"(Usage: canary_load [options]
+Logs in headless clients on a running server and measures it while they play.
+
+  --host <address>         server address (127.0.0.1)
+  --port <port>            game port (7172)
+  --clients <n>            clients to log in (10)
+  --first <n>              number of the first client (1)
+  --account <pattern>      account email of each client, {} is its number (loadbot{}@load.test)
+  --password <password>    password of every account (loadbot)
+  --character <pattern>    character of each client, {} is its number (Load Bot {})
+  --key <file>             private key of the server, the standard key when missing (key.pem)
+  --duration <seconds>     time to play once the clients start logging in (60)
+  --login-interval <ms>    time between two logins (20)
+  --threads <n>            network threads of the clients (1)
+  --walk <ms>              interval between two steps, 0 to stand (600)
+  --talk <ms>              interval between two messages, also the latency probes (5000)
+  --attack <ms>            interval between two attacks on another client (3000)
+  --move <ms>              interval between two item moves (2000)
+  --move-item <id>         item moved between the hands, 0 for none (0)
+  --record <file>          write what the first client sends to a capture
+  --replay <file>          every client plays the capture in a loop instead of the script
+  --replay-speed <factor>  speed of the replay (1)
+  --server-pid <pid>       process of the server, to report its cpu usage (Linux)
+  --report <seconds>       interval between two reports (10)
+  --sql                    print the accounts and characters of the clients to insert and exit
+  --town <id>              town of the characters inserted by --sql (8)
+  --help                   print this help and exit
+)";
+
+	std::atomic<bool> interrupted = false;
+
+	bool parseOptions(int argc, char** argv, Options &options) {
+		using Milliseconds = std::chrono::milliseconds;
+		options.settings.password = "loadbot";
+
+		const std::map<std::string, std::function<void(const std::string &)>> valueOptions {
+			{ "--host", [&](const std::string &value) { options.settings.host = value; } },
+			{ "--port", [&](const std::string &value) { options.settings.port = static_cast<uint16_t>(std::stoul(value)); } },
+			{ "--clients", [&](const std::string &value) { options.clients = std::stoul(value); } },
+			{ "--first", [&](const std::string &value) { options.firstClient = std::stoul(value); } },
+			{ "--account", [&](const std::string &value) { options.account = value; } },
+			{ "--password", [&](const std::string &value) { options.settings.password = value; } },
+			{ "--character", [&](const std::string &value) { options.character = value; } },
+			{ "--key", [&](const std::string &value) { options.keyFile = value; } },
+			{ "--duration", [&](const std::string &value) { options.duration = std::chrono::seconds(std::stoul(value)); } },
+			{ "--login-interval", [&](const std::string &value) { options.loginInterval = Milliseconds(std::stoul(value)); } },
+			{ "--threads", [&](const std::string &value) { options.threads = std::max<size_t>(1, std::stoul(value)); } },
+			{ "--walk", [&](const std::string &value) { options.settings.script.walkInterval = Milliseconds(std::stoul(value)); } },
+			{ "--talk", [&](const std::string &value) { options.settings.script.talkInterval = Milliseconds(std::stoul(value)); } },
+			{ "--attack", [&](const std::string &value) { options.settings.script.attackInterval = Milliseconds(std::stoul(value)); } },
+			{ "--move", [&](const std::string &value) { options.settings.script.moveInterval = Milliseconds(std::stoul(value)); } },
+			{ "--move-item", [&](const std::string &value) { options.settings.script.moveItemId = static_cast<uint16_t>(std::stoul(value)); } },
+			{ "--record", [&](const std::string &value) { options.record = value; } },
+			{ "--replay", [&](const std::string &value) { options.replay = value; } },
+			{ "--replay-speed", [&](const std::string &value) { options.settings.replaySpeed = std::max(0.01, std::stod(value)); } },
+			{ "--server-pid", [&](const std::string &value) { options.serverPid = static_cast<uint32_t>(std::stoul(value)); } },
+			{ "--report", [&](const std::string &value) { options.reportInterval = std::chrono::seconds(std::max<unsigned long>(1, std::stoul(value))); } },
+			{ "--town", [&](const std::string &value) { options.townId = static_cast<uint16_t>(std::stoul(value)); } },
+		};
+
+		for (int i = 1; i < argc; ++i) {
+			const std::string name = argv[i];
+			if (name == "--help") {
+				options.printHelp = true;
+				continue;
+			}
+			if (name == "--sql") {
+				options.printSql = true;
+				continue;
+			}
+
+			const auto it = valueOptions.find(name);
+			if (it == valueOptions.end() || i + 1 >= argc) {
+				fmt::print(stderr, "Unknown option or missing value: {}\n\n{}", name, USAGE);
+				return false;
+			}
+
+			try {
+				it->second(argv[++i]);
+			} catch (const std::exception &) {
+				fmt::print(stderr, "Invalid value for {}: {}\n", name, argv[i]);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::string clientAccount(const Options &options, size_t number) {
+		return fmt::format(fmt::runtime(options.account), number);
+	}
+
+	std::string clientCharacter(const Options &options, size_t number) {
+		return fmt::format(fmt::runtime(options.character), number);
+	}
+
+	void printSql(const Options &options) {
+		// Password authentication with sha1, what Account::authenticate accepts besides argon2
+		fmt::print("-- {} load test characters, the accounts use the email as name\n", options.clients);
+		for (size_t number = options.firstClient; number < options.firstClient + options.clients; ++number) {
+			const auto account = clientAccount(options, number);
+			fmt::print(
+				"INSERT INTO `accounts` (`name`, `email`, `password`, `type`) VALUES ('{}', '{}', SHA1('{}'), 1);\n"
+				"INSERT INTO `players` (`name`, `account_id`, `conditions`, `town_id`) VALUES ('{}', LAST_INSERT_ID(), '', {});\n",
+				account.substr(0, 32), account, options.settings.password, clientCharacter(options, number), options.townId
+			);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!parseOptions(argc, argv, options)) {
+		return 1;
+	}
+
+	if (options.printHelp) {
+		fmt::print("{}", USAGE);
+		return 0;
+	}
+
+	if (options.printSql) {
+		printSql(options);
+		return 0;
+	}
+
+	for (size_t number = options.firstClient; number < options.firstClient + options.clients; ++number) {
+		if (!LoadClient::fitsLoginBlock(clientAccount(options, number), options.settings.password, clientCharacter(options, number))) {
+			fmt::print(stderr, "The account, password and character of client {} are too long for the login message\n", number);
+			return 1;
+		}
+	}
+
+	if (!options.replay.empty()) {
+		options.settings.replay = PacketCapture::load(options.replay);
+		if (options.settings.replay.empty()) {
+			fmt::print(stderr, "No packets in the capture {}\n", options.replay);
+			return 1;
+		}
+		fmt::print("Replaying {} packets of {}\n", options.settings.replay.size(), options.replay);
+	}
+
+	PacketCapture capture;
+	if (!options.record.empty() && !capture.open(options.record)) {
+		fmt::print(stderr, "Can't write the capture {}\n", options.record);
+		return 1;
+	}
+
+	const RsaPublicKey key(options.keyFile);
+	LoadStats stats;
+	PlayerDirectory players;
+
+	asio::io_context context;
+	auto work = asio::make_work_guard(context);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < options.threads; ++i) {
+		threads.emplace_back([&context] { context.run(); });
+	}
+
+	std::signal(SIGINT, [](int) { interrupted = true; });
+
+	LoadRun run { options.settings, key, stats, players, nullptr };
+	LoadRun recordingRun { options.settings, key, stats, players, options.record.empty() ? nullptr : &capture };
+	std::vector<std::shared_ptr<LoadClient>> clients;
+
+	const ProcessCpu serverCpu(options.serverPid);
+	const auto startedAt = std::chrono::steady_clock::now();
+	const auto endsAt = startedAt + options.duration;
+	auto nextLogin = startedAt;
+	auto reportedAt = startedAt;
+	auto nextReport = startedAt + options.reportInterval;
+	auto reportedCpu = serverCpu.getSeconds();
+	const auto startCpu = reportedCpu;
+	auto previous = stats.takeSnapshot();
+	std::vector<uint32_t> latencies;
+	std::vector<uint32_t> loginTimes;
+
+	fmt::print("Logging in {} clients on {}:{}\n", options.clients, options.settings.host, options.settings.port);
+	while (!interrupted) {
+		const auto now = std::chrono::steady_clock::now();
+		if (now >= endsAt) {
+			break;
+		}
+
+		// Logins are spread, a whole run logging in on the same tick is a different test
+		while (clients.size() < options.clients && now >= nextLogin) {
+			const size_t number = options.firstClient + clients.size();
+			auto &clientRun = clients.empty() ? recordingRun : run;
+			clients.emplace_back(std::make_shared<LoadClient>(context, clientRun, number, clientAccount(options, number), clientCharacter(options, number)));
+			asio::post(context, [client = clients.back()] { client->start(); });
+			nextLogin += options.loginInterval;
+		}
+
+		if (now >= nextReport) {
+			const double seconds = std::chrono::duration<double>(now - reportedAt).count();
+			const auto cpu = serverCpu.getSeconds();
+			std::optional<double> cpuShare;
+			if (cpu && reportedCpu) {
+				cpuShare = (*cpu - *reportedCpu) / seconds;
+			}
+
+			auto current = stats.takeSnapshot();
+			fmt::print("[{:>4}s] {}\n", std::chrono::duration_cast<std::chrono::seconds>(now - startedAt).count(), LoadStats::formatInterval(previous, current, seconds, cpuShare));
+			latencies.insert(latencies.end(), current.latencies.begin(), current.latencies.end());
+			loginTimes.insert(loginTimes.end(), current.loginTimes.begin(), current.loginTimes.end());
+			previous = std::move(current);
+			reportedAt = now;
+			reportedCpu = cpu;
+			nextReport = now + options.reportInterval;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	const auto finishedAt = std::chrono::steady_clock::now();
+	const auto endCpu = serverCpu.getSeconds();
+	for (const auto &client : clients) {
+		client->stop();
+	}
+	// Time for the logouts to be written
+	std::this_thread::sleep_for(std::chrono::seconds(1));
+	work.reset();
+	context.stop();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	// The counters are totals already, the samples were taken interval by interval
+	auto last = stats.takeSnapshot();
+	last.latencies.insert(last.latencies.end(), latencies.begin(), latencies.end());
+	last.loginTimes.insert(last.loginTimes.end(), loginTimes.begin(), loginTimes.end());
+	std::ranges::sort(last.latencies);
+	std::ranges::sort(last.loginTimes);
+
+	const double seconds = std::chrono::duration<double>(finishedAt - startedAt).count();
+	std::optional<double> cpuShare;
+	if (startCpu && endCpu) {
+		cpuShare = (*endCpu - *startCpu) / seconds;
+	}
+	fmt::print("\n{}", LoadStats::formatSummary(last, seconds, cpuShare, options.clients));
+	return last.loggedIn > 0 ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "packetcapture.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#include <fmt/format.h>
+
+std::vector<CapturedPacket> PacketCapture::load(const std::string &filename) {
+	std::vector<CapturedPacket> packets;
+	std::ifstream input(filename);
+	std::string line;
+	while (std::getline(input, line)) {
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+
+		std::istringstream fields(line);
+		CapturedPacket packet;
+		std::string hex;
+		if (!(fields >> packet.offset >> hex) || hex.empty() || hex.size() % 2 != 0) {
+			continue;
+		}
+
+		bool valid = true;
+		for (size_t i = 0; valid && i < hex.size(); i += 2) {
+			try {
+				packet.payload.emplace_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+			} catch (const std::exception &) {
+				valid = false;
+			}
+		}
+		if (valid) {
+			packets.emplace_back(std::move(packet));
+		}
+	}
+
+	// Captures merged from several clients come in any order
+	std::stable_sort(packets.begin(), packets.end(), [](const CapturedPacket &a, const CapturedPacket &b) { return a.offset < b.offset; });
+	return packets;
+}
+
+bool PacketCapture::open(const std::string &filename) {
+	file.open(filename, std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	file << "# milliseconds since login, payload\n";
+	return true;
+}
+
+void PacketCapture::write(uint32_t offset, const std::vector<uint8_t> &payload) {
+	std::string hex;
+	hex.reserve(payload.size() * 2);
+	for (const auto byte : payload) {
+		hex += fmt::format("{:02X}", byte);
+	}
+
+	std::scoped_lock lock(mutex);
+	file << offset << ' ' << hex << '\n';
+}
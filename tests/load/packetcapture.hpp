@@ -0,0 +1,40 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Packets a client sent after entering the game, decrypted, with the time they were sent at.
+ * One packet per line: the milliseconds since the login and the payload in hex, starting with the opcode.
+ * Lines starting with # are comments, so captures can be written or edited by hand.
+ */
+struct CapturedPacket {
+	uint32_t offset = 0;
+	std::vector<uint8_t> payload;
+};
+
+class PacketCapture {
+public:
+	// Empty when the file can't be read, the malformed lines are skipped
+	static std::vector<CapturedPacket> load(const std::string &filename);
+
+	bool open(const std::string &filename);
+	// Called from the client threads
+	void write(uint32_t offset, const std::vector<uint8_t> &payload);
+
+private:
+	std::mutex mutex;
+	std::ofstream file;
+};
@@ -0,0 +1,58 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "creatures/combat/condition.hpp"
+#include "utils/tools.hpp"
+
+TEST(ConditionTest, OnlyPeriodicConditionsExecuteOnThink) {
+	EXPECT_FALSE(Condition::createCondition(CONDITIONID_DEFAULT, CONDITION_HASTE, 1000)->executesOnThink());
+	EXPECT_FALSE(Condition::createCondition(CONDITIONID_DEFAULT, CONDITION_OUTFIT, 1000)->executesOnThink());
+	EXPECT_FALSE(Condition::createCondition(CONDITIONID_DEFAULT, CONDITION_INFIGHT, 1000)->executesOnThink());
+	EXPECT_TRUE(Condition::createCondition(CONDITIONID_DEFAULT, CONDITION_POISON, 1000)->executesOnThink());
+	EXPECT_TRUE(Condition::createCondition(CONDITIONID_DEFAULT, CONDITION_REGENERATION, 1000)->executesOnThink());
+
+	const auto condition = Condition::createCondition(CONDITIONID_DEFAULT, CONDITION_INFIGHT, 1000);
+	condition->setParam(CONDITION_PARAM_SOUND_TICK, static_cast<int32_t>(SoundEffect_t::SPELL_OR_RUNE));
+	EXPECT_TRUE(condition->executesOnThink());
+}
+
+TEST(ConditionTest, ExecutedWhenDueCountsDownFromTheEndTime) {
+	UPDATE_OTSYS_TIME();
+	const auto condition = Condition::createCondition(CONDITIONID_DEFAULT, CONDITION_INFIGHT, 60000);
+	ASSERT_TRUE(condition->startCondition(nullptr));
+
+	// Executed on every think until its owner says otherwise
+	EXPECT_TRUE(condition->isExecutionDue(OTSYS_TIME()));
+
+	condition->setExecutedWhenDue(true);
+	EXPECT_FALSE(condition->isExecutionDue(OTSYS_TIME()));
+	EXPECT_FALSE(condition->isExecutionDue(condition->getEndTime()));
+	EXPECT_TRUE(condition->isExecutionDue(condition->getEndTime() + 1));
+
+	const auto remaining = condition->getEndTime() - OTSYS_TIME();
+	EXPECT_EQ(condition->getTicks(), remaining);
+
+	condition->setTicks(1000);
+	EXPECT_LE(condition->getTicks(), 1000);
+	EXPECT_TRUE(condition->isExecutionDue(OTSYS_TIME() + 1001));
+
+	condition->setExecutedWhenDue(false);
+	EXPECT_TRUE(condition->isExecutionDue(OTSYS_TIME()));
+	EXPECT_LE(condition->getTicks(), 1000);
+}
+
+TEST(ConditionTest, InfiniteConditionsAreNeverDue) {
+	UPDATE_OTSYS_TIME();
+	const auto condition = Condition::createCondition(CONDITIONID_DEFAULT, CONDITION_INFIGHT, -1);
+	ASSERT_TRUE(condition->startCondition(nullptr));
+
+	condition->setExecutedWhenDue(true);
+	EXPECT_FALSE(condition->isExecutionDue(std::numeric_limits<int64_t>::max()));
+	EXPECT_EQ(condition->getTicks(), -1);
+}
@@ -10,3 +10,100 @@
 #include "lib/logging/in_memory_logger.hpp"
 
 #include "items/containers/container.hpp"
+#include "items/items.hpp"
+
+namespace {
+	constexpr uint16_t kBackpackId = 100;
+	constexpr uint16_t kBagId = 101;
+	constexpr uint16_t kCoinId = 102;
+	constexpr uint16_t kSwordId = 103;
+
+	class ContainerItemTypeCountTest : public ::testing::Test {
+	protected:
+		void SetUp() override {
+			auto &items = Item::items.getItems();
+			originalSize = items.size();
+			if (items.size() <= kSwordId) {
+				items.resize(kSwordId + 1);
+			}
+
+			for (const auto id : { kBackpackId, kBagId }) {
+				auto &itemType = Item::items.getItemType(id);
+				itemType = ItemType {};
+				itemType.id = id;
+				itemType.group = ITEM_GROUP_CONTAINER;
+			}
+
+			auto &coin = Item::items.getItemType(kCoinId);
+			coin = ItemType {};
+			coin.id = kCoinId;
+			coin.stackable = true;
+
+			auto &sword = Item::items.getItemType(kSwordId);
+			sword = ItemType {};
+			sword.id = kSwordId;
+		}
+
+		void TearDown() override {
+			Item::items.getItems().resize(originalSize);
+		}
+
+		size_t originalSize = 0;
+	};
+}
+
+TEST_F(ContainerItemTypeCountTest, NestedContainersCountTheirContents) {
+	const auto backpack = Container::create(kBackpackId, 20);
+	const auto bag = Container::create(kBagId, 8);
+	const auto coins = std::make_shared<Item>(kCoinId, 50);
+
+	bag->addThing(coins);
+	bag->addThing(std::make_shared<Item>(kSwordId));
+	backpack->addThing(bag);
+	backpack->addThing(std::make_shared<Item>(kCoinId, 30));
+
+	EXPECT_EQ(backpack->getRecursiveItemTypeCount(kCoinId), 80u);
+	EXPECT_EQ(backpack->getRecursiveItemTypeCount(kSwordId), 1u);
+	EXPECT_EQ(backpack->getRecursiveItemTypeCount(kBagId), 1u);
+	EXPECT_EQ(bag->getRecursiveItemTypeCount(kCoinId), 50u);
+	// The cylinder count only looks at the direct contents
+	EXPECT_EQ(backpack->getItemTypeCount(kCoinId), 30u);
+
+	bag->removeThing(coins, 20);
+	EXPECT_EQ(backpack->getRecursiveItemTypeCount(kCoinId), 60u);
+
+	bag->updateThing(coins, kSwordId, 1);
+	EXPECT_EQ(backpack->getRecursiveItemTypeCount(kCoinId), 30u);
+	EXPECT_EQ(backpack->getRecursiveItemTypeCount(kSwordId), 2u);
+	EXPECT_TRUE(backpack->checkItemTypeCounts());
+
+	backpack->removeThing(bag, 1);
+	EXPECT_EQ(backpack->getRecursiveItemTypeCount(kSwordId), 0u);
+	EXPECT_EQ(backpack->getRecursiveItemTypeCount(kBagId), 0u);
+	EXPECT_EQ(backpack->getRecursiveItemTypeCounts().size(), 1u);
+	EXPECT_TRUE(backpack->checkItemTypeCounts());
+}
+
+TEST_F(ContainerItemTypeCountTest, ClonesKeepTheirCounts) {
+	const auto backpack = Container::create(kBackpackId, 20);
+	const auto bag = Container::create(kBagId, 8);
+	bag->addThing(std::make_shared<Item>(kCoinId, 7));
+	backpack->addThing(bag);
+
+	const auto clone = std::static_pointer_cast<Container>(backpack->clone());
+	ASSERT_NE(clone, nullptr);
+	EXPECT_EQ(clone->getRecursiveItemTypeCount(kCoinId), 7u);
+	EXPECT_TRUE(clone->checkItemTypeCounts());
+}
+
+TEST_F(ContainerItemTypeCountTest, CheckerDetectsChangesMadeBehindTheContainer) {
+	const auto backpack = Container::create(kBackpackId, 20);
+	const auto bag = Container::create(kBagId, 8);
+	const auto coins = std::make_shared<Item>(kCoinId, 10);
+	bag->addThing(coins);
+	backpack->addThing(bag);
+	ASSERT_TRUE(backpack->checkItemTypeCounts());
+
+	coins->setItemCount(11);
+	EXPECT_FALSE(backpack->checkItemTypeCounts());
+}
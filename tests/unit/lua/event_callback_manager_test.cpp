@@ -9,6 +9,8 @@
 
 #include "lua/callbacks/event_callback_manager.hpp"
 #include "lua/scripts/luascript.hpp"
+#include "creatures/creatures_definitions.hpp"
+#include "items/items.hpp"
 
 struct DummyScriptInterface final : LuaScriptInterface {
 	mutable int calls = 0;
@@ -72,6 +74,26 @@ struct MutatingScriptInterface final : LuaScriptInterface {
 	}
 };
 
+struct CountingScriptInterface final : LuaScriptInterface {
+	std::unique_ptr<lua_State, decltype(&lua_close)> L { luaL_newstate(), &lua_close };
+	mutable int calls = 0;
+
+	CountingScriptInterface() :
+		LuaScriptInterface("test") { }
+
+	lua_State* getLuaState() override {
+		return L.get();
+	}
+	bool pushFunction(int32_t) const override {
+		return true;
+	}
+	bool callFunction(int params) const override {
+		++calls;
+		lua_pop(L.get(), params);
+		return true;
+	}
+};
+
 TEST(EventCallbackManagerTest, RegistrationSorting) {
 	DummyScriptInterface iface;
 	EventCallbackManager mgr;
@@ -447,3 +469,61 @@ TEST(EventCallbackManagerTest, NoListenersOk) {
 	EXPECT_EQ(dmg.primary.value, 1);
 	EXPECT_EQ(dmg.secondary.value, 2);
 }
+
+TEST(EventCallbackTest, ItemIdFilterSkipsLuaOutsideRanges) {
+	CountingScriptInterface iface;
+	EventCallbackManager mgr;
+
+	using enum EventCallback_t;
+
+	auto cb = std::make_shared<EventCallback>("shop", false, &iface);
+	cb->setType(playerOnLookInShop);
+	cb->setScriptId(1);
+	cb->addItemIdFilter(200, 100);
+	cb->addItemIdFilter(300, 300);
+	mgr.registerCallback(cb);
+
+	ItemType itemType;
+	for (const uint16_t id : { 50, 201, 299, 301 }) {
+		itemType.id = id;
+		EXPECT_TRUE(mgr.checkCallback(playerOnLookInShop, std::shared_ptr<Player>(), &itemType, uint8_t { 1 }));
+	}
+	EXPECT_EQ(iface.calls, 0);
+	EXPECT_EQ(cb->getStats().filtered, 4u);
+
+	for (const uint16_t id : { 100, 150, 200, 300 }) {
+		itemType.id = id;
+		EXPECT_TRUE(mgr.checkCallback(playerOnLookInShop, std::shared_ptr<Player>(), &itemType, uint8_t { 1 }));
+	}
+	EXPECT_EQ(iface.calls, 4);
+	EXPECT_EQ(cb->getStats().calls, 4u);
+	EXPECT_EQ(lua_gettop(iface.L.get()), 0);
+}
+
+TEST(EventCallbackTest, CreatureTypeFilterOnlyAppliesToEventsWithCreatures) {
+	CountingScriptInterface iface;
+	EventCallbackManager mgr;
+
+	using enum EventCallback_t;
+
+	auto outfit = std::make_shared<EventCallback>("outfit", false, &iface);
+	outfit->setType(creatureOnChangeOutfit);
+	outfit->setScriptId(1);
+	outfit->addCreatureTypeFilter(CREATURETYPE_MONSTER);
+	mgr.registerCallback(outfit);
+
+	auto trade = std::make_shared<EventCallback>("trade", false, &iface);
+	trade->setType(playerOnTradeRequest);
+	trade->setScriptId(1);
+	trade->addCreatureTypeFilter(CREATURETYPE_MONSTER);
+	mgr.registerCallback(trade);
+
+	// Without a creature there is no type to match
+	EXPECT_TRUE(mgr.checkCallback(creatureOnChangeOutfit, std::shared_ptr<Creature>(), Outfit_t {}));
+	EXPECT_EQ(iface.calls, 0);
+	EXPECT_EQ(outfit->getStats().filtered, 1u);
+
+	EXPECT_TRUE(mgr.checkCallback(playerOnTradeRequest));
+	EXPECT_EQ(iface.calls, 1);
+	EXPECT_EQ(trade->getStats().filtered, 0u);
+}
@@ -0,0 +1,81 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/scripts/lua_bytecode_cache.hpp"
+
+namespace {
+	class LuaBytecodeCacheTest : public ::testing::Test {
+	protected:
+		void SetUp() override {
+			root = std::filesystem::temp_directory_path() / fmt::format("canary_bytecode_cache_{}", std::chrono::steady_clock::now().time_since_epoch().count());
+			std::filesystem::create_directories(root);
+			cache.setDirectory((root / "cache").string());
+			script = (root / "script.lua").string();
+			L = luaL_newstate();
+			luaL_openlibs(L);
+		}
+
+		void TearDown() override {
+			lua_close(L);
+			std::error_code error;
+			std::filesystem::remove_all(root, error);
+		}
+
+		void write(std::string_view content) const {
+			std::ofstream output(script, std::ios::binary | std::ios::trunc);
+			output << content;
+		}
+
+		lua_Number run() {
+			EXPECT_EQ(cache.loadFile(L, script), 0);
+			EXPECT_EQ(lua_pcall(L, 0, 1, 0), 0);
+			const auto value = lua_tonumber(L, -1);
+			lua_pop(L, 1);
+			return value;
+		}
+
+		std::filesystem::path root;
+		std::string script;
+		LuaBytecodeCache cache;
+		lua_State* L = nullptr;
+	};
+}
+
+TEST(LuaBytecodeCacheHashTest, IsStable) {
+	EXPECT_EQ(LuaBytecodeCache::hash(""), 14695981039346656037ULL);
+	EXPECT_EQ(LuaBytecodeCache::hash("a"), 0xaf63dc4c8601ec8cULL);
+	EXPECT_NE(LuaBytecodeCache::hash("return 1"), LuaBytecodeCache::hash("return 2"));
+}
+
+TEST_F(LuaBytecodeCacheTest, LoadsUnchangedFilesFromTheCache) {
+	write("return 40 + 2");
+	EXPECT_EQ(run(), 42);
+	EXPECT_EQ(run(), 42);
+
+	const auto stats = cache.takeStats();
+	EXPECT_EQ(stats.files, 2u);
+	EXPECT_EQ(stats.cacheHits, 1u);
+}
+
+TEST_F(LuaBytecodeCacheTest, CompilesChangedFilesAgain) {
+	write("return 1");
+	EXPECT_EQ(run(), 1);
+	write("return 2");
+	EXPECT_EQ(run(), 2);
+	EXPECT_EQ(run(), 2);
+
+	EXPECT_EQ(cache.takeStats().cacheHits, 1u);
+}
+
+TEST_F(LuaBytecodeCacheTest, ReportsSyntaxErrors) {
+	write("return +");
+	EXPECT_NE(cache.loadFile(L, script), 0);
+	EXPECT_NE(std::string(lua_tostring(L, -1)).find("script.lua"), std::string::npos);
+	lua_pop(L, 1);
+}
@@ -0,0 +1,81 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/functions/lua_functions_loader.hpp"
+#include "game/movement/position.hpp"
+
+namespace {
+	lua_State* newStateWithClasses() {
+		lua_State* L = luaL_newstate();
+		luaL_openlibs(L);
+		for (const auto &className : { "Position", "Player", "Item", "Tile" }) {
+			Lua::registerClass(L, className, "");
+		}
+		return L;
+	}
+
+	void closeState(lua_State* L) {
+		Lua::clearMetatableRefs(L);
+		lua_close(L);
+	}
+
+	class LuaPushTest : public ::testing::Test {
+	protected:
+		void SetUp() override {
+			L = newStateWithClasses();
+		}
+
+		void TearDown() override {
+			closeState(L);
+		}
+
+		lua_State* L = nullptr;
+	};
+}
+
+TEST_F(LuaPushTest, PushPositionSetsFieldsAndMetatable) {
+	Lua::pushPosition(L, Position(1000, 2000, 7), 3);
+
+	const Position &position = Lua::getPosition(L, lua_gettop(L));
+	EXPECT_EQ(Position(1000, 2000, 7), position);
+
+	lua_getfield(L, -1, "stackpos");
+	EXPECT_EQ(3, lua_tointeger(L, -1));
+	lua_pop(L, 1);
+
+	ASSERT_TRUE(lua_getmetatable(L, -1));
+	luaL_getmetatable(L, "Position");
+	EXPECT_TRUE(lua_rawequal(L, -1, -2));
+	lua_pop(L, 3);
+}
+
+TEST_F(LuaPushTest, SetMetatableUsesTheClassOfTheCurrentState) {
+	int player = 0;
+	Lua::pushUserdata<void>(L, &player);
+	Lua::setMetatable(L, -1, LuaData_t::Player);
+
+	ASSERT_TRUE(lua_getmetatable(L, -1));
+	luaL_getmetatable(L, "Player");
+	EXPECT_TRUE(lua_rawequal(L, -1, -2));
+	lua_pop(L, 3);
+}
+
+TEST(LuaPushStateTest, ClosedStateReferencesAreNotReused) {
+	closeState(newStateWithClasses());
+
+	// A state without the classes, possibly at the address of the closed one
+	lua_State* L = luaL_newstate();
+	luaL_openlibs(L);
+	int player = 0;
+	Lua::pushUserdata<void>(L, &player);
+	Lua::setMetatable(L, -1, LuaData_t::Player);
+	EXPECT_FALSE(lua_getmetatable(L, -1));
+	lua_pop(L, 1);
+	lua_close(L);
+}
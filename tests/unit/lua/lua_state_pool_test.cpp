@@ -0,0 +1,135 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/scripts/lua_state_pool.hpp"
+#include "lua/area_spell.hpp"
+
+TEST(LuaStatePoolTest, CopiesValuesInAndOut) {
+	LuaStatePool pool;
+	pool.init(2);
+	ASSERT_TRUE(pool.loadBuffer("function echo(...) return ... end", "echo"));
+
+	LuaPureValue::Table table;
+	table.emplace_back(tests::number(1), LuaPureValue { std::string("first") });
+	table.emplace_back(LuaPureValue { std::string("nested") }, LuaPureValue { LuaPureValue::Table { { tests::number(1), LuaPureValue { true } } } });
+
+	const LuaPureValues arguments { LuaPureValue { 2.5 }, LuaPureValue { std::string("text") }, LuaPureValue {}, LuaPureValue { table } };
+	LuaPureValues results;
+	std::string error;
+	ASSERT_TRUE(pool.call("echo", arguments, results, error)) << error;
+	ASSERT_EQ(results.size(), 4u);
+	EXPECT_EQ(std::get<double>(results[0].value), 2.5);
+	EXPECT_EQ(std::get<std::string>(results[1].value), "text");
+	EXPECT_TRUE(std::holds_alternative<std::monostate>(results[2].value));
+
+	const auto &resultTable = std::get<LuaPureValue::Table>(results[3].value);
+	ASSERT_EQ(resultTable.size(), 2u);
+	for (const auto &[key, value] : resultTable) {
+		if (std::holds_alternative<std::string>(key.value)) {
+			const auto &nested = std::get<LuaPureValue::Table>(value.value);
+			ASSERT_EQ(nested.size(), 1u);
+			EXPECT_TRUE(std::get<bool>(nested[0].second.value));
+		} else {
+			EXPECT_EQ(tests::toNumber(key), 1);
+			EXPECT_EQ(std::get<std::string>(value.value), "first");
+		}
+	}
+}
+
+TEST(LuaStatePoolTest, StatesOnlyGetThePureLibraries) {
+	LuaStatePool pool;
+	pool.init(0);
+	ASSERT_TRUE(pool.loadBuffer(R"(
+		function sandboxed()
+			return io == nil and os == nil and jit == nil and require == nil and dofile == nil and load == nil and loadstring == nil
+				and collectgarbage == nil and coroutine == nil and string.dump == nil and math.floor ~= nil and string.format ~= nil and table.concat ~= nil
+		end
+	)",
+	                            "sandboxed"));
+
+	LuaPureValues results;
+	std::string error;
+	ASSERT_TRUE(pool.call("sandboxed", {}, results, error)) << error;
+	ASSERT_EQ(results.size(), 1u);
+	EXPECT_TRUE(std::get<bool>(results[0].value));
+	EXPECT_FALSE(pool.hasWorkers());
+}
+
+TEST(LuaStatePoolTest, FailsOnErrorsAndValuesThatCannotBeCopied) {
+	LuaStatePool pool;
+	pool.init(1);
+	ASSERT_TRUE(pool.loadBuffer("function fails() error('broken formula') end function leaks() return print end", "errors"));
+
+	LuaPureValues results;
+	std::string error;
+	EXPECT_FALSE(pool.call("missing", {}, results, error));
+	EXPECT_FALSE(pool.call("fails", {}, results, error));
+	EXPECT_NE(error.find("broken formula"), std::string::npos);
+	EXPECT_FALSE(pool.call("leaks", {}, results, error));
+
+	// The state is still usable afterwards
+	ASSERT_TRUE(pool.loadBuffer("function ok() return 1 end", "ok"));
+	EXPECT_TRUE(pool.call("ok", {}, results, error));
+}
+
+TEST(LuaStatePoolTest, ParallelCallsMatchSerialResults) {
+	constexpr size_t CASTS = 400;
+	const size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+
+	LuaStatePool single;
+	single.init(1);
+	ASSERT_TRUE(single.loadBuffer(tests::AREA_SPELL_SCRIPT, "spell"));
+
+	LuaStatePool parallel;
+	parallel.init(threads);
+	ASSERT_TRUE(parallel.loadBuffer(tests::AREA_SPELL_SCRIPT, "spell"));
+
+	std::vector<double> serialTotals;
+	std::vector<double> parallelTotals;
+	tests::castSpells(single, 1, CASTS, serialTotals);
+	tests::castSpells(parallel, threads, CASTS, parallelTotals);
+
+	EXPECT_EQ(serialTotals, parallelTotals);
+	EXPECT_TRUE(std::ranges::none_of(serialTotals, [](double total) { return total == 0; }));
+}
+
+TEST(LuaStatePoolTest, CloseWaitsForCallsInProgress) {
+	LuaStatePool pool;
+	pool.init(4);
+	ASSERT_TRUE(pool.loadBuffer(tests::AREA_SPELL_SCRIPT, "spell"));
+
+	std::atomic<size_t> succeeded = 0;
+	std::atomic<size_t> refused = 0;
+	std::vector<std::thread> callers;
+	for (size_t caller = 0; caller < 4; ++caller) {
+		callers.emplace_back([&] {
+			LuaPureValues results;
+			std::string error;
+			for (size_t cast = 0; cast < 200; ++cast) {
+				if (pool.call("castAreaSpell", { tests::number(100), tests::number(50), tests::number(40) }, results, error)) {
+					++succeeded;
+				} else if (error.find("not initialized") != std::string::npos) {
+					++refused;
+				}
+			}
+		});
+	}
+
+	while (succeeded == 0) {
+		std::this_thread::yield();
+	}
+	pool.close();
+	for (auto &caller : callers) {
+		caller.join();
+	}
+
+	// Every call either ran on a live state or was refused, none failed half way
+	EXPECT_EQ(succeeded + refused, 800u);
+	EXPECT_EQ(pool.size(), 0u);
+}
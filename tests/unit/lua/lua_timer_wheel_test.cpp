@@ -0,0 +1,130 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "lua/global/lua_timer_wheel.hpp"
+
+namespace {
+	constexpr int64_t START = 1'000'000;
+
+	std::vector<uint32_t> advance(LuaTimerWheel &wheel, int64_t now) {
+		std::vector<uint32_t> expired;
+		wheel.advance(now, expired);
+		return expired;
+	}
+}
+
+TEST(LuaTimerWheelTest, ExpiresInOrderAndNeverEarly) {
+	LuaTimerWheel wheel;
+	const auto late = wheel.add(START, 250, 1, "late.lua", 10, {});
+	const auto early = wheel.add(START, 100, 1, "early.lua", 11, {});
+	const auto sameTime = wheel.add(START, 100, 1, "early.lua", 12, {});
+
+	EXPECT_TRUE(advance(wheel, START + 99).empty());
+	EXPECT_EQ(advance(wheel, START + 100), (std::vector<uint32_t> { early, sameTime }));
+	EXPECT_TRUE(advance(wheel, START + 249).empty());
+	EXPECT_EQ(advance(wheel, START + 260), std::vector<uint32_t> { late });
+
+	// Expired timers are only removed by their owner
+	EXPECT_EQ(wheel.size(), 3u);
+	for (const auto id : { early, sameTime, late }) {
+		EXPECT_TRUE(wheel.erase(id));
+	}
+	EXPECT_TRUE(wheel.empty());
+}
+
+TEST(LuaTimerWheelTest, TimersBeyondOneTurnWaitForTheirRound) {
+	LuaTimerWheel wheel;
+	const auto turn = static_cast<uint32_t>(LuaTimerWheel::SLOTS * LuaTimerWheel::RESOLUTION);
+	const auto far = wheel.add(START, turn + 100, 1, "far.lua", 10, {});
+
+	EXPECT_TRUE(advance(wheel, START + 100).empty());
+	EXPECT_TRUE(advance(wheel, START + turn).empty());
+	EXPECT_EQ(advance(wheel, START + turn + 100), std::vector<uint32_t> { far });
+}
+
+TEST(LuaTimerWheelTest, CatchesUpAfterLongStalls) {
+	LuaTimerWheel wheel;
+	const auto turn = static_cast<int64_t>(LuaTimerWheel::SLOTS * LuaTimerWheel::RESOLUTION);
+	const auto first = wheel.add(START, 100, 1, "a.lua", 10, {});
+	const auto second = wheel.add(START, 5000, 1, "a.lua", 11, {});
+
+	EXPECT_EQ(advance(wheel, START + 3 * turn), (std::vector<uint32_t> { first, second }));
+}
+
+TEST(LuaTimerWheelTest, StoppedTimersDoNotExpire) {
+	LuaTimerWheel wheel;
+	const auto stopped = wheel.add(START, 100, 1, "a.lua", 10, {});
+	const auto kept = wheel.add(START, 100, 1, "a.lua", 11, {});
+
+	EXPECT_TRUE(wheel.erase(stopped));
+	EXPECT_FALSE(wheel.erase(stopped));
+	EXPECT_EQ(wheel.find(stopped), nullptr);
+	EXPECT_EQ(advance(wheel, START + 100), std::vector<uint32_t> { kept });
+}
+
+TEST(LuaTimerWheelTest, ParametersAreKeptInOrderAndRecycled) {
+	LuaTimerWheel wheel;
+	const std::vector<int32_t> parameters { 7, 8, 9 };
+	const auto first = wheel.add(START, 100, 1, "a.lua", 10, parameters);
+
+	const auto* timer = wheel.find(first);
+	ASSERT_NE(timer, nullptr);
+	EXPECT_EQ(timer->function, 10);
+	EXPECT_TRUE(std::ranges::equal(wheel.getParameters(*timer), parameters));
+
+	const auto offset = timer->parameterOffset;
+	wheel.erase(first);
+
+	const std::vector<int32_t> otherParameters { 1, 2, 3 };
+	const auto second = wheel.add(START, 100, 1, "a.lua", 11, otherParameters);
+	timer = wheel.find(second);
+	ASSERT_NE(timer, nullptr);
+	EXPECT_EQ(timer->parameterOffset, offset);
+	EXPECT_TRUE(std::ranges::equal(wheel.getParameters(*timer), otherParameters));
+}
+
+TEST(LuaTimerWheelTest, CountsTimersPerScript) {
+	LuaTimerWheel wheel;
+	const auto a1 = wheel.add(START, 100, 1, "a.lua", 10, {});
+	wheel.add(START, 100, 1, "a.lua", 11, {});
+	wheel.add(START, 100, 2, "b.lua", 12, {});
+	wheel.erase(a1);
+
+	const auto &scripts = wheel.getScriptStats();
+	ASSERT_EQ(scripts.size(), 2u);
+	EXPECT_EQ(scripts[0].name, "a.lua");
+	EXPECT_EQ(scripts[0].active, 1u);
+	EXPECT_EQ(scripts[0].created, 2u);
+	EXPECT_EQ(scripts[1].name, "b.lua");
+	EXPECT_EQ(scripts[1].active, 1u);
+}
+
+TEST(LuaTimerWheelTest, ResolvesScriptNamesOncePerKey) {
+	LuaTimerWheel wheel;
+	int resolved = 0;
+	const auto name = [&resolved](std::string value) {
+		return [&resolved, value] {
+			++resolved;
+			return value;
+		};
+	};
+
+	const auto a = wheel.getScriptIndex(1, name("a.lua"));
+	EXPECT_EQ(wheel.getScriptIndex(1, name("a.lua")), a);
+	const auto b = wheel.getScriptIndex(2, name("b.lua"));
+	// Another key for the same file, e.g. after a reload
+	EXPECT_EQ(wheel.getScriptIndex(3, name("a.lua")), a);
+	EXPECT_NE(a, b);
+	EXPECT_EQ(resolved, 3);
+
+	wheel.add(START, 100, 1, a, 10, {});
+	wheel.add(START, 100, 3, a, 11, {});
+	EXPECT_EQ(wheel.getScriptStats()[a].created, 2u);
+	EXPECT_EQ(wheel.getScriptStats()[b].created, 0u);
+}
@@ -0,0 +1,104 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/connection/receivebuffer.hpp"
+#include "server/network/receive_stream.hpp"
+
+TEST(ReceiveBufferTest, TakesWhatIsBufferedAndRewindsWhenDrained) {
+	ReceiveBuffer buffer(8);
+	EXPECT_EQ(buffer.capacity(), 8u);
+	EXPECT_EQ(buffer.available(), 0u);
+
+	const std::array<uint8_t, 5> incoming { 1, 2, 3, 4, 5 };
+	std::memcpy(buffer.writePosition(), incoming.data(), incoming.size());
+	buffer.commit(incoming.size());
+	EXPECT_EQ(buffer.writableBytes(), 3u);
+
+	std::array<uint8_t, 8> destination {};
+	EXPECT_EQ(buffer.take(destination.data(), 2), 2u);
+	EXPECT_EQ(buffer.available(), 3u);
+	EXPECT_EQ(buffer.take(destination.data() + 2, 6), 3u);
+	EXPECT_EQ(destination, (std::array<uint8_t, 8> { 1, 2, 3, 4, 5, 0, 0, 0 }));
+
+	EXPECT_EQ(buffer.available(), 0u);
+	EXPECT_EQ(buffer.writableBytes(), 8u);
+}
+
+TEST(ReceiveBufferTest, FramesPacketsSplitAnywhere) {
+	std::mt19937 random(5);
+	std::vector<std::vector<uint8_t>> sent;
+	const auto stream = tests::makeStream(2000, random, sent);
+
+	// The network hands the stream over in pieces that have nothing to do with the packets
+	size_t position = 0;
+	const auto read = [&](uint8_t* destination, size_t size) {
+		const size_t bytes = std::min({ size, stream.size() - position, static_cast<size_t>(1 + random() % 300) });
+		std::memcpy(destination, stream.data() + position, bytes);
+		position += bytes;
+		return bytes;
+	};
+
+	ReceiveBuffer buffer(128);
+	size_t reads = 0;
+	EXPECT_EQ(tests::parseStream(buffer, sent.size(), read, reads), sent);
+	EXPECT_EQ(position, stream.size());
+	EXPECT_EQ(buffer.available(), 0u);
+}
+
+TEST(ReceiveBufferTest, ReadsWhatIsMissingOnly) {
+	ReceiveBuffer buffer(8);
+	std::array<uint8_t, 16> destination {};
+
+	// Everything is missing and fits, the read goes to the buffer and may take more
+	auto pending = buffer.beginRead(destination.data(), 3);
+	EXPECT_EQ(pending.target, buffer.writePosition());
+	EXPECT_EQ(pending.minimum, 3u);
+	EXPECT_EQ(pending.maximum, 8u);
+	const std::array<uint8_t, 5> incoming { 1, 2, 3, 4, 5 };
+	std::memcpy(pending.target, incoming.data(), incoming.size());
+	buffer.endRead(pending, incoming.size());
+	EXPECT_EQ(buffer.available(), 2u);
+
+	// Buffered already, the socket isn't touched
+	pending = buffer.beginRead(destination.data() + 3, 2);
+	EXPECT_EQ(pending.minimum, 0u);
+	EXPECT_EQ((std::array<uint8_t, 5> { destination[0], destination[1], destination[2], destination[3], destination[4] }), incoming);
+
+	// Larger than the buffer, read straight to the destination
+	pending = buffer.beginRead(destination.data(), 12);
+	EXPECT_EQ(pending.target, destination.data());
+	EXPECT_EQ(pending.minimum, 12u);
+	EXPECT_EQ(pending.maximum, 12u);
+	EXPECT_EQ(pending.destination, nullptr);
+}
+
+TEST(ReceiveBufferTest, CoalescesTheReadsOfSmallPackets) {
+	std::mt19937 random(7);
+	std::vector<std::vector<uint8_t>> sent;
+	const auto stream = tests::makeStream(2000, random, sent);
+
+	const auto parse = [&stream, &sent](size_t capacity) {
+		// A socket with the whole stream waiting, each read takes as much as it is given room for
+		size_t position = 0;
+		const auto read = [&](uint8_t* destination, size_t size) {
+			const size_t bytes = std::min(size, stream.size() - position);
+			std::memcpy(destination, stream.data() + position, bytes);
+			position += bytes;
+			return bytes;
+		};
+
+		ReceiveBuffer buffer(capacity);
+		size_t reads = 0;
+		EXPECT_EQ(tests::parseStream(buffer, sent.size(), read, reads), sent);
+		return reads;
+	};
+
+	EXPECT_EQ(parse(0), sent.size() * 2);
+	EXPECT_LE(parse(4096), stream.size() / 4096 + sent.size() / 100);
+}
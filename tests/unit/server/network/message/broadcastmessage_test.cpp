@@ -0,0 +1,66 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/message/broadcastmessage.hpp"
+#include "server/network/message/outputmessage.hpp"
+
+TEST(BroadcastMessageTest, EncodesEachVariantOnce) {
+	size_t calls = 0;
+	BroadcastMessage broadcast([&calls](NetworkMessage &msg, BroadcastMessage::Fragment &, bool oldProtocol) {
+		++calls;
+		msg.addByte(0x83);
+		msg.addByte(oldProtocol ? 1 : 2);
+		return true;
+	});
+
+	for (size_t viewer = 0; viewer < 200; ++viewer) {
+		const auto* fragment = broadcast.getFragment(viewer % 10 == 0);
+		ASSERT_NE(fragment, nullptr);
+		EXPECT_EQ(fragment->bytes, (std::vector<uint8_t> { 0x83, static_cast<uint8_t>(viewer % 10 == 0 ? 1 : 2) }));
+	}
+	EXPECT_EQ(calls, 2u);
+	EXPECT_EQ(broadcast.getEncodeCount(), 2u);
+}
+
+TEST(BroadcastMessageTest, VariantsWithNothingToSendAreSkipped) {
+	BroadcastMessage broadcast([](NetworkMessage &msg, BroadcastMessage::Fragment &, bool oldProtocol) {
+		msg.addByte(0x83);
+		return !oldProtocol;
+	});
+
+	EXPECT_EQ(broadcast.getFragment(true), nullptr);
+	EXPECT_NE(broadcast.getFragment(false), nullptr);
+}
+
+TEST(BroadcastMessageTest, PatchesAreWrittenPerViewer) {
+	BroadcastMessage broadcast([](NetworkMessage &msg, BroadcastMessage::Fragment &fragment, bool) {
+		msg.addByte(0xAA);
+		fragment.addPatch(msg, BroadcastMessage::Patch::StatementId);
+		msg.addString("hello");
+		return true;
+	});
+
+	const auto* fragment = broadcast.getFragment(false);
+	ASSERT_NE(fragment, nullptr);
+	ASSERT_EQ(fragment->patches.size(), 1u);
+	EXPECT_EQ(fragment->patches[0].first, 1);
+
+	for (uint32_t statementId : { 7u, 8u }) {
+		const auto output = OutputMessagePool::getOutputMessage();
+		output->addByte(0x01);
+		const auto start = output->getBufferPosition();
+		output->addBytes(reinterpret_cast<const char*>(fragment->bytes.data()), fragment->bytes.size());
+		output->patch<uint32_t>(start + fragment->patches[0].first, statementId);
+
+		output->setBufferPosition(start);
+		EXPECT_EQ(output->getByte(), 0xAA);
+		EXPECT_EQ(output->get<uint32_t>(), statementId);
+		EXPECT_EQ(output->getString(), "hello");
+	}
+}
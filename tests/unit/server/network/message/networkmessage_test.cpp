@@ -10,8 +10,65 @@
 #include "lib/logging/in_memory_logger.hpp"
 
 #include "server/network/message/networkmessage.hpp"
+#include "server/network/message/outputmessage.hpp"
+#include "map/map_const.hpp"
 #include "utils/tools.hpp"
 
+namespace {
+	/**
+	 * Writes what a full map description looks like on a crowded surface floor: the 18x14 client view of
+	 * the eight floors down to the ground, tiles with a ground and a few items, a creature every few tiles
+	 * and skip markers for the empty ones.
+	 */
+	void writeMapDescription(NetworkMessage &msg) {
+		constexpr int32_t width = (MAP_MAX_CLIENT_VIEW_PORT_X + 1) * 2;
+		constexpr int32_t height = (MAP_MAX_CLIENT_VIEW_PORT_Y + 1) * 2;
+		msg.addByte(0x64);
+		msg.addPosition(Position { 1000, 1000, 7 });
+
+		uint32_t tile = 0;
+		for (int32_t z = 7; z >= 0; --z) {
+			for (int32_t x = 0; x < width; ++x) {
+				for (int32_t y = 0; y < height; ++y, ++tile) {
+					if (z < 6 && tile % 3 != 0) {
+						msg.addByte(0);
+						msg.addByte(0xFF);
+						continue;
+					}
+
+					msg.add<uint16_t>(0);
+					msg.add<uint16_t>(static_cast<uint16_t>(100 + tile % 400));
+					for (uint32_t item = 0; item < tile % 4; ++item) {
+						msg.add<uint16_t>(static_cast<uint16_t>(2000 + item));
+						msg.addByte(0xFF);
+					}
+
+					if (tile % 5 == 0) {
+						msg.add<uint16_t>(0x61);
+						msg.add<uint32_t>(0);
+						msg.add<uint32_t>(0x10000000 + tile);
+						msg.addByte(0);
+						msg.addString("Player Name");
+						msg.addByte(100);
+						msg.addByte(2);
+						msg.add<uint16_t>(128);
+						for (uint8_t part = 0; part < 5; ++part) {
+							msg.addByte(part);
+						}
+						msg.add<uint16_t>(0);
+						msg.add<uint16_t>(220);
+						msg.addByte(0);
+						msg.addByte(0);
+						msg.addByte(0);
+					}
+					msg.addByte(0);
+					msg.addByte(0xFF);
+				}
+			}
+		}
+	}
+}
+
 TEST(NetworkMessageTest, AddByteAndGetByte) {
 	NetworkMessage msg;
 	uint8_t byteToAdd = 100;
@@ -128,3 +185,31 @@ TEST(NetworkMessageTest, AddBytesValidatesContent) {
 	);
 	EXPECT_EQ(testData, extractedData);
 }
+
+TEST(NetworkMessageTest, ReserveAndPatch) {
+	NetworkMessage msg;
+	msg.addByte(0x10);
+	const auto countPosition = msg.reserve<uint16_t>();
+	msg.add<uint32_t>(0xDEADBEEF);
+	msg.patch<uint16_t>(countPosition, 513);
+	EXPECT_EQ(msg.getLength(), 7);
+
+	// Out of the written bytes, nothing changes
+	msg.patch<uint32_t>(msg.getBufferPosition() - 2, 0);
+	msg.patch<uint16_t>(0, 0);
+
+	msg.setBufferPosition(NetworkMessage::INITIAL_BUFFER_POSITION);
+	EXPECT_EQ(msg.getByte(), 0x10);
+	EXPECT_EQ(msg.get<uint16_t>(), 513);
+	EXPECT_EQ(msg.get<uint32_t>(), 0xDEADBEEF);
+	EXPECT_EQ(msg.get<uint32_t>(), 0u);
+}
+
+TEST(NetworkMessageTest, MapDescriptionWrittenInPlaceMatchesAppended) {
+	NetworkMessage copied;
+	writeMapDescription(copied);
+	const auto direct = OutputMessagePool::getOutputMessage();
+	writeMapDescription(*direct);
+	ASSERT_EQ(copied.getLength(), direct->getLength());
+	EXPECT_EQ(std::memcmp(copied.getBuffer() + NetworkMessage::INITIAL_BUFFER_POSITION, direct->getOutputBuffer(), copied.getLength()), 0);
+}
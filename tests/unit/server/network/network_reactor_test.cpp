@@ -0,0 +1,56 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/server.hpp"
+
+TEST(NetworkReactorPoolTest, WithoutReactorsSocketsStayOnTheAcceptors) {
+	NetworkReactorPool pool;
+	EXPECT_TRUE(pool.empty());
+	EXPECT_EQ(pool.next(), nullptr);
+}
+
+TEST(NetworkReactorPoolTest, AssignsConnectionsRoundRobin) {
+	NetworkReactorPool pool;
+	pool.start(3);
+
+	std::vector<size_t> ids;
+	for (size_t i = 0; i < 6; ++i) {
+		ids.emplace_back(pool.next()->getId());
+	}
+	EXPECT_EQ(ids, (std::vector<size_t> { 0, 1, 2, 0, 1, 2 }));
+	pool.stop();
+	EXPECT_TRUE(pool.empty());
+}
+
+TEST(NetworkReactorPoolTest, EachReactorRunsOnItsOwnThread) {
+	constexpr size_t REACTORS = 4;
+	NetworkReactorPool pool;
+	pool.start(REACTORS);
+
+	std::mutex mutex;
+	std::condition_variable done;
+	std::set<std::thread::id> threads;
+	for (size_t i = 0; i < REACTORS; ++i) {
+		const auto reactor = pool.next();
+		reactor->onConnectionOpen();
+		EXPECT_EQ(reactor->getConnections(), 1);
+
+		asio::post(reactor->getIoContext(), [&] {
+			std::scoped_lock lock(mutex);
+			threads.emplace(std::this_thread::get_id());
+			done.notify_one();
+		});
+	}
+
+	std::unique_lock lock(mutex);
+	ASSERT_TRUE(done.wait_for(lock, std::chrono::seconds(5), [&] { return threads.size() == REACTORS; }));
+	EXPECT_FALSE(threads.contains(std::this_thread::get_id()));
+	lock.unlock();
+	pool.stop();
+}
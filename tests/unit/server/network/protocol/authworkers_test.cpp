@@ -0,0 +1,66 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/protocol/authworkers.hpp"
+#include "server/network/login_burst.hpp"
+
+TEST(AuthWorkersTest, RunsInlineWithoutThreads) {
+	AuthWorkers workers;
+	workers.start(0, 1);
+
+	const auto caller = std::this_thread::get_id();
+	std::thread::id ranOn;
+	EXPECT_TRUE(workers.submit([&ranOn] { ranOn = std::this_thread::get_id(); }));
+	EXPECT_EQ(ranOn, caller);
+	EXPECT_EQ(workers.getThreadCount(), 0u);
+}
+
+TEST(AuthWorkersTest, RefusesJobsBeyondTheQueueSize) {
+	AuthWorkers workers;
+	workers.start(1, 2);
+
+	std::promise<void> release;
+	std::promise<void> started;
+	const auto blocked = release.get_future().share();
+	ASSERT_TRUE(workers.submit([&started, blocked] {
+		started.set_value();
+		blocked.wait();
+	}));
+	started.get_future().wait();
+
+	std::atomic<int> ran = 0;
+	EXPECT_TRUE(workers.submit([&ran] { ran.fetch_add(1); }));
+	EXPECT_TRUE(workers.submit([&ran] { ran.fetch_add(1); }));
+	EXPECT_EQ(workers.getQueueDepth(), 2u);
+	EXPECT_FALSE(workers.submit([&ran] { ran.fetch_add(1); }));
+
+	// Stopping still runs what was queued
+	release.set_value();
+	workers.stop();
+	EXPECT_EQ(ran.load(), 2);
+	EXPECT_EQ(workers.getQueueDepth(), 0u);
+}
+
+TEST(AuthWorkersTest, LoginBurstAfterRestart) {
+	constexpr size_t LOGINS = 64;
+	const size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+
+	AuthWorkers single;
+	single.start(1, LOGINS);
+	AuthWorkers parallel;
+	parallel.start(threads, LOGINS);
+
+	std::vector<uint64_t> serialResults;
+	std::vector<uint64_t> parallelResults;
+	tests::loginBurst(single, LOGINS, serialResults);
+	tests::loginBurst(parallel, LOGINS, parallelResults);
+
+	EXPECT_EQ(serialResults, parallelResults);
+	EXPECT_TRUE(std::ranges::none_of(parallelResults, [](uint64_t result) { return result == 0; }));
+}
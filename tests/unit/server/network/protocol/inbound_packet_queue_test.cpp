@@ -0,0 +1,139 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "config/configmanager.hpp"
+#include "server/network/connection/connection.hpp"
+#include "server/network/message/networkmessage.hpp"
+#include "server/network/protocol/protocol.hpp"
+
+namespace {
+	class QueueTestProtocol final : public Protocol {
+	public:
+		using Protocol::Protocol;
+		using Protocol::parseInboundPackets;
+		using Protocol::queueInboundPacket;
+
+		bool onRecvFirstMessage(NetworkMessage &) override {
+			return false;
+		}
+
+		void parsePacket(NetworkMessage &msg) override {
+			parsed.emplace_back(msg.get<uint32_t>());
+		}
+
+		std::vector<uint32_t> parsed;
+	};
+
+	NetworkMessage makePacket(uint32_t id) {
+		NetworkMessage msg;
+		msg.add<uint32_t>(id);
+		msg.setBufferPosition(NetworkMessage::INITIAL_BUFFER_POSITION);
+		return msg;
+	}
+
+	class InboundPacketQueueTest : public ::testing::Test {
+	protected:
+		void TearDown() override {
+			if (const auto &connection = protocol ? protocol->getConnection() : nullptr) {
+				connection->close(true);
+			}
+			protocol.reset();
+
+			// Back to the defaults for the tests that follow
+			writeConfig("");
+			g_configManager().setConfigFileLua(previousConfigFile);
+			std::error_code error;
+			std::filesystem::remove(configPath, error);
+		}
+
+		void start(size_t queueSize, bool disconnect) {
+			previousConfigFile = g_configManager().getConfigFileLua();
+			writeConfig(fmt::format("inboundPacketQueueSize = {}\ninboundPacketQueueDisconnect = {}\n", queueSize, disconnect));
+
+			// Only the connection manager keeps the connection, closing it expires the protocol's
+			protocol = std::make_shared<QueueTestProtocol>(ConnectionManager::getInstance().createConnection(ioContext, nullptr));
+		}
+
+		void writeConfig(const std::string &content) {
+			{
+				std::ofstream file(configPath);
+				ASSERT_TRUE(file.is_open());
+				file << content;
+			}
+			g_configManager().setConfigFileLua(configPath.string());
+			ASSERT_TRUE(g_configManager().reload());
+		}
+
+		asio::io_context ioContext;
+		std::shared_ptr<QueueTestProtocol> protocol;
+		std::filesystem::path configPath = std::filesystem::temp_directory_path() / "canary-inbound-packet-queue-test.lua";
+		std::string previousConfigFile;
+	};
+}
+
+TEST_F(InboundPacketQueueTest, FullQueuePausesTheReads) {
+	start(3, false);
+
+	EXPECT_FALSE(protocol->queueInboundPacket(makePacket(1)));
+	EXPECT_FALSE(protocol->queueInboundPacket(makePacket(2)));
+	EXPECT_TRUE(protocol->queueInboundPacket(makePacket(3)));
+	EXPECT_TRUE(protocol->parsed.empty());
+	EXPECT_FALSE(protocol->isConnectionExpired());
+
+	// Nothing reads the socket while the dispatcher hasn't made room
+	EXPECT_EQ(ioContext.poll(), 0u);
+}
+
+TEST_F(InboundPacketQueueTest, DrainingResumesTheReads) {
+	start(2, false);
+
+	EXPECT_FALSE(protocol->queueInboundPacket(makePacket(1)));
+	EXPECT_TRUE(protocol->queueInboundPacket(makePacket(2)));
+	EXPECT_EQ(ioContext.poll(), 0u);
+
+	protocol->parseInboundPackets();
+	EXPECT_EQ(protocol->parsed, (std::vector<uint32_t> { 1, 2 }));
+
+	// The ring is reused in order once drained
+	EXPECT_FALSE(protocol->queueInboundPacket(makePacket(3)));
+	protocol->parseInboundPackets();
+	EXPECT_EQ(protocol->parsed, (std::vector<uint32_t> { 1, 2, 3 }));
+
+	// resumeWork started a read, the socket isn't connected so it completes at once
+	ioContext.restart();
+	EXPECT_GT(ioContext.poll(), 0u);
+}
+
+TEST_F(InboundPacketQueueTest, NotPausedQueueDoesNotResume) {
+	start(4, false);
+
+	EXPECT_FALSE(protocol->queueInboundPacket(makePacket(1)));
+	EXPECT_FALSE(protocol->queueInboundPacket(makePacket(2)));
+	protocol->parseInboundPackets();
+	EXPECT_EQ(protocol->parsed, (std::vector<uint32_t> { 1, 2 }));
+
+	// The connection kept reading, a second read would overlap the one in progress
+	EXPECT_EQ(ioContext.poll(), 0u);
+}
+
+TEST_F(InboundPacketQueueTest, FullQueueDisconnectsWhenConfigured) {
+	start(2, true);
+
+	EXPECT_FALSE(protocol->queueInboundPacket(makePacket(1)));
+	// The reads never stop, the next packet finds the queue full
+	EXPECT_FALSE(protocol->queueInboundPacket(makePacket(2)));
+	EXPECT_FALSE(protocol->isConnectionExpired());
+
+	EXPECT_TRUE(protocol->queueInboundPacket(makePacket(3)));
+	EXPECT_TRUE(protocol->isConnectionExpired());
+
+	// Nothing is parsed for a closed connection
+	protocol->parseInboundPackets();
+	EXPECT_TRUE(protocol->parsed.empty());
+}
@@ -0,0 +1,182 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/protocol/knowncreaturecache.hpp"
+
+namespace {
+	constexpr uint32_t FIRST_ID = 0x10000000;
+
+	// What ProtocolGame did before the cache: a hash set scanned from the start to find a creature to forget
+	class LegacyKnownCreatures {
+	public:
+		template <typename Predicate>
+		uint32_t check(uint32_t id, Predicate &&canEvict) {
+			if (!set.insert(id).second || set.size() <= KnownCreatureCache::CAPACITY) {
+				return 0;
+			}
+			for (auto it = set.begin(); it != set.end(); ++it) {
+				if (*it != id && canEvict(*it)) {
+					const auto removed = *it;
+					set.erase(it);
+					return removed;
+				}
+			}
+			auto it = set.begin();
+			if (*it == id) {
+				++it;
+			}
+			const auto removed = *it;
+			set.erase(it);
+			return removed;
+		}
+
+		bool contains(uint32_t id) const {
+			return set.contains(id);
+		}
+
+	private:
+		std::unordered_set<uint32_t> set;
+	};
+
+	struct CacheKnownCreatures {
+		template <typename Predicate>
+		uint32_t check(uint32_t id, Predicate &&canEvict) {
+			if (!cache.insert(id) || !cache.isOverCapacity()) {
+				return 0;
+			}
+			return cache.evict(id, canEvict);
+		}
+
+		bool contains(uint32_t id) const {
+			return cache.contains(id);
+		}
+
+		KnownCreatureCache cache;
+	};
+
+	struct SimulationResult {
+		uint64_t knownUpdates = 0;
+		uint64_t evictedOnScreen = 0;
+	};
+
+	/**
+	 * Every round the player sees the creatures of its screen again (one check each) and gets a few updates
+	 * for each of them (the contains lookups of the send functions). New creatures keep walking in, so the
+	 * known list stays full and every new creature evicts one that walked out of the screen.
+	 */
+	template <typename Known>
+	SimulationResult simulate(Known &known, uint32_t onScreen, uint32_t arrivalsPerRound, uint32_t rounds) {
+		SimulationResult result;
+		uint32_t nextId = FIRST_ID;
+		for (uint32_t round = 0; round < rounds; ++round) {
+			nextId += arrivalsPerRound;
+			const uint32_t firstOnScreen = nextId - std::min(nextId - FIRST_ID, onScreen);
+			const auto canEvict = [firstOnScreen](uint32_t id) {
+				return id < firstOnScreen;
+			};
+
+			for (uint32_t id = firstOnScreen; id < nextId; ++id) {
+				const auto removed = known.check(id, canEvict);
+				result.evictedOnScreen += removed >= firstOnScreen ? 1 : 0;
+				for (uint32_t update = 0; update < 4; ++update) {
+					result.knownUpdates += known.contains(id) ? 1 : 0;
+				}
+			}
+		}
+		return result;
+	}
+
+	void expectSameUpdates(uint32_t onScreen, uint32_t arrivalsPerRound, uint32_t rounds) {
+		LegacyKnownCreatures legacy;
+		const auto legacyResult = simulate(legacy, onScreen, arrivalsPerRound, rounds);
+		auto cache = std::make_unique<CacheKnownCreatures>();
+		const auto cacheResult = simulate(*cache, onScreen, arrivalsPerRound, rounds);
+
+		EXPECT_EQ(cache->cache.size(), KnownCreatureCache::CAPACITY);
+		EXPECT_EQ(cacheResult.knownUpdates, legacyResult.knownUpdates);
+		EXPECT_EQ(cacheResult.evictedOnScreen, 0u);
+	}
+}
+
+TEST(KnownCreatureCacheTest, InsertFindAndErase) {
+	KnownCreatureCache cache;
+	EXPECT_TRUE(cache.insert(FIRST_ID));
+	EXPECT_FALSE(cache.insert(FIRST_ID));
+	EXPECT_FALSE(cache.insert(0));
+	EXPECT_TRUE(cache.contains(FIRST_ID));
+	EXPECT_FALSE(cache.contains(FIRST_ID + 1));
+	EXPECT_FALSE(cache.contains(0));
+	EXPECT_EQ(cache.size(), 1u);
+
+	EXPECT_TRUE(cache.erase(FIRST_ID));
+	EXPECT_FALSE(cache.erase(FIRST_ID));
+	EXPECT_FALSE(cache.contains(FIRST_ID));
+	EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(KnownCreatureCacheTest, ErasingKeepsTheOtherIdsReachable) {
+	KnownCreatureCache cache;
+	std::set<uint32_t> expected;
+	std::mt19937 random(7);
+	for (uint32_t i = 0; i < 200000; ++i) {
+		// Sequential ids around the same range collide often, which exercises the backward shift
+		const uint32_t id = FIRST_ID + random() % (KnownCreatureCache::CAPACITY * 2);
+		if (cache.size() < KnownCreatureCache::CAPACITY && random() % 3 != 0) {
+			EXPECT_EQ(cache.insert(id), expected.insert(id).second);
+		} else {
+			EXPECT_EQ(cache.erase(id), expected.erase(id) == 1);
+		}
+	}
+
+	ASSERT_EQ(cache.size(), expected.size());
+	for (uint32_t id = FIRST_ID; id < FIRST_ID + KnownCreatureCache::CAPACITY * 2; ++id) {
+		ASSERT_EQ(cache.contains(id), expected.contains(id)) << id;
+	}
+}
+
+TEST(KnownCreatureCacheTest, EvictionSkipsProtectedAndRecentlyUsedCreatures) {
+	KnownCreatureCache cache;
+	for (uint32_t id = 1; id <= KnownCreatureCache::CAPACITY; ++id) {
+		cache.insert(id);
+	}
+	// Seen again since the last sweep, they are passed over once
+	for (uint32_t id = 1; id <= 100; ++id) {
+		cache.insert(id);
+	}
+
+	constexpr uint32_t newId = KnownCreatureCache::CAPACITY + 1;
+	ASSERT_TRUE(cache.insert(newId));
+	ASSERT_TRUE(cache.isOverCapacity());
+
+	// The party members are never offered while there is anyone else
+	const auto removed = cache.evict(newId, [](uint32_t id) { return id > 200; });
+	EXPECT_GT(removed, 200u);
+	EXPECT_FALSE(cache.contains(removed));
+	EXPECT_TRUE(cache.contains(newId));
+	EXPECT_EQ(cache.size(), KnownCreatureCache::CAPACITY);
+
+	// Everyone protected, someone other than the new creature goes anyway
+	ASSERT_TRUE(cache.insert(newId + 1));
+	const auto forced = cache.evict(newId + 1, [](uint32_t) { return false; });
+	EXPECT_NE(forced, 0u);
+	EXPECT_NE(forced, newId + 1);
+	EXPECT_TRUE(cache.contains(newId + 1));
+
+	KnownCreatureCache single;
+	single.insert(newId);
+	EXPECT_EQ(single.evict(newId, [](uint32_t) { return true; }), 0u);
+	EXPECT_TRUE(single.contains(newId));
+}
+
+TEST(KnownCreatureCacheTest, CrowdedDepotAndBossRoom) {
+	// A full depot: hundreds of players on screen, a few logging in every round
+	expectSameUpdates(600, 4, 400);
+	// A boss room: the boss keeps summoning, the summons die quickly and the known list churns all the time
+	expectSameUpdates(250, 40, 400);
+}
@@ -0,0 +1,74 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/message/outputmessage.hpp"
+#include "server/network/protocol/protocol.hpp"
+
+namespace {
+	class EncodeTestProtocol final : public Protocol {
+	public:
+		explicit EncodeTestProtocol(ChecksumMethods_t method) :
+			Protocol(nullptr) {
+			constexpr std::array<uint32_t, 4> key { 0x01234567, 0x89abcdef, 0xfedcba98, 0x76543210 };
+			enableXTEAEncryption();
+			setXTEAKey(key.data());
+			setChecksumMethod(method);
+		}
+
+		bool onRecvFirstMessage(NetworkMessage &) override {
+			return false;
+		}
+	};
+
+	OutputMessage_ptr makeMessage(const std::string &text) {
+		auto msg = OutputMessagePool::getOutputMessage();
+		msg->addByte(0x64);
+		msg->addString(text);
+		return msg;
+	}
+
+	std::vector<uint8_t> bytes(const OutputMessage_ptr &msg) {
+		return { msg->getOutputBuffer(), msg->getOutputBuffer() + msg->getLength() };
+	}
+
+	uint32_t sequenceOf(const OutputMessage_ptr &msg) {
+		uint32_t header;
+		std::memcpy(&header, msg->getOutputBuffer() + sizeof(uint16_t), sizeof(header));
+		return header;
+	}
+}
+
+TEST(ProtocolEncodeTest, EncodingAheadWritesTheSameBytes) {
+	EncodeTestProtocol lazy(CHECKSUM_METHOD_ADLER32);
+	EncodeTestProtocol ahead(CHECKSUM_METHOD_ADLER32);
+
+	const auto lazyMsg = makeMessage("encoded on the network thread");
+	lazy.onSendMessage(lazyMsg);
+
+	const auto aheadMsg = makeMessage("encoded on the network thread");
+	ahead.encodeMessage(*aheadMsg);
+	EXPECT_TRUE(aheadMsg->isEncoded());
+	ahead.onSendMessage(aheadMsg);
+
+	EXPECT_EQ(bytes(lazyMsg), bytes(aheadMsg));
+}
+
+TEST(ProtocolEncodeTest, SequenceFollowsTheWriteOrder) {
+	EncodeTestProtocol protocol(CHECKSUM_METHOD_SEQUENCE);
+
+	const auto first = makeMessage("first");
+	const auto second = makeMessage("second");
+	// The second message is encoded by the autosend flush before the first one reaches the socket
+	protocol.encodeMessage(*second);
+	protocol.onSendMessage(first);
+	protocol.onSendMessage(second);
+
+	EXPECT_EQ(sequenceOf(first), 1u);
+	EXPECT_EQ(sequenceOf(second), 2u);
+}
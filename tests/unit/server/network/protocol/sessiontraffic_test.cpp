@@ -0,0 +1,89 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019–present OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "server/network/protocol/sessiontraffic.hpp"
+#include "server/network/autosend_simulation.hpp"
+
+TEST(SessionTrafficTest, CountsPacketsByDirectionAndOpcode) {
+	SessionTraffic traffic;
+	traffic.addPacket(TrafficDirection::Inbound, 0x64, 10);
+	traffic.addPacket(TrafficDirection::Inbound, 0x64, 15);
+	traffic.addPacket(TrafficDirection::Outbound, 0x64, 200);
+	traffic.addWireBytes(TrafficDirection::Outbound, 208);
+	traffic.addWrite();
+
+	EXPECT_EQ(traffic.getPackets(TrafficDirection::Inbound, 0x64), 2u);
+	EXPECT_EQ(traffic.getBytes(TrafficDirection::Inbound, 0x64), 25u);
+	EXPECT_EQ(traffic.getPackets(TrafficDirection::Outbound, 0x64), 1u);
+	EXPECT_EQ(traffic.getBytes(TrafficDirection::Outbound, 0x64), 200u);
+	EXPECT_EQ(traffic.getPackets(TrafficDirection::Outbound, 0x65), 0u);
+	EXPECT_EQ(traffic.getWireBytes(TrafficDirection::Outbound), 208u);
+	EXPECT_EQ(traffic.getWireBytes(TrafficDirection::Inbound), 0u);
+	EXPECT_EQ(traffic.getWrites(), 1u);
+
+	// Publishing reports the changes, the totals of the session stay
+	traffic.publishMetrics({});
+	EXPECT_EQ(traffic.getPackets(TrafficDirection::Inbound, 0x64), 2u);
+}
+
+TEST(SessionTrafficTest, TimesThePingsAndSmoothsTheRoundTrip) {
+	SessionTraffic traffic;
+	EXPECT_EQ(traffic.getRoundTrip(), 0u);
+	// An answer without a ping is ignored
+	traffic.onPingReceived();
+	EXPECT_EQ(traffic.getRoundTrip(), 0u);
+
+	traffic.onPingSent();
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	traffic.onPingReceived();
+	EXPECT_GE(traffic.getRoundTrip(), 20u);
+
+	SessionTraffic smoothed;
+	smoothed.addRoundTrip(100);
+	smoothed.addRoundTrip(900);
+	EXPECT_EQ(smoothed.getRoundTrip(), 200u);
+}
+
+TEST(SessionTrafficTest, BatchesMoreForDistantAndSlowClients) {
+	SessionTraffic traffic;
+	EXPECT_EQ(traffic.getBatchTicks(false, 3), 1u);
+	EXPECT_EQ(traffic.getBatchTicks(true, 3), 3u);
+	EXPECT_EQ(traffic.getBatchTicks(true, 1), 1u);
+
+	traffic.addRoundTrip(150);
+	EXPECT_EQ(traffic.getBatchTicks(false, 3), 2u);
+	EXPECT_EQ(traffic.getBatchTicks(false, 1), 1u);
+
+	SessionTraffic distant;
+	distant.addRoundTrip(800);
+	EXPECT_EQ(distant.getBatchTicks(false, 3), 3u);
+}
+
+TEST(SessionTrafficTest, OnlyAnswersToTheClientFlush) {
+	EXPECT_TRUE(SessionTraffic::isInteractive(0x1D));
+	EXPECT_TRUE(SessionTraffic::isInteractive(0x1E));
+	EXPECT_TRUE(SessionTraffic::isInteractive(0x64));
+	EXPECT_TRUE(SessionTraffic::isInteractive(0xB5));
+
+	// Sent to every client that sees it happen
+	for (const uint8_t opcode : { 0x6D, 0xA0, 0xAA, 0xB4, 0x8C }) {
+		EXPECT_FALSE(SessionTraffic::isInteractive(opcode)) << static_cast<int>(opcode);
+	}
+}
+
+TEST(SessionTrafficTest, AdaptiveAutosendOnACrowdedServer) {
+	constexpr uint32_t TICKS = 500;
+	const auto fixed = tests::simulateAutosend(1, TICKS);
+	const auto adaptive = tests::simulateAutosend(3, TICKS);
+
+	EXPECT_EQ(fixed.messages, adaptive.messages);
+	EXPECT_LT(adaptive.writes, fixed.writes);
+	// Every message still leaves within the largest batch
+	EXPECT_LE(adaptive.waitedTicks, adaptive.messages * 2);
+}